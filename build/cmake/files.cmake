@@ -443,6 +443,8 @@ set(BASE_CMN_SRC
     src/common/languageinfo.cpp
     src/common/list.cpp
     src/common/log.cpp
+    src/common/logasync.cpp
+    src/common/logbinary.cpp
     src/common/longlong.cpp
     src/common/mimecmn.cpp
     src/common/module.cpp
@@ -489,6 +491,9 @@ set(BASE_CMN_SRC
     src/common/lzmastream.cpp
     src/common/uilocale.cpp
     src/common/fs_data.cpp
+    src/common/zstdstream.cpp
+    src/common/asyncfile.cpp
+    src/common/atomstr.cpp
 )
 
 set(BASE_AND_GUI_CMN_SRC
@@ -572,6 +577,8 @@ set(BASE_CMN_HDR
     wx/list.h
     wx/listimpl.cpp
     wx/log.h
+    wx/logasync.h
+    wx/logbinary.h
     wx/longlong.h
     wx/math.h
     wx/memconf.h
@@ -666,6 +673,9 @@ set(BASE_CMN_HDR
     wx/localedefs.h
     wx/uilocale.h
     wx/fs_data.h
+    wx/zstdstream.h
+    wx/asyncfile.h
+    wx/atomstr.h
 )
 
 set(NET_UNIX_SRC
@@ -787,6 +797,7 @@ set(GUI_CMN_SRC
     src/common/helpbase.cpp
     src/common/iconbndl.cpp
     src/common/imagall.cpp
+    src/common/imagbatch.cpp
     src/common/imagbmp.cpp
     src/common/image.cpp
     src/common/imagfill.cpp
@@ -1103,6 +1114,7 @@ set(GUI_CMN_HDR
     wx/helpbase.h
     wx/helpwin.h
     wx/iconbndl.h
+    wx/imagbatch.h
     wx/imagbmp.h
     wx/image.h
     wx/imaggif.h
@@ -367,6 +367,14 @@ if(wxUSE_LIBLZMA)
     endif()
 endif()
 
+if(wxUSE_LIBZSTD)
+    find_package(ZSTD)
+    if(NOT ZSTD_FOUND)
+        message(WARNING "libzstd not found, Zstandard compression won't be available")
+        wx_option_force_value(wxUSE_LIBZSTD OFF)
+    endif()
+endif()
+
 if (wxUSE_WEBREQUEST)
     if(wxUSE_WEBREQUEST_CURL)
         find_package(CURL)
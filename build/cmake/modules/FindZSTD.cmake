@@ -0,0 +1,26 @@
+# Find the Zstandard headers and libraries.
+#
+#  This module defines the following variables:
+#     ZSTD_FOUND        - true if libzstd is found.
+#     ZSTD_INCLUDE_DIRS - list of libzstd include directories.
+#     ZSTD_LIBRARIES    - list of libzstd libraries.
+
+find_package(PkgConfig QUIET)
+pkg_check_modules(PC_ZSTD QUIET libzstd)
+
+find_path(ZSTD_INCLUDE_DIRS
+    NAMES zstd.h
+    HINTS ${PC_ZSTD_INCLUDEDIR}
+          ${PC_ZSTD_INCLUDE_DIRS}
+)
+
+find_library(ZSTD_LIBRARIES
+    NAMES zstd zstd_static
+    HINTS ${PC_ZSTD_LIBDIR}
+          ${PC_ZSTD_LIBRARY_DIRS}
+)
+
+include(FindPackageHandleStandardArgs)
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(ZSTD DEFAULT_MSG ZSTD_LIBRARIES ZSTD_INCLUDE_DIRS)
+
+mark_as_advanced(ZSTD_INCLUDE_DIRS ZSTD_LIBRARIES)
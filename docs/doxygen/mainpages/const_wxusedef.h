@@ -146,6 +146,7 @@ library:
 @itemdef{wxUSE_LIBLZMA, Enables LZMA compression support (see @ref page_build_liblzma).}
 @itemdef{wxUSE_LIBPNG, Enables PNG format support (requires libpng). Also requires wxUSE_ZLIB.}
 @itemdef{wxUSE_LIBTIFF, Enables TIFF format support (requires libtiff).}
+@itemdef{wxUSE_LIBZSTD, Enables Zstandard compression support (requires libzstd).}
 @itemdef{wxUSE_LISTBOOK, Use wxListbook class.}
 @itemdef{wxUSE_LISTBOX, Use wxListBox class.}
 @itemdef{wxUSE_LISTCTRL, Use wxListCtrl class.}
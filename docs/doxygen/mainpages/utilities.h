@@ -71,6 +71,16 @@ use for anything else than wxWidgets docs reviewing.
 You can find it in @c utils/ifacecheck.
 
 
+@section page_utils_logdecode Log Decoder
+
+This utility converts the binary logs written by wxLogBinary to text. By
+default, it outputs the time stamp, level and text of each message, and with
+@c --verbose option it also outputs the thread, component and the location in
+the source code where the message was logged.
+
+You can find it in @c utils/logdecode.
+
+
 @section page_utils_screenshotgen Screenshot Generator
 
 This utility automates the process of taking screenshots of various GUI
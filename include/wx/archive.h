@@ -296,6 +296,54 @@ typedef wxArchiveIterator<wxArchiveInputStream,
         std::pair<wxString, wxArchiveEntry*> >  wxArchivePairIter;
 
 
+/////////////////////////////////////////////////////////////////////////////
+// wxArchiveEntryIndex
+//
+// Owns the entries read from an archive's catalog and looks them up by their
+// internal names. Used by the index classes of the archive formats, such as
+// wxZipIndex and wxTarIndex.
+
+#include "wx/hashmap.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+template <class T>
+class wxArchiveEntryIndex
+{
+public:
+    wxArchiveEntryIndex() = default;
+
+    // Takes ownership of the entry, which must not refer to the archive
+    // stream it was read from. If several entries have the same name, the
+    // last one is found, as it's the one which would be extracted.
+    void Add(T *entry) {
+        m_entries.emplace_back(entry);
+        m_names[entry->GetInternalName()] = m_entries.size() - 1;
+    }
+
+    void Clear() {
+        m_entries.clear();
+        m_names.clear();
+    }
+
+    size_t GetCount() const { return m_entries.size(); }
+    const T& GetEntry(size_t n) const { return *m_entries[n]; }
+
+    const T *Find(const wxString& name, wxPathFormat format) const {
+        const auto it = m_names.find(T::GetInternalName(name, format));
+        return it != m_names.end() ? m_entries[it->second].get() : nullptr;
+    }
+
+private:
+    std::vector<std::unique_ptr<T>> m_entries;
+    std::unordered_map<wxString, size_t, wxStringHash, wxStringEqual> m_names;
+
+    wxDECLARE_NO_COPY_TEMPLATE_CLASS(wxArchiveEntryIndex, T);
+};
+
+
 /////////////////////////////////////////////////////////////////////////////
 // wxArchiveClassFactory
 //
@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/asyncfile.h
+// Purpose:     wxAsyncFile class for asynchronous file I/O
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_ASYNCFILE_H_
+#define _WX_ASYNCFILE_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_FILE && wxUSE_THREADS
+
+#include "wx/buffer.h"
+#include "wx/event.h"
+#include "wx/file.h"
+
+#include <memory>
+
+// ----------------------------------------------------------------------------
+// constants
+// ----------------------------------------------------------------------------
+
+// Kind of the operation an wxAsyncFileEvent corresponds to.
+enum wxAsyncFileOperation
+{
+    wxASYNC_FILE_READ,
+    wxASYNC_FILE_WRITE
+};
+
+// ----------------------------------------------------------------------------
+// wxAsyncFileEvent: notifies about completion of an asynchronous operation
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_FWD_BASE wxAsyncFileEvent;
+wxDECLARE_EXPORTED_EVENT(WXDLLIMPEXP_BASE, wxEVT_ASYNC_FILE, wxAsyncFileEvent);
+
+class WXDLLIMPEXP_BASE wxAsyncFileEvent : public wxEvent
+{
+public:
+    wxAsyncFileEvent(int id = wxID_ANY,
+                     long request = 0,
+                     wxAsyncFileOperation operation = wxASYNC_FILE_READ,
+                     wxFileOffset offset = 0,
+                     size_t size = 0)
+        : wxEvent(id, wxEVT_ASYNC_FILE),
+          m_request(request),
+          m_operation(operation),
+          m_offset(offset),
+          m_size(size),
+          m_count(0),
+          m_error(0),
+          m_cancelled(false)
+    {
+    }
+
+    // Identifier of the request returned by wxAsyncFile::Read() or Write().
+    long GetRequest() const { return m_request; }
+
+    wxAsyncFileOperation GetOperation() const { return m_operation; }
+
+    // The offset and size passed to Read() or Write().
+    wxFileOffset GetOffset() const { return m_offset; }
+    size_t GetSize() const { return m_size; }
+
+    // The number of bytes actually read or written, which may be less than
+    // the size for reads at the end of file or in case of error.
+    size_t GetCount() const { return m_count; }
+
+    // The data read by a read operation.
+    const wxMemoryBuffer& GetData() const { return m_data; }
+
+    // Return true if the operation was performed without errors.
+    bool IsOk() const { return !m_error && !m_cancelled; }
+
+    // Return the system error code if the operation failed, 0 otherwise.
+    unsigned long GetErrorCode() const { return m_error; }
+
+    // Return true if the request was cancelled before being performed.
+    bool WasCancelled() const { return m_cancelled; }
+
+
+    // Setters are only used by wxWidgets itself.
+    void SetCount(size_t count) { m_count = count; }
+    void SetData(const wxMemoryBuffer& data) { m_data = data; }
+    void SetErrorCode(unsigned long error) { m_error = error; }
+    void SetCancelled() { m_cancelled = true; }
+
+    wxNODISCARD virtual wxEvent* Clone() const override
+    {
+        return new wxAsyncFileEvent(*this);
+    }
+
+    virtual wxEventCategory GetEventCategory() const override
+    {
+        return wxEVT_CATEGORY_THREAD;
+    }
+
+private:
+    long m_request;
+    wxAsyncFileOperation m_operation;
+    wxFileOffset m_offset;
+    size_t m_size;
+    size_t m_count;
+    wxMemoryBuffer m_data;
+    unsigned long m_error;
+    bool m_cancelled;
+
+    wxDECLARE_DYNAMIC_CLASS_NO_ASSIGN_DEF_COPY(wxAsyncFileEvent);
+};
+
+typedef void (wxEvtHandler::*wxAsyncFileEventFunction)(wxAsyncFileEvent&);
+
+#define wxAsyncFileEventHandler(func) \
+    wxEVENT_HANDLER_CAST(wxAsyncFileEventFunction, func)
+
+#define EVT_ASYNC_FILE(id, func) \
+    wx__DECLARE_EVT1(wxEVT_ASYNC_FILE, id, wxAsyncFileEventHandler(func))
+
+// ----------------------------------------------------------------------------
+// wxAsyncFile: performs file reads and writes in background
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxAsyncFile
+{
+public:
+    explicit wxAsyncFile(wxEvtHandler* owner = nullptr, int id = wxID_ANY);
+    wxAsyncFile(const wxString& filename,
+                wxFile::OpenMode mode,
+                wxEvtHandler* owner,
+                int id = wxID_ANY);
+
+    // Waits for all operations in progress to complete.
+    ~wxAsyncFile();
+
+    // The handler receiving wxEVT_ASYNC_FILE events and their id: changing
+    // them only affects the operations started after the change.
+    void SetOwner(wxEvtHandler* owner, int id = wxID_ANY);
+    wxEvtHandler* GetOwner() const { return m_owner; }
+    int GetId() const { return m_id; }
+
+    bool Open(const wxString& filename,
+              wxFile::OpenMode mode = wxFile::read,
+              int access = wxS_DEFAULT);
+    bool IsOpened() const;
+
+    // Cancels all the pending operations, waits for the ones in progress to
+    // complete and closes the file.
+    bool Close();
+
+    // Start reading or writing the given number of bytes at the given
+    // offset. Return the identifier of the request, which is always
+    // positive, or 0 if it couldn't be started. The data to write is copied
+    // and doesn't need to remain valid after Write() returns.
+    long Read(wxFileOffset offset, size_t size);
+    long Write(wxFileOffset offset, const void* data, size_t size);
+
+    // Cancel the given operation if it hasn't started yet, return true if it
+    // was cancelled or false if it is already in progress or done.
+    bool Cancel(long request);
+    void CancelAll();
+
+    // Block until all operations started so far complete.
+    void Wait();
+
+    // Return the number of operations that are not completed yet.
+    size_t GetPendingCount() const;
+
+
+    // Set the maximal number of background threads used by all wxAsyncFile
+    // objects, 0 means to use the default.
+    static void SetMaxThreads(unsigned maxThreads);
+    static unsigned GetMaxThreads();
+
+private:
+    long Submit(wxAsyncFileOperation operation,
+                wxFileOffset offset,
+                size_t size,
+                const void* data);
+
+    std::shared_ptr<class wxAsyncFileData> m_data;
+    wxEvtHandler* m_owner;
+    int m_id;
+
+    wxDECLARE_NO_COPY_CLASS(wxAsyncFile);
+};
+
+#endif // wxUSE_FILE && wxUSE_THREADS
+
+#endif // _WX_ASYNCFILE_H_
@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/atomstr.h
+// Purpose:     wxAtomString class for interned strings
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_ATOMSTR_H_
+#define _WX_ATOMSTR_H_
+
+#include "wx/string.h"
+
+#include <functional>
+
+// ----------------------------------------------------------------------------
+// wxAtomStringStats: information about the global table of interned strings
+// ----------------------------------------------------------------------------
+
+struct wxAtomStringStats
+{
+    // Number of distinct strings in the table.
+    size_t count = 0;
+
+    // Total length of all these strings, in characters.
+    size_t length = 0;
+
+    // Approximate amount of memory used by the table, in bytes.
+    size_t memory = 0;
+
+    // Number of times a string was interned and how many of these times it
+    // was already present in the table.
+    size_t lookups = 0;
+    size_t hits = 0;
+};
+
+// ----------------------------------------------------------------------------
+// wxAtomString: immutable string stored only once in a global table
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxAtomString
+{
+public:
+    // Default ctor creates an empty atom, without using the table at all.
+    wxAtomString() noexcept : m_str(nullptr) { }
+
+    // Intern the given string: this requires looking it up in the global
+    // table, but copying, comparing and hashing the atom is cheap.
+    explicit wxAtomString(const wxString& str) : m_str(Intern(str)) { }
+
+    // Access the interned string, which remains valid until the program
+    // termination, without copying it.
+    const wxString& GetString() const
+        { return m_str ? *m_str : GetEmptyString(); }
+    operator const wxString&() const { return GetString(); }
+
+    bool IsEmpty() const { return m_str == nullptr; }
+
+    // Comparing atoms only compares pointers.
+    bool IsSameAs(const wxAtomString& other) const
+        { return m_str == other.m_str; }
+
+    size_t GetHash() const { return std::hash<const void*>()(m_str); }
+
+
+    // Return the statistics of the table containing all interned strings.
+    static wxAtomStringStats GetStats();
+
+private:
+    // Return the pointer to the string in the table, adding it there if
+    // necessary, or null for the empty string.
+    static const wxString* Intern(const wxString& str);
+
+    static const wxString& GetEmptyString();
+
+    const wxString* m_str;
+};
+
+inline bool operator==(const wxAtomString& a, const wxAtomString& b)
+    { return a.IsSameAs(b); }
+inline bool operator!=(const wxAtomString& a, const wxAtomString& b)
+    { return !a.IsSameAs(b); }
+
+// Comparing atoms with strings compares the strings contents.
+inline bool operator==(const wxAtomString& a, const wxString& b)
+    { return a.GetString() == b; }
+inline bool operator!=(const wxAtomString& a, const wxString& b)
+    { return a.GetString() != b; }
+inline bool operator==(const wxString& a, const wxAtomString& b)
+    { return a == b.GetString(); }
+inline bool operator!=(const wxString& a, const wxAtomString& b)
+    { return a != b.GetString(); }
+
+// These overloads are needed to avoid ambiguities when comparing with literals.
+#define wxDEFINE_ATOMSTR_CMP(T)                                               \
+    inline bool operator==(const wxAtomString& a, T b)                        \
+        { return a.GetString() == b; }                                        \
+    inline bool operator!=(const wxAtomString& a, T b)                        \
+        { return a.GetString() != b; }                                        \
+    inline bool operator==(T a, const wxAtomString& b)                        \
+        { return b.GetString() == a; }                                        \
+    inline bool operator!=(T a, const wxAtomString& b)                        \
+        { return b.GetString() != a; }
+
+#ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
+wxDEFINE_ATOMSTR_CMP(const char*)
+#endif
+wxDEFINE_ATOMSTR_CMP(const wchar_t*)
+
+#undef wxDEFINE_ATOMSTR_CMP
+
+namespace std
+{
+    template<>
+    struct hash<wxAtomString>
+    {
+        size_t operator()(const wxAtomString& s) const
+        {
+            return s.GetHash();
+        }
+    };
+} // namespace std
+
+#endif // _WX_ATOMSTR_H_
@@ -691,6 +691,16 @@ private:
     wxMemoryBufferData*  m_bufdata;
 };
 
+// ----------------------------------------------------------------------------
+// wxIOVec: a chunk of memory used for vectored I/O, like POSIX struct iovec
+// ----------------------------------------------------------------------------
+
+struct wxIOVec
+{
+    const void *data;
+    size_t size;
+};
+
 // ----------------------------------------------------------------------------
 // template class for any kind of data
 // ----------------------------------------------------------------------------
@@ -79,6 +79,9 @@ public:
   ssize_t Read(void *pBuf, size_t nCount);
     // returns the number of bytes written
   size_t Write(const void *pBuf, size_t nCount);
+    // write all buffers, using a single system call if possible, and return
+    // the total number of bytes written
+  size_t WriteV(const wxIOVec *vec, size_t count);
     // returns true on success
   bool Write(const wxString& s, const wxMBConv& conv = wxConvAuto());
     // flush data not yet written
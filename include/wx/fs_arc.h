@@ -15,10 +15,38 @@
 
 #include "wx/filesys.h"
 
+#include <memory>
 #include <unordered_map>
 
 using wxArchiveFilenameHashMap = std::unordered_map<wxString, int>;
 
+//---------------------------------------------------------------------------
+// wxArchiveFSCacheStats: statistics of the cache used by wxArchiveFSHandler
+//---------------------------------------------------------------------------
+
+struct wxArchiveFSCacheStats
+{
+    // Number of archives and of their entries in the cache.
+    size_t archives = 0;
+    size_t entries = 0;
+
+    // Number of lookups of entries by name and how many of them failed.
+    size_t lookups = 0;
+    size_t lookupFailures = 0;
+
+    // Number of files opened from the cached contents and the number of them
+    // which had to be decompressed from the archive instead.
+    size_t hits = 0;
+    size_t misses = 0;
+
+    // Number of contents removed from the cache to respect its maximal size.
+    size_t evictions = 0;
+
+    // Number and total size of the currently cached contents.
+    size_t cachedFiles = 0;
+    size_t cachedBytes = 0;
+};
+
 //---------------------------------------------------------------------------
 // wxArchiveFSHandler
 //---------------------------------------------------------------------------
@@ -34,16 +62,19 @@ public:
     void Cleanup();
     virtual ~wxArchiveFSHandler();
 
-private:
-    class wxArchiveFSCache *m_cache;
-    wxFileSystem m_fs;
+    // The cache of archive catalogs and of the decompressed files contents is
+    // shared by all handlers.
+    static void SetCacheMaxSize(size_t size);
+    static size_t GetCacheMaxSize();
+    static wxArchiveFSCacheStats GetCacheStats();
+    static void ClearCache();
 
+private:
     // these vars are used by FindFirst/Next:
-    class wxArchiveFSCacheData *m_Archive;
-    struct wxArchiveFSEntry *m_FindEntry;
+    std::shared_ptr<class wxArchiveFSCacheData> m_Archive;
+    size_t m_FindIndex;
     wxString m_Pattern, m_BaseDir, m_ZipFile;
     bool m_AllowDirs, m_AllowFiles;
-    wxArchiveFilenameHashMap *m_DirsFound;
 
     wxString DoFind();
 
@@ -107,6 +107,10 @@ protected:      // internal utilities
     bool RebuildBackingStoreUpToFrame(unsigned int);
     void DrawFrame(wxDC &dc, unsigned int);
 
+    // Save the part of the backing store covered by the given frame if it
+    // uses wxANIM_TOPREVIOUS disposal, so that it can be restored later.
+    void SaveAreaUnderFrame(wxDC& dc, unsigned int frame);
+
     virtual void DisplayStaticImage() override;
     virtual wxSize DoGetBestSize() const override;
 
@@ -139,6 +143,10 @@ protected:
     wxBitmap      m_backingStore;     // The frames are drawn here and then blitted
                                       // on the screen
 
+    wxBitmap      m_bmpUnderFrame;    // The part of the backing store under
+    wxPoint       m_posUnderFrame;    // the last frame with wxANIM_TOPREVIOUS
+                                      // disposal and its position
+
 private:
     // True if we need to show the next frame after painting the current one.
     bool m_needToShowNextFrame = false;
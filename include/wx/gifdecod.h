@@ -22,6 +22,8 @@
 // internal utility used to store a frame in 8bit-per-pixel format
 class GIFImage;
 
+class WXDLLIMPEXP_FWD_BASE wxMemoryBuffer;
+
 
 // --------------------------------------------------------------------------
 // Constants
@@ -52,7 +54,13 @@ public:
     wxGIFDecoder();
     ~wxGIFDecoder();
 
-    // get data of current frame
+    // get data of current frame: notice that the frames are decoded on
+    // demand and only the data of the last frame passed to this function is
+    // kept, so the returned pointer is only valid until it is called for
+    // another frame or Destroy() is called
+    //
+    // as this and other const functions modify the internal state, the same
+    // decoder object must not be used by several threads concurrently
     unsigned char* GetData(unsigned int frame) const;
     unsigned char* GetPalette(unsigned int frame) const;
     unsigned int GetNcolours(unsigned int frame) const;
@@ -91,20 +99,30 @@ protected:
         // modifies current stream position (see wxAnimationDecoder::CanRead)
 
 private:
-    int getcode(wxInputStream& stream, int bits, int abfin);
-    wxGIFErrorCode dgif(wxInputStream& stream,
-                        GIFImage *img, int interl, int bits);
+    int getcode(wxInputStream& stream, int bits, int abfin) const;
+    wxGIFErrorCode dgif(wxInputStream& stream, const GIFImage *img,
+                        unsigned char *p, int interl, int bits) const;
+
+    // decode the given frame into the provided buffer of w*h bytes
+    wxGIFErrorCode DecodeFrame(unsigned int frame, unsigned char *p) const;
 
 
     // array of all frames
     wxArrayPtrVoid m_frames;
 
-    // decoder state vars
-    int           m_restbits;       // remaining valid bits
-    unsigned int  m_restbyte;       // remaining bytes in this block
-    unsigned int  m_lastbyte;       // last byte read
-    unsigned char m_buffer[256];    // buffer for reading
-    unsigned char *m_bufp;          // pointer to next byte in buffer
+    // decoder state vars: these are modified when decoding the frames on
+    // demand from const methods
+    mutable int           m_restbits;       // remaining valid bits
+    mutable unsigned int  m_restbyte;       // remaining bytes in this block
+    mutable unsigned int  m_lastbyte;       // last byte read
+    mutable unsigned char m_buffer[256];    // buffer for reading
+    mutable unsigned char *m_bufp;          // pointer to next byte in buffer
+    mutable wxMemoryBuffer *m_rawData;      // if non-null, raw data blocks
+                                            // read by getcode() are stored here
+
+    // decoded data of m_dataFrame returned by GetData() or null
+    mutable unsigned char *m_data;
+    mutable unsigned int   m_dataFrame;
 
     wxDECLARE_NO_COPY_CLASS(wxGIFDecoder);
 };
@@ -0,0 +1,104 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/imagbatch.h
+// Purpose:     wxImageBatchLoader class for loading many images in parallel
+// Created:     2026-10-16
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_IMAGBATCH_H_
+#define _WX_IMAGBATCH_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_IMAGE && wxUSE_STREAMS
+
+#include "wx/image.h"
+#include "wx/event.h"
+
+class WXDLLIMPEXP_FWD_BASE wxInputStream;
+class wxImageBatchLoaderImpl;
+
+// Events sent by wxImageBatchLoader::Start(): the first one is sent once for
+// every image and the second one when loading all of them is finished.
+wxDECLARE_EXPORTED_EVENT(WXDLLIMPEXP_CORE, wxEVT_IMAGE_BATCH_LOADED, wxThreadEvent);
+wxDECLARE_EXPORTED_EVENT(WXDLLIMPEXP_CORE, wxEVT_IMAGE_BATCH_COMPLETED, wxThreadEvent);
+
+// ----------------------------------------------------------------------------
+// wxImageBatchLoader: loads several images using a pool of worker threads
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxImageBatchLoader
+{
+public:
+    wxImageBatchLoader();
+
+    // Cancels loading if it's still in progress.
+    ~wxImageBatchLoader();
+
+    // Add an image to load, return its index in this loader.
+    size_t Add(const wxString& filename,
+               wxBitmapType type = wxBITMAP_TYPE_ANY,
+               int index = -1);
+
+    // Same as above, but takes ownership of the stream, which is deleted
+    // after loading the image from it.
+    size_t Add(wxInputStream* stream,
+               wxBitmapType type = wxBITMAP_TYPE_ANY,
+               int index = -1);
+
+    size_t GetCount() const;
+
+    // Remove all images, can't be called while loading.
+    void Clear();
+
+    // Options are set for all the images before loading them, e.g. this can
+    // be used with wxIMAGE_OPTION_MAX_WIDTH for loading thumbnails.
+    void SetOption(const wxString& name, const wxString& value);
+    void SetOption(const wxString& name, int value);
+
+    // Set the number of threads to use, 0 (default) means using as many
+    // threads as there are CPUs.
+    void SetMaxThreads(int maxThreads);
+    int GetMaxThreads() const;
+
+
+    // Load all images and wait until they're loaded, returns true if all of
+    // them were loaded successfully.
+    bool Load();
+
+    // Start loading images in the background, wxEVT_IMAGE_BATCH_XXX events
+    // are sent to the given handler to notify about the progress.
+    bool Start(wxEvtHandler* handler);
+
+    // Check if loading started by Start() is still in progress.
+    bool IsRunning() const;
+
+    // Stop loading as soon as possible: images not loaded yet won't be.
+    void Cancel();
+
+    // Wait until all images are loaded, return true if all of them were
+    // loaded successfully.
+    bool Wait();
+
+
+    // Access the loading results, this can be done either after Load() or
+    // Wait() return or from wxEVT_IMAGE_BATCH_LOADED handler.
+    bool IsLoaded(size_t n) const;
+    wxImage GetImage(size_t n) const;
+    wxString GetFileName(size_t n) const;
+
+private:
+    wxImageBatchLoaderImpl* const m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxImageBatchLoader);
+};
+
+#define EVT_IMAGE_BATCH_LOADED(func) \
+    wx__DECLARE_EVT0(wxEVT_IMAGE_BATCH_LOADED, wxThreadEventHandler(func))
+#define EVT_IMAGE_BATCH_COMPLETED(func) \
+    wx__DECLARE_EVT0(wxEVT_IMAGE_BATCH_COMPLETED, wxThreadEventHandler(func))
+
+#endif // wxUSE_IMAGE && wxUSE_STREAMS
+
+#endif // _WX_IMAGBATCH_H_
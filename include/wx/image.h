@@ -87,6 +87,26 @@ enum wxImageAlphaBlendMode
     wxIMAGE_ALPHA_BLEND_COMPOSE = 1
 };
 
+// Pixel formats of the external buffers which can be used with wxImageView.
+enum wxImagePixelFormat
+{
+    // 3 bytes per pixel, this is the format used by wxImage itself
+    wxIMAGE_PIXEL_FORMAT_RGB,
+    wxIMAGE_PIXEL_FORMAT_BGR,
+
+    // 4 bytes per pixel with alpha
+    wxIMAGE_PIXEL_FORMAT_RGBA,
+    wxIMAGE_PIXEL_FORMAT_BGRA,
+    wxIMAGE_PIXEL_FORMAT_ARGB,
+
+    // 4 bytes per pixel with the unused padding byte
+    wxIMAGE_PIXEL_FORMAT_RGBX,
+    wxIMAGE_PIXEL_FORMAT_BGRX,
+
+    // 1 byte per pixel
+    wxIMAGE_PIXEL_FORMAT_GREY
+};
+
 // alpha channel values: fully transparent, default threshold separating
 // transparent pixels from opaque for a few functions dealing with alpha and
 // fully opaque
@@ -102,6 +122,34 @@ class WXDLLIMPEXP_FWD_CORE wxImageHandler;
 class WXDLLIMPEXP_FWD_CORE wxImage;
 class WXDLLIMPEXP_FWD_CORE wxPalette;
 
+//-----------------------------------------------------------------------------
+// wxImageRowConsumer: receives image rows from wxImageHandler::LoadRows()
+//-----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxImageRowConsumer
+{
+public:
+    wxImageRowConsumer() = default;
+    virtual ~wxImageRowConsumer() = default;
+
+    // Called once before any rows, return false to stop loading.
+    virtual bool OnImageStart(int width, int height, bool hasAlpha) = 0;
+
+    // Called for each row, from top to bottom, with 3*width bytes of RGB data
+    // and width bytes of alpha (or nullptr if there is no alpha), which are
+    // only valid during this call. Return false to stop loading.
+    virtual bool OnImageRow(int y,
+                            const unsigned char* rgb,
+                            const unsigned char* alpha) = 0;
+
+    // Can be overridden to let the handler reduce the image size while
+    // decoding it, if it can do it cheaply. Either component may be 0 to
+    // indicate that there is no limit, as with wxIMAGE_OPTION_MAX_WIDTH.
+    virtual wxSize GetMaxSize() const { return wxSize(0, 0); }
+
+    wxDECLARE_NO_COPY_CLASS(wxImageRowConsumer);
+};
+
 //-----------------------------------------------------------------------------
 // wxImageHandler
 //-----------------------------------------------------------------------------
@@ -123,6 +171,12 @@ public:
                            bool WXUNUSED(verbose)=true )
         { return false; }
 
+    // Load the image passing its rows to the consumer as soon as they are
+    // decoded. The default implementation loads the entire image first, the
+    // handlers able to decode it row by row override this to use less memory.
+    virtual bool LoadRows( wxImageRowConsumer& consumer, wxInputStream& stream,
+                           bool verbose=true, int index=-1 );
+
     int GetImageCount( wxInputStream& stream );
         // save the stream position, call DoGetImageCount() and restore the position
 
@@ -367,6 +421,9 @@ public:
     wxImage BlurHorizontal(int radius) const;
     wxImage BlurVertical(int radius) const;
 
+    // blur the image using (an approximation of) Gaussian blur
+    wxImage GaussianBlur(double sigma) const;
+
     wxImage ShrinkBy( int xFactor , int yFactor ) const ;
 
     // rescales the image in place
@@ -464,6 +521,11 @@ public:
     void SetLoadFlags(int flags);
     int GetLoadFlags() const;
 
+    // maximal number of threads used by the image processing functions, 0
+    // means to use as many threads as there are CPUs
+    static void SetMaxThreads(int maxThreads);
+    static int GetMaxThreads();
+
     static bool CanRead( const wxString& name );
     static int GetImageCount( const wxString& name, wxBitmapType type = wxBITMAP_TYPE_ANY );
     virtual bool LoadFile( const wxString& name, wxBitmapType type = wxBITMAP_TYPE_ANY, int index = -1 );
@@ -637,6 +699,11 @@ private:
     // modified versions of this image.
     wxImage MakeEmptyClone(int flags = Clone_SameOrientation) const;
 
+    // Returns a clone of this image as created by MakeEmptyClone(), but with
+    // the same pixels and alpha values. This is used by the blurring functions
+    // which then modify this copy in place.
+    wxImage MakeBlurCopy() const;
+
 #if wxUSE_STREAMS
     // read the image from the specified stream updating image type if
     // successful
@@ -651,6 +718,92 @@ private:
 };
 
 
+//-----------------------------------------------------------------------------
+// wxImageView: non-owning view of the pixels in an external buffer
+//-----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxImageView
+{
+public:
+    // Default ctor creates an invalid view.
+    wxImageView() = default;
+
+    // Create a view of the buffer containing height rows of width pixels in
+    // the given format, with the start of each row separated from the next
+    // one by stride bytes (0 means that the rows are tightly packed).
+    wxImageView(const void* data,
+                int width,
+                int height,
+                wxImagePixelFormat format,
+                int stride = 0);
+
+    // Create a view of the existing image, which must remain alive for as
+    // long as the view is used.
+    explicit wxImageView(const wxImage& image);
+
+    // Use the separate plane with the given stride (0 meaning width) for
+    // alpha values instead of taking them from the pixel data, or stop
+    // using alpha at all if the pointer is null.
+    wxImageView& SetAlpha(const void* alpha, int stride = 0);
+
+    bool IsOk() const { return m_data != nullptr; }
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    wxSize GetSize() const { return wxSize(m_width, m_height); }
+    wxImagePixelFormat GetFormat() const { return m_format; }
+    int GetStride() const { return m_stride; }
+    const unsigned char* GetData() const { return m_data; }
+
+    bool HasAlpha() const;
+
+    static int GetBytesPerPixel(wxImagePixelFormat format);
+
+    // Return a view of the given part of this one, without copying anything.
+    wxImageView GetSubView(const wxRect& rect) const;
+
+    // Return the pointer to count pixels starting at the given position in
+    // the same format as used by wxImage, i.e. 3 bytes per pixel for RGB or
+    // 1 byte for alpha (or nullptr if there is no alpha). If the data is not
+    // in this format, it is converted into the provided buffer, which must be
+    // big enough to hold the result, and the buffer itself is returned.
+    const unsigned char*
+    GetPixelsRGB(int x, int y, int count, unsigned char* buffer) const;
+    const unsigned char*
+    GetPixelsAlpha(int x, int y, int count, unsigned char* buffer) const;
+
+    const unsigned char* GetRowRGB(int y, unsigned char* buffer) const
+        { return GetPixelsRGB(0, y, m_width, buffer); }
+    const unsigned char* GetRowAlpha(int y, unsigned char* buffer) const
+        { return GetPixelsAlpha(0, y, m_width, buffer); }
+
+    // Functions creating new images from the pixels of this view without
+    // making any intermediate copies of them.
+    wxImage ToImage() const;
+    wxImage Scale(int width, int height,
+                  wxImageResizeQuality quality = wxIMAGE_QUALITY_NORMAL) const;
+    wxImage Rotate90(bool clockwise = true) const;
+    wxImage Mirror(bool horizontally = true) const;
+
+#if wxUSE_STREAMS
+    bool SaveFile(wxOutputStream& stream, wxBitmapType type) const;
+#endif // wxUSE_STREAMS
+    bool SaveFile(const wxString& name, wxBitmapType type) const;
+
+private:
+    // Return wxImage sharing the data with this view if possible (i.e. if it
+    // uses the same layout) or a copy of it otherwise.
+    wxImage AsImage() const;
+
+    const unsigned char* m_data = nullptr;
+    const unsigned char* m_alpha = nullptr;
+    int m_width = 0;
+    int m_height = 0;
+    int m_stride = 0;
+    int m_alphaStride = 0;
+    wxImagePixelFormat m_format = wxIMAGE_PIXEL_FORMAT_RGB;
+};
+
 extern void WXDLLIMPEXP_CORE wxInitAllImageHandlers();
 
 extern WXDLLIMPEXP_DATA_CORE(wxImage)    wxNullImage;
@@ -37,6 +37,7 @@ public:
 
 #if wxUSE_STREAMS
     virtual bool LoadFile( wxImage *image, wxInputStream& stream, bool verbose=true, int index=-1 ) override;
+    virtual bool LoadRows( wxImageRowConsumer& consumer, wxInputStream& stream, bool verbose=true, int index=-1 ) override;
     virtual bool SaveFile( wxImage *image, wxOutputStream& stream, bool verbose=true ) override;
 protected:
     virtual bool DoCanRead( wxInputStream& stream ) override;
@@ -28,6 +28,8 @@
 #define wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY    wxT("PngZS")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_BUFFER_SIZE wxT("PngZB")
 #define wxIMAGE_OPTION_PNG_DESCRIPTION             wxT("PngDescription")
+#define wxIMAGE_OPTION_PNG_COMPRESSION_PROFILE     wxT("PngZP")
+#define wxIMAGE_OPTION_PNG_COMPRESSION_PARALLEL    wxT("PngZT")
 
 enum
 {
@@ -37,6 +39,14 @@ enum
     wxPNG_TYPE_PALETTE = 4
 };
 
+enum
+{
+    wxPNG_COMPRESSION_DEFAULT = 0,
+    wxPNG_COMPRESSION_FAST = 1,
+    wxPNG_COMPRESSION_BALANCED = 2,
+    wxPNG_COMPRESSION_SMALL = 3
+};
+
 class WXDLLIMPEXP_CORE wxPNGHandler: public wxImageHandler
 {
 public:
@@ -52,6 +62,7 @@ public:
 
 #if wxUSE_STREAMS
     virtual bool LoadFile( wxImage *image, wxInputStream& stream, bool verbose=true, int index=-1 ) override;
+    virtual bool LoadRows( wxImageRowConsumer& consumer, wxInputStream& stream, bool verbose=true, int index=-1 ) override;
     virtual bool SaveFile( wxImage *image, wxOutputStream& stream, bool verbose=true ) override;
 protected:
     virtual bool DoCanRead( wxInputStream& stream ) override;
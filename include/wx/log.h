@@ -607,6 +607,16 @@ protected:
     // nothing otherwise; return the old value of repetition counter
     unsigned LogLastRepeatIfNeeded();
 
+    // return true if this log target queues the records itself and its
+    // DoLogRecord() can be called from any thread: in this case OnLog() passes
+    // all records to it directly, without buffering the ones logged from the
+    // other threads and without handling their extra data nor repetitions
+    //
+    // notice that this must not change during the object lifetime, as it's
+    // used by SetActiveTarget() to decide whether it needs to wait until the
+    // other threads stop using the old target
+    virtual bool IsAsync() const { return false; }
+
 private:
 #if wxUSE_THREADS
     // called from FlushActive() to really log any buffered messages logged
@@ -639,6 +649,9 @@ private:
 
     wxLogFormatter    *m_formatter; // We own this pointer.
 
+    // wxLogAsync uses CallDoLogNow() of its target from its own thread
+    friend class wxLogAsync;
+
 
     // static variables
     // ----------------
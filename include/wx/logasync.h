@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/logasync.h
+// Purpose:     wxLogAsync class for logging from background thread
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_LOGASYNC_H_
+#define _WX_LOGASYNC_H_
+
+#include "wx/log.h"
+
+#if wxUSE_LOG && wxUSE_THREADS
+
+#include <memory>
+
+// ----------------------------------------------------------------------------
+// constants
+// ----------------------------------------------------------------------------
+
+// What to do when the buffer of the thread logging a message is full.
+enum wxLogAsyncPolicy
+{
+    // Discard the message and increment the dropped messages counter.
+    wxLOG_ASYNC_DROP,
+
+    // Wait until there is space in the buffer.
+    wxLOG_ASYNC_BLOCK
+};
+
+// ----------------------------------------------------------------------------
+// wxLogAsync: passes messages to another log target from a background thread
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxLogAsync : public wxLog
+{
+public:
+    // Takes ownership of the target, which must not be null and will be only
+    // used from the background thread and from Flush().
+    explicit wxLogAsync(wxLog* target,
+                        wxLogAsyncPolicy policy = wxLOG_ASYNC_DROP,
+                        size_t bufferSize = 1024);
+
+    // Outputs all the remaining messages before destroying the target.
+    virtual ~wxLogAsync();
+
+    wxLog* GetTarget() const { return m_target; }
+    wxLogAsyncPolicy GetPolicy() const { return m_policy; }
+
+    // Return the number of messages discarded because the buffer was full and
+    // the number of messages passed to the target so far.
+    size_t GetDroppedCount() const;
+    size_t GetLoggedCount() const;
+
+    // Pass all the messages logged so far to the target and flush it.
+    virtual void Flush() override;
+
+protected:
+    virtual void DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info) override;
+
+    virtual bool IsAsync() const override { return true; }
+
+private:
+    wxLog* const m_target;
+    const wxLogAsyncPolicy m_policy;
+
+    std::unique_ptr<class wxLogAsyncData> m_data;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsync);
+};
+
+#endif // wxUSE_LOG && wxUSE_THREADS
+
+#endif // _WX_LOGASYNC_H_
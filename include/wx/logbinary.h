@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/logbinary.h
+// Purpose:     wxLogBinary and wxLogBinaryReader for compact binary logs
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_LOGBINARY_H_
+#define _WX_LOGBINARY_H_
+
+#include "wx/log.h"
+
+#if wxUSE_LOG && wxUSE_STREAMS
+
+#include "wx/stream.h"
+
+#include <memory>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// constants
+// ----------------------------------------------------------------------------
+
+// Version of the format written by wxLogBinary.
+#define wxLOG_BINARY_VERSION 1
+
+// ----------------------------------------------------------------------------
+// wxLogBinary: log target writing records to a stream in binary format
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxLogBinary : public wxLog
+{
+public:
+    // The stream is not owned by this object and must remain valid until it
+    // is destroyed. The records are buffered and written to it only when the
+    // buffer becomes bigger than the given size or when Flush() is called.
+    explicit wxLogBinary(wxOutputStream* stream, size_t bufferSize = 65536);
+
+    // Writes the remaining buffered records to the stream.
+    virtual ~wxLogBinary();
+
+    // Return false if writing to the stream failed.
+    bool IsOk() const;
+
+    virtual void Flush() override;
+
+protected:
+    virtual void DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info) override;
+
+private:
+    std::unique_ptr<class wxLogBinaryData> m_data;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogBinary);
+};
+
+// ----------------------------------------------------------------------------
+// wxLogBinaryRecord: a record read by wxLogBinaryReader
+// ----------------------------------------------------------------------------
+
+struct wxLogBinaryRecord
+{
+    wxLogBinaryRecord()
+        : level(0),
+          timestampMS(0),
+          threadId(0),
+          line(0)
+    {
+    }
+
+    wxLogLevel level;
+
+    // Time of the record in milliseconds since Epoch.
+    wxLongLong_t timestampMS;
+
+    // Id of the thread which logged this record or 0 if unknown.
+    wxULongLong_t threadId;
+
+    // These fields are empty (and line is 0) if the information was not
+    // available when the record was logged.
+    wxString filename;
+    int line;
+    wxString func;
+    wxString component;
+
+    wxString msg;
+};
+
+// ----------------------------------------------------------------------------
+// wxLogBinaryReader: reads the records written by wxLogBinary
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxLogBinaryReader
+{
+public:
+    // The stream must remain valid while this object is used.
+    explicit wxLogBinaryReader(wxInputStream& stream);
+
+    // Return false if the stream doesn't contain a valid binary log or if it
+    // was corrupted.
+    bool IsOk() const { return m_ok; }
+
+    // Return the format version, only valid if IsOk() returned true.
+    unsigned GetVersion() const { return m_version; }
+
+    // Read the next record, return false at the end of stream or on error,
+    // use IsOk() to distinguish between the two cases.
+    bool ReadRecord(wxLogBinaryRecord& record);
+
+private:
+    bool ReadByte(unsigned char& value);
+    bool ReadVarUInt(wxULongLong_t& value);
+    bool ReadUTF8(wxString& str);
+    bool ReadStringRef(wxString& str);
+
+    wxInputStream& m_stream;
+
+    // Strings and thread ids defined so far, indexed by their ids minus 1.
+    std::vector<wxString> m_strings;
+    std::vector<wxULongLong_t> m_threads;
+
+    // Buffer used by ReadUTF8().
+    std::vector<char> m_utf8;
+
+    wxLongLong_t m_lastTimestamp;
+    unsigned m_version;
+    bool m_ok;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogBinaryReader);
+};
+
+#endif // wxUSE_LOG && wxUSE_STREAMS
+
+#endif // _WX_LOGBINARY_H_
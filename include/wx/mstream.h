@@ -72,6 +72,8 @@ public:
 
     size_t CopyTo(void *buffer, size_t len) const;
 
+    virtual wxOutputStream& WriteV(const wxIOVec *vec, size_t count) override;
+
     wxStreamBuffer *GetOutputStreamBuffer() const { return m_o_streambuf; }
 
 protected:
@@ -531,6 +531,18 @@
 // Recommended setting: 1 if you need LZMA compression.
 #define wxUSE_LIBLZMA       0
 
+// Set to 1 if libzstd is available to enable wxZstd{Input,Output}Stream
+// classes and support for Zstandard compressed entries in zip files.
+//
+// Notice that if you enable this build option when not using configure or
+// CMake, you need to ensure that libzstd headers and libraries are available
+// and can be found, as explained for wxUSE_LIBLZMA above.
+//
+// Default is 0 under MSW, auto-detected by configure.
+//
+// Recommended setting: 1 if you need Zstandard compression.
+#define wxUSE_LIBZSTD       0
+
 // If enabled, the code written by Apple will be used to write, in a portable
 // way, float on the disk. See extended.c for the license which is different
 // from wxWidgets one.
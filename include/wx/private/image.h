@@ -0,0 +1,28 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/image.h
+// Purpose:     Private helpers for processing wxImage data
+// Created:     2026-10-16
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_IMAGE_H_
+#define _WX_PRIVATE_IMAGE_H_
+
+#include <functional>
+
+// Function processing the rows in [start, end) range.
+typedef std::function<void (int start, int end)> wxImageRowBandFunc;
+
+// Call the given function for the bands of rows covering [0, numRows) range.
+//
+// If using multiple threads is enabled with wxImage::SetMaxThreads(), the
+// bands are processed in parallel, so the function must only modify the rows
+// in the range passed to it. In any case, the results must not depend on how
+// the rows are split into bands.
+//
+// The rowSize parameter is the number of pixels in each row and is used to
+// avoid the overhead of creating threads for processing small images.
+void wxForEachImageRowBand(int numRows, int rowSize, const wxImageRowBandFunc& func);
+
+#endif // _WX_PRIVATE_IMAGE_H_
@@ -13,4 +13,14 @@
 // this table gives the length of the UTF-8 encoding from its first character:
 extern const unsigned char tableUtf8Lengths[256];
 
+// These functions handle the longest prefix of ASCII characters of the given
+// string, of at most len characters, in blocks and return the number of
+// characters processed, which can be less than the length of the prefix.
+//
+// The first one just skips them, the others also copy them to dst, which may
+// be null, converting to wchar_t or to char respectively.
+size_t wxSkipASCIIPrefix(const char *src, size_t len);
+size_t wxWidenASCIIPrefix(wchar_t *dst, const char *src, size_t len);
+size_t wxNarrowASCIIPrefix(char *dst, const wchar_t *src, size_t len);
+
 #endif // _WX_PRIVATE_UNICODEH__
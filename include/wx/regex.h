@@ -45,6 +45,9 @@ enum
     // after/before it regardless of the setting of wxRE_NOT[BE]OL
     wxRE_NEWLINE  = 16,
 
+    // don't use JIT compilation even if it's available
+    wxRE_NOJIT    = 256,
+
     // default flags
     wxRE_DEFAULT  = wxRE_EXTENDED
 };
@@ -99,8 +102,11 @@ public:
     //
     // may only be called after successful call to Compile()
     bool Matches(const wxString& text, int flags = 0) const;
-    bool Matches(const wxChar *text, int flags, size_t len) const
-        { return Matches(wxString(text, len), flags); }
+    bool Matches(const wxChar *text, int flags, size_t len) const;
+
+    // same as Matches() but for UTF-8 text, the offsets returned by
+    // GetMatch() are in bytes in this case
+    bool MatchesUTF8(const char *text, size_t len, int flags = 0) const;
 
     // get the start index and the length of the match of the expression
     // (index 0) or a bracketed subexpression (index != 0)
@@ -152,6 +158,10 @@ public:
     // return version information for the underlying regex library
     static wxVersionInfo GetLibraryVersionInfo();
 
+    // set the maximal number of compiled regexes kept in the cache shared by
+    // all wxRegEx objects, 0 disables the cache
+    static void SetCacheSize(size_t size);
+
     // dtor not virtual, don't derive from this class
     ~wxRegEx();
 
@@ -21,6 +21,8 @@ public:
     wxSocketOutputStream(wxSocketBase& s);
     virtual ~wxSocketOutputStream();
 
+    wxOutputStream& WriteV(const wxIOVec *vec, size_t count) override;
+
 protected:
     wxSocketBase *m_o_socket;
 
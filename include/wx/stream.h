@@ -241,6 +241,12 @@ public:
     // less data than requested but still return without error.
     bool WriteAll(const void *buffer, size_t size);
 
+    // Write all the given buffers, in order, as if Write() were called for
+    // each of them but possibly more efficiently, e.g. using a single system
+    // call. Stops at the first buffer which couldn't be completely written,
+    // LastWrite() returns the total number of bytes written.
+    virtual wxOutputStream& WriteV(const wxIOVec *vec, size_t count);
+
     wxOutputStream& Write(wxInputStream& stream_in);
 
     virtual wxFileOffset SeekO(wxFileOffset pos, wxSeekMode mode = wxFromStart);
@@ -455,6 +461,7 @@ public:
     size_t Read(wxStreamBuffer *buf);
     virtual size_t Write(const void *buffer, size_t size);
     size_t Write(wxStreamBuffer *buf);
+    size_t Write(const wxIOVec *vec, size_t count);
 
     virtual char Peek();
     virtual char GetChar();
@@ -474,7 +481,7 @@ public:
     void *GetBufferStart() const { return m_buffer_start; }
     void *GetBufferEnd() const { return m_buffer_end; }
     void *GetBufferPos() const { return m_buffer_pos; }
-    size_t GetBufferSize() const { return m_buffer_end - m_buffer_start; }
+    size_t GetBufferSize() const { return m_buffer_size; }
     size_t GetIntPosition() const { return m_buffer_pos - m_buffer_start; }
     void SetIntPosition(size_t pos) { m_buffer_pos = m_buffer_start + pos; }
     size_t GetLastAccess() const { return m_buffer_end - m_buffer_start; }
@@ -483,13 +490,25 @@ public:
     void Fixed(bool fixed) { m_fixed = fixed; }
     void Flushable(bool f) { m_flushable = f; }
 
+    // let a read buffer grow up to the given size when reading sequentially
+    // and shrink back to its initial size after seeking, 0 disables this
+    void SetMaxBufferSize(size_t size);
+    size_t GetMaxBufferSize() const { return m_size_max; }
+
+    // counters for profiling: the number of calls to OnSysRead() and
+    // OnSysWrite() made by this buffer and the number of bytes copied to or
+    // from it
+    wxUint64 GetSysCallCount() const { return m_sysCalls; }
+    wxUint64 GetBytesCopied() const { return m_bytesCopied; }
+    void ResetCounters() { m_sysCalls = m_bytesCopied = 0; }
+
     bool FlushBuffer();
     bool FillBuffer();
     size_t GetDataLeft();
 
     // misc accessors
     wxStreamBase *GetStream() const { return m_stream; }
-    bool HasBuffer() const { return m_buffer_start != m_buffer_end; }
+    bool HasBuffer() const { return m_buffer_size != 0; }
 
     bool IsFixed() const { return m_fixed; }
     bool IsFlushable() const { return m_flushable; }
@@ -506,6 +525,10 @@ protected:
     void GetFromBuffer(void *buffer, size_t size);
     void PutToBuffer(const void *buffer, size_t size);
 
+    // grow the buffer, if it's not fixed, to have at least the given number
+    // of bytes left in it, return false if this couldn't be done
+    bool ReserveBytesLeft(size_t size);
+
     // set the last error to the specified value if we didn't have it before
     void SetError(wxStreamError err);
 
@@ -521,12 +544,29 @@ protected:
     // free the buffer (always safe to call)
     void FreeBuffer();
 
+    // reallocate the (empty) adaptive read buffer to the given size
+    bool ResizeReadBuffer(size_t size);
+
     // the buffer itself: the pointers to its start and end and the current
     // position in the buffer
     char *m_buffer_start,
          *m_buffer_end,
          *m_buffer_pos;
 
+    // the allocated size of the buffer, which can be bigger than the data in
+    // it after a short read
+    size_t m_buffer_size;
+
+    // the initial and the maximal size of an adaptive read buffer and the
+    // number of times it was filled completely since the last seek
+    size_t m_size_initial,
+           m_size_max,
+           m_full_reads;
+
+    // profiling counters
+    wxUint64 m_sysCalls,
+             m_bytesCopied;
+
     // the stream we're associated with
     wxStreamBase *m_stream;
 
@@ -608,6 +648,7 @@ public:
     virtual ~wxBufferedOutputStream();
 
     virtual wxOutputStream& Write(const void *buffer, size_t size) override;
+    virtual wxOutputStream& WriteV(const wxIOVec *vec, size_t count) override;
 
     // Position functions
     virtual wxFileOffset SeekO(wxFileOffset pos, wxSeekMode mode = wxFromStart) override;
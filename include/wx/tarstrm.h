@@ -15,7 +15,9 @@
 
 #include "wx/archive.h"
 
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 /////////////////////////////////////////////////////////////////////////////
 // Constants
@@ -41,6 +43,19 @@ enum wxTarFormat
 };
 
 
+// A region of a sparse file containing data, the rest of the file is a hole
+struct wxTarSparseRegion
+{
+    wxTarSparseRegion(wxFileOffset offset_ = 0, wxFileOffset size_ = 0)
+        : offset(offset_), size(size_) { }
+
+    wxFileOffset offset;
+    wxFileOffset size;
+};
+
+typedef std::vector<wxTarSparseRegion> wxTarSparseMap;
+
+
 /////////////////////////////////////////////////////////////////////////////
 // wxTarNotifier
 
@@ -86,6 +101,10 @@ public:
     int          GetDevMajor() const            { return m_DevMajor; }
     int          GetDevMinor() const            { return m_DevMinor; }
 
+    // sparse files
+    bool         IsSparse() const               { return m_IsSparse; }
+    const wxTarSparseMap& GetSparseMap() const  { return m_SparseMap; }
+
     // is accessors
     bool IsDir() const override;
     bool IsReadOnly() const override                     { return !(m_Mode & 0222); }
@@ -139,6 +158,8 @@ private:
     wxString     m_GroupName;
     int          m_DevMajor;
     int          m_DevMinor;
+    bool         m_IsSparse;
+    wxTarSparseMap m_SparseMap;
 
     friend class wxTarInputStream;
 
@@ -182,6 +203,13 @@ private:
 
     wxStreamError ReadHeaders();
     bool ReadExtendedHeader(wxTarHeaderRecords*& recs);
+    bool ReadSparseMap(wxTarEntry& entry);
+    bool ReadGnuSparseMap(wxTarEntry& entry);
+    bool ReadPaxSparseMap(wxTarEntry& entry, const wxString& map);
+    bool ReadPaxSparseData(wxTarEntry& entry);
+    void SetupEntry(const wxTarEntry& entry);
+    size_t ReadSparse(char *buffer, size_t size);
+    wxFileOffset GetSparseDataPos(wxFileOffset pos, size_t *region) const;
 
     wxString GetExtendedHeader(const wxString& key) const;
     wxString GetHeaderPath() const;
@@ -193,6 +221,14 @@ private:
     wxFileOffset m_offset;  // offset to the start of the entry's data
     wxFileOffset m_size;    // size of the current entry's data
 
+    // for sparse entries the stored data is smaller than the entry itself
+    wxFileOffset m_dataPos; // position within the stored data
+    wxFileOffset m_dataSize;// size of the stored data
+    bool m_isSparse;        // true if the current entry is sparse
+    wxTarSparseMap m_sparse;// data regions of a sparse entry
+    std::vector<wxFileOffset> m_sparseStart; // data position of each region
+    size_t m_region;        // index of the current region in m_sparse
+
     int m_sumType;
     int m_tarType;
     class wxTarHeaderBlock *m_hdr;
@@ -294,6 +330,49 @@ typedef wxArchiveIterator<wxTarInputStream,
          std::pair<wxString, wxTarEntry*> > wxTarPairIter;
 
 
+/////////////////////////////////////////////////////////////////////////////
+// wxTarIndex
+//
+// Holds the headers of all entries of a tar, read once, so that any entry
+// can be looked up by name and opened directly without scanning the tar
+// again, including from several threads at once as long as each of them
+// uses its own parent stream.
+
+class WXDLLIMPEXP_BASE wxTarIndex
+{
+public:
+    wxTarIndex() : m_conv(&wxConvLocal), m_ok(false) { }
+    explicit wxTarIndex(wxInputStream& stream, wxMBConv& conv = wxConvLocal)
+        : m_conv(&conv), m_ok(false) { Load(stream, conv); }
+
+    bool Load(wxInputStream& stream, wxMBConv& conv = wxConvLocal);
+    void Clear();
+
+    bool IsOk() const { return m_ok; }
+
+    size_t GetCount() const { return m_entries.GetCount(); }
+    const wxTarEntry& GetEntry(size_t n) const { return m_entries.GetEntry(n); }
+    const wxTarEntry *Find(const wxString& name,
+                           wxPathFormat format = wxPATH_NATIVE) const
+        { return m_entries.Find(name, format); }
+
+    wxTarInputStream *OpenEntry(wxInputStream& stream,
+                                const wxTarEntry& entry) const;
+    wxTarInputStream *OpenEntry(wxInputStream *stream,
+                                const wxTarEntry& entry) const;
+
+private:
+    wxTarInputStream *DoOpenEntry(wxTarInputStream *tar,
+                                  const wxTarEntry& entry) const;
+
+    wxArchiveEntryIndex<wxTarEntry> m_entries;
+    wxMBConv *m_conv;
+    bool m_ok;
+
+    wxDECLARE_NO_COPY_CLASS(wxTarIndex);
+};
+
+
 /////////////////////////////////////////////////////////////////////////////
 // wxTarClassFactory
 
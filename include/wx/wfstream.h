@@ -17,6 +17,7 @@
 #include "wx/object.h"
 #include "wx/string.h"
 #include "wx/stream.h"
+#include "wx/mstream.h"
 #include "wx/file.h"
 #include "wx/ffile.h"
 
@@ -53,6 +54,17 @@ protected:
     wxFile *m_file;
     bool m_file_destroy;
 
+private:
+    // tell the OS about the detected access pattern, to adjust read-ahead
+    void SetSequentialAccess(bool sequential);
+
+    // common part of all ctors
+    void Init();
+
+    wxFileOffset m_readPos;     // position after the last read or seek
+    unsigned m_seqReads;        // number of reads since the last seek back
+    int m_accessHint;           // last hint given to the OS
+
     wxDECLARE_NO_COPY_CLASS(wxFileInputStream);
 };
 
@@ -64,6 +76,8 @@ public:
     wxFileOutputStream(int fd);
     virtual ~wxFileOutputStream();
 
+    virtual wxOutputStream& WriteV(const wxIOVec *vec, size_t count) override;
+
     void Sync() override;
     bool Close() override { return m_file_destroy ? m_file->Close() : true; }
     virtual wxFileOffset GetLength() const override;
@@ -174,6 +188,34 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxFileStream);
 };
 
+// ----------------------------------------------------------------------------
+// wxMappedFileInputStream: read a file mapped into memory
+// ----------------------------------------------------------------------------
+
+class wxMappedFileData;
+
+class WXDLLIMPEXP_BASE wxMappedFileInputStream : public wxMemoryInputStream
+{
+public:
+    explicit wxMappedFileInputStream(const wxString& fileName);
+    virtual ~wxMappedFileInputStream();
+
+    // Pointer to the file contents, valid as long as this object exists: it
+    // may be used to create other streams reading the same data, e.g. in
+    // other threads.
+    const void* GetData() const;
+
+    // Return true if the file is really mapped and not just read in memory.
+    bool IsMapped() const;
+
+private:
+    explicit wxMappedFileInputStream(wxMappedFileData* data);
+
+    wxMappedFileData* const m_data;
+
+    wxDECLARE_NO_COPY_CLASS(wxMappedFileInputStream);
+};
+
 #endif //wxUSE_FILE
 
 #if wxUSE_FFILE
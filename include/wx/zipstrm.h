@@ -50,6 +50,7 @@ enum wxZipMethod
     wxZIP_METHOD_DEFLATE,
     wxZIP_METHOD_DEFLATE64,
     wxZIP_METHOD_BZIP2 = 12,
+    wxZIP_METHOD_ZSTD = 93,
     wxZIP_METHOD_DEFAULT = 0xffff
 };
 
@@ -322,6 +323,9 @@ public:
     int  GetLevel() const                       { return m_level; }
     void WXZIPFIX SetLevel(int level);
 
+    unsigned GetMaxThreads() const              { return m_maxThreads; }
+    void SetMaxThreads(unsigned maxThreads)     { m_maxThreads = maxThreads; }
+
     void SetFormat(wxZipArchiveFormat format)   { m_format = format; }
     wxZipArchiveFormat GetFormat() const        { return m_format; }
 
@@ -366,6 +370,7 @@ private:
     wxUint32 m_crcAccumulator;
     wxOutputStream *m_comp;
     int m_level;
+    unsigned m_maxThreads;
     wxFileOffset m_offsetAdjustment;
     wxString m_Comment;
     bool m_endrecWritten;
@@ -451,11 +456,57 @@ private:
                     wxZipEntry *entry, wxZipInputStream& inputStream);
     friend bool wxZipOutputStream::CopyArchiveMetaData(
                     wxZipInputStream& inputStream);
+    friend class wxZipIndex;
 
     wxDECLARE_NO_COPY_CLASS(wxZipInputStream);
 };
 
 
+/////////////////////////////////////////////////////////////////////////////
+// wxZipIndex
+//
+// Holds the parsed central directory of a zip, so that any entry can be
+// looked up by name and opened directly, including from several threads at
+// once as long as each of them uses its own parent stream.
+
+class WXDLLIMPEXP_BASE wxZipIndex
+{
+public:
+    wxZipIndex() : m_conv(&wxConvLocal), m_ok(false) { }
+    explicit wxZipIndex(wxInputStream& stream, wxMBConv& conv = wxConvLocal)
+        : m_conv(&conv), m_ok(false) { Load(stream, conv); }
+
+    bool Load(wxInputStream& stream, wxMBConv& conv = wxConvLocal);
+    void Clear();
+
+    bool IsOk() const { return m_ok; }
+
+    size_t GetCount() const { return m_entries.GetCount(); }
+    const wxZipEntry& GetEntry(size_t n) const { return m_entries.GetEntry(n); }
+    const wxZipEntry *Find(const wxString& name,
+                           wxPathFormat format = wxPATH_NATIVE) const
+        { return m_entries.Find(name, format); }
+
+    const wxString& GetComment() const { return m_comment; }
+
+    wxZipInputStream *OpenEntry(wxInputStream& stream,
+                                const wxZipEntry& entry) const;
+    wxZipInputStream *OpenEntry(wxInputStream *stream,
+                                const wxZipEntry& entry) const;
+
+private:
+    wxZipInputStream *DoOpenEntry(wxZipInputStream *zip,
+                                  const wxZipEntry& entry) const;
+
+    wxArchiveEntryIndex<wxZipEntry> m_entries;
+    wxString m_comment;
+    wxMBConv *m_conv;
+    bool m_ok;
+
+    wxDECLARE_NO_COPY_CLASS(wxZipIndex);
+};
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Iterators
 
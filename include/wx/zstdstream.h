@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/zstdstream.h
+// Purpose:     Filters streams using Zstandard compression
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_ZSTDSTREAM_H_
+#define _WX_ZSTDSTREAM_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_LIBZSTD && wxUSE_STREAMS
+
+#include "wx/stream.h"
+#include "wx/versioninfo.h"
+
+namespace wxPrivate
+{
+
+// Common part of input and output Zstandard streams: this is just an
+// implementation detail and is not part of the public API.
+class WXDLLIMPEXP_BASE wxZstdData
+{
+protected:
+    wxZstdData(size_t bufSize);
+    ~wxZstdData();
+
+    wxUint8* m_streamBuf;
+    size_t m_bufSize;
+    wxFileOffset m_pos;
+
+    wxDECLARE_NO_COPY_CLASS(wxZstdData);
+};
+
+} // namespace wxPrivate
+
+// Flags for wxZstdInputStream
+enum
+{
+    // Stop at the end of the first frame instead of decompressing all the
+    // concatenated frames, leaving the data following it in the underlying
+    // stream. This is used for the zip entries.
+    wxZSTD_SINGLE_FRAME = 1
+};
+
+// ----------------------------------------------------------------------------
+// Filter for decompressing data compressed using Zstandard
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxZstdInputStream : public wxFilterInputStream,
+                                           private wxPrivate::wxZstdData
+{
+public:
+    explicit wxZstdInputStream(wxInputStream& stream, int flags = 0);
+    explicit wxZstdInputStream(wxInputStream* stream, int flags = 0);
+    virtual ~wxZstdInputStream();
+
+    char Peek() override { return wxInputStream::Peek(); }
+    wxFileOffset GetLength() const override { return wxInputStream::GetLength(); }
+
+protected:
+    size_t OnSysRead(void *buffer, size_t size) override;
+    wxFileOffset OnSysTell() const override { return m_pos; }
+
+private:
+    void Init(int flags);
+
+    struct ZSTD_DCtx_s* m_dctx;
+
+    int m_flags;
+
+    // Position and amount of the compressed data in m_streamBuf.
+    size_t m_inPos;
+    size_t m_inSize;
+
+    // Set when the end of a Zstandard frame has been reached and the next one
+    // hasn't been started yet.
+    bool m_atFrameEnd;
+
+    // Set when there is no more data to decompress.
+    bool m_eof;
+};
+
+// ----------------------------------------------------------------------------
+// Filter for compressing data using Zstandard algorithm
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxZstdOutputStream : public wxFilterOutputStream,
+                                            private wxPrivate::wxZstdData
+{
+public:
+    explicit wxZstdOutputStream(wxOutputStream& stream, int level = -1);
+    explicit wxZstdOutputStream(wxOutputStream* stream, int level = -1);
+    virtual ~wxZstdOutputStream();
+
+    void Sync() override { DoFlush(false); }
+    bool Close() override;
+    wxFileOffset GetLength() const override { return m_pos; }
+
+protected:
+    size_t OnSysWrite(const void *buffer, size_t size) override;
+    wxFileOffset OnSysTell() const override { return m_pos; }
+
+private:
+    void Init(int level);
+
+    // Compress the given data using the given ZSTD_EndDirective and write
+    // the output, return false on error.
+    bool DoCompress(const void *buffer, size_t size, int mode);
+
+    // Flush (if argument is false) or finish the frame (if it is true),
+    // return true on success or false on error.
+    bool DoFlush(bool finish);
+
+    struct ZSTD_CCtx_s* m_cctx;
+};
+
+// ----------------------------------------------------------------------------
+// Support for creating Zstandard streams from extension/MIME type
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxZstdClassFactory: public wxFilterClassFactory
+{
+public:
+    wxZstdClassFactory();
+
+    wxFilterInputStream *NewStream(wxInputStream& stream) const override
+        { return new wxZstdInputStream(stream); }
+    wxFilterOutputStream *NewStream(wxOutputStream& stream) const override
+        { return new wxZstdOutputStream(stream, -1); }
+    wxFilterInputStream *NewStream(wxInputStream *stream) const override
+        { return new wxZstdInputStream(stream); }
+    wxFilterOutputStream *NewStream(wxOutputStream *stream) const override
+        { return new wxZstdOutputStream(stream, -1); }
+
+    const wxChar * const *GetProtocols(wxStreamProtocolType type
+                                       = wxSTREAM_PROTOCOL) const override;
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxZstdClassFactory);
+};
+
+WXDLLIMPEXP_BASE wxVersionInfo wxGetLibZstdVersionInfo();
+
+#endif // wxUSE_LIBZSTD && wxUSE_STREAMS
+
+#endif // _WX_ZSTDSTREAM_H_
@@ -78,6 +78,9 @@ class WXDLLIMPEXP_BASE wxZlibOutputStream: public wxFilterOutputStream {
   bool SetDictionary(const char *data, size_t datalen);
   bool SetDictionary(const wxMemoryBuffer &buf);
 
+  bool SetMaxThreads(unsigned maxThreads, size_t blockSize = 0);
+  unsigned GetMaxThreads() const;
+
  protected:
   size_t OnSysWrite(const void *buffer, size_t size) override;
   wxFileOffset OnSysTell() const override { return m_pos; }
@@ -87,6 +90,10 @@ class WXDLLIMPEXP_BASE wxZlibOutputStream: public wxFilterOutputStream {
  private:
   void Init(int level, int flags);
 
+  class wxZlibParallelDeflate *m_parallel;
+  int m_level;
+  int m_flags;
+
  protected:
   size_t m_z_size;
   unsigned char *m_z_buffer;
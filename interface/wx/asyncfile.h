@@ -0,0 +1,322 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/asyncfile.h
+// Purpose:     wxAsyncFile and wxAsyncFileEvent documentation
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+    The kind of operation wxAsyncFileEvent corresponds to.
+
+    @since 3.3.2
+*/
+enum wxAsyncFileOperation
+{
+    /// The event was generated by wxAsyncFile::Read().
+    wxASYNC_FILE_READ,
+
+    /// The event was generated by wxAsyncFile::Write().
+    wxASYNC_FILE_WRITE
+};
+
+/**
+    @class wxAsyncFileEvent
+
+    Event sent by wxAsyncFile when an operation completes.
+
+    Exactly one such event is generated for each request successfully started
+    by wxAsyncFile::Read() or wxAsyncFile::Write(), even if the operation
+    fails or is cancelled. The event identifier is the one specified when
+    creating wxAsyncFile or in wxAsyncFile::SetOwner().
+
+    @beginEventTable{wxAsyncFileEvent}
+    @event{EVT_ASYNC_FILE(id, func)}
+        Process a @c wxEVT_ASYNC_FILE event.
+    @endEventTable
+
+    @library{wxbase}
+    @category{events,file}
+
+    @see wxAsyncFile
+
+    @since 3.3.2
+*/
+class wxAsyncFileEvent : public wxEvent
+{
+public:
+    /**
+        Constructor is only used by wxWidgets itself.
+    */
+    wxAsyncFileEvent(int id = wxID_ANY,
+                     long request = 0,
+                     wxAsyncFileOperation operation = wxASYNC_FILE_READ,
+                     wxFileOffset offset = 0,
+                     size_t size = 0);
+
+    /**
+        Returns the identifier of the request, as returned by
+        wxAsyncFile::Read() or wxAsyncFile::Write().
+    */
+    long GetRequest() const;
+
+    /**
+        Returns the kind of the operation that completed.
+    */
+    wxAsyncFileOperation GetOperation() const;
+
+    /**
+        Returns the offset in the file at which the operation was performed.
+    */
+    wxFileOffset GetOffset() const;
+
+    /**
+        Returns the number of bytes that were requested to be read or written.
+    */
+    size_t GetSize() const;
+
+    /**
+        Returns the number of bytes actually read or written.
+
+        This can be less than GetSize() if the operation failed or, for the
+        read operations, if the end of file was reached.
+    */
+    size_t GetCount() const;
+
+    /**
+        Returns the data read by a read operation.
+
+        The length of the buffer is the same as GetCount(). For the write
+        operations, the returned buffer is always empty.
+    */
+    const wxMemoryBuffer& GetData() const;
+
+    /**
+        Returns @true if the operation completed without errors.
+
+        Note that reading at or past the end of file is not considered to be
+        an error, check GetCount() to detect it.
+    */
+    bool IsOk() const;
+
+    /**
+        Returns the system error code if the operation failed or 0 otherwise.
+
+        wxSysErrorMsgStr() can be used to get the error description.
+    */
+    unsigned long GetErrorCode() const;
+
+    /**
+        Returns @true if the request was cancelled before being performed.
+    */
+    bool WasCancelled() const;
+};
+
+wxEventType wxEVT_ASYNC_FILE;
+
+/**
+    @class wxAsyncFile
+
+    wxAsyncFile allows reading from and writing to a file without blocking the
+    calling thread.
+
+    Each call to Read() or Write() starts a request performed by one of the
+    background threads shared by all wxAsyncFile objects and returns
+    immediately. When the operation completes, a wxAsyncFileEvent is queued
+    for the owner event handler using wxQueueEvent(). This wakes up the main
+    event loop, so the event is processed as soon as possible in the main
+    thread, without polling and without having to manage any threads in the
+    application code. The data read from the file is passed to the event
+    handler in the event object itself.
+
+    All operations specify the offset in the file explicitly and do not use
+    nor change the current file position, so several of them can be
+    performed simultaneously and may complete in any order.
+
+    Example of use:
+    @code
+    class MyFrame : public wxFrame
+    {
+    public:
+        MyFrame()
+            : m_file("data.bin", wxFile::read, this)
+        {
+            Bind(wxEVT_ASYNC_FILE, &MyFrame::OnRead, this);
+
+            m_file.Read(0, 16*1024*1024);
+        }
+
+    private:
+        void OnRead(wxAsyncFileEvent& event)
+        {
+            if ( !event.IsOk() )
+            {
+                wxLogError("Reading failed: %s",
+                           wxSysErrorMsgStr(event.GetErrorCode()));
+                return;
+            }
+
+            ProcessData(event.GetData());
+        }
+
+        wxAsyncFile m_file;
+    };
+    @endcode
+
+    The owner must remain alive until all the operations complete, which is
+    ensured if the wxAsyncFile object is destroyed before it, as in the
+    example above, because the destructor waits for the operations in
+    progress to complete and cancels the ones that haven't started yet.
+
+    This class is only available if @c wxUSE_THREADS is 1.
+
+    @library{wxbase}
+    @category{file}
+
+    @see wxFile, wxAsyncFileEvent
+
+    @since 3.3.2
+*/
+class wxAsyncFile
+{
+public:
+    /**
+        Default constructor doesn't open any file.
+
+        Use Open() to open the file later.
+
+        @param owner
+            The handler receiving wxEVT_ASYNC_FILE events, can be @NULL if
+            the completion notifications are not needed.
+        @param id
+            Identifier of the events generated by this object.
+    */
+    explicit wxAsyncFile(wxEvtHandler* owner = nullptr, int id = wxID_ANY);
+
+    /**
+        Constructor opening the given file.
+
+        Check if the file was opened successfully with IsOpened().
+    */
+    wxAsyncFile(const wxString& filename,
+                wxFile::OpenMode mode,
+                wxEvtHandler* owner,
+                int id = wxID_ANY);
+
+    /**
+        Destructor closes the file.
+
+        See Close() for more details.
+    */
+    ~wxAsyncFile();
+
+    /**
+        Sets the handler receiving the events and their identifier.
+
+        This only affects the operations started after calling this function.
+    */
+    void SetOwner(wxEvtHandler* owner, int id = wxID_ANY);
+
+    /**
+        Returns the handler receiving the events.
+    */
+    wxEvtHandler* GetOwner() const;
+
+    /**
+        Returns the identifier used for the events.
+    */
+    int GetId() const;
+
+    /**
+        Opens the file, closing the previously opened one, if any.
+
+        The parameters have the same meaning as for wxFile::Open().
+    */
+    bool Open(const wxString& filename,
+              wxFile::OpenMode mode = wxFile::read,
+              int access = wxS_DEFAULT);
+
+    /**
+        Returns @true if the file is opened.
+    */
+    bool IsOpened() const;
+
+    /**
+        Closes the file.
+
+        All the operations that haven't started yet are cancelled and this
+        function waits until the ones already in progress complete, so it
+        may block.
+    */
+    bool Close();
+
+    /**
+        Starts reading @a size bytes at the given offset.
+
+        @return The positive identifier of the request or 0 if it couldn't
+            be started, e.g. because the file is not opened or because the
+            library has been already shut down.
+    */
+    long Read(wxFileOffset offset, size_t size);
+
+    /**
+        Starts writing @a size bytes of data at the given offset.
+
+        The data is copied and so doesn't need to remain valid after this
+        function returns.
+
+        @return The positive identifier of the request or 0 if it couldn't
+            be started, e.g. because the file is not opened or because the
+            library has been already shut down.
+    */
+    long Write(wxFileOffset offset, const void* data, size_t size);
+
+    /**
+        Cancels the given request if it hasn't started yet.
+
+        The event for the request is still generated, but with
+        wxAsyncFileEvent::WasCancelled() returning @true.
+
+        @return @true if the request was cancelled or @false if it is already
+            in progress or had already completed.
+    */
+    bool Cancel(long request);
+
+    /**
+        Cancels all requests that haven't started yet.
+    */
+    void CancelAll();
+
+    /**
+        Blocks until all the operations started so far complete.
+
+        When this function returns, the events for all the operations are
+        already queued for the owner, but not processed yet.
+    */
+    void Wait();
+
+    /**
+        Returns the number of requests that haven't completed yet.
+    */
+    size_t GetPendingCount() const;
+
+    /**
+        Sets the maximal number of background threads used for performing the
+        operations of all wxAsyncFile objects.
+
+        The threads are created on demand, and only when there are no idle
+        threads available, so a single thread is used if the operations are
+        started one after another. Calling this function doesn't affect the
+        threads that already exist.
+
+        @param maxThreads
+            The maximal number of threads or 0 to use the default, which is
+            currently 4.
+    */
+    static void SetMaxThreads(unsigned maxThreads);
+
+    /**
+        Returns the maximal number of threads used for the operations.
+    */
+    static unsigned GetMaxThreads();
+};
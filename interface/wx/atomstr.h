@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/atomstr.h
+// Purpose:     wxAtomString and wxAtomStringStats documentation
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+    Statistics about the global table of strings interned by wxAtomString.
+
+    @see wxAtomString::GetStats()
+
+    @since 3.3.2
+*/
+struct wxAtomStringStats
+{
+    /// Number of distinct strings in the table.
+    size_t count;
+
+    /// Total length of all the strings in the table, in characters.
+    size_t length;
+
+    /**
+        Approximate amount of memory used by the table, in bytes.
+
+        This includes the memory used by the strings themselves and the
+        overhead of the table, but the exact value depends on the standard
+        library implementation and so is only an estimate.
+    */
+    size_t memory;
+
+    /// Number of times a non-empty string was interned.
+    size_t lookups;
+
+    /// Number of lookups that found the string already in the table.
+    size_t hits;
+};
+
+/**
+    @class wxAtomString
+
+    wxAtomString is an immutable string stored only once in a global table.
+
+    Creating a wxAtomString from a wxString, which is called interning the
+    string, looks it up in the global table and adds it there if it's not
+    present yet. This requires computing the hash of the string and locking
+    the table, so it is not cheap, but all the other operations are: copying
+    wxAtomString objects just copies a pointer, comparing them only compares
+    pointers and their hash is computed in constant time too. Moreover,
+    GetString() returns a reference to the string in the table and so
+    doesn't copy it.
+
+    This makes wxAtomString useful for storing large numbers of short
+    strings with many repetitions, such as labels or identifiers, as each
+    of the distinct strings is only stored once, and for using such strings
+    as keys in hash maps, e.g. @c std::unordered_map<wxAtomString,T>.
+
+    Note that the strings added to the table are never removed from it and
+    remain valid until the program termination, so wxAtomString should not
+    be used for arbitrary strings, e.g. the ones coming from user input, as
+    this could result in unbounded memory growth. GetStats() can be used to
+    check the memory used by the table.
+
+    The global table can be used from multiple threads. However, the strings
+    returned by GetString() are shared and the conversions of wxString which
+    cache their result, such as the implicit conversion to @c const @c char*,
+    are not thread-safe, so only conversions returning a new buffer, such as
+    wxString::utf8_str() or wxString::mb_str(), should be used with them if
+    the same atom can be used by several threads.
+
+    @library{wxbase}
+    @category{data}
+
+    @see wxString
+
+    @since 3.3.2
+*/
+class wxAtomString
+{
+public:
+    /**
+        Default constructor creates an empty atom.
+
+        This doesn't use the global table and so is very cheap.
+    */
+    wxAtomString() noexcept;
+
+    /**
+        Constructor interns the given string.
+
+        If the string is empty, the atom is the same as the one created by
+        the default constructor.
+    */
+    explicit wxAtomString(const wxString& str);
+
+    /**
+        Returns the interned string.
+
+        The returned reference remains valid until the program termination.
+    */
+    const wxString& GetString() const;
+
+    /**
+        Implicit conversion to the interned string.
+
+        This is the same as GetString().
+    */
+    operator const wxString&() const;
+
+    /**
+        Returns @true if the atom corresponds to the empty string.
+    */
+    bool IsEmpty() const;
+
+    /**
+        Returns @true if both atoms correspond to the same string.
+
+        This only compares pointers and not the strings contents. The same
+        function is also available as @c operator==() and @c operator!=().
+        Comparing an atom with wxString or C string using these operators
+        compares the strings contents.
+    */
+    bool IsSameAs(const wxAtomString& other) const;
+
+    /**
+        Returns the hash of the atom.
+
+        The hash is computed in constant time and is used by the
+        specialization of @c std::hash for wxAtomString. Note that it is not
+        the same as the hash of the string itself and may be different
+        during different program runs.
+    */
+    size_t GetHash() const;
+
+    /**
+        Returns the current statistics of the global table of strings.
+    */
+    static wxAtomStringStats GetStats();
+};
@@ -274,6 +274,26 @@ public:
     wxWCharBuffer(const wxCStrData& cstr);
 };
 
+/**
+    Describes a chunk of memory used for vectored I/O.
+
+    This is similar to POSIX @c struct @c iovec and is used by
+    wxOutputStream::WriteV() and wxFile::WriteV() to write data from several
+    non-contiguous buffers at once. The memory is not owned by this struct.
+
+    @library{wxbase}
+
+    @since 3.3.2
+*/
+struct wxIOVec
+{
+    /// Pointer to the data, may be @NULL only if @a size is 0.
+    const void *data;
+
+    /// Size of the data in bytes.
+    size_t size;
+};
+
 /**
     @class wxMemoryBuffer
 
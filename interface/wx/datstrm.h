@@ -26,6 +26,12 @@
     If you want to write data to text files (or streams) use wxTextOutputStream
     instead.
 
+    When writing many values of the same type, prefer the overloads taking a
+    buffer and its size, such as Write32(const wxUint32*, size_t), to calling
+    the functions writing a single value in a loop: they write all values at
+    once if their byte order doesn't need to be changed and in big chunks
+    otherwise and so are much more efficient.
+
     The "<<" operator is overloaded and you can use this class like a standard
     C++ iostream. See wxDataInputStream for its usage and caveats.
 
@@ -211,6 +217,10 @@ public:
     If you want to read data from text files (or streams) use wxTextInputStream
     instead.
 
+    Similarly to wxDataOutputStream, the overloads reading many values into a
+    buffer, such as Read32(wxUint32*, size_t), are much more efficient than
+    reading the values one by one in a loop.
+
     The ">>" operator is overloaded and you can use this class like a standard
     C++ iostream. Note, however, that the arguments are the fixed size types
     wxUint32, wxInt32 etc and on a typical 32-bit computer, none of these match
@@ -459,6 +459,25 @@ public:
     */
     bool Write(const wxString& s, const wxMBConv& conv = wxConvAuto());
 
+    /**
+       Write data from several buffers to the file (descriptor).
+
+       Under Unix this uses @c writev() to write all the buffers using a
+       single system call (or a few of them if there are many buffers), under
+       the other platforms it just calls Write() for each of the buffers.
+
+       @param vec
+          Array of @a count buffers to write, in order.
+       @param count
+          Number of elements in @a vec.
+
+       @return The total number of bytes written, which is less than the total
+          size of all buffers if an error occurred.
+
+       @since 3.3.2
+    */
+    size_t WriteV(const wxIOVec *vec, size_t count);
+
     /**
         Returns the file descriptor associated with the file.
     */
@@ -6,10 +6,60 @@
 // Licence:     wxWindows licence
 /////////////////////////////////////////////////////////////////////////////
 
+/**
+    Statistics of the cache used by wxArchiveFSHandler.
+
+    @see wxArchiveFSHandler::GetCacheStats()
+
+    @since 3.3.2
+*/
+struct wxArchiveFSCacheStats
+{
+    /// Number of archives whose catalogs are cached.
+    size_t archives;
+
+    /// Total number of entries in the cached catalogs.
+    size_t entries;
+
+    /// Number of lookups of entries by name.
+    size_t lookups;
+
+    /// Number of lookups which didn't find the entry.
+    size_t lookupFailures;
+
+    /// Number of files opened using their cached contents.
+    size_t hits;
+
+    /// Number of files which had to be read from the archive.
+    size_t misses;
+
+    /// Number of contents removed from the cache to respect its maximal size.
+    size_t evictions;
+
+    /// Number of files whose contents are currently cached.
+    size_t cachedFiles;
+
+    /// Total size of the currently cached contents.
+    size_t cachedBytes;
+};
+
 /**
     @class wxArchiveFSHandler
 
     A file system handler for accessing files inside of archives.
+
+    The catalog of each archive is read only once, when the archive is
+    accessed for the first time, and is kept in a cache shared by all the
+    handlers and all threads. Looking up a file in it takes constant time and
+    finding the files in a directory only examines the contents of this
+    directory, making this handler suitable for archives with many entries.
+
+    The decompressed contents of recently opened small files are kept in the
+    same cache, so that opening them again doesn't require decompressing them.
+    The total size of these contents is limited, see SetCacheMaxSize().
+
+    Note that the cache is not updated if the archive changes, ClearCache()
+    must be called to make the new contents of the archive accessible.
 */
 class wxArchiveFSHandler : public wxFileSystemHandler
 {
@@ -17,6 +67,49 @@ public:
     wxArchiveFSHandler();
     virtual ~wxArchiveFSHandler();
     void Cleanup();
+
+    /**
+        Sets the maximal total size of the files contents kept in the cache.
+
+        Only files using at most a quarter of this size are cached, bigger
+        files are decompressed each time they're opened. If the currently
+        cached contents exceed the new size, the least recently used ones are
+        removed from the cache. Using 0 disables caching of the contents, but
+        not of the archive catalogs.
+
+        The default size is 4MiB.
+
+        @since 3.3.2
+    */
+    static void SetCacheMaxSize(size_t size);
+
+    /**
+        Returns the maximal total size of the files contents in the cache.
+
+        @see SetCacheMaxSize()
+
+        @since 3.3.2
+    */
+    static size_t GetCacheMaxSize();
+
+    /**
+        Returns the statistics of the cache usage.
+
+        The statistics are accumulated since the cache creation or the last
+        call to ClearCache().
+
+        @since 3.3.2
+    */
+    static wxArchiveFSCacheStats GetCacheStats();
+
+    /**
+        Removes all archives and files contents from the cache.
+
+        This also resets the cache statistics, but not its maximal size.
+
+        @since 3.3.2
+    */
+    static void ClearCache();
 };
 
 
@@ -11,6 +11,10 @@
    @class wxGIFDecoder
 
    An animation decoder supporting animated GIF files.
+
+   The frames are decoded on demand when they are used, so the same decoder
+   object must not be used by several threads concurrently, even when only
+   calling its const functions.
 */
 class  wxGIFDecoder : public wxAnimationDecoder
 {
@@ -0,0 +1,243 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        imagbatch.h
+// Purpose:     interface of wxImageBatchLoader
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxImageBatchLoader
+
+    Loads several images in parallel using a pool of worker threads.
+
+    Loading many images, e.g. all the icons used by the application, one by
+    one using wxImage::LoadFile() may take noticeable time as both reading
+    and decoding each of them is done sequentially. This class allows to load
+    them concurrently, as decoding different images is independent, either
+    synchronously, using Load(), or in the background, using Start(), in
+    which case the events are sent to the specified event handler when each
+    image is loaded and when loading of all of them is finished.
+
+    Example of synchronous loading:
+    @code
+    wxImageBatchLoader loader;
+    for ( const wxString& file : files )
+        loader.Add(file);
+
+    if ( !loader.Load() )
+        wxLogWarning("Some images couldn't be loaded.");
+
+    for ( size_t n = 0; n < loader.GetCount(); n++ )
+    {
+        if ( loader.IsLoaded(n) )
+            UseImage(loader.GetImage(n));
+    }
+    @endcode
+
+    And the same example using asynchronous loading, assuming @c m_loader is
+    a wxImageBatchLoader member of @c MyFrame class:
+    @code
+    MyFrame::MyFrame()
+    {
+        for ( const wxString& file : files )
+            m_loader.Add(file);
+
+        Bind(wxEVT_IMAGE_BATCH_LOADED, [this](wxThreadEvent& event) {
+            const size_t n = event.GetInt();
+            if ( m_loader.IsLoaded(n) )
+                UseImage(m_loader.GetImage(n));
+        });
+
+        m_loader.Start(this);
+    }
+    @endcode
+
+    Note that all image handlers must be added using wxImage::AddHandler()
+    before starting loading the images and no handlers can be added or removed
+    while it is in progress. Also note that the error messages logged while
+    loading the images from the worker threads are only shown after they are
+    flushed by the main thread, as usual.
+
+    @beginEventEmissionTable{wxThreadEvent}
+    @event{EVT_IMAGE_BATCH_LOADED(func)}
+        Sent when loading of a single image is finished, whether successfully
+        or not. wxThreadEvent::GetInt() returns the index of this image,
+        which can be passed to IsLoaded() and GetImage(), and
+        wxThreadEvent::GetString() returns its file name, if any.
+        Event type is @c wxEVT_IMAGE_BATCH_LOADED.
+    @event{EVT_IMAGE_BATCH_COMPLETED(func)}
+        Sent after all images are loaded or loading them was cancelled.
+        wxThreadEvent::GetInt() returns the number of successfully loaded
+        images. Event type is @c wxEVT_IMAGE_BATCH_COMPLETED.
+    @endEventTable
+
+    @library{wxcore}
+    @category{gdi}
+
+    @see wxImage::LoadFile(), wxImage::SetMaxThreads()
+
+    @since 3.3.2
+*/
+class wxImageBatchLoader
+{
+public:
+    /**
+        Default constructor.
+
+        Use Add() to add images to load after creating the object.
+    */
+    wxImageBatchLoader();
+
+    /**
+        Destructor cancels loading if it is still in progress.
+
+        Notice that it waits until the images being currently loaded by the
+        worker threads are loaded, so it may block for some time.
+    */
+    ~wxImageBatchLoader();
+
+    /**
+        Add an image file to load.
+
+        The parameters have the same meaning as for wxImage::LoadFile().
+
+        This function can't be called while loading is in progress.
+
+        @return The index of the image which can be used with GetImage().
+    */
+    size_t Add(const wxString& filename,
+               wxBitmapType type = wxBITMAP_TYPE_ANY,
+               int index = -1);
+
+    /**
+        Add an image to load from the given stream.
+
+        The loader takes ownership of the stream, which must be non-@NULL and
+        is deleted after the image is loaded from it. Notice that the stream
+        is used from a worker thread, so it must not be used by any other
+        thread.
+
+        This function can't be called while loading is in progress.
+
+        @return The index of the image which can be used with GetImage().
+    */
+    size_t Add(wxInputStream* stream,
+               wxBitmapType type = wxBITMAP_TYPE_ANY,
+               int index = -1);
+
+    /**
+        Returns the number of images added to this loader.
+    */
+    size_t GetCount() const;
+
+    /**
+        Removes all the images from the loader.
+
+        This function can't be called while loading is in progress.
+    */
+    void Clear();
+
+    /**
+        Sets an option for all the images before loading them.
+
+        This can be used to set any of the options which can be specified
+        using wxImage::SetOption() before loading an image, e.g. setting
+        @c wxIMAGE_OPTION_MAX_WIDTH and @c wxIMAGE_OPTION_MAX_HEIGHT allows to
+        efficiently load thumbnails of the images.
+    */
+    void SetOption(const wxString& name, const wxString& value);
+
+    /// @overload
+    void SetOption(const wxString& name, int value);
+
+    /**
+        Sets the maximal number of threads to use for loading the images.
+
+        The default value of 0 means to use as many threads as there are CPUs
+        on the system. Notice that no more threads than the number of images
+        are created in any case.
+    */
+    void SetMaxThreads(int maxThreads);
+
+    /**
+        Returns the maximal number of threads used for loading the images.
+
+        @see SetMaxThreads()
+    */
+    int GetMaxThreads() const;
+
+    /**
+        Loads all the images and returns when they are loaded.
+
+        The calling thread is used as one of the worker threads.
+
+        Calling this function (or Start()) again after it returns only loads
+        the images which couldn't be loaded previously. Notice that images
+        added from streams are not loaded again if loading them failed, as
+        the stream has been already consumed and deleted.
+
+        @return @true if all images were loaded successfully, @false if
+            loading at least one of them failed.
+    */
+    bool Load();
+
+    /**
+        Starts loading the images in the background.
+
+        This function returns immediately and @c wxEVT_IMAGE_BATCH_LOADED and
+        @c wxEVT_IMAGE_BATCH_COMPLETED events are sent to the given handler,
+        which must be non-@NULL and remain alive until loading is finished,
+        to notify about the progress of loading.
+
+        @return @true if loading was started or @false if it is already in
+            progress.
+    */
+    bool Start(wxEvtHandler* handler);
+
+    /**
+        Returns @true if the loading started by Start() is still in progress.
+    */
+    bool IsRunning() const;
+
+    /**
+        Cancels the loading started by Start().
+
+        The images not yet being loaded won't be loaded at all and this
+        function waits until all worker threads terminate before returning.
+    */
+    void Cancel();
+
+    /**
+        Waits until loading started by Start() is finished.
+
+        @return @true if all images were loaded successfully, @false if
+            loading at least one of them failed or was cancelled.
+    */
+    bool Wait();
+
+    /**
+        Returns @true if the image with the given index was loaded
+        successfully.
+
+        This function can be called at any time, but returns @false for the
+        images which are not loaded yet.
+    */
+    bool IsLoaded(size_t n) const;
+
+    /**
+        Returns the image with the given index.
+
+        The returned image is invalid if it couldn't be loaded or wasn't
+        loaded yet.
+    */
+    wxImage GetImage(size_t n) const;
+
+    /**
+        Returns the file name of the image with the given index.
+
+        The returned string is empty for the images loaded from streams.
+    */
+    wxString GetFileName(size_t n) const;
+};
+
+wxEventType wxEVT_IMAGE_BATCH_LOADED;
+wxEventType wxEVT_IMAGE_BATCH_COMPLETED;
@@ -104,6 +104,38 @@ enum wxImageAlphaBlendMode
     wxIMAGE_ALPHA_BLEND_COMPOSE = 1
 };
 
+/**
+    Pixel formats of the external buffers that can be used with wxImageView.
+
+    @since 3.3.2
+*/
+enum wxImagePixelFormat
+{
+    /// 3 bytes per pixel: red, green and blue, as used by wxImage itself.
+    wxIMAGE_PIXEL_FORMAT_RGB,
+
+    /// 3 bytes per pixel: blue, green and red.
+    wxIMAGE_PIXEL_FORMAT_BGR,
+
+    /// 4 bytes per pixel: red, green, blue and alpha.
+    wxIMAGE_PIXEL_FORMAT_RGBA,
+
+    /// 4 bytes per pixel: blue, green, red and alpha.
+    wxIMAGE_PIXEL_FORMAT_BGRA,
+
+    /// 4 bytes per pixel: alpha, red, green and blue.
+    wxIMAGE_PIXEL_FORMAT_ARGB,
+
+    /// 4 bytes per pixel: red, green, blue and an unused byte.
+    wxIMAGE_PIXEL_FORMAT_RGBX,
+
+    /// 4 bytes per pixel: blue, green, red and an unused byte.
+    wxIMAGE_PIXEL_FORMAT_BGRX,
+
+    /// 1 byte per pixel used for all of red, green and blue components.
+    wxIMAGE_PIXEL_FORMAT_GREY
+};
+
 /**
     Possible values for PNG image type option.
 
@@ -117,6 +149,21 @@ enum wxImagePNGType
     wxPNG_TYPE_PALETTE = 4      ///< Palette encoding.
 };
 
+/**
+    Possible values for PNG compression profile option.
+
+    @see wxImage::GetOptionInt().
+
+    @since 3.3.2
+ */
+enum wxImagePNGCompression
+{
+    wxPNG_COMPRESSION_DEFAULT = 0,  ///< Use libpng defaults.
+    wxPNG_COMPRESSION_FAST = 1,     ///< Fastest compression, bigger files.
+    wxPNG_COMPRESSION_BALANCED = 2, ///< Faster than default, similar size.
+    wxPNG_COMPRESSION_SMALL = 3     ///< Smallest files, slowest compression.
+};
+
 
 /**
    Image option names.
@@ -149,6 +196,8 @@ enum wxImagePNGType
 #define wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY         wxString("PngZS")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_BUFFER_SIZE      wxString("PngZB")
 #define wxIMAGE_OPTION_PNG_DESCRIPTION                  wxString("PngDescription")
+#define wxIMAGE_OPTION_PNG_COMPRESSION_PROFILE          wxString("PngZP")
+#define wxIMAGE_OPTION_PNG_COMPRESSION_PARALLEL         wxString("PngZT")
 
 #define wxIMAGE_OPTION_TIFF_BITSPERSAMPLE               wxString("BitsPerSample")
 #define wxIMAGE_OPTION_TIFF_SAMPLESPERPIXEL             wxString("SamplesPerPixel")
@@ -175,6 +224,76 @@ enum
 };
 
 
+/**
+    @class wxImageRowConsumer
+
+    Base class for objects receiving the image rows from
+    wxImageHandler::LoadRows().
+
+    Derive from this class and override its pure virtual functions to process
+    the image rows as they are decoded.
+
+    @library{wxcore}
+    @category{gdi}
+
+    @since 3.3.2
+*/
+class wxImageRowConsumer
+{
+public:
+    /// Default constructor.
+    wxImageRowConsumer();
+
+    /// Virtual destructor for the base class.
+    virtual ~wxImageRowConsumer();
+
+    /**
+        Called once before any rows are passed to OnImageRow().
+
+        @param width The width of the image, i.e. the number of pixels in
+            each row.
+        @param height The height of the image, i.e. the number of rows.
+        @param hasAlpha Whether OnImageRow() will be passed alpha values.
+        @return @true to continue loading or @false to stop it.
+    */
+    virtual bool OnImageStart(int width, int height, bool hasAlpha) = 0;
+
+    /**
+        Called for each row of the image, in order from top to bottom.
+
+        @param y The index of the row.
+        @param rgb Pointer to 3*width bytes containing red, green and blue
+            components of the pixels, as in wxImage::GetData(). It is only
+            valid until this function returns.
+        @param alpha Pointer to width bytes containing the alpha values of
+            the pixels or @NULL if the image doesn't have alpha. It is only
+            valid until this function returns.
+        @return @true to continue loading or @false to stop it.
+    */
+    virtual bool OnImageRow(int y,
+                            const unsigned char* rgb,
+                            const unsigned char* alpha) = 0;
+
+    /**
+        Returns the maximal size of the image this consumer needs.
+
+        This function can be overridden to allow the handler to decode a
+        smaller version of the image if it can do it more efficiently than
+        decoding the full image, e.g. wxJPEGHandler can reduce the image size
+        by 2, 4 or 8 during decoding. Notice that the image passed to the
+        consumer may still be bigger than the returned size, as only cheap
+        reductions are done, so OnImageStart() must still check the actual
+        image size.
+
+        The meaning of the returned value is the same as for
+        @c wxIMAGE_OPTION_MAX_WIDTH and @c wxIMAGE_OPTION_MAX_HEIGHT options,
+        i.e. either of its components may be 0 to indicate that there is no
+        limit in this direction. The default implementation returns a size
+        with both components equal to 0, i.e. the full size image is loaded.
+    */
+    virtual wxSize GetMaxSize() const;
+};
+
 /**
     @class wxImageHandler
 
@@ -316,6 +435,73 @@ public:
     virtual bool LoadFile(wxImage* image, wxInputStream& stream,
                           bool verbose = true, int index = -1);
 
+    /**
+        Loads an image from a stream passing its rows to the given consumer.
+
+        Unlike LoadFile(), this function doesn't necessarily store the entire
+        image in memory: wxPNGHandler, wxJPEGHandler and wxTIFFHandler pass
+        each row to the consumer as soon as it is decoded, so that only a few
+        rows need to be kept in memory at any time, which is useful for
+        processing very big images, e.g. for creating their thumbnails or
+        computing their hashes. Note that interlaced PNG images and TIFF images
+        not stored from top to bottom still need to be decoded entirely before
+        returning any rows.
+
+        The default implementation of this function, used by all the other
+        handlers, just calls LoadFile() and then passes all the rows of the
+        loaded image to the consumer.
+
+        Example of computing the average brightness of an image:
+        @code
+        class AverageComputer : public wxImageRowConsumer
+        {
+        public:
+            bool OnImageStart(int width, int height, bool) override
+            {
+                m_count = static_cast<double>(width) * height * 3;
+                m_width = width;
+                return true;
+            }
+
+            bool OnImageRow(int, const unsigned char* rgb, const unsigned char*) override
+            {
+                for ( int n = 0; n < 3*m_width; n++ )
+                    m_sum += rgb[n];
+                return true;
+            }
+
+            double Get() const { return m_sum / m_count; }
+
+        private:
+            int m_width = 0;
+            double m_count = 0, m_sum = 0;
+        };
+
+        AverageComputer avg;
+        wxFileInputStream stream("huge.png");
+        if ( wxImage::FindHandler(wxBITMAP_TYPE_PNG)->LoadRows(avg, stream) )
+            wxLogMessage("Average brightness is %g", avg.Get());
+        @endcode
+
+        @param consumer
+            The object receiving the image rows.
+        @param stream
+            Opened input stream for reading image data.
+        @param verbose
+            If set to @true, errors reported by the image handler will produce
+            wxLogMessages.
+        @param index
+            The index of the image in the file (starting from zero).
+
+        @return @true if all rows were successfully loaded and passed to the
+            consumer, @false if an error occurred or if the consumer stopped
+            loading by returning @false.
+
+        @since 3.3.2
+    */
+    virtual bool LoadRows(wxImageRowConsumer& consumer, wxInputStream& stream,
+                          bool verbose = true, int index = -1);
+
     /**
         Saves an image in the output stream.
 
@@ -849,6 +1035,29 @@ public:
     */
     wxImage BlurVertical(int blurRadius) const;
 
+    /**
+        Blurs the image using an approximation of Gaussian blur with the given
+        standard deviation.
+
+        The blur is approximated by applying three successive box blur passes
+        in both horizontal and vertical directions, which is visually
+        indistinguishable from the true Gaussian blur in practice. The time
+        taken by this function doesn't depend on @a sigma, so it can be used
+        even with big values of it.
+
+        If the image has alpha channel, it is blurred independently of the
+        colour channels. As with Blur(), this function should not be used when
+        using a single mask colour for transparency.
+
+        @param sigma The standard deviation of the Gaussian, in pixels. If it
+            is not positive, the image is returned unchanged.
+
+        @see Blur()
+
+        @since 3.3.2
+    */
+    wxImage GaussianBlur(double sigma) const;
+
     /**
         Returns a mirrored copy of the image.
         The parameter @a horizontally indicates the orientation.
@@ -1361,7 +1570,10 @@ public:
             one right now) support rescaling the image during loading which is
             vastly more efficient than loading the entire huge image and
             rescaling it later (if these options are not supported by the
-            handler, this is still what happens however). These options must be
+            handler, this is still what happens however). JPEG handler can
+            reduce the image size by a factor of up to 8 while decoding it,
+            using less time and memory, and only the remaining reduction, if
+            any, is done by rescaling the decoded image. These options must be
             set before calling LoadFile() to have any effect.
 
         @li @c wxIMAGE_OPTION_ORIGINAL_WIDTH and @c wxIMAGE_OPTION_ORIGINAL_HEIGHT:
@@ -1412,6 +1624,22 @@ public:
             (in bytes) for saving a PNG file. Ideally this should be as big as
             the resulting PNG file. Use this option if your application produces
             images with small size variation.
+        @li @c wxIMAGE_OPTION_PNG_COMPRESSION_PROFILE: One of wxImagePNGCompression
+            values selecting the filter and compression level to use. The
+            individual options above override the values selected by the
+            profile. E.g. @c wxPNG_COMPRESSION_FAST is appropriate for saving
+            screenshots when the speed matters more than the file size. This
+            option is available since wxWidgets 3.3.2.
+        @li @c wxIMAGE_OPTION_PNG_COMPRESSION_PARALLEL: If non-zero, the image
+            data is split into blocks of rows which are filtered and compressed
+            independently, using as many threads as allowed by
+            wxImage::SetMaxThreads(). This produces slightly bigger files but is
+            much faster for big images on multi-core machines. Notice that
+            @c wxIMAGE_OPTION_PNG_COMPRESSION_MEM_LEVEL,
+            @c wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY and
+            @c wxIMAGE_OPTION_PNG_COMPRESSION_BUFFER_SIZE are ignored in this
+            mode and that it is not used for bit depths less than 8. This option
+            is available since wxWidgets 3.3.2.
 
         Options specific to wxTIFFHandler:
         @li @c wxIMAGE_OPTION_TIFF_BITSPERSAMPLE: Number of bits per
@@ -1808,6 +2036,46 @@ public:
     */
     void SetDataRGBA(const unsigned char* data);
 
+    /**
+        Sets the maximal number of threads used for processing images.
+
+        By default, all image processing functions work in the calling thread
+        only. Calling this function with @a maxThreads greater than 1 allows
+        Scale(), Rescale(), the resampling functions, Blur(), BlurHorizontal(),
+        BlurVertical(), Rotate(), ConvertToGreyscale() and the functions
+        changing the pixels colours, such as RotateHue(), ChangeSaturation() or
+        ChangeBrightness(), to split the image in bands of rows and process
+        them in parallel using up to the given number of threads, including the
+        calling one. Special value 0 means to use as many threads as there are
+        CPUs, see wxThread::GetCPUCount().
+
+        The results are exactly the same as when not using multiple threads,
+        but images of big size are processed much faster on multi-core
+        machines. Small images are always processed in the calling thread, as
+        the overhead of using multiple threads would outweigh any gains.
+
+        This setting is global and affects all wxImage objects. It is safe to
+        call this function from any thread, but changing it while the images
+        are being processed only affects the subsequent calls.
+
+        @param maxThreads Maximal number of threads to use, must be
+            non-negative. The default value is 1.
+
+        @see GetMaxThreads()
+
+        @since 3.3.2
+     */
+    static void SetMaxThreads(int maxThreads);
+
+    /**
+        Returns the maximal number of threads used for processing images.
+
+        @see SetMaxThreads()
+
+        @since 3.3.2
+     */
+    static int GetMaxThreads();
+
     /**
         Sets the default value for the flags used for loading image files.
 
@@ -2207,6 +2475,222 @@ public:
                                unsigned char startB = 0 ) const;
 };
 
+/**
+    @class wxImageView
+
+    Non-owning view of the pixels stored in an external buffer.
+
+    This class allows to use the image data in a buffer not owned by wxWidgets
+    and using a different layout than wxImage, e.g. with the pixels in BGRA
+    format or with padding at the end of each row, without repacking it into
+    wxImage first. The functions creating new images from the view, such as
+    Scale(), Rotate90() or Mirror(), read the pixels directly from the buffer,
+    converting them to the format used by wxImage on the fly, a few pixels at
+    a time, and so avoid making an intermediate copy of the entire image.
+
+    Note that the view doesn't copy the data, so the buffer must remain
+    valid for as long as the view is used. Copying the view itself is cheap.
+
+    Example of scaling a frame with 4 bytes per pixel and padded rows:
+    @code
+    wxImageView view(frame.data, frame.width, frame.height,
+                     wxIMAGE_PIXEL_FORMAT_BGRA, frame.bytesPerLine);
+    wxImage thumbnail = view.Scale(160, 120, wxIMAGE_QUALITY_HIGH);
+    @endcode
+
+    @library{wxcore}
+    @category{gdi}
+
+    @see wxImage
+
+    @since 3.3.2
+*/
+class wxImageView
+{
+public:
+    /**
+        Default constructor creates an invalid view.
+    */
+    wxImageView();
+
+    /**
+        Creates a view of the pixels in the given buffer.
+
+        @param data Pointer to the first pixel of the first (top) row.
+        @param width Width of the image in pixels, must be positive.
+        @param height Height of the image in pixels, must be positive.
+        @param format Format of the pixels in the buffer.
+        @param stride Offset in bytes between the start of consecutive rows.
+            The default value of 0 means that the rows are tightly packed,
+            i.e. the stride is equal to the width multiplied by the number of
+            bytes per pixel. It may also be negative for the images stored
+            bottom-up, in which case @a data must still point to the top row.
+    */
+    wxImageView(const void* data,
+                int width,
+                int height,
+                wxImagePixelFormat format,
+                int stride = 0);
+
+    /**
+        Creates a view of the given image.
+
+        The image must remain alive and must not be modified while the view
+        is used.
+    */
+    explicit wxImageView(const wxImage& image);
+
+    /**
+        Uses the separate plane for alpha values.
+
+        By default, alpha values are taken from the pixels if their format
+        includes alpha, e.g. wxIMAGE_PIXEL_FORMAT_RGBA, and the view doesn't
+        have any alpha otherwise. This function allows to use the alpha values
+        from a separate buffer, with 1 byte per pixel, instead, in the same way
+        as wxImage does.
+
+        @param alpha Pointer to the alpha value of the first pixel of the first
+            row or @NULL to stop using the separate alpha plane.
+        @param stride Offset in bytes between the start of consecutive rows
+            in the alpha plane, 0 means the width of the image.
+        @return Reference to this object.
+    */
+    wxImageView& SetAlpha(const void* alpha, int stride = 0);
+
+    /**
+        Returns @true if the view is valid.
+    */
+    bool IsOk() const;
+
+    /// Returns the width of the view in pixels.
+    int GetWidth() const;
+
+    /// Returns the height of the view in pixels.
+    int GetHeight() const;
+
+    /// Returns the size of the view in pixels.
+    wxSize GetSize() const;
+
+    /// Returns the format of the pixels.
+    wxImagePixelFormat GetFormat() const;
+
+    /// Returns the offset in bytes between the start of consecutive rows.
+    int GetStride() const;
+
+    /// Returns the pointer to the first pixel.
+    const unsigned char* GetData() const;
+
+    /**
+        Returns @true if the view has alpha, either in the pixels themselves
+        or in a separate plane.
+    */
+    bool HasAlpha() const;
+
+    /**
+        Returns the number of bytes used by a single pixel in the given format.
+    */
+    static int GetBytesPerPixel(wxImagePixelFormat format);
+
+    /**
+        Returns a view of the given part of this view.
+
+        This doesn't copy any data. The rectangle must be non-empty and
+        entirely inside this view.
+    */
+    wxImageView GetSubView(const wxRect& rect) const;
+
+    /**
+        Returns the red, green and blue components of @a count pixels
+        starting at the given position.
+
+        The returned pointer points to 3 bytes per pixel, as used by wxImage.
+        If the pixels are already stored in this format, it points directly
+        into the view data. Otherwise, the pixels are converted into the
+        provided @a buffer, which must be big enough to contain @a count
+        pixels, and it is returned.
+    */
+    const unsigned char*
+    GetPixelsRGB(int x, int y, int count, unsigned char* buffer) const;
+
+    /**
+        Returns the alpha values of @a count pixels starting at the given
+        position.
+
+        This is similar to GetPixelsRGB() but returns 1 byte per pixel and
+        returns @NULL if the view doesn't have alpha.
+    */
+    const unsigned char*
+    GetPixelsAlpha(int x, int y, int count, unsigned char* buffer) const;
+
+    /**
+        Returns the red, green and blue components of all pixels of the given
+        row.
+
+        This is the same as GetPixelsRGB() with 0 @a x and the view width as
+        @a count.
+    */
+    const unsigned char* GetRowRGB(int y, unsigned char* buffer) const;
+
+    /**
+        Returns the alpha values of all pixels of the given row.
+
+        This is the same as GetPixelsAlpha() with 0 @a x and the view width as
+        @a count.
+    */
+    const unsigned char* GetRowAlpha(int y, unsigned char* buffer) const;
+
+    /**
+        Creates a new image with the copy of the pixels of this view.
+
+        The image has alpha channel if the view has alpha.
+    */
+    wxImage ToImage() const;
+
+    /**
+        Creates a new image by scaling the pixels of this view.
+
+        This is equivalent to, but more efficient than, calling
+        wxImage::Scale() on the result of ToImage().
+    */
+    wxImage Scale(int width, int height,
+                  wxImageResizeQuality quality = wxIMAGE_QUALITY_NORMAL) const;
+
+    /**
+        Creates a new image by rotating the pixels of this view by 90 degrees.
+
+        This is equivalent to, but more efficient than, calling
+        wxImage::Rotate90() on the result of ToImage().
+    */
+    wxImage Rotate90(bool clockwise = true) const;
+
+    /**
+        Creates a new image by mirroring the pixels of this view.
+
+        This is equivalent to, but more efficient than, calling
+        wxImage::Mirror() on the result of ToImage().
+    */
+    wxImage Mirror(bool horizontally = true) const;
+
+    /**
+        Saves the pixels of this view to the given stream.
+
+        If the view uses the same layout as wxImage, i.e. the format is
+        wxIMAGE_PIXEL_FORMAT_RGB and the rows (and alpha, if any) are tightly
+        packed, the data is saved directly without copying it. Otherwise it is
+        converted to wxImage first.
+
+        @see wxImage::SaveFile()
+    */
+    bool SaveFile(wxOutputStream& stream, wxBitmapType type) const;
+
+    /**
+        Saves the pixels of this view to the file with the given name.
+
+        @see SaveFile(wxOutputStream&, wxBitmapType) const
+    */
+    bool SaveFile(const wxString& name, wxBitmapType type) const;
+};
+
 /**
     An instance of an empty image without an alpha channel.
 */
@@ -13,6 +13,8 @@
 #define wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY     wxT("PngZS")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_BUFFER_SIZE  wxT("PngZB")
 #define wxIMAGE_OPTION_PNG_DESCRIPTION              wxT("PngDescription")
+#define wxIMAGE_OPTION_PNG_COMPRESSION_PROFILE      wxT("PngZP")
+#define wxIMAGE_OPTION_PNG_COMPRESSION_PARALLEL     wxT("PngZT")
 
 /* These are already in interface/wx/image.h
     They were likely put there as a stopgap, but they've been there long enough
@@ -689,6 +689,29 @@ protected:
     virtual void DoLogText(const wxString& msg);
 
     ///@}
+
+    /**
+        Returns @true if this log target handles the records asynchronously.
+
+        If this function returns @true, the records logged from any thread
+        are passed to DoLogRecord() directly, in the thread which logged them,
+        instead of buffering the records logged from the background threads
+        until they can be passed to the log target in the main thread. In this
+        case the log target is also responsible for handling the repeated
+        messages and the system error code associated with the record.
+
+        Note that, unlike the other log targets, asynchronous ones are used
+        by the other threads while they're active. When such target is
+        replaced by another one, SetActiveTarget() waits until all the other
+        threads stop using it before returning, so that it can be safely
+        deleted.
+
+        The base class version returns @false. It is overridden by wxLogAsync
+        to return @true.
+
+        @since 3.3.2
+    */
+    virtual bool IsAsync() const;
 };
 
 
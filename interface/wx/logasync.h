@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/logasync.h
+// Purpose:     wxLogAsync documentation
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+    What wxLogAsync does when the buffer of the thread logging a message is
+    full.
+
+    @since 3.3.2
+*/
+enum wxLogAsyncPolicy
+{
+    /**
+        Discard the message.
+
+        The number of discarded messages is returned by
+        wxLogAsync::GetDroppedCount() and is also periodically logged as a
+        warning.
+    */
+    wxLOG_ASYNC_DROP,
+
+    /**
+        Wait until the background thread makes space in the buffer.
+
+        Note that the messages logged by the log target itself are still
+        discarded if the buffer is full, as waiting for them would result in a
+        deadlock.
+    */
+    wxLOG_ASYNC_BLOCK
+};
+
+/**
+    @class wxLogAsync
+
+    Log target passing all messages to another log target from a background
+    thread.
+
+    Logging a message using this log target only copies it into a buffer
+    which belongs to the current thread, without any locking, and all the
+    rest of the work, including formatting the message time stamp and the
+    system error message, if any, and outputting it, is done by a background
+    thread. This makes logging from multiple threads much cheaper than with
+    the other log targets, for which the messages logged by the threads other
+    than the main one are added to a single buffer protected by a critical
+    section and then processed in the main thread.
+
+    Example of use:
+    @code
+    delete wxLog::SetActiveTarget(new wxLogAsync(new wxLogStderr));
+    @endcode
+
+    The target receiving the messages is only used by the background thread
+    and by Flush(), so it doesn't need to be thread-safe, but it must be
+    usable from a thread other than the main one. Notably, this is not the
+    case for the GUI log targets such as wxLogGui or wxLogWindow.
+
+    The messages logged by the same thread are passed to the target in the
+    same order, but the messages logged by different threads may be
+    reordered. The time stamps of the messages are still those of the moment
+    when they were logged.
+
+    The size of each buffer is fixed and, if a thread logs messages faster
+    than they can be output, its buffer becomes full. In this case, the
+    messages are either discarded or the thread waits until there is space
+    in the buffer, depending on wxLogAsyncPolicy. The buffer of a thread is
+    freed after it exits, once all the messages remaining in it are output.
+
+    When this object is the active log target, the other threads only use it
+    until it is replaced by wxLog::SetActiveTarget(), which waits until all
+    of them are done with it, so the returned pointer can be deleted safely.
+    But if it is used as thread-specific target, i.e. passed to
+    wxLog::SetThreadActiveTarget(), or if its functions are called directly,
+    it must not be destroyed while other threads can still use it.
+
+    This class is only available if @c wxUSE_THREADS is 1.
+
+    @library{wxbase}
+    @category{logging}
+
+    @see wxLog::IsAsync()
+
+    @since 3.3.2
+*/
+class wxLogAsync : public wxLog
+{
+public:
+    /**
+        Creates the log target and starts its background thread.
+
+        @param target
+            The log target to pass the messages to, must not be @NULL.
+            wxLogAsync takes ownership of it and deletes it when it is
+            destroyed itself.
+        @param policy
+            What to do when the buffer of a thread is full.
+        @param bufferSize
+            The number of messages which can be queued by each thread. It is
+            rounded up to a power of 2.
+    */
+    explicit wxLogAsync(wxLog* target,
+                        wxLogAsyncPolicy policy = wxLOG_ASYNC_DROP,
+                        size_t bufferSize = 1024);
+
+    /**
+        Destructor stops the background thread, passes all the remaining
+        messages to the target and deletes it.
+    */
+    virtual ~wxLogAsync();
+
+    /**
+        Returns the log target receiving the messages.
+    */
+    wxLog* GetTarget() const;
+
+    /**
+        Returns the policy specified in the constructor.
+    */
+    wxLogAsyncPolicy GetPolicy() const;
+
+    /**
+        Returns the number of messages discarded so far because the buffer
+        was full.
+    */
+    size_t GetDroppedCount() const;
+
+    /**
+        Returns the number of messages passed to the target so far.
+    */
+    size_t GetLoggedCount() const;
+
+    /**
+        Passes all the messages logged so far to the target and flushes it.
+
+        This function blocks until all the messages are processed.
+    */
+    virtual void Flush();
+};
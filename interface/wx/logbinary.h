@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/logbinary.h
+// Purpose:     wxLogBinary, wxLogBinaryRecord and wxLogBinaryReader documentation
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+    Version of the format written by wxLogBinary.
+
+    This version is incremented when the format changes, wxLogBinaryReader
+    can read the logs written using this or any previous version.
+
+    @since 3.3.2
+*/
+#define wxLOG_BINARY_VERSION 1
+
+/**
+    @class wxLogBinary
+
+    Log target writing log records to a stream in a compact binary format.
+
+    This log target is meant to be used when a lot of messages are logged and
+    the cost of formatting them as text, as done by the other log targets,
+    is too high. Instead, it writes all the information about each message,
+    i.e. its level, time stamp, the id of the thread which logged it, the
+    file, line, function and component where it was logged and the message
+    itself, in a binary format, which can be converted to text later using
+    wxLogBinaryReader or the @c logdecode utility included with wxWidgets.
+
+    The file, function and component names are written only once and then
+    referenced by their ids and all the numbers use variable length
+    encoding, so that the records are typically only a few bytes longer than
+    the message text. They are buffered in memory and written to the stream
+    only when the buffer becomes full or Flush() is called, so care should be
+    taken to flush the log before the program terminates.
+
+    Example of use:
+    @code
+    wxFileOutputStream stream("app.wxlog");
+    wxLogBinary* const log = new wxLogBinary(&stream);
+    wxLog* const logOld = wxLog::SetActiveTarget(log);
+
+    ... log messages as usual ...
+
+    wxLog::SetActiveTarget(logOld);
+    delete log;
+    @endcode
+
+    Note that the message itself is still formatted by the logging functions
+    such as wxLogMessage() before it's passed to this log target. To also
+    move the work of writing the records out of the threads logging them,
+    this log target can be used together with wxLogAsync.
+
+    This class is only available if @c wxUSE_STREAMS is 1.
+
+    @library{wxbase}
+    @category{logging,streams}
+
+    @see wxLogBinaryReader
+
+    @since 3.3.2
+*/
+class wxLogBinary : public wxLog
+{
+public:
+    /**
+        Creates the log target writing to the given stream.
+
+        @param stream
+            The stream to write the log records to, must not be @NULL.
+            wxLogBinary doesn't take ownership of it, so it must remain valid
+            until this object is destroyed.
+        @param bufferSize
+            The size of the memory buffer, in bytes, used to accumulate the
+            records before writing them to the stream.
+    */
+    explicit wxLogBinary(wxOutputStream* stream, size_t bufferSize = 65536);
+
+    /**
+        Destructor writes all the buffered records to the stream.
+    */
+    virtual ~wxLogBinary();
+
+    /**
+        Returns @false if the stream is in error state.
+    */
+    bool IsOk() const;
+
+    /**
+        Writes all the buffered records to the stream.
+    */
+    virtual void Flush();
+};
+
+/**
+    @struct wxLogBinaryRecord
+
+    A log record read by wxLogBinaryReader.
+
+    @library{wxbase}
+    @category{logging}
+
+    @since 3.3.2
+*/
+struct wxLogBinaryRecord
+{
+    /// The level of the message.
+    wxLogLevel level;
+
+    /// Time when the message was logged in milliseconds since Epoch.
+    wxLongLong_t timestampMS;
+
+    /**
+        The id of the thread which logged the message.
+
+        This is 0 if the thread id is not available, which is the case when
+        the log was written by a program built with @c wxUSE_THREADS set
+        to 0.
+    */
+    wxULongLong_t threadId;
+
+    /// The name of the source file or empty string if not available.
+    wxString filename;
+
+    /// The line in the source file or 0 if not available.
+    int line;
+
+    /// The name of the function or empty string if not available.
+    wxString func;
+
+    /// The component which logged the message or empty string if none.
+    wxString component;
+
+    /// The message itself.
+    wxString msg;
+};
+
+/**
+    @class wxLogBinaryReader
+
+    Reads the log records written by wxLogBinary.
+
+    Example of use:
+    @code
+    wxFileInputStream fileStream("app.wxlog");
+    wxBufferedInputStream stream(fileStream);
+    wxLogBinaryReader reader(stream);
+
+    wxLogBinaryRecord record;
+    while ( reader.ReadRecord(record) )
+    {
+        ... use record.msg and the other fields ...
+    }
+
+    if ( !reader.IsOk() )
+    {
+        wxLogError("Failed to read the log.");
+    }
+    @endcode
+
+    As this class reads the stream one byte at a time, it's recommended to
+    use a buffered stream, as in the example above, for better performance.
+
+    This class is only available if @c wxUSE_STREAMS is 1.
+
+    @library{wxbase}
+    @category{logging,streams}
+
+    @see wxLogBinary
+
+    @since 3.3.2
+*/
+class wxLogBinaryReader
+{
+public:
+    /**
+        Creates the reader and reads the log header from the stream.
+
+        The stream must remain valid while this object is used. Use IsOk() to
+        check if the stream contains a valid log.
+    */
+    explicit wxLogBinaryReader(wxInputStream& stream);
+
+    /**
+        Returns @false if the stream doesn't contain a valid log, or uses a
+        newer version of the format than the one supported by this class, or
+        if an error occurred while reading it.
+    */
+    bool IsOk() const;
+
+    /**
+        Returns the version of the format of the log.
+
+        The value is only meaningful if IsOk() returns @true.
+    */
+    unsigned GetVersion() const;
+
+    /**
+        Reads the next record from the log.
+
+        Returns @false if there are no more records or if an error occurred,
+        IsOk() can be used to distinguish between these two cases.
+    */
+    bool ReadRecord(wxLogBinaryRecord& record);
+};
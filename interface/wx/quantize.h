@@ -31,10 +31,15 @@ public:
         (@a in_rows contains @a w * 3 bytes per row, @a out_rows @a w bytes per row).
         Fills @a out_rows with indexes into palette (which is also stored into @a palette
         variable).
+
+        The @a flags parameter may contain either @c wxQUANTIZE_NO_DITHER or
+        @c wxQUANTIZE_ORDERED_DITHER, see Quantize(). This parameter was
+        added in wxWidgets 3.3.2.
     */
     static void DoQuantize(unsigned int w, unsigned int h,
                            unsigned char** in_rows, unsigned char** out_rows,
-                           unsigned char* palette, int desiredNoColours);
+                           unsigned char* palette, int desiredNoColours,
+                           int flags = 0);
 
     /**
         Reduce the colours in the source image and put the result into the destination image.
@@ -42,6 +47,21 @@ public:
 
         Specify an optional palette pointer to receive the resulting palette.
         This palette may be passed to ConvertImageToBitmap, for example.
+
+        By default, Floyd-Steinberg dithering is used when mapping the image
+        pixels to the palette colours, which gives the best results but is
+        relatively slow and must be done sequentially. The @a flags may
+        include one of the following values to use a different method (both
+        of them can use multiple threads, see wxImage::SetMaxThreads()):
+        - @c wxQUANTIZE_NO_DITHER: Just use the closest palette colour for
+          each pixel. This is the fastest method and works well for the
+          images with few colours, but results in visible banding for the
+          images with smooth gradients.
+        - @c wxQUANTIZE_ORDERED_DITHER: Use ordered dithering with 8*8 Bayer
+          matrix. This is almost as fast as not dithering at all and gives
+          results of intermediate quality.
+
+        These flags are available since wxWidgets 3.3.2.
     */
     static bool Quantize(const wxImage& src, wxImage& dest,
                          wxPalette** pPalette, int desiredNoColours = 236,
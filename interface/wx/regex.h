@@ -54,6 +54,19 @@ enum
     */
     wxRE_NEWLINE  = 16,
 
+    /**
+        Don't use JIT compilation for this regex.
+
+        By default, the regex is compiled to machine code if the JIT compiler
+        is supported by PCRE on the current platform, which makes matching
+        significantly faster, but makes compiling the regex slower and uses
+        more memory. Use this flag to disable JIT compilation for a regex
+        that is used to match only a few short strings.
+
+        @since 3.3.2
+     */
+    wxRE_NOJIT    = 256,
+
     /** Default flags.*/
     wxRE_DEFAULT  = wxRE_EXTENDED
 };
@@ -106,6 +119,14 @@ enum
     - Much better performance in many common cases, by a factor of 10-100.
     - Consistent behaviour, including performance, on all platforms.
 
+    Since wxWidgets 3.3.2, the compiled regular expressions are kept in a
+    cache shared by all wxRegEx objects, so that compiling the same pattern
+    with the same flags again, e.g. when wxRegEx is used as a local variable
+    in a function called many times, is cheap. The cache is thread-safe and
+    its size can be changed using SetCacheSize(). Also, the regular
+    expressions are compiled to machine code, if PCRE supports JIT
+    compilation for the current platform, unless ::wxRE_NOJIT is used.
+
     @library{wxbase}
     @category{data}
 
@@ -291,12 +312,51 @@ public:
         form can be used instead, making it possible to avoid a wxStrlen() inside
         the loop.
 
+        Since wxWidgets 3.3.2, the text passed to the latter form is used
+        directly, without copying or converting it, unless wxWidgets is built
+        with @c wxUSE_UNICODE_UTF8 set to 1. Note that, as in the other
+        builds, wxChar is UTF-32 code unit under Unix and UTF-16 code unit
+        under Windows.
+
         May only be called after successful call to Compile().
     */
     bool Matches(const wxChar* text, int flags = 0) const;
     bool Matches(const wxChar* text, int flags, size_t len) const;
     ///@}
 
+    /**
+        Matches the precompiled regular expression against the UTF-8 text.
+
+        This function is similar to Matches(), but takes the text in UTF-8
+        encoding, which is convenient when it comes from a file or network
+        and avoids creating a wxString from it. Unlike with the other
+        overloads, the offsets returned by GetMatch() after a successful call
+        to this function are in bytes in @a text, and not in characters.
+
+        The text is used directly when wxWidgets is built with
+        @c wxUSE_UNICODE_UTF8 set to 1, otherwise it is converted into a
+        buffer reused by all calls to this function for the same wxRegEx
+        object. If the text is not valid UTF-8, an error is logged and
+        @false is returned.
+
+        Note that the overloads of GetMatch() and Replace() taking wxString
+        can't be used with this function, use GetMatch() returning the offsets
+        instead.
+
+        @param text
+            The text to match, doesn't need to be NUL-terminated.
+        @param len
+            The length of the text in bytes.
+        @param flags
+            Combination of @c wxRE_NOTBOL, @c wxRE_NOTEOL and
+            @c wxRE_NOTEMPTY, see @ref wxRE_NOT_FLAGS.
+
+        May only be called after successful call to Compile().
+
+        @since 3.3.2
+    */
+    bool MatchesUTF8(const char* text, size_t len, int flags = 0) const;
+
     /**
         Matches the precompiled regular expression against the string @a text,
         returns @true if matches and @false otherwise.
@@ -385,5 +445,24 @@ public:
         @since 3.1.6
      */
     static wxVersionInfo GetLibraryVersionInfo();
+
+    /**
+        Sets the maximal number of compiled regular expressions kept in the
+        cache shared by all wxRegEx objects.
+
+        When a pattern is compiled, it is first looked up in this cache and
+        reused if it was already compiled with the same flags before. When
+        the cache is full, the least recently used pattern is removed from
+        it. Note that the patterns used by the existing wxRegEx objects
+        remain valid even when they're removed from the cache.
+
+        The default size of the cache is 64. Setting it to 0 disables the
+        cache and removes all patterns from it.
+
+        This function can be called from any thread.
+
+        @since 3.3.2
+     */
+    static void SetCacheSize(size_t size);
 };
 
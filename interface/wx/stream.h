@@ -287,6 +287,10 @@ public:
 
     /**
         Returns the size of the buffer.
+
+        This is the allocated size of the buffer, which can be bigger than the
+        amount of data read into it by the last read from the stream, see
+        GetLastAccess().
     */
     size_t GetBufferSize() const;
 
@@ -336,6 +340,10 @@ public:
         been requested, reads more data from the associated stream and updates
         the buffer accordingly until all requested data is read.
 
+        If the buffer is empty and the remaining amount of data to read is
+        at least as big as it, the data is read directly into @a buffer,
+        without copying it through the stream buffer.
+
         @return It returns the size of the data read. If the returned size is
                 different of the specified size, an error has occurred and
                 should be tested using GetLastError().
@@ -353,9 +361,81 @@ public:
 
     /**
         Resets to the initial state variables concerning the buffer.
+
+        This also shrinks an adaptive read buffer back to its initial size,
+        see SetMaxBufferSize().
     */
     void ResetBuffer();
 
+    /**
+        Enables or disables adapting the size of a read buffer to the way the
+        stream is used.
+
+        If @a size is greater than the current buffer size, the buffer grows
+        when the stream is read sequentially: each time the buffer is
+        entirely filled by reading from the stream and then consumed, its
+        size is doubled, up to @a size. When seeking outside of the buffer,
+        it goes back to its current size, which is used as the initial one.
+        This allows to read big streams with few calls to the underlying
+        stream without using big buffers for the random access.
+
+        This only has effect for the buffers allocated by the stream buffer
+        itself, i.e. using SetBufferIO() overload taking the buffer size or
+        with @c takeOwnership parameter set to @true.
+
+        The buffer used by default by wxBufferedInputStream is adaptive.
+
+        @param size
+            The maximal size of the buffer or 0 to disable adapting its size.
+
+        @since 3.3.2
+    */
+    void SetMaxBufferSize(size_t size);
+
+    /**
+        Returns the maximal size of an adaptive buffer or 0 if the buffer size
+        is fixed.
+
+        @see SetMaxBufferSize()
+
+        @since 3.3.2
+    */
+    size_t GetMaxBufferSize() const;
+
+    /**
+        Returns the number of calls to the underlying stream
+        wxInputStream::OnSysRead() or wxOutputStream::OnSysWrite() functions
+        made by this buffer.
+
+        Together with GetBytesCopied(), this can be used to profile the
+        buffering of a stream, e.g. to choose the buffer size.
+
+        @see ResetCounters()
+
+        @since 3.3.2
+    */
+    wxUint64 GetSysCallCount() const;
+
+    /**
+        Returns the number of bytes copied to or from the buffer.
+
+        The data read or written directly by the underlying stream, bypassing
+        the buffer, is not counted.
+
+        @see GetSysCallCount(), ResetCounters()
+
+        @since 3.3.2
+    */
+    wxUint64 GetBytesCopied() const;
+
+    /**
+        Resets the counters returned by GetSysCallCount() and
+        GetBytesCopied() to 0.
+
+        @since 3.3.2
+    */
+    void ResetCounters();
+
     /**
         Changes the current position.
         Parameter @a mode may be one of the following:
@@ -445,6 +525,17 @@ public:
         See Read().
     */
     size_t Write(wxStreamBuffer* buffer);
+
+    /**
+        Writes the data from several buffers, in order.
+
+        This is the same as calling Write() for each of the buffers, except
+        that if the buffer is not fixed, it is enlarged only once, to make it
+        big enough for all the data.
+
+        @since 3.3.2
+    */
+    size_t Write(const wxIOVec* vec, size_t count);
 };
 
 
@@ -550,6 +641,32 @@ public:
     */
     bool WriteAll(const void* buffer, size_t size);
 
+    /**
+        Writes the data from several buffers, in order.
+
+        This is equivalent to calling Write() for each of the buffers, but can
+        be more efficient, as the derived classes may override it to avoid
+        copying the data or to write all of it at once. In particular,
+        wxFileOutputStream writes all the buffers using a single system call
+        under Unix, wxMemoryOutputStream grows its buffer only once and
+        wxBufferedOutputStream passes the buffers, together with any data
+        already buffered, to the underlying stream if they don't fit into its
+        buffer. This allows, for example, writing a header followed by a
+        payload without concatenating them first.
+
+        Writing stops at the first buffer which couldn't be written
+        completely. LastWrite() returns the total number of bytes written.
+
+        @param vec
+            Array of @a count buffers to write. Buffers of size 0 are allowed
+            and their data pointer may be @NULL.
+        @param count
+            Number of elements in @a vec.
+
+        @since 3.3.2
+    */
+    virtual wxOutputStream& WriteV(const wxIOVec* vec, size_t count);
+
 protected:
     /**
         Internal function. It is called when the stream wants to write data of the
@@ -771,7 +888,10 @@ public:
 
     This stream acts as a cache. It caches the bytes read from the specified
     input stream (see wxFilterInputStream).
-    It uses wxStreamBuffer and sets the default in-buffer size to 1024 bytes.
+    It uses wxStreamBuffer and, by default, a buffer starting at 4KB which
+    grows up to 256KB when the stream is read sequentially, see
+    wxStreamBuffer::SetMaxBufferSize(). Before wxWidgets 3.3.2 a fixed 1KB
+    buffer was used by default.
     This class may not be used without some other stream to read the data
     from (such as a file stream or a memory stream).
 
@@ -791,7 +911,7 @@ public:
         @param buffer
             The buffer to use if non-null. Notice that the ownership of this
             buffer is taken by the stream, i.e. it will delete it. If this
-            parameter is @NULL a default 1KB buffer is used.
+            parameter is @NULL the default adaptive buffer is used.
     */
     wxBufferedInputStream(wxInputStream& stream,
                           wxStreamBuffer *buffer = nullptr);
@@ -27,6 +27,32 @@ enum wxTarFormat
 };
 
 
+/**
+    A region of a sparse file containing data.
+
+    The parts of the file not covered by any region are holes, which read as
+    zeros.
+
+    @since 3.3.2
+
+    @see wxTarEntry::GetSparseMap()
+*/
+struct wxTarSparseRegion
+{
+    wxTarSparseRegion(wxFileOffset offset = 0, wxFileOffset size = 0);
+
+    wxFileOffset offset;    ///< Offset of the region in the file.
+    wxFileOffset size;      ///< Size of the region.
+};
+
+/**
+    The regions of a sparse file in increasing order of their offsets.
+
+    @since 3.3.2
+*/
+typedef std::vector<wxTarSparseRegion> wxTarSparseMap;
+
+
 /**
     @class wxTarInputStream
 
@@ -43,7 +69,17 @@ enum wxTarFormat
 
     Tar entries are seekable if the parent stream is seekable. In practice this
     usually means they are only seekable if the tar is stored as a local file and
-    is not compressed.
+    is not compressed. When the parent stream is seekable, the data of the
+    entries that are not read is skipped by seeking over it rather than
+    reading it, so iterating over the entries of a big tar is fast.
+
+    Sparse files stored by GNU tar, in either the old GNU format or any of the
+    pax sparse formats, are read transparently: the entry's size is the size
+    of the whole file and reading it returns zeros for the holes. Sizes too
+    big for the octal header fields are also supported in the base-256
+    encoding used by GNU tar and others. Since 3.3.2.
+
+    To find entries by name and open them directly, see wxTarIndex.
 
     @library{wxbase}
     @category{archive,streams}
@@ -94,6 +130,130 @@ public:
 };
 
 
+/**
+    @class wxTarIndex
+
+    Holds the headers of all the entries of a tar, allowing to find entries by
+    name and to open any of them without iterating over the tar again.
+
+    As the tar format has no central directory, Load() reads all the headers
+    once, seeking over the entries' data. After
+    this, OpenEntry() can be used to open any number of entries, each
+    returning a new independent wxTarInputStream reading just that entry.
+    The index itself is never modified by opening entries, so different
+    threads may open and read entries concurrently, provided that each of
+    them uses its own parent stream, e.g.:
+
+    @code
+        wxFFileInputStream file("assets.tar");
+        wxTarIndex index(file);
+
+        const wxTarEntry* entry = index.Find("images/logo.png");
+        if ( entry )
+        {
+            std::unique_ptr<wxTarInputStream> tar(index.OpenEntry(file, *entry));
+            if ( tar )
+                ... read the entry data from tar ...
+        }
+    @endcode
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @since 3.3.2
+
+    @see wxTarInputStream, wxTarEntry, wxZipIndex
+*/
+class wxTarIndex
+{
+public:
+    /**
+        Default constructor creates an empty index, Load() must be called to
+        fill it.
+    */
+    wxTarIndex();
+
+    /**
+        Constructor loading the index from the given stream.
+
+        Use IsOk() to check if it was loaded successfully.
+    */
+    explicit wxTarIndex(wxInputStream& stream, wxMBConv& conv = wxConvLocal);
+
+    /**
+        Reads the headers of all the entries of the tar in the given stream.
+
+        The stream must be seekable, as OpenEntry() needs to seek to the
+        entries in it, and this function fails immediately if it isn't. The
+        stream is only used during this call. The @a conv object is used to translate the
+        names of the entries and must remain valid for as long as the index
+        is used, as it is also used by the streams returned by OpenEntry().
+
+        Returns @true if the whole tar was read successfully, otherwise the
+        index is left empty.
+    */
+    bool Load(wxInputStream& stream, wxMBConv& conv = wxConvLocal);
+
+    /**
+        Removes all entries from the index.
+    */
+    void Clear();
+
+    /**
+        Returns @true if the index was loaded successfully.
+    */
+    bool IsOk() const;
+
+    /**
+        Returns the number of entries in the tar.
+    */
+    size_t GetCount() const;
+
+    /**
+        Returns the entry with the given index, in the order in which they
+        appear in the tar.
+
+        @a n must be less than GetCount().
+    */
+    const wxTarEntry& GetEntry(size_t n) const;
+
+    /**
+        Finds the entry with the given name.
+
+        The name is converted to the internal tar format in the same way as
+        by wxTarEntry::GetInternalName(). If the tar contains several entries
+        with the same name, the last one is returned, as it is the one that
+        would be extracted.
+
+        Returns @NULL if there is no such entry.
+    */
+    const wxTarEntry* Find(const wxString& name,
+                           wxPathFormat format = wxPATH_NATIVE) const;
+
+    ///@{
+    /**
+        Opens the given entry and returns a new stream reading its data.
+
+        @a stream must be seekable and contain the same tar as the one from
+        which the index was loaded. Each stream returned by this function
+        reads from its parent stream, so different threads must use different
+        parent streams.
+
+        If the parent stream is passed as a pointer then the returned stream
+        takes ownership of it, and it is also deleted if opening the entry
+        fails. If it is passed by reference then it does not.
+
+        Returns @NULL if the entry could not be opened, otherwise the caller
+        is responsible for deleting the returned stream.
+    */
+    wxTarInputStream* OpenEntry(wxInputStream& stream,
+                                const wxTarEntry& entry) const;
+    wxTarInputStream* OpenEntry(wxInputStream* stream,
+                                const wxTarEntry& entry) const;
+    ///@}
+};
+
+
 
 /**
     @class wxTarClassFactory
@@ -300,6 +460,25 @@ public:
     void SetDevMinor(int dev);
     ///@}
 
+    /**
+        Returns @true if the entry is a sparse file read from a tar.
+
+        The entry's type is then @e wxTAR_REGTYPE and its size is the size of
+        the whole file, holes included.
+
+        @since 3.3.2
+    */
+    bool IsSparse() const;
+
+    /**
+        Returns the regions of a sparse entry containing data.
+
+        The map is empty if IsSparse() returns @false.
+
+        @since 3.3.2
+    */
+    const wxTarSparseMap& GetSparseMap() const;
+
     ///@{
     /**
         The user ID and group ID that has permissions (see wxTarEntry::GetMode())
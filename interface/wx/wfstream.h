@@ -220,6 +220,10 @@ public:
     Note that wxInputStream::SeekI() can seek beyond the end of the stream (file)
     and will thus not return ::wxInvalidOffset for that.
 
+    When the file is read sequentially, this stream tells the system about it
+    using @c posix_fadvise(), where available, so that it can read ahead more
+    data. Seeking back to an earlier position cancels this. Since 3.3.2.
+
     @library{wxbase}
     @category{streams}
 
@@ -265,6 +269,72 @@ public:
 
 
 
+/**
+    @class wxMappedFileInputStream
+
+    This class reads a file mapped into memory.
+
+    Unlike wxFileInputStream, it doesn't read the file data into a buffer,
+    so reading from it, seeking in it and peeking at its data only involve
+    copying or accessing the data from memory, which makes it appropriate for
+    reading big files, especially when random access to them is needed, as
+    in the case of the archive files.
+
+    Being a wxMemoryInputStream, it can be used anywhere such a stream can be
+    used. The data of the file can also be accessed directly using GetData()
+    and multiple threads can read it concurrently, e.g. by creating their own
+    wxMemoryInputStream objects using this data, as long as this stream
+    object itself exists.
+
+    If the file can't be mapped into memory, e.g. because it is not a regular
+    disk file, its contents is read into memory instead, so this class can
+    still be used, but without the benefits of mapping.
+
+    Notice that the file must not be truncated while it's mapped, as accessing
+    the pages corresponding to the removed part of the file results in a
+    crash under most platforms.
+
+    @library{wxbase}
+    @category{streams}
+
+    @since 3.3.2
+
+    @see wxFileInputStream, wxMemoryInputStream
+*/
+class wxMappedFileInputStream : public wxMemoryInputStream
+{
+public:
+    /**
+        Maps the file with the given name into memory.
+
+        Use wxStreamBase::IsOk() to check if the file could be opened.
+    */
+    explicit wxMappedFileInputStream(const wxString& fileName);
+
+    /**
+        Destructor unmaps the file.
+
+        The pointer returned by GetData() becomes invalid after this.
+    */
+    virtual ~wxMappedFileInputStream();
+
+    /**
+        Returns the pointer to the file contents.
+
+        The data is valid as long as this object exists and its size is given
+        by GetLength(). The pointer is @NULL for empty files.
+    */
+    const void* GetData() const;
+
+    /**
+        Returns @true if the file is mapped into memory or @false if its
+        contents was read into memory because mapping it was impossible.
+    */
+    bool IsMapped() const;
+};
+
+
+
 /**
     @class wxFFileInputStream
 
@@ -7,7 +7,8 @@
 
 
 
-/// Compression Method, only 0 (store) and 8 (deflate) are supported here
+/// Compression Method, only 0 (store) and 8 (deflate) are supported here,
+/// as well as 93 (Zstandard) if wxUSE_LIBZSTD is enabled
 enum wxZipMethod
 {
     wxZIP_METHOD_STORE,
@@ -21,6 +22,7 @@ enum wxZipMethod
     wxZIP_METHOD_DEFLATE,
     wxZIP_METHOD_DEFLATE64,
     wxZIP_METHOD_BZIP2 = 12,
+    wxZIP_METHOD_ZSTD = 93,
     wxZIP_METHOD_DEFAULT = 0xffff
 };
 
@@ -438,6 +440,141 @@ public:
 
 
 
+/**
+    @class wxZipIndex
+
+    Holds the parsed central directory of a zip, allowing to find entries by
+    name and to open any of them without iterating over the zip again.
+
+    The index is loaded once from a seekable stream by Load() and can then be
+    used to open any number of entries with OpenEntry(), each of which returns
+    a new independent wxZipInputStream reading just that entry. The index
+    itself is never modified by opening entries, so different threads may
+    open and read entries concurrently, provided that each of them uses its
+    own parent stream, e.g.:
+
+    @code
+        wxMappedFileInputStream file("assets.zip");
+        wxZipIndex index(file);
+
+        // in each worker thread:
+        const wxZipEntry* entry = index.Find("images/logo.png");
+        if ( entry )
+        {
+            std::unique_ptr<wxZipInputStream> zip(index.OpenEntry(
+                new wxMemoryInputStream(file.GetData(), file.GetLength()),
+                *entry));
+            if ( zip )
+                ... read the entry data from zip ...
+        }
+    @endcode
+
+    Using wxMappedFileInputStream as above avoids opening the file once per
+    thread, but any seekable stream, e.g. a separate wxFFileInputStream per
+    thread, works too.
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @since 3.3.2
+
+    @see wxZipInputStream, wxZipEntry
+*/
+class wxZipIndex
+{
+public:
+    /**
+        Default constructor creates an empty index, Load() must be called to
+        fill it.
+    */
+    wxZipIndex();
+
+    /**
+        Constructor loading the index from the given stream.
+
+        Use IsOk() to check if it was loaded successfully.
+    */
+    explicit wxZipIndex(wxInputStream& stream, wxMBConv& conv = wxConvLocal);
+
+    /**
+        Reads the central directory of the zip in the given stream.
+
+        The stream must be seekable and is only used during this call. The
+        @a conv object is used to translate the names of the entries and must
+        remain valid for as long as the index is used, as it is also used by
+        the streams returned by OpenEntry().
+
+        Returns @true if the whole directory was read successfully, otherwise
+        the index is left empty.
+    */
+    bool Load(wxInputStream& stream, wxMBConv& conv = wxConvLocal);
+
+    /**
+        Removes all entries from the index.
+    */
+    void Clear();
+
+    /**
+        Returns @true if the index was loaded successfully.
+    */
+    bool IsOk() const;
+
+    /**
+        Returns the number of entries in the zip.
+    */
+    size_t GetCount() const;
+
+    /**
+        Returns the entry with the given index, in the order in which they
+        appear in the central directory.
+
+        @a n must be less than GetCount().
+    */
+    const wxZipEntry& GetEntry(size_t n) const;
+
+    /**
+        Finds the entry with the given name.
+
+        The name is converted to the internal zip format in the same way as
+        by wxZipEntry::GetInternalName(), so this function is a fast
+        equivalent of iterating over the entries and comparing their internal
+        names.
+
+        Returns @NULL if there is no such entry.
+    */
+    const wxZipEntry* Find(const wxString& name,
+                           wxPathFormat format = wxPATH_NATIVE) const;
+
+    /**
+        Returns the zip comment.
+    */
+    const wxString& GetComment() const;
+
+    ///@{
+    /**
+        Opens the given entry and returns a new stream reading its data.
+
+        @a stream must be seekable and contain the same zip as the one from
+        which the index was loaded. Each stream returned by this function
+        reads from its parent stream, so different threads must use different
+        parent streams.
+
+        If the parent stream is passed as a pointer then the returned stream
+        takes ownership of it, and it is also deleted if opening the entry
+        fails. If it is passed by reference then it does not.
+
+        Returns @NULL if the entry could not be opened, otherwise the caller
+        is responsible for deleting the returned stream.
+    */
+    wxZipInputStream* OpenEntry(wxInputStream& stream,
+                                const wxZipEntry& entry) const;
+    wxZipInputStream* OpenEntry(wxInputStream* stream,
+                                const wxZipEntry& entry) const;
+    ///@}
+};
+
+
+
 /**
     @class wxZipClassFactory
 
@@ -556,6 +693,25 @@ public:
     void SetLevel(int level);
     ///@}
 
+    ///@{
+    /**
+        Set the maximal number of threads used for compressing the entries.
+
+        The default value of 1 means that the entries are compressed
+        sequentially, while the other values are passed to
+        wxZlibOutputStream::SetMaxThreads() for the entries using
+        ::wxZIP_METHOD_DEFLATE, so that each of them is compressed using
+        multiple threads. As with wxZlibOutputStream, 0 means using as many
+        threads as there are CPUs.
+
+        The new value is used starting from the next created entry.
+
+        @since 3.3.2
+    */
+    unsigned GetMaxThreads() const;
+    void SetMaxThreads(unsigned maxThreads);
+    ///@}
+
     /**
         Create a new directory entry (see wxArchiveEntry::IsDir) with the given
         name and timestamp.
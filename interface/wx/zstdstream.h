@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/zstdstream.h
+// Purpose:     Zstandard [de]compression classes documentation
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+    Flags for wxZstdInputStream.
+
+    @since 3.3.2
+*/
+enum
+{
+    /**
+        Stop at the end of the first Zstandard frame.
+
+        Any data following the frame remains available in the underlying
+        stream. This is used for reading zip entries compressed using
+        Zstandard.
+    */
+    wxZSTD_SINGLE_FRAME = 1
+};
+
+/**
+    @class wxZstdInputStream
+
+    This filter stream decompresses data in Zstandard format.
+
+    Zstandard format is used by .zst files and is notable for its fast
+    decompression, which is significantly faster than that of the GZip format
+    read by wxZlibInputStream while achieving comparable or better compression
+    ratios. All the frames in the underlying stream are decompressed, so that
+    files consisting of several concatenated frames, such as those created by
+    concatenating several .zst files or by multithreaded compressors, are read
+    entirely, and skippable frames are ignored. Use ::wxZSTD_SINGLE_FRAME to
+    stop reading at the end of the first frame instead.
+
+    To decompress contents of standard input to standard output, the following
+    (not optimally efficient) code could be used:
+    @code
+    wxFFileInputStream fin(stdin);
+    wxZstdInputStream zin(fin);
+    wxFFileOutputStream fout(stdout);
+    zin.Read(fout);
+
+    if ( zin.GetLastError() != wxSTREAM_EOF ) {
+        ... handle error ...
+    }
+    @endcode
+
+    This class is only available if @c wxUSE_LIBZSTD is set to 1, which
+    requires libzstd to be available when building wxWidgets.
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see wxInputStream, wxZlibInputStream, wxZstdOutputStream.
+
+    @since 3.3.2
+*/
+class wxZstdInputStream : public wxFilterInputStream
+{
+public:
+    /**
+        Create decompressing stream associated with the given underlying
+        stream.
+
+        This overload does not take ownership of the @a stream.
+
+        @param stream
+            The stream to read the compressed data from.
+        @param flags
+            Either 0 or ::wxZSTD_SINGLE_FRAME.
+    */
+    wxZstdInputStream(wxInputStream& stream, int flags = 0);
+
+    /**
+        Create decompressing stream associated with the given underlying
+        stream and takes ownership of it.
+
+        As with the base wxFilterInputStream class, passing @a stream by
+        pointer indicates that this object takes ownership of it and will
+        delete it when it is itself destroyed.
+     */
+    wxZstdInputStream(wxInputStream* stream, int flags = 0);
+};
+
+/**
+    @class wxZstdOutputStream
+
+    This filter stream compresses data using Zstandard format.
+
+    The output is a single Zstandard frame including the checksum of the
+    data, compatible with the zstd command line utility working with .zst
+    files. The frame is finished when the stream is closed or destroyed.
+
+    This class is only available if @c wxUSE_LIBZSTD is set to 1.
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see wxOutputStream, wxZlibOutputStream, wxZstdInputStream
+
+    @since 3.3.2
+*/
+class wxZstdOutputStream : public wxFilterOutputStream
+{
+public:
+    /**
+        Create compressing stream associated with the given underlying
+        stream.
+
+        This overload does not take ownership of the @a stream.
+
+        @param stream
+            The stream to write the compressed data to.
+        @param level
+            Compression level, between 1 and 22 (negative values enabling
+            faster compression are supported too), or -1 to use the default
+            level of the library.
+    */
+    wxZstdOutputStream(wxOutputStream& stream, int level = -1);
+
+    /**
+        Create compressing stream associated with the given underlying
+        stream and takes ownership of it.
+
+        As with the base wxFilterOutputStream class, passing @a stream by
+        pointer indicates that this object takes ownership of it and will
+        delete it when it is itself destroyed.
+     */
+    wxZstdOutputStream(wxOutputStream* stream, int level = -1);
+};
+
+/**
+    @class wxZstdClassFactory
+
+    Filter class factory for Zstandard streams.
+
+    It is registered automatically and allows wxFilterClassFactory::Find() and
+    hence wxFilterFSHandler and wxArchiveFSHandler to recognize files with
+    @c .zst extension and the @c application/zstd MIME type.
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see wxFilterClassFactory
+
+    @since 3.3.2
+*/
+class wxZstdClassFactory : public wxFilterClassFactory
+{
+public:
+    wxZstdClassFactory();
+};
+
+/**
+    Return the version of libzstd library used by Zstandard stream classes.
+
+    @see wxVersionInfo
+
+    @header{wx/zstdstream.h}
+    @library{wxbase}
+
+    @since 3.3.2
+*/
+wxVersionInfo wxGetLibZstdVersionInfo();
@@ -84,10 +84,51 @@ public:
         will inflate corrupted data.
 
         Returns @true if the dictionary was successfully set.
+
+        The dictionary can't be used when compressing in parallel, see
+        SetMaxThreads().
     */
     bool SetDictionary(const char *data, size_t datalen);
     bool SetDictionary(const wxMemoryBuffer &buf);
     ///@}
+
+    /**
+        Enables compressing the data using multiple threads.
+
+        When @a maxThreads is greater than 1, the data written to the stream
+        is split into blocks of @a blockSize bytes (128KiB by default) which
+        are compressed independently and in parallel, using up to
+        @a maxThreads threads. Each block still uses the end of the previous
+        one as its dictionary, so the compression ratio is only slightly
+        worse than when compressing sequentially, and the output is a single
+        standard zlib, gzip or raw deflate stream which can be decompressed
+        by any program.
+
+        If @a maxThreads is 0, the number of CPUs is used. The default value
+        of 1 disables parallel compression.
+
+        Note that the data is buffered until there is enough of it to give
+        a block to each thread, so using this mode requires more memory and
+        is only worth it when compressing big amounts of data. Calling Sync()
+        compresses the data buffered so far immediately.
+
+        This function must be called before writing any data to the stream
+        and can't be combined with SetDictionary().
+
+        Returns @true if the number of threads was set.
+
+        @since 3.3.2
+    */
+    bool SetMaxThreads(unsigned maxThreads, size_t blockSize = 0);
+
+    /**
+        Returns the number of threads used for compressing the data.
+
+        This is 1 unless SetMaxThreads() was called.
+
+        @since 3.3.2
+    */
+    unsigned GetMaxThreads() const;
 };
 
 
@@ -0,0 +1,718 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/asyncfile.cpp
+// Purpose:     wxAsyncFile implementation
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// For compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#if wxUSE_FILE && wxUSE_THREADS
+
+#include "wx/asyncfile.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+    #include "wx/module.h"
+    #include "wx/utils.h"
+#endif
+
+#include "wx/thread.h"
+
+#ifdef __WINDOWS__
+    #include "wx/msw/wrapwin.h"
+    #include <io.h>
+#else
+    #include <errno.h>
+    #include <unistd.h>
+#endif
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+wxDEFINE_EVENT(wxEVT_ASYNC_FILE, wxAsyncFileEvent);
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxAsyncFileEvent, wxEvent);
+
+// ============================================================================
+// helpers
+// ============================================================================
+
+// The state shared by wxAsyncFile and the requests using it: this allows the
+// background threads to keep using it even if the wxAsyncFile itself is
+// being destroyed, although wxAsyncFile dtor waits for them to finish anyhow.
+class wxAsyncFileData
+{
+public:
+    wxAsyncFileData()
+        : m_cond(m_mutex),
+          m_pending(0),
+          m_lastRequest(0)
+    {
+    }
+
+    wxFile m_file;
+
+    // Return the id of the new request and account for it as pending.
+    long NewRequest()
+    {
+        wxMutexLocker lock(m_mutex);
+
+        m_pending++;
+
+        if ( ++m_lastRequest <= 0 )
+            m_lastRequest = 1;
+
+        return m_lastRequest;
+    }
+
+    // Must be called exactly once for every request created by NewRequest().
+    void RequestDone()
+    {
+        wxMutexLocker lock(m_mutex);
+
+        if ( !--m_pending )
+            m_cond.Broadcast();
+    }
+
+    void WaitAll()
+    {
+        wxMutexLocker lock(m_mutex);
+
+        while ( m_pending )
+            m_cond.Wait();
+    }
+
+    size_t GetPending()
+    {
+        wxMutexLocker lock(m_mutex);
+
+        return m_pending;
+    }
+
+private:
+    wxMutex m_mutex;
+    wxCondition m_cond;
+    size_t m_pending;
+    long m_lastRequest;
+
+    wxDECLARE_NO_COPY_CLASS(wxAsyncFileData);
+};
+
+namespace
+{
+
+// One read or write operation.
+struct wxAsyncFileRequest
+{
+    std::shared_ptr<wxAsyncFileData> file;
+    long id;
+    wxAsyncFileOperation operation;
+    wxFileOffset offset;
+    size_t size;
+
+    // The data to write, unused for reads.
+    std::vector<char> data;
+
+    // The handler to notify about completion, may be null.
+    wxEvtHandler* owner;
+    int ownerId;
+};
+
+typedef std::unique_ptr<wxAsyncFileRequest> wxAsyncFileRequestPtr;
+
+// Functions performing I/O at the given offset without using (and so without
+// changing) the file pointer, which means that they can be used from several
+// threads simultaneously. They return the number of bytes transferred and
+// set the error to the system error code if it is less than the requested
+// size because of an error and not because of reaching the end of file.
+
+#ifdef __WINDOWS__
+
+size_t DoReadAt(int fd, void* buf, size_t size, wxFileOffset offset,
+                unsigned long& error)
+{
+    const HANDLE h = reinterpret_cast<HANDLE>(::_get_osfhandle(fd));
+
+    size_t done = 0;
+    while ( done < size )
+    {
+        const wxFileOffset pos = offset + done;
+
+        OVERLAPPED ov = {};
+        ov.Offset = static_cast<DWORD>(pos);
+        ov.OffsetHigh = static_cast<DWORD>(pos >> 32);
+
+        const DWORD chunk = static_cast<DWORD>(wxMin(size - done, 0x40000000u));
+        DWORD count = 0;
+        if ( !::ReadFile(h, static_cast<char*>(buf) + done, chunk, &count, &ov) )
+        {
+            const DWORD rc = ::GetLastError();
+            if ( rc != ERROR_HANDLE_EOF )
+                error = rc;
+            break;
+        }
+
+        if ( !count )
+            break;
+
+        done += count;
+    }
+
+    return done;
+}
+
+size_t DoWriteAt(int fd, const void* buf, size_t size, wxFileOffset offset,
+                 unsigned long& error)
+{
+    const HANDLE h = reinterpret_cast<HANDLE>(::_get_osfhandle(fd));
+
+    size_t done = 0;
+    while ( done < size )
+    {
+        const wxFileOffset pos = offset + done;
+
+        OVERLAPPED ov = {};
+        ov.Offset = static_cast<DWORD>(pos);
+        ov.OffsetHigh = static_cast<DWORD>(pos >> 32);
+
+        const DWORD chunk = static_cast<DWORD>(wxMin(size - done, 0x40000000u));
+        DWORD count = 0;
+        if ( !::WriteFile(h, static_cast<const char*>(buf) + done, chunk,
+                          &count, &ov) )
+        {
+            error = ::GetLastError();
+            break;
+        }
+
+        done += count;
+    }
+
+    return done;
+}
+
+#else // !__WINDOWS__
+
+size_t DoReadAt(int fd, void* buf, size_t size, wxFileOffset offset,
+                unsigned long& error)
+{
+    size_t done = 0;
+    while ( done < size )
+    {
+        const ssize_t rc = ::pread(fd, static_cast<char*>(buf) + done,
+                                   size - done, offset + done);
+        if ( rc < 0 )
+        {
+            if ( errno == EINTR )
+                continue;
+
+            error = errno;
+            break;
+        }
+
+        if ( !rc )
+            break;
+
+        done += rc;
+    }
+
+    return done;
+}
+
+size_t DoWriteAt(int fd, const void* buf, size_t size, wxFileOffset offset,
+                 unsigned long& error)
+{
+    size_t done = 0;
+    while ( done < size )
+    {
+        const ssize_t rc = ::pwrite(fd, static_cast<const char*>(buf) + done,
+                                    size - done, offset + done);
+        if ( rc < 0 )
+        {
+            if ( errno == EINTR )
+                continue;
+
+            error = errno;
+            break;
+        }
+
+        done += rc;
+    }
+
+    return done;
+}
+
+#endif // __WINDOWS__/!__WINDOWS__
+
+// Notify the owner about the completion of the request and forget about it.
+void CompleteRequest(wxAsyncFileRequest& req, wxAsyncFileEvent* event)
+{
+    // Note that the event must be queued before calling RequestDone() to
+    // ensure that it's already pending when wxAsyncFile::Wait() returns.
+    if ( req.owner )
+        wxQueueEvent(req.owner, event);
+    else
+        delete event;
+
+    req.file->RequestDone();
+}
+
+wxAsyncFileEvent* CreateCompletionEvent(const wxAsyncFileRequest& req)
+{
+    return new wxAsyncFileEvent(req.ownerId, req.id, req.operation,
+                                req.offset, req.size);
+}
+
+void PerformRequest(wxAsyncFileRequest& req)
+{
+    wxAsyncFileEvent* const event = CreateCompletionEvent(req);
+
+    const int fd = req.file->m_file.fd();
+
+    unsigned long error = 0;
+    switch ( req.operation )
+    {
+        case wxASYNC_FILE_READ:
+            {
+                wxMemoryBuffer buf(req.size);
+                buf.SetDataLen(DoReadAt(fd, buf.GetData(), req.size,
+                                        req.offset, error));
+                event->SetCount(buf.GetDataLen());
+                event->SetData(buf);
+            }
+            break;
+
+        case wxASYNC_FILE_WRITE:
+            event->SetCount(DoWriteAt(fd, req.data.data(), req.size,
+                                      req.offset, error));
+            break;
+    }
+
+    event->SetErrorCode(error);
+
+    CompleteRequest(req, event);
+}
+
+void CancelRequest(wxAsyncFileRequest& req)
+{
+    wxAsyncFileEvent* const event = CreateCompletionEvent(req);
+    event->SetCancelled();
+
+    CompleteRequest(req, event);
+}
+
+// By default we use a few threads: using more wouldn't help with a single
+// disk and even a single one is enough to avoid blocking the main thread.
+const unsigned DEFAULT_MAX_THREADS = 4;
+
+std::atomic<unsigned> gs_maxThreads{0};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxAsyncFilePool: threads performing the requests of all wxAsyncFiles
+// ----------------------------------------------------------------------------
+
+class wxAsyncFilePool
+{
+public:
+    // Return the global pool, creating it if necessary, or null if it had
+    // been already destroyed by Cleanup().
+    static wxAsyncFilePool* Get();
+
+    // Allow creating the pool again after Cleanup().
+    static void Init();
+
+    // Stop all threads and destroy the global pool, if it had been created.
+    // After this, Get() doesn't create a new pool until Init() is called.
+    static void Cleanup();
+
+    void Submit(wxAsyncFileRequestPtr req);
+
+    // Remove the given request or all requests for this file if the id is 0
+    // from the queue and return them.
+    std::vector<wxAsyncFileRequestPtr> Remove(const wxAsyncFileData* file,
+                                              long id);
+
+private:
+    wxAsyncFilePool()
+        : m_cond(m_mutex),
+          m_idle(0),
+          m_stop(false)
+    {
+    }
+
+    ~wxAsyncFilePool();
+
+    void WorkerMain();
+
+    class Worker : public wxThread
+    {
+    public:
+        explicit Worker(wxAsyncFilePool& pool)
+            : wxThread(wxTHREAD_JOINABLE),
+              m_pool(pool)
+        {
+        }
+
+    protected:
+        void* Entry() override
+        {
+            m_pool.WorkerMain();
+            return nullptr;
+        }
+
+    private:
+        wxAsyncFilePool& m_pool;
+    };
+
+    static wxAsyncFilePool* ms_pool;
+    static bool ms_shutDown;
+
+    wxMutex m_mutex;
+    wxCondition m_cond;
+    std::deque<wxAsyncFileRequestPtr> m_queue;
+    std::vector<Worker*> m_threads;
+    size_t m_idle;
+    bool m_stop;
+
+    wxDECLARE_NO_COPY_CLASS(wxAsyncFilePool);
+};
+
+wxAsyncFilePool* wxAsyncFilePool::ms_pool = nullptr;
+bool wxAsyncFilePool::ms_shutDown = false;
+
+namespace
+{
+
+wxCriticalSection& GetPoolCritSect()
+{
+    static wxCriticalSection s_cs;
+    return s_cs;
+}
+
+} // anonymous namespace
+
+/* static */
+wxAsyncFilePool* wxAsyncFilePool::Get()
+{
+    wxCriticalSectionLocker lock(GetPoolCritSect());
+
+    // Don't create a new pool, whose threads would never be stopped, if
+    // a file is used after the library shutdown, e.g. from a global object.
+    if ( !ms_pool && !ms_shutDown )
+        ms_pool = new wxAsyncFilePool();
+
+    return ms_pool;
+}
+
+/* static */
+void wxAsyncFilePool::Init()
+{
+    wxCriticalSectionLocker lock(GetPoolCritSect());
+
+    ms_shutDown = false;
+}
+
+/* static */
+void wxAsyncFilePool::Cleanup()
+{
+    wxCriticalSectionLocker lock(GetPoolCritSect());
+
+    delete ms_pool;
+    ms_pool = nullptr;
+    ms_shutDown = true;
+}
+
+wxAsyncFilePool::~wxAsyncFilePool()
+{
+    {
+        wxMutexLocker lock(m_mutex);
+        m_stop = true;
+        m_cond.Broadcast();
+    }
+
+    for ( Worker* thread : m_threads )
+    {
+        thread->Wait();
+        delete thread;
+    }
+
+    // We can't notify anybody about the requests still remaining in the
+    // queue as we're called during the program shutdown, so just drop them.
+    for ( wxAsyncFileRequestPtr& req : m_queue )
+        req->file->RequestDone();
+}
+
+void wxAsyncFilePool::Submit(wxAsyncFileRequestPtr req)
+{
+    {
+        wxMutexLocker lock(m_mutex);
+
+        m_queue.push_back(std::move(req));
+
+        const unsigned maxThreads = wxAsyncFile::GetMaxThreads();
+        if ( m_idle >= m_queue.size() || m_threads.size() >= maxThreads )
+        {
+            m_cond.Signal();
+            return;
+        }
+
+        Worker* const thread = new Worker(*this);
+        if ( thread->Run() == wxTHREAD_NO_ERROR )
+        {
+            m_threads.push_back(thread);
+            return;
+        }
+
+        delete thread;
+
+        // If we already have some threads, they will process the request.
+        if ( !m_threads.empty() )
+        {
+            m_cond.Signal();
+            return;
+        }
+
+        req = std::move(m_queue.back());
+        m_queue.pop_back();
+    }
+
+    // Without any threads, we have no choice but to do it synchronously.
+    wxLogDebug("Failed to start asynchronous I/O thread.");
+
+    PerformRequest(*req);
+}
+
+std::vector<wxAsyncFileRequestPtr>
+wxAsyncFilePool::Remove(const wxAsyncFileData* file, long id)
+{
+    std::vector<wxAsyncFileRequestPtr> removed;
+
+    wxMutexLocker lock(m_mutex);
+
+    for ( auto it = m_queue.begin(); it != m_queue.end(); )
+    {
+        if ( (*it)->file.get() == file && (!id || (*it)->id == id) )
+        {
+            removed.push_back(std::move(*it));
+            it = m_queue.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return removed;
+}
+
+void wxAsyncFilePool::WorkerMain()
+{
+    for ( ;; )
+    {
+        wxAsyncFileRequestPtr req;
+
+        {
+            wxMutexLocker lock(m_mutex);
+
+            m_idle++;
+            while ( m_queue.empty() && !m_stop )
+                m_cond.Wait();
+            m_idle--;
+
+            if ( m_stop )
+                break;
+
+            req = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        PerformRequest(*req);
+    }
+}
+
+// ============================================================================
+// wxAsyncFile implementation
+// ============================================================================
+
+wxAsyncFile::wxAsyncFile(wxEvtHandler* owner, int id)
+    : m_data(std::make_shared<wxAsyncFileData>()),
+      m_owner(owner),
+      m_id(id)
+{
+}
+
+wxAsyncFile::wxAsyncFile(const wxString& filename,
+                         wxFile::OpenMode mode,
+                         wxEvtHandler* owner,
+                         int id)
+    : m_data(std::make_shared<wxAsyncFileData>()),
+      m_owner(owner),
+      m_id(id)
+{
+    Open(filename, mode);
+}
+
+wxAsyncFile::~wxAsyncFile()
+{
+    Close();
+}
+
+void wxAsyncFile::SetOwner(wxEvtHandler* owner, int id)
+{
+    m_owner = owner;
+    m_id = id;
+}
+
+bool wxAsyncFile::Open(const wxString& filename,
+                       wxFile::OpenMode mode,
+                       int access)
+{
+    Close();
+
+    return m_data->m_file.Open(filename, mode, access);
+}
+
+bool wxAsyncFile::IsOpened() const
+{
+    return m_data->m_file.IsOpened();
+}
+
+bool wxAsyncFile::Close()
+{
+    if ( !IsOpened() )
+        return true;
+
+    CancelAll();
+    Wait();
+
+    return m_data->m_file.Close();
+}
+
+long wxAsyncFile::Submit(wxAsyncFileOperation operation,
+                         wxFileOffset offset,
+                         size_t size,
+                         const void* data)
+{
+    wxCHECK_MSG( IsOpened(), 0, wxS("file must be opened") );
+    wxCHECK_MSG( offset >= 0, 0, wxS("invalid offset") );
+
+    wxAsyncFilePool* const pool = wxAsyncFilePool::Get();
+    if ( !pool )
+    {
+        wxLogDebug("Can't start asynchronous I/O after shutdown.");
+        return 0;
+    }
+
+    wxAsyncFileRequestPtr req(new wxAsyncFileRequest);
+    req->file = m_data;
+    req->operation = operation;
+    req->offset = offset;
+    req->size = size;
+    req->owner = m_owner;
+    req->ownerId = m_id;
+
+    if ( data )
+    {
+        const char* const p = static_cast<const char*>(data);
+        req->data.assign(p, p + size);
+    }
+
+    const long id = m_data->NewRequest();
+    req->id = id;
+
+    pool->Submit(std::move(req));
+
+    return id;
+}
+
+long wxAsyncFile::Read(wxFileOffset offset, size_t size)
+{
+    return Submit(wxASYNC_FILE_READ, offset, size, nullptr);
+}
+
+long wxAsyncFile::Write(wxFileOffset offset, const void* data, size_t size)
+{
+    wxCHECK_MSG( data || !size, 0, wxS("null data pointer") );
+
+    return Submit(wxASYNC_FILE_WRITE, offset, size, data);
+}
+
+bool wxAsyncFile::Cancel(long request)
+{
+    wxCHECK_MSG( request > 0, false, wxS("invalid request") );
+
+    // There can be no queued requests after the pool was destroyed.
+    wxAsyncFilePool* const pool = wxAsyncFilePool::Get();
+    if ( !pool )
+        return false;
+
+    std::vector<wxAsyncFileRequestPtr>
+        removed = pool->Remove(m_data.get(), request);
+
+    for ( wxAsyncFileRequestPtr& req : removed )
+        CancelRequest(*req);
+
+    return !removed.empty();
+}
+
+void wxAsyncFile::CancelAll()
+{
+    wxAsyncFilePool* const pool = wxAsyncFilePool::Get();
+    if ( !pool )
+        return;
+
+    std::vector<wxAsyncFileRequestPtr>
+        removed = pool->Remove(m_data.get(), 0);
+
+    for ( wxAsyncFileRequestPtr& req : removed )
+        CancelRequest(*req);
+}
+
+void wxAsyncFile::Wait()
+{
+    m_data->WaitAll();
+}
+
+size_t wxAsyncFile::GetPendingCount() const
+{
+    return m_data->GetPending();
+}
+
+/* static */
+void wxAsyncFile::SetMaxThreads(unsigned maxThreads)
+{
+    gs_maxThreads = maxThreads;
+}
+
+/* static */
+unsigned wxAsyncFile::GetMaxThreads()
+{
+    const unsigned maxThreads = gs_maxThreads;
+    return maxThreads ? maxThreads : DEFAULT_MAX_THREADS;
+}
+
+// ----------------------------------------------------------------------------
+// wxAsyncFileModule: stops the background threads on exit
+// ----------------------------------------------------------------------------
+
+class wxAsyncFileModule : public wxModule
+{
+public:
+    wxAsyncFileModule() = default;
+
+    bool OnInit() override { wxAsyncFilePool::Init(); return true; }
+    void OnExit() override { wxAsyncFilePool::Cleanup(); }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxAsyncFileModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxAsyncFileModule, wxModule);
+
+#endif // wxUSE_FILE && wxUSE_THREADS
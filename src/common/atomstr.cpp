@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/atomstr.cpp
+// Purpose:     wxAtomString implementation
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#include "wx/atomstr.h"
+
+#include "wx/thread.h"
+
+#include <unordered_set>
+
+// ----------------------------------------------------------------------------
+// wxAtomStringTable: global table of all interned strings
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+class wxAtomStringTable
+{
+public:
+    wxAtomStringTable() = default;
+
+    const wxString* Intern(const wxString& str);
+
+    wxAtomStringStats GetStats() const;
+
+    // Return the unique global table.
+    static wxAtomStringTable& Get()
+    {
+        static wxAtomStringTable s_table;
+        return s_table;
+    }
+
+private:
+    // Elements of std::unordered_set are never moved, even when rehashing,
+    // so pointers to them can be used as atoms.
+    std::unordered_set<wxString> m_strings;
+
+    // Statistics not available from m_strings itself.
+    size_t m_length = 0;
+    size_t m_memory = 0;
+    size_t m_lookups = 0;
+    size_t m_hits = 0;
+
+#if wxUSE_THREADS
+    mutable wxCriticalSection m_cs;
+#endif // wxUSE_THREADS
+
+    wxDECLARE_NO_COPY_CLASS(wxAtomStringTable);
+};
+
+const wxString* wxAtomStringTable::Intern(const wxString& str)
+{
+    wxCRIT_SECT_LOCKER(lock, m_cs);
+
+    m_lookups++;
+
+    const auto res = m_strings.insert(str);
+    if ( res.second )
+    {
+        m_length += str.length();
+
+        // This is only an estimate: assume that the set node contains the
+        // string itself, the pointer to the next node and the cached hash
+        // and that the string contents is allocated on the heap.
+        m_memory += sizeof(wxString) + sizeof(void*) + sizeof(size_t) +
+                    (str.length() + 1)*sizeof(wxStringCharType);
+    }
+    else
+    {
+        m_hits++;
+    }
+
+    return &*res.first;
+}
+
+wxAtomStringStats wxAtomStringTable::GetStats() const
+{
+    wxCRIT_SECT_LOCKER(lock, m_cs);
+
+    wxAtomStringStats stats;
+    stats.count = m_strings.size();
+    stats.length = m_length;
+    stats.memory = sizeof(*this) +
+                   m_strings.bucket_count()*sizeof(void*) +
+                   m_memory;
+    stats.lookups = m_lookups;
+    stats.hits = m_hits;
+
+    return stats;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// wxAtomString implementation
+// ============================================================================
+
+/* static */
+const wxString* wxAtomString::Intern(const wxString& str)
+{
+    if ( str.empty() )
+        return nullptr;
+
+    return wxAtomStringTable::Get().Intern(str);
+}
+
+/* static */
+const wxString& wxAtomString::GetEmptyString()
+{
+    static const wxString s_empty;
+    return s_empty;
+}
+
+/* static */
+wxAtomStringStats wxAtomString::GetStats()
+{
+    return wxAtomStringTable::Get().GetStats();
+}
@@ -18,6 +18,7 @@
 
 #ifndef WX_PRECOMP
     #include "wx/math.h"
+    #include "wx/utils.h"
 #endif //WX_PRECOMP
 
 namespace
@@ -36,6 +37,83 @@ union Float64Data
     wxUint32 i[2];
 };
 
+// return true if the stream byte order is different from the native one
+inline bool NeedsSwap(bool be_order)
+{
+    return be_order != (wxBYTE_ORDER == wxBIG_ENDIAN);
+}
+
+inline wxUint16 SwapValue(wxUint16 v) { return wxUINT16_SWAP_ALWAYS(v); }
+inline wxUint32 SwapValue(wxUint32 v) { return wxUINT32_SWAP_ALWAYS(v); }
+inline wxUint64 SwapValue(wxUint64 v) { return wxUINT64_SWAP_ALWAYS(v); }
+
+// swap the bytes of all values in the buffer in place: this is written as a
+// simple loop without any dependencies between iterations, which compilers
+// vectorize, and uses memcpy() to allow using it for float values too
+template <typename T>
+void SwapBytes(void *buffer, size_t size)
+{
+    unsigned char *p = static_cast<unsigned char *>(buffer);
+
+    for ( size_t n = 0; n < size; n++, p += sizeof(T) )
+    {
+        T v;
+        memcpy(&v, p, sizeof(T));
+        v = SwapValue(v);
+        memcpy(p, &v, sizeof(T));
+    }
+}
+
+// read all values at once directly into the destination buffer and then
+// convert them to the native byte order, if necessary
+template <typename T>
+void ReadArray(wxInputStream *input, void *buffer, size_t size, bool be_order)
+{
+    input->Read(buffer, size * sizeof(T));
+
+    if ( NeedsSwap(be_order) )
+        SwapBytes<T>(buffer, size);
+}
+
+// write all values at once if they're already in the right byte order or
+// convert them using a temporary buffer and write them in chunks otherwise
+template <typename T>
+void WriteArray(wxOutputStream *output, const void *buffer, size_t size,
+                bool be_order)
+{
+    if ( !NeedsSwap(be_order) )
+    {
+        output->Write(buffer, size * sizeof(T));
+        return;
+    }
+
+    unsigned char buf[4096];
+    const size_t chunkSize = sizeof(buf) / sizeof(T);
+
+    const unsigned char *p = static_cast<const unsigned char *>(buffer);
+    while ( size )
+    {
+        const size_t n = wxMin(size, chunkSize);
+        const size_t bytes = n * sizeof(T);
+
+        memcpy(buf, p, bytes);
+        SwapBytes<T>(buf, n);
+
+        if ( output->Write(buf, bytes).LastWrite() != bytes )
+            break;
+
+        p += bytes;
+        size -= n;
+    }
+}
+
+#if wxUSE_APPLE_IEEE
+
+// the number of values in extended precision format converted at once
+const size_t EXTENDED_CHUNK_SIZE = 256;
+
+#endif // wxUSE_APPLE_IEEE
+
 } // anonymous namespace
 
 // ----------------------------------------------------------------------------
@@ -264,66 +342,14 @@ static void DoWriteLL(const T *buffer, size_t size, wxOutputStream *output, bool
     delete[] pchBuffer;
 }
 
-template <class T>
-static
-void DoReadI64(T *buffer, size_t size, wxInputStream *input, bool be_order)
-{
-    typedef T DataType;
-    unsigned char *pchBuffer = (unsigned char*) buffer;
-    // TODO: Check for overflow when size is of type uint and is > than 512m
-    input->Read(pchBuffer, size * 8);
-    if ( be_order )
-    {
-        for ( wxUint32 i = 0; i < size; i++ )
-        {
-            DataType v = wxUINT64_SWAP_ON_LE(*buffer);
-            *(buffer++) = v;
-        }
-    }
-    else // little endian
-    {
-        for ( wxUint32 i=0; i<size; i++ )
-        {
-            DataType v = wxUINT64_SWAP_ON_BE(*buffer);
-            *(buffer++) = v;
-        }
-    }
-}
-
-template <class T>
-static
-void DoWriteI64(const T *buffer, size_t size, wxOutputStream *output, bool be_order)
-{
-  typedef T DataType;
-  if ( be_order )
-  {
-    for ( size_t i = 0; i < size; i++ )
-    {
-      DataType i64 = wxUINT64_SWAP_ON_LE(*buffer);
-      buffer++;
-      output->Write(&i64, 8);
-    }
-  }
-  else // little endian
-  {
-    for ( size_t i=0; i < size; i++ )
-    {
-      DataType i64 = wxUINT64_SWAP_ON_BE(*buffer);
-      buffer++;
-      output->Write(&i64, 8);
-    }
-  }
-}
-
-
 void wxDataInputStream::Read64(wxUint64 *buffer, size_t size)
 {
-    DoReadI64(buffer, size, m_input, m_be_order);
+    ReadArray<wxUint64>(m_input, buffer, size, m_be_order);
 }
 
 void wxDataInputStream::Read64(wxInt64 *buffer, size_t size)
 {
-    DoReadI64(buffer, size, m_input, m_be_order);
+    ReadArray<wxUint64>(m_input, buffer, size, m_be_order);
 }
 
 void wxDataInputStream::Read64(wxULongLong *buffer, size_t size)
@@ -355,46 +381,12 @@ wxLongLong wxDataInputStream::ReadLL(void)
 
 void wxDataInputStream::Read32(wxUint32 *buffer, size_t size)
 {
-    m_input->Read(buffer, size * 4);
-
-    if (m_be_order)
-    {
-        for (wxUint32 i=0; i<size; i++)
-        {
-            wxUint32 v = wxUINT32_SWAP_ON_LE(*buffer);
-            *(buffer++) = v;
-        }
-    }
-    else
-    {
-        for (wxUint32 i=0; i<size; i++)
-        {
-            wxUint32 v = wxUINT32_SWAP_ON_BE(*buffer);
-            *(buffer++) = v;
-        }
-    }
+    ReadArray<wxUint32>(m_input, buffer, size, m_be_order);
 }
 
 void wxDataInputStream::Read16(wxUint16 *buffer, size_t size)
 {
-  m_input->Read(buffer, size * 2);
-
-  if (m_be_order)
-  {
-    for (wxUint32 i=0; i<size; i++)
-    {
-      wxUint16 v = wxUINT16_SWAP_ON_LE(*buffer);
-      *(buffer++) = v;
-    }
-  }
-  else
-  {
-    for (wxUint32 i=0; i<size; i++)
-    {
-      wxUint16 v = wxUINT16_SWAP_ON_BE(*buffer);
-      *(buffer++) = v;
-    }
-  }
+    ReadArray<wxUint16>(m_input, buffer, size, m_be_order);
 }
 
 void wxDataInputStream::Read8(wxUint8 *buffer, size_t size)
@@ -402,20 +394,59 @@ void wxDataInputStream::Read8(wxUint8 *buffer, size_t size)
   m_input->Read(buffer, size);
 }
 
+#if wxUSE_APPLE_IEEE
+
+template <typename T>
+static
+void DoReadExtended(T *buffer, size_t size, wxInputStream *input)
+{
+    wxInt8 buf[10*EXTENDED_CHUNK_SIZE];
+
+    while ( size )
+    {
+        const size_t n = wxMin(size, EXTENDED_CHUNK_SIZE);
+
+        input->Read(buf, n * 10);
+        for ( size_t i = 0; i < n; i++ )
+            *(buffer++) = static_cast<T>(wxConvertFromIeeeExtended(buf + i*10));
+
+        size -= n;
+    }
+}
+
+#endif // wxUSE_APPLE_IEEE
+
 void wxDataInputStream::ReadDouble(double *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    *(buffer++) = ReadDouble();
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        DoReadExtended(buffer, size, m_input);
+        return;
+    }
+#endif // wxUSE_APPLE_IEEE
+
+    // This is the same as what ReadDouble() does, as swapping the order of
+    // both 32 bit halves and of the bytes in each of them is equivalent to
+    // swapping the bytes of the whole 64 bit value.
+    wxCOMPILE_TIME_ASSERT( sizeof(double) == sizeof(wxUint64), BadDoubleSize );
+
+    ReadArray<wxUint64>(m_input, buffer, size, m_be_order);
 }
 
 void wxDataInputStream::ReadFloat(float *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    *(buffer++) = ReadFloat();
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        DoReadExtended(buffer, size, m_input);
+        return;
+    }
+#endif // wxUSE_APPLE_IEEE
+
+    wxCOMPILE_TIME_ASSERT( sizeof(float) == sizeof(wxUint32), BadFloatSize );
+
+    ReadArray<wxUint32>(m_input, buffer, size, m_be_order);
 }
 
 wxDataInputStream& wxDataInputStream::operator>>(wxString& s)
@@ -602,12 +633,12 @@ void wxDataOutputStream::WriteFloat(float f)
 
 void wxDataOutputStream::Write64(const wxUint64 *buffer, size_t size)
 {
-    DoWriteI64(buffer, size, m_output, m_be_order);
+    WriteArray<wxUint64>(m_output, buffer, size, m_be_order);
 }
 
 void wxDataOutputStream::Write64(const wxInt64 *buffer, size_t size)
 {
-    DoWriteI64(buffer, size, m_output, m_be_order);
+    WriteArray<wxUint64>(m_output, buffer, size, m_be_order);
 }
 
 void wxDataOutputStream::Write64(const wxULongLong *buffer, size_t size)
@@ -642,46 +673,12 @@ void wxDataOutputStream::WriteLL(const wxULongLong &ll)
 
 void wxDataOutputStream::Write32(const wxUint32 *buffer, size_t size)
 {
-  if (m_be_order)
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint32 i32 = wxUINT32_SWAP_ON_LE(*buffer);
-      buffer++;
-      m_output->Write(&i32, 4);
-    }
-  }
-  else
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint32 i32 = wxUINT32_SWAP_ON_BE(*buffer);
-      buffer++;
-      m_output->Write(&i32, 4);
-    }
-  }
+    WriteArray<wxUint32>(m_output, buffer, size, m_be_order);
 }
 
 void wxDataOutputStream::Write16(const wxUint16 *buffer, size_t size)
 {
-  if (m_be_order)
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint16 i16 = wxUINT16_SWAP_ON_LE(*buffer);
-      buffer++;
-      m_output->Write(&i16, 2);
-    }
-  }
-  else
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint16 i16 = wxUINT16_SWAP_ON_BE(*buffer);
-      buffer++;
-      m_output->Write(&i16, 2);
-    }
-  }
+    WriteArray<wxUint16>(m_output, buffer, size, m_be_order);
 }
 
 void wxDataOutputStream::Write8(const wxUint8 *buffer, size_t size)
@@ -689,20 +686,55 @@ void wxDataOutputStream::Write8(const wxUint8 *buffer, size_t size)
   m_output->Write(buffer, size);
 }
 
+#if wxUSE_APPLE_IEEE
+
+template <typename T>
+static
+void DoWriteExtended(const T *buffer, size_t size, wxOutputStream *output)
+{
+    wxInt8 buf[10*EXTENDED_CHUNK_SIZE];
+
+    while ( size )
+    {
+        const size_t n = wxMin(size, EXTENDED_CHUNK_SIZE);
+
+        for ( size_t i = 0; i < n; i++ )
+            wxConvertToIeeeExtended(*(buffer++), buf + i*10);
+
+        if ( output->Write(buf, n * 10).LastWrite() != n * 10 )
+            break;
+
+        size -= n;
+    }
+}
+
+#endif // wxUSE_APPLE_IEEE
+
 void wxDataOutputStream::WriteDouble(const double *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    WriteDouble(*(buffer++));
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        DoWriteExtended(buffer, size, m_output);
+        return;
+    }
+#endif // wxUSE_APPLE_IEEE
+
+    // See wxDataInputStream::ReadDouble(double*, size_t).
+    WriteArray<wxUint64>(m_output, buffer, size, m_be_order);
 }
 
 void wxDataOutputStream::WriteFloat(const float *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    WriteFloat(*(buffer++));
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        DoWriteExtended(buffer, size, m_output);
+        return;
+    }
+#endif // wxUSE_APPLE_IEEE
+
+    WriteArray<wxUint32>(m_output, buffer, size, m_be_order);
 }
 
 wxDataOutputStream& wxDataOutputStream::operator<<(const wxString& string)
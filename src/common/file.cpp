@@ -46,6 +46,10 @@
     #include  <unistd.h>
     #include  <time.h>
     #include  <sys/stat.h>
+    #ifdef __UNIX__
+        #include  <sys/uio.h>
+        #include  <limits.h>
+    #endif
     #ifdef __GNUWIN32__
         #include "wx/msw/wrapwin.h"
     #endif
@@ -74,6 +78,7 @@
     #include  "wx/intl.h"
     #include  "wx/log.h"
     #include "wx/crt.h"
+    #include "wx/utils.h"
 #endif // !WX_PRECOMP
 
 #include  "wx/filename.h"
@@ -355,6 +360,64 @@ size_t wxFile::Write(const void *pBuf, size_t nCount)
     return iRc;
 }
 
+size_t wxFile::WriteV(const wxIOVec *vec, size_t count)
+{
+    wxCHECK( (vec != nullptr || !count) && IsOpened(), 0 );
+
+    size_t total = 0;
+
+#ifdef __UNIX__
+    // writev() can only write a limited number of buffers at once, so write
+    // them in batches of reasonable size.
+#if defined(IOV_MAX) && IOV_MAX < 64
+    struct iovec iov[IOV_MAX];
+#else
+    struct iovec iov[64];
+#endif
+
+    while ( count )
+    {
+        const size_t n = wxMin(count, WXSIZEOF(iov));
+
+        size_t size = 0;
+        for ( size_t i = 0; i < n; i++ )
+        {
+            iov[i].iov_base = const_cast<void*>(vec[i].data);
+            iov[i].iov_len = vec[i].size;
+            size += vec[i].size;
+        }
+
+        ssize_t iRc = writev(m_fd, iov, n);
+
+        if ( CheckForError(iRc) )
+        {
+            wxLogSysError(_("can't write to file descriptor %d"), m_fd);
+            break;
+        }
+
+        total += iRc;
+
+        // Stop after a partial write, just as Write() does.
+        if ( static_cast<size_t>(iRc) != size )
+            break;
+
+        vec += n;
+        count -= n;
+    }
+#else // !__UNIX__
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const size_t written = Write(vec[n].data, vec[n].size);
+        total += written;
+
+        if ( written != vec[n].size )
+            break;
+    }
+#endif // __UNIX__/!__UNIX__
+
+    return total;
+}
+
 bool wxFile::Write(const wxString& s, const wxMBConv& conv)
 {
     // Writing nothing always succeeds -- and simplifies the check for
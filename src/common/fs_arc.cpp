@@ -20,286 +20,511 @@
 #endif
 
 #include "wx/archive.h"
+#include "wx/module.h"
+#include "wx/mstream.h"
+#include "wx/thread.h"
 #include "wx/private/fileback.h"
 
+#include <list>
+#include <vector>
+
 //---------------------------------------------------------------------------
-// wxArchiveFSCacheDataImpl
+// wxArchiveFSCacheData
 //
 // Holds the catalog of an archive file, and if it is being read from a
 // non-seekable stream, a copy of its backing file.
 //
-// This class is actually the reference counted implementation for the
-// wxArchiveFSCacheData class below. It was done that way to allow sharing
-// between instances of wxFileSystem, though that's a feature not used in this
-// version.
+// The catalog is read completely when the archive is first accessed and is
+// not modified afterwards, so it can be shared between threads. Besides the
+// entries themselves, it contains a hash of their names and, for each
+// directory, the list of its children, so that neither opening a file nor
+// iterating over a directory needs to examine all the entries.
 //---------------------------------------------------------------------------
 
-using wxArchiveFSEntryHash =
-    std::unordered_map<wxString, std::unique_ptr<wxArchiveEntry>>;
-
-struct wxArchiveFSEntry
+struct wxArchiveFSDirEntry
 {
-    wxArchiveEntry *entry;
-    wxArchiveFSEntry *next;
+    wxString name;
+    bool isDir;
 };
 
-class wxArchiveFSCacheDataImpl
+using wxArchiveFSDirEntries = std::vector<wxArchiveFSDirEntry>;
+
+class wxArchiveFSCacheData
 {
 public:
-    wxArchiveFSCacheDataImpl(const wxArchiveClassFactory& factory,
-                             const wxBackingFile& backer);
-    wxArchiveFSCacheDataImpl(const wxArchiveClassFactory& factory,
-                             wxInputStream *stream);
+    wxArchiveFSCacheData(const wxArchiveClassFactory& factory,
+                         const wxBackingFile& backer);
+    wxArchiveFSCacheData(const wxArchiveClassFactory& factory,
+                         wxInputStream *stream);
 
-    ~wxArchiveFSCacheDataImpl();
+    size_t GetCount() const { return m_entries.size(); }
 
-    void Release() { if (--m_refcount == 0) delete this; }
-    wxArchiveFSCacheDataImpl *AddRef() { m_refcount++; return this; }
+    const wxArchiveEntry *Get(const wxString& name) const;
+    const wxArchiveFSDirEntries *GetDir(const wxString& dir) const;
 
-    wxArchiveEntry *Get(const wxString& name);
-    wxInputStream *NewStream() const;
+    // Opens the given entry of the archive whose location is "left",
+    // returns nullptr on failure.
+    wxArchiveInputStream *OpenEntry(const wxArchiveEntry& entry,
+                                    const wxString& left);
 
-    wxArchiveFSEntry *GetNext(wxArchiveFSEntry *fse);
+    // Reads the whole contents of the given entry, returns false on failure.
+    bool ReadEntry(const wxArchiveEntry& entry,
+                   const wxString& left,
+                   wxMemoryBuffer& buf);
 
 private:
-    // Takes ownership of "entry".
-    wxArchiveFSEntry *AddToCache(wxArchiveEntry *entry);
-    void CloseStreams();
+    void Load(wxInputStream *stream);
+    void AddDir(const wxString& dir);
 
-    int m_refcount;
+    const wxArchiveClassFactory& m_factory;
 
-    wxArchiveFSEntryHash m_hash;
-    wxArchiveFSEntry *m_begin;
-    wxArchiveFSEntry **m_endptr;
+    std::vector<std::unique_ptr<wxArchiveEntry>> m_entries;
+    std::unordered_map<wxString, wxArchiveEntry*> m_hash;
+    std::unordered_map<wxString, wxArchiveFSDirEntries> m_dirs;
 
+    // The backing file can't be read by several threads at once, so all the
+    // streams reading from it use this lock, which is shared with them as
+    // they can outlive this object.
     wxBackingFile m_backer;
-    wxInputStream *m_stream;
-    wxArchiveInputStream *m_archive;
+    std::shared_ptr<wxCriticalSection> m_backerLock;
+
+    wxDECLARE_NO_COPY_CLASS(wxArchiveFSCacheData);
+};
+
+//---------------------------------------------------------------------------
+// wxArchiveFSBackedStream
+//
+// Reads from the backing file of an archive while holding its lock.
+//---------------------------------------------------------------------------
+
+class wxArchiveFSBackedStream : public wxBackedInputStream
+{
+public:
+    wxArchiveFSBackedStream(const wxBackingFile& backer,
+                            const std::shared_ptr<wxCriticalSection>& lock)
+     :  wxBackedInputStream(backer),
+        m_lock(lock)
+    {
+    }
+
+    wxFileOffset GetLength() const override
+    {
+        wxCriticalSectionLocker lock(*m_lock);
+        return wxBackedInputStream::GetLength();
+    }
+
+protected:
+    size_t OnSysRead(void *buffer, size_t size) override
+    {
+        wxCriticalSectionLocker lock(*m_lock);
+        return wxBackedInputStream::OnSysRead(buffer, size);
+    }
+
+private:
+    const std::shared_ptr<wxCriticalSection> m_lock;
+
+    wxDECLARE_NO_COPY_CLASS(wxArchiveFSBackedStream);
 };
 
-wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
+wxArchiveFSCacheData::wxArchiveFSCacheData(
         const wxArchiveClassFactory& factory,
         const wxBackingFile& backer)
- :  m_refcount(1),
-    m_begin(nullptr),
-    m_endptr(&m_begin),
+ :  m_factory(factory),
     m_backer(backer),
-    m_stream(new wxBackedInputStream(backer)),
-    m_archive(factory.NewStream(*m_stream))
+    m_backerLock(std::make_shared<wxCriticalSection>())
 {
+    Load(new wxBackedInputStream(backer));
 }
 
-wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
+wxArchiveFSCacheData::wxArchiveFSCacheData(
         const wxArchiveClassFactory& factory,
         wxInputStream *stream)
- :  m_refcount(1),
-    m_begin(nullptr),
-    m_endptr(&m_begin),
-    m_stream(stream),
-    m_archive(factory.NewStream(*m_stream))
+ :  m_factory(factory)
 {
+    Load(stream);
 }
 
-wxArchiveFSCacheDataImpl::~wxArchiveFSCacheDataImpl()
+void wxArchiveFSCacheData::Load(wxInputStream *stream)
 {
-    wxArchiveFSEntry *entry = m_begin;
+    std::unique_ptr<wxArchiveInputStream> archive(m_factory.NewStream(stream));
+    if (!archive)
+        return;
+
+    wxArchiveEntry *entry;
 
-    while (entry)
+    while ((entry = archive->GetNextEntry()) != nullptr)
     {
-        wxArchiveFSEntry *next = entry->next;
-        delete entry;
-        entry = next;
-    }
+        m_entries.push_back(std::unique_ptr<wxArchiveEntry>(entry));
 
-    CloseStreams();
-}
+        const wxString name = entry->GetName(wxPATH_UNIX);
+        if (name.empty())
+            continue;
 
-wxArchiveFSEntry *wxArchiveFSCacheDataImpl::AddToCache(wxArchiveEntry *entry)
-{
-    m_hash[entry->GetName(wxPATH_UNIX)] = std::unique_ptr<wxArchiveEntry>(entry);
-    wxArchiveFSEntry *fse = new wxArchiveFSEntry;
-    *m_endptr = fse;
-    (*m_endptr)->entry = entry;
-    (*m_endptr)->next = nullptr;
-    m_endptr = &(*m_endptr)->next;
-    return fse;
-}
+        if (entry->IsDir())
+        {
+            // Allow opening explicit directory entries as before, even if
+            // this is not very useful.
+            m_hash.emplace(name, entry);
+            AddDir(name);
+            continue;
+        }
 
-void wxArchiveFSCacheDataImpl::CloseStreams()
-{
-    wxDELETE(m_archive);
-    wxDELETE(m_stream);
+        // A later entry with the same name replaces the earlier one, but is
+        // only listed once.
+        wxArchiveEntry*& hashed = m_hash[name];
+        const bool isNew = hashed == nullptr;
+        hashed = entry;
+
+        if (isNew)
+        {
+            const wxString dir = name.BeforeLast(wxT('/'));
+            AddDir(dir);
+            m_dirs[dir].push_back({ name.AfterLast(wxT('/')), false });
+        }
+    }
 }
 
-wxArchiveEntry *wxArchiveFSCacheDataImpl::Get(const wxString& name)
+void wxArchiveFSCacheData::AddDir(const wxString& dir)
 {
-    const auto it = m_hash.find(name);
-
-    if (it != m_hash.end())
-        return it->second.get();
+    // Directories may be present in the archive explicitly or only implied
+    // by the names of the files in them, but are listed only once in either
+    // case, before any of their contents.
+    if (dir.empty() || m_dirs.find(dir) != m_dirs.end())
+        return;
 
-    if (!m_archive)
-        return nullptr;
+    const wxString parent = dir.BeforeLast(wxT('/'));
+    AddDir(parent);
 
-    wxArchiveEntry *entry;
+    m_dirs[parent].push_back({ dir.AfterLast(wxT('/')), true });
+    m_dirs[dir];
+}
 
-    while ((entry = m_archive->GetNextEntry()) != nullptr)
-    {
-        AddToCache(entry);
+const wxArchiveEntry *wxArchiveFSCacheData::Get(const wxString& name) const
+{
+    const auto it = m_hash.find(name);
 
-        if (entry->GetName(wxPATH_UNIX) == name)
-            return entry;
-    }
+    return it != m_hash.end() ? it->second : nullptr;
+}
 
-    CloseStreams();
+const wxArchiveFSDirEntries *
+wxArchiveFSCacheData::GetDir(const wxString& dir) const
+{
+    const auto it = m_dirs.find(dir);
 
-    return nullptr;
+    return it != m_dirs.end() ? &it->second : nullptr;
 }
 
-wxInputStream* wxArchiveFSCacheDataImpl::NewStream() const
+wxArchiveInputStream *wxArchiveFSCacheData::OpenEntry(
+        const wxArchiveEntry& entry,
+        const wxString& left)
 {
+    wxInputStream *stream;
+
     if (m_backer)
-        return new wxBackedInputStream(m_backer);
+    {
+        stream = new wxArchiveFSBackedStream(m_backer, m_backerLock);
+    }
     else
+    {
+        // Don't use the handler's file system object, as this can be called
+        // from any thread.
+        wxFileSystem fs;
+        wxFSFile *leftFile = fs.OpenFile(left);
+        if (!leftFile)
+            return nullptr;
+        stream = leftFile->DetachStream();
+        delete leftFile;
+    }
+
+    std::unique_ptr<wxArchiveInputStream> s(m_factory.NewStream(stream));
+    if (!s)
+        return nullptr;
+
+    // The cached entry is shared, so open a copy of it.
+    std::unique_ptr<wxArchiveEntry> copy(entry.Clone());
+    if (!s->OpenEntry(*copy) || !s->IsOk())
         return nullptr;
+
+    return s.release();
 }
 
-wxArchiveFSEntry *wxArchiveFSCacheDataImpl::GetNext(wxArchiveFSEntry *fse)
+bool wxArchiveFSCacheData::ReadEntry(
+        const wxArchiveEntry& entry,
+        const wxString& left,
+        wxMemoryBuffer& buf)
 {
-    wxArchiveFSEntry *next = fse ? fse->next : m_begin;
+    std::unique_ptr<wxArchiveInputStream> s(OpenEntry(entry, left));
+    if (!s)
+        return false;
+
+    const wxFileOffset size = entry.GetSize();
+    if (size != wxInvalidOffset)
+        buf.SetBufSize(size + 1);
 
-    if (!next && m_archive)
+    for (;;)
     {
-        wxArchiveEntry *entry = m_archive->GetNextEntry();
+        const size_t avail = buf.GetBufSize() - buf.GetDataLen();
+        void *p = buf.GetAppendBuf(avail > 0 ? avail : 0x4000);
 
-        if (entry)
-            next = AddToCache(entry);
-        else
-            CloseStreams();
+        s->Read(p, buf.GetBufSize() - buf.GetDataLen());
+        buf.UngetAppendBuf(s->LastRead());
+
+        if (!s->IsOk())
+            break;
     }
 
-    return next;
+    return s->Eof();
 }
 
 //---------------------------------------------------------------------------
-// wxArchiveFSCacheData
+// wxArchiveFSCache
 //
-// This is the interface for wxArchiveFSCacheDataImpl above. Holds the catalog
-// of an archive file, and if it is being read from a non-seekable stream, a
-// copy of its backing file.
+// wxArchiveFSCacheData caches a single archive, and this class holds a
+// collection of them to cache all the archives accessed by any instance of
+// wxFileSystem, as well as the contents of the recently opened small files.
+//
+// There is a single global instance of this class which is used from all
+// threads, so all its public methods lock it.
 //---------------------------------------------------------------------------
 
-class wxArchiveFSCacheData
+using wxArchiveFSContent = std::shared_ptr<const wxMemoryBuffer>;
+
+// Memory input stream keeping the shared contents it reads from alive.
+class wxArchiveFSContentStream : public wxMemoryInputStream
 {
 public:
-    wxArchiveFSCacheData() : m_impl(nullptr) { }
-    wxArchiveFSCacheData(const wxArchiveClassFactory& factory,
-                         const wxBackingFile& backer);
-    wxArchiveFSCacheData(const wxArchiveClassFactory& factory,
-                         wxInputStream *stream);
+    explicit wxArchiveFSContentStream(const wxArchiveFSContent& content)
+        : wxMemoryInputStream(content->GetData(), content->GetDataLen()),
+          m_content(content)
+    {
+    }
 
-    wxArchiveFSCacheData(const wxArchiveFSCacheData& data);
-    wxArchiveFSCacheData& operator=(const wxArchiveFSCacheData& data);
+private:
+    const wxArchiveFSContent m_content;
 
-    ~wxArchiveFSCacheData() { if (m_impl) m_impl->Release(); }
+    wxDECLARE_NO_COPY_CLASS(wxArchiveFSContentStream);
+};
 
-    wxArchiveEntry *Get(const wxString& name) { return m_impl->Get(name); }
-    wxInputStream *NewStream() const { return m_impl->NewStream(); }
-    wxArchiveFSEntry *GetNext(wxArchiveFSEntry *fse)
-        { return m_impl->GetNext(fse); }
+class wxArchiveFSCache
+{
+public:
+    // By default, use a few megabytes for the contents.
+    wxArchiveFSCache() : m_maxSize(4*1024*1024) { }
+
+    static wxArchiveFSCache& Instance();
+
+    std::shared_ptr<wxArchiveFSCacheData> Get(const wxString& name);
+    std::shared_ptr<wxArchiveFSCacheData> Add(const wxString& name,
+                                              const wxArchiveClassFactory& factory,
+                                              wxInputStream *stream);
+
+    const wxArchiveEntry *GetEntry(const wxArchiveFSCacheData& data,
+                                   const wxString& name);
+
+    // Returns the contents of the file with the given location or nullptr
+    // if it's not cached.
+    wxArchiveFSContent GetContent(const wxString& location);
+    void AddContent(const wxString& location, const wxArchiveFSContent& content);
+
+    // Only files using at most a quarter of the cache are kept in it, as
+    // caching bigger ones would evict too many others.
+    bool CanCache(wxFileOffset size);
+
+    void SetMaxSize(size_t size);
+    size_t GetMaxSize();
+    wxArchiveFSCacheStats GetStats();
+    void Clear();
 
 private:
-    wxArchiveFSCacheDataImpl *m_impl;
+    // Must be called with the lock held.
+    void Evict(size_t maxSize);
+
+    struct Content
+    {
+        wxArchiveFSContent data;
+        std::list<wxString>::iterator lru;
+    };
+
+    wxCriticalSection m_lock;
+
+    std::unordered_map<wxString, std::shared_ptr<wxArchiveFSCacheData>> m_archives;
+
+    // The most recently used contents are at the front of the list.
+    std::unordered_map<wxString, Content> m_contents;
+    std::list<wxString> m_lru;
+
+    size_t m_maxSize;
+    wxArchiveFSCacheStats m_stats;
+
+    wxDECLARE_NO_COPY_CLASS(wxArchiveFSCache);
 };
 
-wxArchiveFSCacheData::wxArchiveFSCacheData(
-        const wxArchiveClassFactory& factory,
-        const wxBackingFile& backer)
-  : m_impl(new wxArchiveFSCacheDataImpl(factory, backer))
+wxArchiveFSCache& wxArchiveFSCache::Instance()
 {
+    static wxArchiveFSCache s_cache;
+
+    return s_cache;
 }
 
-wxArchiveFSCacheData::wxArchiveFSCacheData(
+std::shared_ptr<wxArchiveFSCacheData> wxArchiveFSCache::Get(const wxString& name)
+{
+    wxCriticalSectionLocker lock(m_lock);
+
+    const auto it = m_archives.find(name);
+
+    if (it != m_archives.end())
+        return it->second;
+
+    return nullptr;
+}
+
+std::shared_ptr<wxArchiveFSCacheData> wxArchiveFSCache::Add(
+        const wxString& name,
         const wxArchiveClassFactory& factory,
         wxInputStream *stream)
-  : m_impl(new wxArchiveFSCacheDataImpl(factory, stream))
 {
+    // Read the catalog without holding the lock, as this may take a while.
+    std::shared_ptr<wxArchiveFSCacheData> data;
+
+    if (stream->IsSeekable())
+        data = std::make_shared<wxArchiveFSCacheData>(factory, stream);
+    else
+        data = std::make_shared<wxArchiveFSCacheData>(factory, wxBackingFile(stream));
+
+    wxCriticalSectionLocker lock(m_lock);
+
+    // If another thread has added the same archive meanwhile, use it.
+    const auto res = m_archives.emplace(name, data);
+    if (res.second)
+    {
+        m_stats.archives++;
+        m_stats.entries += data->GetCount();
+    }
+
+    return res.first->second;
 }
 
-wxArchiveFSCacheData::wxArchiveFSCacheData(const wxArchiveFSCacheData& data)
-  : m_impl(data.m_impl ? data.m_impl->AddRef() : nullptr)
+const wxArchiveEntry *wxArchiveFSCache::GetEntry(
+        const wxArchiveFSCacheData& data,
+        const wxString& name)
 {
+    const wxArchiveEntry *entry = data.Get(name);
+
+    wxCriticalSectionLocker lock(m_lock);
+
+    m_stats.lookups++;
+    if (!entry)
+        m_stats.lookupFailures++;
+
+    return entry;
 }
 
-wxArchiveFSCacheData& wxArchiveFSCacheData::operator=(
-        const wxArchiveFSCacheData& data)
+wxArchiveFSContent wxArchiveFSCache::GetContent(const wxString& location)
 {
-    if (data.m_impl != m_impl)
-    {
-        if (m_impl)
-            m_impl->Release();
+    wxCriticalSectionLocker lock(m_lock);
 
-        m_impl = data.m_impl;
+    const auto it = m_contents.find(location);
 
-        if (m_impl)
-            m_impl->AddRef();
+    if (it == m_contents.end())
+    {
+        m_stats.misses++;
+        return nullptr;
     }
 
-    return *this;
+    m_stats.hits++;
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+
+    return it->second.data;
 }
 
-//---------------------------------------------------------------------------
-// wxArchiveFSCache
-//
-// wxArchiveFSCacheData caches a single archive, and this class holds a
-// collection of them to cache all the archives accessed by this instance
-// of wxFileSystem.
-//---------------------------------------------------------------------------
+void wxArchiveFSCache::AddContent(const wxString& location,
+                                  const wxArchiveFSContent& content)
+{
+    wxCriticalSectionLocker lock(m_lock);
 
-using wxArchiveFSCacheDataHash =
-    std::unordered_map<wxString, wxArchiveFSCacheData>;
+    const size_t size = content->GetDataLen();
+    if (size > m_maxSize / 4 || m_contents.count(location))
+        return;
 
-class wxArchiveFSCache
+    Evict(m_maxSize - size);
+
+    m_lru.push_front(location);
+    m_contents[location] = { content, m_lru.begin() };
+
+    m_stats.cachedFiles++;
+    m_stats.cachedBytes += size;
+}
+
+bool wxArchiveFSCache::CanCache(wxFileOffset size)
 {
-public:
-    wxArchiveFSCache() { }
-    ~wxArchiveFSCache() { }
+    wxCriticalSectionLocker lock(m_lock);
 
-    wxArchiveFSCacheData* Add(const wxString& name,
-                              const wxArchiveClassFactory& factory,
-                              wxInputStream *stream);
+    return size != wxInvalidOffset && size_t(size) <= m_maxSize / 4;
+}
 
-    wxArchiveFSCacheData *Get(const wxString& name);
+void wxArchiveFSCache::Evict(size_t maxSize)
+{
+    while (m_stats.cachedBytes > maxSize)
+    {
+        const auto it = m_contents.find(m_lru.back());
 
-private:
-    wxArchiveFSCacheDataHash m_hash;
-};
+        m_stats.cachedFiles--;
+        m_stats.cachedBytes -= it->second.data->GetDataLen();
+        m_stats.evictions++;
 
-wxArchiveFSCacheData* wxArchiveFSCache::Add(
-        const wxString& name,
-        const wxArchiveClassFactory& factory,
-        wxInputStream *stream)
+        m_contents.erase(it);
+        m_lru.pop_back();
+    }
+}
+
+void wxArchiveFSCache::SetMaxSize(size_t size)
 {
-    wxArchiveFSCacheData& data = m_hash[name];
+    wxCriticalSectionLocker lock(m_lock);
 
-    if (stream->IsSeekable())
-        data = wxArchiveFSCacheData(factory, stream);
-    else
-        data = wxArchiveFSCacheData(factory, wxBackingFile(stream));
+    m_maxSize = size;
+    Evict(m_maxSize);
+}
+
+size_t wxArchiveFSCache::GetMaxSize()
+{
+    wxCriticalSectionLocker lock(m_lock);
 
-    return &data;
+    return m_maxSize;
 }
 
-wxArchiveFSCacheData *wxArchiveFSCache::Get(const wxString& name)
+wxArchiveFSCacheStats wxArchiveFSCache::GetStats()
 {
-    const auto it = m_hash.find(name);
+    wxCriticalSectionLocker lock(m_lock);
 
-    if (it != m_hash.end())
-        return &it->second;
+    return m_stats;
+}
 
-    return nullptr;
+void wxArchiveFSCache::Clear()
+{
+    wxCriticalSectionLocker lock(m_lock);
+
+    m_archives.clear();
+    m_contents.clear();
+    m_lru.clear();
+    m_stats = wxArchiveFSCacheStats();
 }
 
+//---------------------------------------------------------------------------
+// wxArchiveFSModule: frees the cache on exit
+//---------------------------------------------------------------------------
+
+class wxArchiveFSModule : public wxModule
+{
+public:
+    virtual bool OnInit() override { return true; }
+    virtual void OnExit() override { wxArchiveFSCache::Instance().Clear(); }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxArchiveFSModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxArchiveFSModule, wxModule);
+
 //----------------------------------------------------------------------------
 // wxArchiveFSHandler
 //----------------------------------------------------------------------------
@@ -309,22 +534,42 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxArchiveFSHandler, wxFileSystemHandler);
 wxArchiveFSHandler::wxArchiveFSHandler()
  :  wxFileSystemHandler()
 {
-    m_Archive = nullptr;
-    m_FindEntry = nullptr;
+    m_FindIndex = 0;
     m_AllowDirs = m_AllowFiles = true;
-    m_DirsFound = nullptr;
-    m_cache = nullptr;
 }
 
 wxArchiveFSHandler::~wxArchiveFSHandler()
 {
     Cleanup();
-    delete m_cache;
 }
 
 void wxArchiveFSHandler::Cleanup()
 {
-    wxDELETE(m_DirsFound);
+    m_Archive.reset();
+}
+
+/* static */
+void wxArchiveFSHandler::SetCacheMaxSize(size_t size)
+{
+    wxArchiveFSCache::Instance().SetMaxSize(size);
+}
+
+/* static */
+size_t wxArchiveFSHandler::GetCacheMaxSize()
+{
+    return wxArchiveFSCache::Instance().GetMaxSize();
+}
+
+/* static */
+wxArchiveFSCacheStats wxArchiveFSHandler::GetCacheStats()
+{
+    return wxArchiveFSCache::Instance().GetStats();
+}
+
+/* static */
+void wxArchiveFSHandler::ClearCache()
+{
+    wxArchiveFSCache::Instance().Clear();
 }
 
 bool wxArchiveFSHandler::CanOpen(const wxString& location)
@@ -333,6 +578,28 @@ bool wxArchiveFSHandler::CanOpen(const wxString& location)
     return wxArchiveClassFactory::Find(p) != nullptr;
 }
 
+// Returns the cached catalog of the archive, reading it if necessary.
+static std::shared_ptr<wxArchiveFSCacheData>
+wxGetArchiveFSCacheData(const wxString& key,
+                        const wxString& left,
+                        const wxArchiveClassFactory& factory)
+{
+    wxArchiveFSCache& cache = wxArchiveFSCache::Instance();
+
+    std::shared_ptr<wxArchiveFSCacheData> cached = cache.Get(key);
+    if (!cached)
+    {
+        wxFileSystem fs;
+        wxFSFile *leftFile = fs.OpenFile(left);
+        if (!leftFile)
+            return nullptr;
+        cached = cache.Add(key, factory, leftFile->DetachStream());
+        delete leftFile;
+    }
+
+    return cached;
+}
+
 wxFSFile* wxArchiveFSHandler::OpenFile(
         wxFileSystem& WXUNUSED(fs),
         const wxString& location)
@@ -352,52 +619,49 @@ wxFSFile* wxArchiveFSHandler::OpenFile(
 
     if (!right.empty() && right.GetChar(0) == wxT('/')) right = right.Mid(1);
 
-    if (!m_cache)
-        m_cache = new wxArchiveFSCache;
-
     const wxArchiveClassFactory *factory;
     factory = wxArchiveClassFactory::Find(protocol);
     if (!factory)
         return nullptr;
 
-    wxArchiveFSCacheData *cached = m_cache->Get(key);
+    std::shared_ptr<wxArchiveFSCacheData>
+        cached = wxGetArchiveFSCacheData(key, left, *factory);
     if (!cached)
-    {
-        wxFSFile *leftFile = m_fs.OpenFile(left);
-        if (!leftFile)
-            return nullptr;
-        cached = m_cache->Add(key, *factory, leftFile->DetachStream());
-        delete leftFile;
-    }
+        return nullptr;
 
-    wxArchiveEntry *entry = cached->Get(right);
+    wxArchiveFSCache& cache = wxArchiveFSCache::Instance();
+
+    const wxArchiveEntry *entry = cache.GetEntry(*cached, right);
     if (!entry)
         return nullptr;
 
-    wxInputStream *leftStream = cached->NewStream();
-    if (!leftStream)
-    {
-        wxFSFile *leftFile = m_fs.OpenFile(left);
-        if (!leftFile)
-            return nullptr;
-        leftStream = leftFile->DetachStream();
-        delete leftFile;
-    }
+    const wxString name = key + right;
 
-    wxArchiveInputStream *s = factory->NewStream(leftStream);
-    if ( !s )
-        return nullptr;
+    wxInputStream *s;
 
-    s->OpenEntry(*entry);
+    wxArchiveFSContent content = cache.GetContent(name);
+    if (content)
+    {
+        s = new wxArchiveFSContentStream(content);
+    }
+    else if (cache.CanCache(entry->GetSize()))
+    {
+        std::shared_ptr<wxMemoryBuffer> buf = std::make_shared<wxMemoryBuffer>();
+        if (!cached->ReadEntry(*entry, left, *buf))
+            return nullptr;
 
-    if (!s->IsOk())
+        cache.AddContent(name, buf);
+        s = new wxArchiveFSContentStream(buf);
+    }
+    else
     {
-        delete s;
-        return nullptr;
+        s = cached->OpenEntry(*entry, left);
+        if (!s)
+            return nullptr;
     }
 
     return new wxFSFile(s,
-                        key + right,
+                        name,
                         wxEmptyString,
                         GetAnchor(location)
 #if wxUSE_DATETIME
@@ -415,25 +679,13 @@ wxString wxArchiveFSHandler::FindFirst(const wxString& spec, int flags)
 
     if (!right.empty() && right.Last() == wxT('/')) right.RemoveLast();
 
-    if (!m_cache)
-        m_cache = new wxArchiveFSCache;
-
     const wxArchiveClassFactory *factory;
     factory = wxArchiveClassFactory::Find(protocol);
     if (!factory)
         return wxEmptyString;
 
-    m_Archive = m_cache->Get(key);
-    if (!m_Archive)
-    {
-        wxFSFile *leftFile = m_fs.OpenFile(left);
-        if (!leftFile)
-            return wxEmptyString;
-        m_Archive = m_cache->Add(key, *factory, leftFile->DetachStream());
-        delete leftFile;
-    }
-
-    m_FindEntry = nullptr;
+    m_Archive = wxGetArchiveFSCacheData(key, left, *factory);
+    m_FindIndex = 0;
 
     switch (flags)
     {
@@ -454,13 +706,8 @@ wxString wxArchiveFSHandler::FindFirst(const wxString& spec, int flags)
 
     if (m_Archive)
     {
-        if (m_AllowDirs)
-        {
-            delete m_DirsFound;
-            m_DirsFound = new wxArchiveFilenameHashMap();
-            if (right.empty())  // allow "/" to match the archive root
-                return spec;
-        }
+        if (m_AllowDirs && right.empty())  // allow "/" to match the archive root
+            return spec;
         return DoFind();
     }
     return wxEmptyString;
@@ -474,48 +721,29 @@ wxString wxArchiveFSHandler::FindNext()
 
 wxString wxArchiveFSHandler::DoFind()
 {
-    wxString namestr, dir, filename;
-    wxString match;
+    // Only the children of the base directory need to be examined.
+    const wxArchiveFSDirEntries *children = m_Archive->GetDir(m_BaseDir);
 
-    while (match.empty())
+    while (children && m_FindIndex < children->size())
     {
-        m_FindEntry = m_Archive->GetNext(m_FindEntry);
-
-        if (!m_FindEntry)
-        {
-            m_Archive = nullptr;
-            m_FindEntry = nullptr;
-            break;
-        }
-        namestr = m_FindEntry->entry->GetName(wxPATH_UNIX);
+        const wxArchiveFSDirEntry& child = (*children)[m_FindIndex++];
 
-        if (m_AllowDirs)
-        {
-            dir = namestr.BeforeLast(wxT('/'));
-            while (!dir.empty())
-            {
-                if( m_DirsFound->find(dir) == m_DirsFound->end() )
-                {
-                    (*m_DirsFound)[dir] = 1;
-                    filename = dir.AfterLast(wxT('/'));
-                    dir = dir.BeforeLast(wxT('/'));
-                    if (!filename.empty() && m_BaseDir == dir &&
-                                wxMatchWild(m_Pattern, filename, false))
-                        match = m_ZipFile + dir + wxT("/") + filename;
-                }
-                else
-                    break; // already transversed
-            }
-        }
+        if (!(child.isDir ? m_AllowDirs : m_AllowFiles) ||
+                !wxMatchWild(m_Pattern, child.name, false))
+            continue;
 
-        filename = namestr.AfterLast(wxT('/'));
-        dir = namestr.BeforeLast(wxT('/'));
-        if (m_AllowFiles && !filename.empty() && m_BaseDir == dir &&
-                            wxMatchWild(m_Pattern, filename, false))
-            match = m_ZipFile + namestr;
+        if (child.isDir)
+            return m_ZipFile + m_BaseDir + wxT("/") + child.name;
+        else if (m_BaseDir.empty())
+            return m_ZipFile + child.name;
+        else
+            return m_ZipFile + m_BaseDir + wxT("/") + child.name;
     }
 
-    return match;
+    m_Archive.reset();
+    m_FindIndex = 0;
+
+    return wxEmptyString;
 }
 
 #endif // wxUSE_FS_ARCHIVE
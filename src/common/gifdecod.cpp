@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "wx/gifdecod.h"
+#include "wx/mstream.h"
 #include "wx/scopedarray.h"
 #include "wx/scopeguard.h"
 
@@ -58,7 +59,9 @@ public:
     int transparent;                // transparent color index (-1 = none)
     wxAnimationDisposal disposal;   // disposal method
     long delay;                     // delay in ms (-1 = unused)
-    unsigned char *p;               // bitmap
+    int interlaced;                 // 1 if the image is interlaced
+    int bits;                       // initial LZW code size
+    wxMemoryBuffer data;            // compressed raster data blocks
     unsigned char *pal;             // palette
     unsigned int ncolours;          // number of colours
     wxString comment;
@@ -78,7 +81,8 @@ GIFImage::GIFImage()
     transparent = 0;
     disposal = wxANIM_DONOTREMOVE;
     delay = -1;
-    p = (unsigned char *) nullptr;
+    interlaced = 0;
+    bits = 0;
     pal = (unsigned char *) nullptr;
     ncolours = 0;
 }
@@ -89,6 +93,9 @@ GIFImage::GIFImage()
 
 wxGIFDecoder::wxGIFDecoder()
 {
+    m_rawData = nullptr;
+    m_data = nullptr;
+    m_dataFrame = 0;
 }
 
 wxGIFDecoder::~wxGIFDecoder()
@@ -102,11 +109,14 @@ void wxGIFDecoder::Destroy()
     for (unsigned int i=0; i<m_nFrames; i++)
     {
         GIFImage *f = (GIFImage*)m_frames[i];
-        free(f->p);
         free(f->pal);
         delete f;
     }
 
+    free(m_data);
+    m_data = nullptr;
+    m_dataFrame = 0;
+
     m_frames.Clear();
     m_nFrames = 0;
 }
@@ -137,8 +147,23 @@ bool wxGIFDecoder::ConvertToImage(unsigned int frame, wxImage *image) const
     if (!image->IsOk())
         return false;
 
+    // Don't use GetData() which would keep the decoded frame in memory, the
+    // frames are only stored in compressed form unless explicitly requested.
+    wxScopedArray<unsigned char> decoded;
+    if ( m_data && m_dataFrame == frame )
+    {
+        src = m_data;
+    }
+    else
+    {
+        decoded.reset(new unsigned char[sz.GetWidth() * sz.GetHeight()]);
+        if ( DecodeFrame(frame, decoded.get()) != wxGIF_OK )
+            return false;
+
+        src = decoded.get();
+    }
+
     pal = GetPalette(frame);
-    src = GetData(frame);
     dst = image->GetData();
     transparent = GetTransparentColourIndex(frame);
 
@@ -270,7 +295,34 @@ wxColour wxGIFDecoder::GetTransparentColour(unsigned int frame) const
                     pal[n*3 + 2]);
 }
 
-unsigned char* wxGIFDecoder::GetData(unsigned int frame) const    { return (GetFrame(frame)->p); }
+unsigned char* wxGIFDecoder::GetData(unsigned int frame) const
+{
+    if ( m_data && m_dataFrame == frame )
+        return m_data;
+
+    // Only keep the last used frame, which is typically the one the next
+    // frame is composited on, to avoid keeping all frames of a long animation
+    // in memory.
+    free(m_data);
+    m_data = nullptr;
+
+    const GIFImage* const img = GetFrame(frame);
+    unsigned char* const p = (unsigned char *) malloc(img->w * img->h);
+    if ( !p )
+        return nullptr;
+
+    if ( DecodeFrame(frame, p) != wxGIF_OK )
+    {
+        free(p);
+        return nullptr;
+    }
+
+    m_data = p;
+    m_dataFrame = frame;
+
+    return m_data;
+}
+
 unsigned char* wxGIFDecoder::GetPalette(unsigned int frame) const { return (GetFrame(frame)->pal); }
 unsigned int wxGIFDecoder::GetNcolours(unsigned int frame) const  { return (GetFrame(frame)->ncolours); }
 int wxGIFDecoder::GetTransparentColourIndex(unsigned int frame) const  { return (GetFrame(frame)->transparent); }
@@ -281,10 +333,26 @@ int wxGIFDecoder::GetTransparentColourIndex(unsigned int frame) const  { return
 // GIF reading and decoding
 //---------------------------------------------------------------------------
 
+// DecodeFrame:
+//  Decodes the compressed data of the given frame stored by LoadGIF().
+//
+wxGIFErrorCode wxGIFDecoder::DecodeFrame(unsigned int frame, unsigned char *p) const
+{
+    const GIFImage* const img = GetFrame(frame);
+    if ( !img->w || !img->h )
+        return wxGIF_OK;
+
+    // initialize the pixels which could remain unset if the data is truncated
+    memset(p, 0, img->w * img->h);
+
+    wxMemoryInputStream stream(img->data.GetData(), img->data.GetDataLen());
+    return dgif(stream, img, p, img->interlaced, img->bits);
+}
+
 // getcode:
 //  Reads the next code from the file stream, with size 'bits'
 //
-int wxGIFDecoder::getcode(wxInputStream& stream, int bits, int ab_fin)
+int wxGIFDecoder::getcode(wxInputStream& stream, int bits, int ab_fin) const
 {
     unsigned int mask;          // bit mask
     unsigned int code;          // code (result)
@@ -315,6 +383,15 @@ int wxGIFDecoder::getcode(wxInputStream& stream, int bits, int ab_fin)
 
             // prefetch data
             stream.Read((void *) m_buffer, m_restbyte);
+
+            // keep the data to be able to decode it again later, including
+            // the incomplete block, so that it's decoded in the same way
+            if (m_rawData)
+            {
+                m_rawData->AppendByte((char) m_restbyte);
+                m_rawData->AppendData(m_buffer, stream.LastRead());
+            }
+
             if (stream.LastRead() != m_restbyte)
             {
                 code = ab_fin;
@@ -343,10 +420,13 @@ int wxGIFDecoder::getcode(wxInputStream& stream, int bits, int ab_fin)
 // dgif:
 //  GIF decoding function. The initial code size (aka root size)
 //  is 'bits'. Supports interlaced images (interl == 1).
+//  The decoded pixels are stored in 'p' which may be null to just skip
+//  over the image data in the stream.
 //  Returns wxGIF_OK (== 0) on success, or an error code if something
 // fails (see header file for details)
 wxGIFErrorCode
-wxGIFDecoder::dgif(wxInputStream& stream, GIFImage *img, int interl, int bits)
+wxGIFDecoder::dgif(wxInputStream& stream, const GIFImage *img,
+                   unsigned char *p, int interl, int bits) const
 {
     static const int allocSize = 4096 + 1;
 
@@ -469,7 +549,8 @@ wxGIFDecoder::dgif(wxInputStream& stream, GIFImage *img, int interl, int bits)
         // dump stack data to the image buffer
         while (pos >= 0)
         {
-            (img->p)[x + (y * (img->w))] = (char) stack[pos];
+            if (p)
+                p[x + (y * (img->w))] = (unsigned char) stack[pos];
             pos--;
 
             if (++x >= (img->w))
@@ -618,7 +699,6 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
     unsigned int  global_ncolors = 0;
     int           bits, interl, i;
     wxAnimationDisposal disposal;
-    long          size;
     long          delay;
     unsigned char type = 0;
     unsigned char pal[768];
@@ -828,17 +908,16 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
                 }
 
                 interl = ((buf[8] & 0x40)? 1 : 0);
-                size = pimg->w * pimg->h;
 
                 pimg->transparent = transparent;
                 pimg->disposal = disposal;
                 pimg->delay = delay;
 
-                // allocate memory for image and palette
-                pimg->p   = (unsigned char *) malloc((unsigned int)size);
+                // allocate memory for palette, the image itself is only
+                // decoded when it's needed
                 pimg->pal = (unsigned char *) malloc(768);
 
-                if ((!pimg->p) || (!pimg->pal))
+                if (!pimg->pal)
                     return wxGIF_MEMERR;
 
                 // load local color map if available, else use global map
@@ -862,8 +941,20 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
                 if (stream.Eof() || bits <= 0)
                     return wxGIF_INVFORMAT;
 
-                // decode image
-                wxGIFErrorCode result = dgif(stream, pimg.get(), interl, bits);
+                pimg->interlaced = interl;
+                pimg->bits = bits;
+
+                // Run the decoder without storing the pixels to find the end
+                // of the image data: we can't just skip all the data blocks
+                // because some broken encoders produce image data which must
+                // be stopped at the end of the image, see the comment in
+                // dgif(). Only keep the compressed data blocks which are then
+                // decoded again when the frame is really used, this takes
+                // much less memory than keeping the decoded frames.
+                m_rawData = &pimg->data;
+                wxGIFErrorCode result = dgif(stream, pimg.get(), nullptr,
+                                             interl, bits);
+                m_rawData = nullptr;
                 if (result != wxGIF_OK)
                     return result;
 
@@ -0,0 +1,509 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/imagbatch.cpp
+// Purpose:     wxImageBatchLoader implementation
+// Created:     2026-10-16
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+// For compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#if wxUSE_IMAGE && wxUSE_STREAMS
+
+#include "wx/imagbatch.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/arrstr.h"
+    #include "wx/log.h"
+#endif
+
+#include "wx/stream.h"
+
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+wxDEFINE_EVENT(wxEVT_IMAGE_BATCH_LOADED, wxThreadEvent);
+wxDEFINE_EVENT(wxEVT_IMAGE_BATCH_COMPLETED, wxThreadEvent);
+
+// ----------------------------------------------------------------------------
+// wxImageBatchLoaderImpl
+// ----------------------------------------------------------------------------
+
+class wxImageBatchLoaderImpl
+{
+public:
+    // A single image to load.
+    struct Item
+    {
+        wxString filename;
+        std::unique_ptr<wxInputStream> stream;
+        wxBitmapType type = wxBITMAP_TYPE_ANY;
+        int index = -1;
+
+        // The image and the flag are only modified by the thread loading it
+        // and then only read, but still need to be protected by m_cs as the
+        // main thread may read them at any moment.
+        wxImage image;
+        bool loaded = false;
+
+        // Set if loading the image from the stream failed: as the stream is
+        // not available any more, it can't be retried later.
+        bool failed = false;
+    };
+
+    wxImageBatchLoaderImpl() = default;
+
+    ~wxImageBatchLoaderImpl()
+    {
+        Cancel();
+    }
+
+    size_t AddItem(Item* item)
+    {
+        wxCHECK_MSG( IsIdle(), static_cast<size_t>(-1),
+                     wxS("can't add images while loading them") );
+
+        m_items.emplace_back(item);
+        return m_items.size() - 1;
+    }
+
+    bool IsRunning() const
+    {
+        return m_running.load() != 0;
+    }
+
+    // Return false if loading is still in progress, otherwise clean up after
+    // the previous loading, if any, and return true.
+    bool IsIdle()
+    {
+        if ( IsRunning() )
+            return false;
+
+        Wait();
+
+        return true;
+    }
+
+    // Prepare for loading the items, must be called before LoadItems().
+    void Reset(wxEvtHandler* handler)
+    {
+        m_handler = handler;
+        m_next = 0;
+        m_numLoaded = 0;
+        m_cancelled = false;
+    }
+
+    // Start loading the items using the given number of worker threads, Reset()
+    // must have been called before.
+    void Start(int numThreads);
+
+    // Load the items in the calling thread until there are none left.
+    void LoadItems();
+
+    void Cancel()
+    {
+        m_cancelled = true;
+        Wait();
+    }
+
+    bool Wait();
+
+    Item& GetItem(size_t n)
+    {
+        return *m_items[n];
+    }
+
+    int GetThreadsCount() const
+    {
+        int numThreads = m_maxThreads;
+#if wxUSE_THREADS
+        if ( numThreads == 0 )
+            numThreads = wxThread::GetCPUCount();
+#endif // wxUSE_THREADS
+
+        if ( numThreads < 1 )
+            numThreads = 1;
+        if ( static_cast<size_t>(numThreads) > m_items.size() )
+            numThreads = static_cast<int>(m_items.size());
+
+        return numThreads;
+    }
+
+    // Load a single item, return true if it was loaded successfully.
+    bool LoadItem(Item& item);
+
+    // Called by each worker thread when it doesn't have anything more to do
+    // and once by Start() itself.
+    void OnThreadDone();
+
+
+    std::vector<std::unique_ptr<Item>> m_items;
+
+    wxArrayString m_optionNames,
+                  m_optionValues;
+
+    int m_maxThreads = 0;
+
+    // The handler to notify or null if none.
+    wxEvtHandler* m_handler = nullptr;
+
+    // Index of the next item to load.
+    std::atomic<size_t> m_next{0};
+
+    // Number of worker threads still running.
+    std::atomic<int> m_running{0};
+
+    // Number of successfully loaded items.
+    std::atomic<int> m_numLoaded{0};
+
+    std::atomic<bool> m_cancelled{false};
+
+#if wxUSE_THREADS
+    wxCriticalSection m_cs;
+
+    std::vector<wxThread*> m_threads;
+#endif // wxUSE_THREADS
+};
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+class wxImageBatchLoaderThread : public wxThread
+{
+public:
+    explicit wxImageBatchLoaderThread(wxImageBatchLoaderImpl& impl)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_impl(impl)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        m_impl.LoadItems();
+        m_impl.OnThreadDone();
+
+        return nullptr;
+    }
+
+private:
+    wxImageBatchLoaderImpl& m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxImageBatchLoaderThread);
+};
+
+} // anonymous namespace
+
+#endif // wxUSE_THREADS
+
+bool wxImageBatchLoaderImpl::LoadItem(Item& item)
+{
+    // Don't load the same image twice if Load() or Start() are called again,
+    // e.g. after Cancel(): notice that the image can't be loaded again from
+    // the stream anyhow.
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif // wxUSE_THREADS
+
+        if ( item.loaded )
+        {
+            ++m_numLoaded;
+            return true;
+        }
+
+        if ( item.failed )
+            return false;
+    }
+
+    wxImage image;
+    for ( size_t n = 0; n < m_optionNames.size(); n++ )
+        image.SetOption(m_optionNames[n], m_optionValues[n]);
+
+    bool ok;
+    const bool fromStream = item.stream != nullptr;
+    if ( fromStream )
+    {
+        ok = image.LoadFile(*item.stream, item.type, item.index);
+
+        // We don't need the stream any more, so close it as soon as possible.
+        item.stream.reset();
+    }
+    else
+    {
+        ok = image.LoadFile(item.filename, item.type, item.index);
+    }
+
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif // wxUSE_THREADS
+
+        if ( ok )
+            item.image = image;
+        else if ( fromStream )
+            item.failed = true;
+        item.loaded = ok;
+
+        // Reference counting is not thread-safe, so release our reference
+        // while still holding the lock as another thread can be copying the
+        // image in GetImage() right now.
+        image.UnRef();
+    }
+
+    if ( ok )
+        ++m_numLoaded;
+
+    return ok;
+}
+
+void wxImageBatchLoaderImpl::LoadItems()
+{
+    while ( !m_cancelled )
+    {
+        const size_t n = m_next++;
+        if ( n >= m_items.size() )
+            break;
+
+        LoadItem(*m_items[n]);
+
+        if ( m_handler )
+        {
+            wxThreadEvent* const event = new wxThreadEvent(wxEVT_IMAGE_BATCH_LOADED);
+            event->SetInt(static_cast<int>(n));
+            event->SetString(m_items[n]->filename);
+            wxQueueEvent(m_handler, event);
+        }
+    }
+}
+
+void wxImageBatchLoaderImpl::OnThreadDone()
+{
+    // Notify about completion when the last worker thread is done.
+    if ( --m_running == 0 && m_handler )
+    {
+        wxThreadEvent* const event = new wxThreadEvent(wxEVT_IMAGE_BATCH_COMPLETED);
+        event->SetInt(m_numLoaded);
+        wxQueueEvent(m_handler, event);
+    }
+}
+
+void wxImageBatchLoaderImpl::Start(int numThreads)
+{
+    // Account for this thread too to avoid sending the completion event
+    // before all worker threads are created.
+    m_running = 1;
+
+#if wxUSE_THREADS
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        wxThread* const thread = new wxImageBatchLoaderThread(*this);
+
+        ++m_running;
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            --m_running;
+            delete thread;
+
+            wxLogDebug("Failed to create image loading thread.");
+            break;
+        }
+
+        m_threads.push_back(thread);
+    }
+
+    // If we couldn't create any threads at all, do everything right now.
+    if ( m_threads.empty() )
+        LoadItems();
+#else // !wxUSE_THREADS
+    // Without threads, just do everything right now, the events will still
+    // be processed later, as usual.
+    wxUnusedVar(numThreads);
+
+    LoadItems();
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    OnThreadDone();
+}
+
+bool wxImageBatchLoaderImpl::Wait()
+{
+#if wxUSE_THREADS
+    for ( wxThread* thread : m_threads )
+    {
+        thread->Wait();
+        delete thread;
+    }
+
+    m_threads.clear();
+#endif // wxUSE_THREADS
+
+    m_handler = nullptr;
+
+    return static_cast<size_t>(m_numLoaded.load()) == m_items.size();
+}
+
+// ----------------------------------------------------------------------------
+// wxImageBatchLoader
+// ----------------------------------------------------------------------------
+
+wxImageBatchLoader::wxImageBatchLoader()
+    : m_impl(new wxImageBatchLoaderImpl())
+{
+}
+
+wxImageBatchLoader::~wxImageBatchLoader()
+{
+    delete m_impl;
+}
+
+size_t
+wxImageBatchLoader::Add(const wxString& filename, wxBitmapType type, int index)
+{
+    wxImageBatchLoaderImpl::Item* const item = new wxImageBatchLoaderImpl::Item();
+    item->filename = filename;
+    item->type = type;
+    item->index = index;
+
+    return m_impl->AddItem(item);
+}
+
+size_t
+wxImageBatchLoader::Add(wxInputStream* stream, wxBitmapType type, int index)
+{
+    wxCHECK_MSG( stream, static_cast<size_t>(-1), wxS("null stream") );
+
+    wxImageBatchLoaderImpl::Item* const item = new wxImageBatchLoaderImpl::Item();
+    item->stream.reset(stream);
+    item->type = type;
+    item->index = index;
+
+    return m_impl->AddItem(item);
+}
+
+size_t wxImageBatchLoader::GetCount() const
+{
+    return m_impl->m_items.size();
+}
+
+void wxImageBatchLoader::Clear()
+{
+    wxCHECK_RET( m_impl->IsIdle(), wxS("can't clear while loading") );
+
+    m_impl->m_items.clear();
+}
+
+void wxImageBatchLoader::SetOption(const wxString& name, const wxString& value)
+{
+    wxCHECK_RET( !m_impl->IsRunning(), wxS("can't change options while loading") );
+
+    const int idx = m_impl->m_optionNames.Index(name, false);
+    if ( idx == wxNOT_FOUND )
+    {
+        m_impl->m_optionNames.push_back(name);
+        m_impl->m_optionValues.push_back(value);
+    }
+    else
+    {
+        m_impl->m_optionNames[idx] = name;
+        m_impl->m_optionValues[idx] = value;
+    }
+}
+
+void wxImageBatchLoader::SetOption(const wxString& name, int value)
+{
+    SetOption(name, wxString::Format(wxS("%d"), value));
+}
+
+void wxImageBatchLoader::SetMaxThreads(int maxThreads)
+{
+    wxCHECK_RET( maxThreads >= 0, wxS("invalid number of threads") );
+
+    m_impl->m_maxThreads = maxThreads;
+}
+
+int wxImageBatchLoader::GetMaxThreads() const
+{
+    return m_impl->m_maxThreads;
+}
+
+bool wxImageBatchLoader::Load()
+{
+    wxCHECK_MSG( m_impl->IsIdle(), false, wxS("already loading images") );
+
+    m_impl->Reset(nullptr);
+
+    // Use this thread as one of the workers.
+    const int numThreads = m_impl->GetThreadsCount();
+    if ( numThreads > 1 )
+        m_impl->Start(numThreads - 1);
+
+    m_impl->LoadItems();
+
+    return m_impl->Wait();
+}
+
+bool wxImageBatchLoader::Start(wxEvtHandler* handler)
+{
+    wxCHECK_MSG( handler, false, wxS("null event handler") );
+    wxCHECK_MSG( m_impl->IsIdle(), false, wxS("already loading images") );
+
+    m_impl->Reset(handler);
+    m_impl->Start(m_impl->GetThreadsCount());
+
+    return true;
+}
+
+bool wxImageBatchLoader::IsRunning() const
+{
+    return m_impl->IsRunning();
+}
+
+void wxImageBatchLoader::Cancel()
+{
+    m_impl->Cancel();
+}
+
+bool wxImageBatchLoader::Wait()
+{
+    return m_impl->Wait();
+}
+
+bool wxImageBatchLoader::IsLoaded(size_t n) const
+{
+    wxCHECK_MSG( n < m_impl->m_items.size(), false, wxS("invalid index") );
+
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(m_impl->m_cs);
+#endif // wxUSE_THREADS
+
+    return m_impl->GetItem(n).loaded;
+}
+
+wxImage wxImageBatchLoader::GetImage(size_t n) const
+{
+    wxCHECK_MSG( n < m_impl->m_items.size(), wxNullImage, wxS("invalid index") );
+
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(m_impl->m_cs);
+#endif // wxUSE_THREADS
+
+    return m_impl->GetItem(n).image;
+}
+
+wxString wxImageBatchLoader::GetFileName(size_t n) const
+{
+    wxCHECK_MSG( n < m_impl->m_items.size(), wxString(), wxS("invalid index") );
+
+    return m_impl->GetItem(n).filename;
+}
+
+#endif // wxUSE_IMAGE && wxUSE_STREAMS
@@ -26,12 +26,33 @@
 
 #include "wx/wfstream.h"
 #include "wx/xpmdecod.h"
+#include "wx/private/image.h"
+
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif
 
 // For memcpy
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <unordered_set>
 
+// SSE2 is part of the base x86-64 instruction set and so is NEON, including
+// its double precision operations, for AArch64, so we can use them without
+// any run-time checks when targeting these architectures. Elsewhere we just
+// use the scalar code.
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define wxIMAGE_USE_SSE2
+    #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define wxIMAGE_USE_NEON
+    #include <arm_neon.h>
+#endif
+
 // make the code compile with either wxFile*Stream or wxFFile*Stream:
 #define HAS_FILE_STREAMS (wxUSE_STREAMS && (wxUSE_FILE || wxUSE_FFILE))
 
@@ -56,6 +77,110 @@ IMPLEMENT_VARIANT_OBJECT_EXPORTED_SHALLOWCMP(wxImage,WXDLLEXPORT)
 wxList wxImage::sm_handlers;
 wxImage wxNullImage;
 
+// Maximal number of threads to use for processing the image rows, see
+// wxImage::SetMaxThreads().
+static std::atomic<int> gs_imageMaxThreads(1);
+
+//-----------------------------------------------------------------------------
+// helpers for processing the image in parallel
+//-----------------------------------------------------------------------------
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+// Thread processing a single band of rows for wxForEachImageRowBand().
+class ImageRowBandThread : public wxThread
+{
+public:
+    ImageRowBandThread(const wxImageRowBandFunc& func, int start, int end)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_func(func),
+          m_start(start),
+          m_end(end)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        m_func(m_start, m_end);
+
+        return nullptr;
+    }
+
+private:
+    const wxImageRowBandFunc& m_func;
+    const int m_start,
+              m_end;
+
+    wxDECLARE_NO_COPY_CLASS(ImageRowBandThread);
+};
+
+} // anonymous namespace
+
+#endif // wxUSE_THREADS
+
+void wxForEachImageRowBand(int numRows, int rowSize, const wxImageRowBandFunc& func)
+{
+#if wxUSE_THREADS
+    // Don't bother with using threads for less than this number of pixels.
+    static const wxUint64 MIN_PIXELS_PER_THREAD = 64*1024;
+
+    int numThreads = gs_imageMaxThreads;
+    if ( numThreads == 0 )
+        numThreads = wxThread::GetCPUCount();
+
+    const wxUint64
+        maxThreads = static_cast<wxUint64>(numRows) * rowSize / MIN_PIXELS_PER_THREAD;
+    if ( static_cast<wxUint64>(numThreads) > maxThreads )
+        numThreads = static_cast<int>(maxThreads);
+
+    if ( numThreads > 1 )
+    {
+        wxVector<ImageRowBandThread*> threads;
+
+        // Process the first band in this thread and all the other ones in the
+        // worker threads.
+        const int firstEnd = numRows / numThreads;
+
+        int start = firstEnd;
+        for ( int n = 1; n < numThreads; n++ )
+        {
+            const int end = static_cast<int>(static_cast<wxUint64>(numRows) * (n + 1) / numThreads);
+
+            ImageRowBandThread* const thread = new ImageRowBandThread(func, start, end);
+            if ( thread->Run() != wxTHREAD_NO_ERROR )
+            {
+                // Just do the rest of the work in this thread if we can't
+                // create any more threads.
+                delete thread;
+                func(start, numRows);
+                break;
+            }
+
+            threads.push_back(thread);
+            start = end;
+        }
+
+        func(0, firstEnd);
+
+        for ( ImageRowBandThread* thread : threads )
+        {
+            thread->Wait();
+            delete thread;
+        }
+
+        return;
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(rowSize);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    func(0, numRows);
+}
+
 //-----------------------------------------------------------------------------
 // wxImageRefData
 //-----------------------------------------------------------------------------
@@ -533,18 +658,19 @@ wxImage::Scale( int width, int height, wxImageResizeQuality quality ) const
     return image;
 }
 
-wxImage wxImage::ResampleNearest(int width, int height) const
+namespace
 {
-    wxImage image;
 
-    wxCHECK_MSG( IsOk(), image, "invalid image" );
+wxImage DoResampleNearest(const wxImageView& src, int width, int height)
+{
+    wxImage image;
 
     // We use wxUIntPtr to rescale images of larger size in 64-bit builds:
     // using long wouldn't allow using images larger than 2^16 in either
     // direction because of the check below, as sizeof(long) == 4 even in 64
     // bit builds under MSW, but sizeof(wxUIntPtr) == 8 in this case.
-    const wxUIntPtr old_width  = M_IMGDATA->m_width;
-    const wxUIntPtr old_height = M_IMGDATA->m_height;
+    const wxUIntPtr old_width  = src.GetWidth();
+    const wxUIntPtr old_height = src.GetHeight();
 
     // We use "x << 16" in the code below, so check that this doesn't wrap
     // around, as the code wouldn't work correctly if it did.
@@ -559,351 +685,883 @@ wxImage wxImage::ResampleNearest(int width, int height) const
 
     wxCHECK_MSG( data, image, wxT("unable to create image") );
 
-    const unsigned char *source_data = M_IMGDATA->m_data;
     unsigned char *target_data = data;
-    const unsigned char *source_alpha = nullptr ;
     unsigned char *target_alpha = nullptr ;
 
-    if ( !M_IMGDATA->m_hasMask )
+    const bool hasAlpha = src.HasAlpha();
+    if ( hasAlpha )
     {
-        source_alpha = M_IMGDATA->m_alpha ;
-        if ( source_alpha )
-        {
-            image.SetAlpha() ;
-            target_alpha = image.GetAlpha() ;
-        }
+        image.SetAlpha() ;
+        target_alpha = image.GetAlpha() ;
     }
 
     const wxUIntPtr x_delta = (old_width  << 16) / width;
     const wxUIntPtr y_delta = (old_height << 16) / height;
 
-    unsigned char* dest_pixel = target_data;
-
-    wxUIntPtr y = y_delta / 2;
-    for (int j = 0; j < height; j++)
+    wxForEachImageRowBand(height, width, [=](int start, int end)
     {
-        const unsigned char* src_line = &source_data[(y>>16)*old_width*3];
-        const unsigned char* src_alpha_line = source_alpha ? &source_alpha[(y>>16)*old_width] : nullptr ;
-
-        wxUIntPtr x = x_delta / 2;
-        for (int i = 0; i < width; i++)
-        {
-            const unsigned char* src_pixel = &src_line[(x>>16)*3];
-            const unsigned char* src_alpha_pixel = source_alpha ? &src_alpha_line[(x>>16)] : nullptr ;
-            dest_pixel[0] = src_pixel[0];
-            dest_pixel[1] = src_pixel[1];
-            dest_pixel[2] = src_pixel[2];
-            dest_pixel += 3;
-            if ( source_alpha )
-                *(target_alpha++) = *src_alpha_pixel ;
-            x += x_delta;
-        }
+        unsigned char* dest_pixel = target_data + static_cast<size_t>(start) * width * 3;
+        unsigned char* dest_alpha = target_alpha
+                                        ? target_alpha + static_cast<size_t>(start) * width
+                                        : nullptr;
 
-        y += y_delta;
-    }
-
-    return image;
-}
+        // Buffers used if the source data needs to be converted.
+        wxVector<unsigned char> lineBuffer(old_width * 3);
+        wxVector<unsigned char> alphaBuffer(hasAlpha ? old_width : 0);
 
-namespace
-{
+        const unsigned char* src_line = nullptr;
+        const unsigned char* src_alpha_line = nullptr;
+        wxUIntPtr src_y = static_cast<wxUIntPtr>(-1);
 
-struct BoxPrecalc
-{
-    int boxStart;
-    int boxEnd;
-};
+        wxUIntPtr y = y_delta / 2 + start * y_delta;
+        for (int j = start; j < end; j++)
+        {
+            // Consecutive rows often use the same source row when enlarging.
+            if ( (y>>16) != src_y )
+            {
+                src_y = y>>16;
+                src_line = src.GetRowRGB(src_y, &lineBuffer[0]);
+                if ( hasAlpha )
+                    src_alpha_line = src.GetRowAlpha(src_y, &alphaBuffer[0]);
+            }
 
-void ResampleBoxPrecalc(wxVector<BoxPrecalc>& boxes, int oldDim)
-{
-    const int newDim = boxes.size();
-    wxASSERT( oldDim > 0 && newDim > 0 );
+            wxUIntPtr x = x_delta / 2;
+            for (int i = 0; i < width; i++)
+            {
+                const unsigned char* src_pixel = &src_line[(x>>16)*3];
+                const unsigned char* src_alpha_pixel = hasAlpha ? &src_alpha_line[(x>>16)] : nullptr ;
+                dest_pixel[0] = src_pixel[0];
+                dest_pixel[1] = src_pixel[1];
+                dest_pixel[2] = src_pixel[2];
+                dest_pixel += 3;
+                if ( hasAlpha )
+                    *(dest_alpha++) = *src_alpha_pixel ;
+                x += x_delta;
+            }
 
-    // We need to map pixel values in the range [-0.5 .. (newDim-1)+0.5]
-    // to the pixel values in the range [-0.5 .. (oldDim-1)+0.5].
-    // Transformation function is therefore:
-    //   pOld = sc * (pNew + 0.5) - 0.5, where sc = oldDim/newDim
-    //
-    // A new pixel pNew in the interval [pNew-0.5 .. pNew+0.5]
-    // is mapped to the old pixel in the interval [pOldLoBound..pOldUpBound],
-    // where:
-    //   pOldLoBound = sc * ((pNew-0.5) + 0.5) - 0.5 = sc * pNew - 0.5
-    //   pOldUpBound = sc * ((pNew+0.5) + 0.5) - 0.5 = sc * (pNew+1) - 0.5
-    // So, the lower bound of the pixel box (interval) is:
-    //   boxStart = round(pOldLoBound) = trunc((sc * pNew - 0.5) + 0.5) = trunc(sc * pNew)
-    // and the upper bound is:
-    // - if fraction(pOldUpBound) != 0.5 (bound inside the pixel):
-    //   boxEnd = round(pixOldUpBound) = trunc((sc * (pNew+1) - 0.5) + 0.5) = trunc(sc * (pNew+1))
-    //    e.g. for UpBound = 7.2 -> boxEnd = 7
-    //         for UpBound = 7.6 -> boxEnd = 8
-    // - if fraction(pOldUpBound) == 0.5 (bound at the edge of the pixel):
-    //   boxEnd = round(pOldUpBound)-1 = trunc((sc * (pNew+1) - 0.5) + 0.5) - 1 = trunc(sc * (pNew+1))-1
-    //    e.g. for UpBound = 7.5 -> boxEnd = 7 (not 8)
-    //
-    // In integer arithmetic:
-    //  boxStart = (oldDim * pNew) / newDim
-    //  boxEnd:
-    //   vEnd =  oldDim * (pNew+1) = oldDim * pNew + oldDim
-    //  if vEnd % newDim != 0 (frac(pOldUpBound) != 0.5) => boxEnd = vEnd / newDim
-    //  if vEnd % newDim == 0 (frac(pOldUpBound) == 0.5) => boxEnd = (vEnd / newDim) - 1
+            y += y_delta;
+        }
+    });
 
-    int v = 0; // oldDim * 0
-    for ( int dst = 0; dst < newDim; dst++ )
-    {
-        BoxPrecalc& precalc = boxes[dst];
-        precalc.boxStart = v/newDim;
-        v += oldDim;
-        precalc.boxEnd = v%newDim != 0 ? v/newDim : (v/newDim)-1;
-    }
+    return image;
 }
 
-} // anonymous namespace
-
-wxImage wxImage::ResampleBox(int width, int height) const
+// This does the same thing as wxImage::ShrinkBy() for an image without mask.
+wxImage DoShrinkBy(const wxImageView& src, int xFactor, int yFactor)
 {
-    wxCHECK_MSG( IsOk(), {}, "invalid image" );
-
-    // This function implements a simple pre-blur/box averaging method for
-    // downsampling that gives reasonably smooth results To scale the image
-    // down we will need to gather a grid of pixels of the size of the scale
-    // factor in each direction and then do an averaging of the pixels.
-
-    wxImage ret_image(width, height, false);
+    const int old_width = src.GetWidth();
+    const int width = old_width / xFactor;
+    const int height = src.GetHeight() / yFactor;
 
-    wxVector<BoxPrecalc> vPrecalcs(height);
-    wxVector<BoxPrecalc> hPrecalcs(width);
+    wxImage image(width, height, false);
 
-    ResampleBoxPrecalc(vPrecalcs, M_IMGDATA->m_height);
-    ResampleBoxPrecalc(hPrecalcs, M_IMGDATA->m_width);
+    wxCHECK_MSG( image.IsOk(), image, wxT("unable to create image") );
 
+    const bool hasAlpha = src.HasAlpha();
+    if ( hasAlpha )
+        image.SetAlpha();
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = nullptr;
+    unsigned char* const target_data = image.GetData();
+    unsigned char* const target_alpha = image.GetAlpha();
 
-    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
+    const unsigned long counter = static_cast<unsigned long>(xFactor) * yFactor;
 
-    if ( src_alpha )
+    wxForEachImageRowBand(height, width, [=](int start, int end)
     {
-        ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
-    }
-
-    int averaged_pixels, src_pixel_index;
-    double sum_r, sum_g, sum_b, sum_a;
+        // Buffers used if the source data needs to be converted.
+        wxVector<unsigned char> lineBuffer(old_width * 3);
+        wxVector<unsigned char> alphaBuffer(hasAlpha ? old_width : 0);
 
-    for ( int y = 0; y < height; y++ )         // Destination image - Y direction
-    {
-        // Source pixel in the Y direction
-        const BoxPrecalc& vPrecalc = vPrecalcs[y];
+        // Sums of red, green, blue and alpha for each pixel of the row.
+        wxVector<unsigned long> sums(width * 4);
 
-        for ( int x = 0; x < width; x++ )      // Destination image - X direction
+        for ( int y = start; y < end; y++ )
         {
-            // Source pixel in the X direction
-            const BoxPrecalc& hPrecalc = hPrecalcs[x];
-
-            // Box of pixels to average
-            averaged_pixels = (vPrecalc.boxEnd - vPrecalc.boxStart + 1)
-                                * (hPrecalc.boxEnd - hPrecalc.boxStart + 1);
-            sum_r = sum_g = sum_b = sum_a = 0.0;
+            std::fill(sums.begin(), sums.end(), 0);
 
-            for ( int j = vPrecalc.boxStart; j <= vPrecalc.boxEnd; ++j )
+            for ( int y1 = 0; y1 < yFactor; y1++ )
             {
-                for ( int i = hPrecalc.boxStart; i <= hPrecalc.boxEnd; ++i )
+                const int src_y = y * yFactor + y1;
+                const unsigned char* const
+                    src_line = src.GetRowRGB(src_y, &lineBuffer[0]);
+                const unsigned char* const
+                    src_alpha_line = hasAlpha
+                                        ? src.GetRowAlpha(src_y, &alphaBuffer[0])
+                                        : nullptr;
+
+                for ( int x = 0; x < width; x++ )
                 {
-                    // Calculate the actual index in our source pixels
-                    src_pixel_index = j * M_IMGDATA->m_width + i;
-
-                    if (src_alpha)
-                    {
-                        sum_r += src_data[src_pixel_index * 3 + 0] * src_alpha[src_pixel_index];
-                        sum_g += src_data[src_pixel_index * 3 + 1] * src_alpha[src_pixel_index];
-                        sum_b += src_data[src_pixel_index * 3 + 2] * src_alpha[src_pixel_index];
-                        sum_a += src_alpha[src_pixel_index];
-                    }
-                    else
+                    unsigned long* const sum = &sums[x * 4];
+                    for ( int x1 = 0; x1 < xFactor; x1++ )
                     {
-                        sum_r += src_data[src_pixel_index * 3 + 0];
-                        sum_g += src_data[src_pixel_index * 3 + 1];
-                        sum_b += src_data[src_pixel_index * 3 + 2];
+                        const int src_x = x * xFactor + x1;
+                        const unsigned char alpha = hasAlpha
+                                                        ? src_alpha_line[src_x]
+                                                        : 255;
+
+                        // Fully transparent pixels don't contribute to the
+                        // colour, but still count for the average.
+                        if ( alpha > 0 )
+                        {
+                            const unsigned char* const
+                                src_pixel = &src_line[src_x * 3];
+                            sum[0] += src_pixel[0];
+                            sum[1] += src_pixel[1];
+                            sum[2] += src_pixel[2];
+                        }
+                        sum[3] += alpha;
                     }
                 }
             }
 
-            // Calculate the average from the sum and number of averaged pixels
-            if (src_alpha)
+            unsigned char* dest_pixel = target_data + static_cast<size_t>(y) * width * 3;
+            for ( int x = 0; x < width; x++ )
             {
-                if (sum_a != 0)
+                const unsigned long* const sum = &sums[x * 4];
+                *dest_pixel++ = static_cast<unsigned char>(sum[0] / counter);
+                *dest_pixel++ = static_cast<unsigned char>(sum[1] / counter);
+                *dest_pixel++ = static_cast<unsigned char>(sum[2] / counter);
+                if ( hasAlpha )
                 {
-                    dst_data[0] = (unsigned char)(sum_r / sum_a);
-                    dst_data[1] = (unsigned char)(sum_g / sum_a);
-                    dst_data[2] = (unsigned char)(sum_b / sum_a);
+                    target_alpha[static_cast<size_t>(y) * width + x] =
+                        static_cast<unsigned char>(sum[3] / counter);
                 }
-                else
-                {
-                    dst_data[0] = 0;
-                    dst_data[1] = 0;
-                    dst_data[2] = 0;
-                }
-                *dst_alpha++ = (unsigned char)(sum_a / averaged_pixels);
-            }
-            else
-            {
-                dst_data[0] = (unsigned char)(sum_r / averaged_pixels);
-                dst_data[1] = (unsigned char)(sum_g / averaged_pixels);
-                dst_data[2] = (unsigned char)(sum_b / averaged_pixels);
             }
-            dst_data += 3;
         }
-    }
+    });
 
-    return ret_image;
+    return image;
 }
 
-namespace
-{
+} // anonymous namespace
 
-struct BilinearPrecalc
+wxImage wxImage::ResampleNearest(int width, int height) const
 {
-    int offset1;
-    int offset2;
-    double dd;
-    double dd1;
-};
+    wxCHECK_MSG( IsOk(), wxImage(), "invalid image" );
 
-inline void DoCalc(BilinearPrecalc& precalc, double srcpix, int srcpixmax)
-{
-    int srcpix1 = int(srcpix);
-    int srcpix2 = srcpix1 == srcpixmax ? srcpix1 : srcpix1 + 1;
+    // Alpha is not used for the images with mask.
+    wxImageView view(*this);
+    if ( M_IMGDATA->m_hasMask )
+        view.SetAlpha(nullptr);
 
-    precalc.dd = srcpix - (int)srcpix;
-    precalc.dd1 = 1.0 - precalc.dd;
-    precalc.offset1 = srcpix1 < 0.0
-                        ? 0
-                        : srcpix1 > srcpixmax
-                            ? srcpixmax
-                            : (int)srcpix1;
-    precalc.offset2 = srcpix2 < 0.0
-                        ? 0
-                        : srcpix2 > srcpixmax
-                            ? srcpixmax
-                            : (int)srcpix2;
+    return DoResampleNearest(view, width, height);
 }
 
-void ResampleBilinearPrecalc(wxVector<BilinearPrecalc>& precalcs, int oldDim)
+// ----------------------------------------------------------------------------
+// Helpers for the resampling functions below
+// ----------------------------------------------------------------------------
+
+namespace
 {
-    const int newDim = precalcs.size();
-    wxASSERT( oldDim > 0 && newDim > 0 );
-    const int srcpixmax = oldDim - 1;
-    if ( newDim > 1 )
-    {
-        // We want to map pixels in the range [0..newDim-1]
-        // to the range [0..oldDim-1]
-        const double scale_factor = double(oldDim-1) / (newDim-1);
 
-        for ( int dsty = 0; dsty < newDim; dsty++ )
-        {
-            // We need to calculate the source pixel to interpolate from - Y-axis
-            double srcpix = (double)dsty * scale_factor;
+// Red, green, blue and alpha (or anything else, depending on the context)
+// components of a pixel stored as doubles.
+//
+// All the operations on this struct are done component-wise and the
+// resampling code uses them in exactly the same order as it used to use the
+// scalar operations before, so that the results are exactly the same whether
+// SIMD instructions are available or not.
+struct Pixel4d
+{
+#if defined(wxIMAGE_USE_SSE2)
+    __m128d rg,
+            ba;
 
-            DoCalc(precalcs[dsty], srcpix, srcpixmax);
-        }
-    }
-    else
+    static Pixel4d Zero()
     {
-        // Let's take the pixel from the center of the source image.
-        double srcpix = (double)srcpixmax / 2.0;
+        return { _mm_setzero_pd(), _mm_setzero_pd() };
+    }
 
-        DoCalc(precalcs[0], srcpix, srcpixmax);
+    static Pixel4d Load(const double* p)
+    {
+        return { _mm_loadu_pd(p), _mm_loadu_pd(p + 2) };
     }
-}
 
-} // anonymous namespace
+    static Pixel4d FromBytes(const unsigned char* rgb, double a)
+    {
+        return { _mm_set_pd(rgb[1], rgb[0]), _mm_set_pd(a, rgb[2]) };
+    }
 
-wxImage wxImage::ResampleBilinear(int width, int height) const
-{
-    wxCHECK_MSG( IsOk(), {}, "invalid image" );
+    void Store(double* p) const
+    {
+        _mm_storeu_pd(p, rg);
+        _mm_storeu_pd(p + 2, ba);
+    }
 
-    // This function implements a Bilinear algorithm for resampling.
-    wxImage ret_image(width, height, false);
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = nullptr;
+    Pixel4d operator+(const Pixel4d& other) const
+    {
+        return { _mm_add_pd(rg, other.rg), _mm_add_pd(ba, other.ba) };
+    }
 
-    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
+    Pixel4d operator+(double d) const
+    {
+        const __m128d v = _mm_set1_pd(d);
+        return { _mm_add_pd(rg, v), _mm_add_pd(ba, v) };
+    }
 
-    if ( src_alpha )
+    Pixel4d operator*(double d) const
     {
-        ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
+        const __m128d v = _mm_set1_pd(d);
+        return { _mm_mul_pd(rg, v), _mm_mul_pd(ba, v) };
     }
 
-    wxVector<BilinearPrecalc> vPrecalcs(height);
-    wxVector<BilinearPrecalc> hPrecalcs(width);
-    ResampleBilinearPrecalc(vPrecalcs, M_IMGDATA->m_height);
-    ResampleBilinearPrecalc(hPrecalcs, M_IMGDATA->m_width);
+    Pixel4d operator/(double d) const
+    {
+        const __m128d v = _mm_set1_pd(d);
+        return { _mm_div_pd(rg, v), _mm_div_pd(ba, v) };
+    }
 
-    // initialize alpha values to avoid g++ warnings about possibly
-    // uninitialized variables
-    double r1, g1, b1, a1 = 0;
-    double r2, g2, b2, a2 = 0;
+    double GetAlpha() const
+    {
+        return _mm_cvtsd_f64(_mm_unpackhi_pd(ba, ba));
+    }
 
-    for ( int dsty = 0; dsty < height; dsty++ )
+    // Store the first 3 components truncated to unsigned char.
+    void StoreRGB(unsigned char* rgb) const
     {
-        // We need to calculate the source pixel to interpolate from - Y-axis
-        const BilinearPrecalc& vPrecalc = vPrecalcs[dsty];
-        const int y_offset1 = vPrecalc.offset1;
-        const int y_offset2 = vPrecalc.offset2;
-        const double dy = vPrecalc.dd;
-        const double dy1 = vPrecalc.dd1;
+        const __m128i rg32 = _mm_cvttpd_epi32(rg);
+        const __m128i ba32 = _mm_cvttpd_epi32(ba);
 
+        rgb[0] = static_cast<unsigned char>(_mm_cvtsi128_si32(rg32));
+        rgb[1] = static_cast<unsigned char>(_mm_cvtsi128_si32(_mm_srli_si128(rg32, 4)));
+        rgb[2] = static_cast<unsigned char>(_mm_cvtsi128_si32(ba32));
+    }
+#elif defined(wxIMAGE_USE_NEON)
+    float64x2_t rg,
+                ba;
+
+    static Pixel4d Zero()
+    {
+        return { vdupq_n_f64(0.0), vdupq_n_f64(0.0) };
+    }
+
+    static Pixel4d Load(const double* p)
+    {
+        return { vld1q_f64(p), vld1q_f64(p + 2) };
+    }
+
+    static Pixel4d FromBytes(const unsigned char* rgb, double a)
+    {
+        const double p[4] = { double(rgb[0]), double(rgb[1]), double(rgb[2]), a };
+        return Load(p);
+    }
+
+    void Store(double* p) const
+    {
+        vst1q_f64(p, rg);
+        vst1q_f64(p + 2, ba);
+    }
+
+    Pixel4d operator+(const Pixel4d& other) const
+    {
+        return { vaddq_f64(rg, other.rg), vaddq_f64(ba, other.ba) };
+    }
+
+    Pixel4d operator+(double d) const
+    {
+        const float64x2_t v = vdupq_n_f64(d);
+        return { vaddq_f64(rg, v), vaddq_f64(ba, v) };
+    }
+
+    Pixel4d operator*(double d) const
+    {
+        return { vmulq_n_f64(rg, d), vmulq_n_f64(ba, d) };
+    }
+
+    Pixel4d operator/(double d) const
+    {
+        const float64x2_t v = vdupq_n_f64(d);
+        return { vdivq_f64(rg, v), vdivq_f64(ba, v) };
+    }
+
+    double GetAlpha() const
+    {
+        return vgetq_lane_f64(ba, 1);
+    }
+
+    void StoreRGB(unsigned char* rgb) const
+    {
+        const int64x2_t rg64 = vcvtq_s64_f64(rg);
+        const int64x2_t ba64 = vcvtq_s64_f64(ba);
+
+        rgb[0] = static_cast<unsigned char>(vgetq_lane_s64(rg64, 0));
+        rgb[1] = static_cast<unsigned char>(vgetq_lane_s64(rg64, 1));
+        rgb[2] = static_cast<unsigned char>(vgetq_lane_s64(ba64, 0));
+    }
+#else // no SIMD
+    double c[4];
+
+    static Pixel4d Zero()
+    {
+        return { { 0.0, 0.0, 0.0, 0.0 } };
+    }
+
+    static Pixel4d Load(const double* p)
+    {
+        return { { p[0], p[1], p[2], p[3] } };
+    }
+
+    static Pixel4d FromBytes(const unsigned char* rgb, double a)
+    {
+        return { { double(rgb[0]), double(rgb[1]), double(rgb[2]), a } };
+    }
+
+    void Store(double* p) const
+    {
+        p[0] = c[0];
+        p[1] = c[1];
+        p[2] = c[2];
+        p[3] = c[3];
+    }
+
+    Pixel4d operator+(const Pixel4d& other) const
+    {
+        return { { c[0] + other.c[0], c[1] + other.c[1],
+                   c[2] + other.c[2], c[3] + other.c[3] } };
+    }
+
+    Pixel4d operator+(double d) const
+    {
+        return { { c[0] + d, c[1] + d, c[2] + d, c[3] + d } };
+    }
+
+    Pixel4d operator*(double d) const
+    {
+        return { { c[0] * d, c[1] * d, c[2] * d, c[3] * d } };
+    }
+
+    Pixel4d operator/(double d) const
+    {
+        return { { c[0] / d, c[1] / d, c[2] / d, c[3] / d } };
+    }
+
+    double GetAlpha() const
+    {
+        return c[3];
+    }
+
+    void StoreRGB(unsigned char* rgb) const
+    {
+        rgb[0] = static_cast<unsigned char>(c[0]);
+        rgb[1] = static_cast<unsigned char>(c[1]);
+        rgb[2] = static_cast<unsigned char>(c[2]);
+    }
+#endif // SIMD
+};
+
+// Cache of rows of 4 doubles per pixel, as expected by Pixel4d::Load(),
+// computed from the source image rows by the provided function.
+//
+// Consecutive destination rows typically use the same (when enlarging) or
+// nearby source rows, so caching them avoids converting the same pixels over
+// and over again.
+class ResampleRowCache
+{
+public:
+    // Function filling the buffer with the pixels corresponding to the given
+    // source row.
+    typedef std::function<void (int y, double* row)> FillFunc;
+
+    // Up to numRows consecutive rows of the given length may be used at the
+    // same time.
+    ResampleRowCache(int length, int numRows, const FillFunc& fill)
+        : m_length(length),
+          m_fill(fill),
+          m_rows(numRows, -1),
+          m_buffer(static_cast<size_t>(numRows) * length * 4)
+    {
+    }
+
+    // Return the given row. The returned pointer remains valid as long as
+    // only the rows in the range [y - numRows + 1, y + numRows - 1] are used.
+    const double* GetRow(int y)
+    {
+        const size_t slot = static_cast<size_t>(y) % m_rows.size();
+        double* const row = &m_buffer[slot * m_length * 4];
+
+        if ( m_rows[slot] != y )
+        {
+            m_rows[slot] = y;
+            m_fill(y, row);
+        }
+
+        return row;
+    }
+
+private:
+    const size_t m_length;
+    const FillFunc m_fill;
+
+    // Index of the row stored in each slot or -1.
+    wxVector<int> m_rows;
+
+    wxVector<double> m_buffer;
+
+    wxDECLARE_NO_COPY_CLASS(ResampleRowCache);
+};
+
+// Add n bytes to the corresponding sums.
+template <typename T>
+inline void AccumulateBytes(T* sums, const unsigned char* data, size_t n)
+{
+    for ( size_t i = 0; i < n; i++ )
+        sums[i] += data[i];
+}
+
+template <>
+inline void AccumulateBytes(wxUint32* sums, const unsigned char* data, size_t n)
+{
+    size_t i = 0;
+
+#if defined(wxIMAGE_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; i + 16 <= n; i += 16 )
+    {
+        const __m128i
+            bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+
+        __m128i* const s = reinterpret_cast<__m128i*>(sums + i);
+        _mm_storeu_si128(s, _mm_add_epi32(_mm_loadu_si128(s),
+                                          _mm_unpacklo_epi16(lo, zero)));
+        _mm_storeu_si128(s + 1, _mm_add_epi32(_mm_loadu_si128(s + 1),
+                                              _mm_unpackhi_epi16(lo, zero)));
+        _mm_storeu_si128(s + 2, _mm_add_epi32(_mm_loadu_si128(s + 2),
+                                              _mm_unpacklo_epi16(hi, zero)));
+        _mm_storeu_si128(s + 3, _mm_add_epi32(_mm_loadu_si128(s + 3),
+                                              _mm_unpackhi_epi16(hi, zero)));
+    }
+#elif defined(wxIMAGE_USE_NEON)
+    for ( ; i + 16 <= n; i += 16 )
+    {
+        const uint8x16_t bytes = vld1q_u8(data + i);
+        const uint16x8_t lo = vmovl_u8(vget_low_u8(bytes));
+        const uint16x8_t hi = vmovl_u8(vget_high_u8(bytes));
+
+        uint32_t* const s = sums + i;
+        vst1q_u32(s, vaddw_u16(vld1q_u32(s), vget_low_u16(lo)));
+        vst1q_u32(s + 4, vaddw_u16(vld1q_u32(s + 4), vget_high_u16(lo)));
+        vst1q_u32(s + 8, vaddw_u16(vld1q_u32(s + 8), vget_low_u16(hi)));
+        vst1q_u32(s + 12, vaddw_u16(vld1q_u32(s + 12), vget_high_u16(hi)));
+    }
+#endif // SIMD
+
+    for ( ; i < n; i++ )
+        sums[i] += data[i];
+}
+
+// Add the pixels of the given row to the per-column sums, which contain 3
+// values per pixel if alpha is null or 4 values (R*A, G*A, B*A, A) otherwise.
+template <typename T>
+void AccumulateBoxRow(T* sums,
+                      const unsigned char* data,
+                      const unsigned char* alpha,
+                      int width)
+{
+    if ( alpha )
+    {
+        for ( int x = 0; x < width; x++, data += 3, sums += 4 )
+        {
+            const T a = alpha[x];
+            sums[0] += data[0] * a;
+            sums[1] += data[1] * a;
+            sums[2] += data[2] * a;
+            sums[3] += a;
+        }
+    }
+    else
+    {
+        AccumulateBytes(sums, data, static_cast<size_t>(width) * 3);
+    }
+}
+
+} // anonymous namespace
+
+namespace
+{
+
+struct BoxPrecalc
+{
+    int boxStart;
+    int boxEnd;
+};
+
+void ResampleBoxPrecalc(wxVector<BoxPrecalc>& boxes, int oldDim)
+{
+    const int newDim = boxes.size();
+    wxASSERT( oldDim > 0 && newDim > 0 );
+
+    // We need to map pixel values in the range [-0.5 .. (newDim-1)+0.5]
+    // to the pixel values in the range [-0.5 .. (oldDim-1)+0.5].
+    // Transformation function is therefore:
+    //   pOld = sc * (pNew + 0.5) - 0.5, where sc = oldDim/newDim
+    //
+    // A new pixel pNew in the interval [pNew-0.5 .. pNew+0.5]
+    // is mapped to the old pixel in the interval [pOldLoBound..pOldUpBound],
+    // where:
+    //   pOldLoBound = sc * ((pNew-0.5) + 0.5) - 0.5 = sc * pNew - 0.5
+    //   pOldUpBound = sc * ((pNew+0.5) + 0.5) - 0.5 = sc * (pNew+1) - 0.5
+    // So, the lower bound of the pixel box (interval) is:
+    //   boxStart = round(pOldLoBound) = trunc((sc * pNew - 0.5) + 0.5) = trunc(sc * pNew)
+    // and the upper bound is:
+    // - if fraction(pOldUpBound) != 0.5 (bound inside the pixel):
+    //   boxEnd = round(pixOldUpBound) = trunc((sc * (pNew+1) - 0.5) + 0.5) = trunc(sc * (pNew+1))
+    //    e.g. for UpBound = 7.2 -> boxEnd = 7
+    //         for UpBound = 7.6 -> boxEnd = 8
+    // - if fraction(pOldUpBound) == 0.5 (bound at the edge of the pixel):
+    //   boxEnd = round(pOldUpBound)-1 = trunc((sc * (pNew+1) - 0.5) + 0.5) - 1 = trunc(sc * (pNew+1))-1
+    //    e.g. for UpBound = 7.5 -> boxEnd = 7 (not 8)
+    //
+    // In integer arithmetic:
+    //  boxStart = (oldDim * pNew) / newDim
+    //  boxEnd:
+    //   vEnd =  oldDim * (pNew+1) = oldDim * pNew + oldDim
+    //  if vEnd % newDim != 0 (frac(pOldUpBound) != 0.5) => boxEnd = vEnd / newDim
+    //  if vEnd % newDim == 0 (frac(pOldUpBound) == 0.5) => boxEnd = (vEnd / newDim) - 1
+
+    int v = 0; // oldDim * 0
+    for ( int dst = 0; dst < newDim; dst++ )
+    {
+        BoxPrecalc& precalc = boxes[dst];
+        precalc.boxStart = v/newDim;
+        v += oldDim;
+        precalc.boxEnd = v%newDim != 0 ? v/newDim : (v/newDim)-1;
+    }
+}
+
+// Implementation of wxImage::ResampleBox() using the given type for the sums
+// of the pixel values over a single column of a box.
+//
+// Instead of summing all the pixels of each box separately, we first compute
+// the per-column sums for all the source rows of the current destination row
+// and then just add up the sums of the columns belonging to each box. As all
+// the sums are integer, this gives exactly the same results but only
+// requires looking at each source pixel once when shrinking the image.
+//
+// Only the destination rows in [start, end) range are computed and dst_data
+// and dst_alpha must point to the start of the first of them.
+template <typename T>
+void ResampleBoxRows(const wxImageView& src,
+                     const wxVector<BoxPrecalc>& vPrecalcs,
+                     const wxVector<BoxPrecalc>& hPrecalcs,
+                     int start,
+                     int end,
+                     unsigned char* dst_data,
+                     unsigned char* dst_alpha)
+{
+    const bool src_alpha = src.HasAlpha();
+    const int components = src_alpha ? 4 : 3;
+    const int srcWidth = src.GetWidth();
+
+    wxVector<T> columnSums(static_cast<size_t>(srcWidth) * components);
+
+    // Buffers used if the source data needs to be converted.
+    wxVector<unsigned char> lineBuffer(static_cast<size_t>(srcWidth) * 3);
+    wxVector<unsigned char> alphaBuffer(src_alpha ? srcWidth : 0);
+
+    for ( int y = start; y < end; y++ )
+    {
+        const BoxPrecalc& vPrecalc = vPrecalcs[y];
+
+        std::fill(columnSums.begin(), columnSums.end(), T(0));
+
+        for ( int j = vPrecalc.boxStart; j <= vPrecalc.boxEnd; ++j )
+        {
+            AccumulateBoxRow(&columnSums[0],
+                             src.GetRowRGB(j, &lineBuffer[0]),
+                             src_alpha ? src.GetRowAlpha(j, &alphaBuffer[0])
+                                       : nullptr,
+                             srcWidth);
+        }
+
+        const int boxHeight = vPrecalc.boxEnd - vPrecalc.boxStart + 1;
+
+        for ( const BoxPrecalc& hPrecalc : hPrecalcs )
+        {
+            // Box of pixels to average
+            const int averaged_pixels =
+                boxHeight * (hPrecalc.boxEnd - hPrecalc.boxStart + 1);
+
+            wxUint64 sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
+
+            const T* sums = &columnSums[static_cast<size_t>(hPrecalc.boxStart) * components];
+            for ( int i = hPrecalc.boxStart; i <= hPrecalc.boxEnd; ++i )
+            {
+                sum_r += sums[0];
+                sum_g += sums[1];
+                sum_b += sums[2];
+                if ( src_alpha )
+                    sum_a += sums[3];
+
+                sums += components;
+            }
+
+            // Calculate the average from the sum and number of averaged
+            // pixels, using the floating point arithmetic to get the same
+            // results as in the previous versions.
+            if ( src_alpha )
+            {
+                if ( sum_a != 0 )
+                {
+                    const double a = static_cast<double>(sum_a);
+                    dst_data[0] = (unsigned char)(static_cast<double>(sum_r) / a);
+                    dst_data[1] = (unsigned char)(static_cast<double>(sum_g) / a);
+                    dst_data[2] = (unsigned char)(static_cast<double>(sum_b) / a);
+                }
+                else
+                {
+                    dst_data[0] = 0;
+                    dst_data[1] = 0;
+                    dst_data[2] = 0;
+                }
+                *dst_alpha++ = (unsigned char)(static_cast<double>(sum_a) / averaged_pixels);
+            }
+            else
+            {
+                dst_data[0] = (unsigned char)(static_cast<double>(sum_r) / averaged_pixels);
+                dst_data[1] = (unsigned char)(static_cast<double>(sum_g) / averaged_pixels);
+                dst_data[2] = (unsigned char)(static_cast<double>(sum_b) / averaged_pixels);
+            }
+            dst_data += 3;
+        }
+    }
+}
+
+wxImage DoResampleBox(const wxImageView& src, int width, int height)
+{
+    // This function implements a simple pre-blur/box averaging method for
+    // downsampling that gives reasonably smooth results To scale the image
+    // down we will need to gather a grid of pixels of the size of the scale
+    // factor in each direction and then do an averaging of the pixels.
+
+    wxImage ret_image(width, height, false);
+
+    wxVector<BoxPrecalc> vPrecalcs(height);
+    wxVector<BoxPrecalc> hPrecalcs(width);
+
+    ResampleBoxPrecalc(vPrecalcs, src.GetHeight());
+    ResampleBoxPrecalc(hPrecalcs, src.GetWidth());
+
+    const bool src_alpha = src.HasAlpha();
+    unsigned char* dst_data = ret_image.GetData();
+    unsigned char* dst_alpha = nullptr;
+
+    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
+
+    if ( src_alpha )
+    {
+        ret_image.SetAlpha();
+        dst_alpha = ret_image.GetAlpha();
+    }
+
+    // The sums of the pixel values (possibly multiplied by alpha) can't
+    // overflow 32 bit integers unless the boxes are very high, but we still
+    // need to use 64 bit ones for the latter case.
+    int maxBoxHeight = 0;
+    for ( const auto& vPrecalc : vPrecalcs )
+    {
+        maxBoxHeight = wxMax(maxBoxHeight, vPrecalc.boxEnd - vPrecalc.boxStart + 1);
+    }
+
+    const wxUint64 maxSum = static_cast<wxUint64>(maxBoxHeight) *
+                                (src_alpha ? 255*255 : 255);
+    const bool use32 = maxSum <= 0xffffffffu;
+
+    wxForEachImageRowBand(height, width, [&](int start, int end)
+    {
+        unsigned char* const dst = dst_data + static_cast<size_t>(start) * width * 3;
+        unsigned char* const alpha = dst_alpha
+                                        ? dst_alpha + static_cast<size_t>(start) * width
+                                        : nullptr;
+        if ( use32 )
+        {
+            ResampleBoxRows<wxUint32>(src, vPrecalcs, hPrecalcs, start, end,
+                                      dst, alpha);
+        }
+        else
+        {
+            ResampleBoxRows<wxUint64>(src, vPrecalcs, hPrecalcs, start, end,
+                                      dst, alpha);
+        }
+    });
+
+    return ret_image;
+}
+
+} // anonymous namespace
+
+wxImage wxImage::ResampleBox(int width, int height) const
+{
+    wxCHECK_MSG( IsOk(), {}, "invalid image" );
+
+    return DoResampleBox(wxImageView(*this), width, height);
+}
+
+namespace
+{
+
+struct BilinearPrecalc
+{
+    int offset1;
+    int offset2;
+    double dd;
+    double dd1;
+};
+
+inline void DoCalc(BilinearPrecalc& precalc, double srcpix, int srcpixmax)
+{
+    int srcpix1 = int(srcpix);
+    int srcpix2 = srcpix1 == srcpixmax ? srcpix1 : srcpix1 + 1;
+
+    precalc.dd = srcpix - (int)srcpix;
+    precalc.dd1 = 1.0 - precalc.dd;
+    precalc.offset1 = srcpix1 < 0.0
+                        ? 0
+                        : srcpix1 > srcpixmax
+                            ? srcpixmax
+                            : (int)srcpix1;
+    precalc.offset2 = srcpix2 < 0.0
+                        ? 0
+                        : srcpix2 > srcpixmax
+                            ? srcpixmax
+                            : (int)srcpix2;
+}
+
+void ResampleBilinearPrecalc(wxVector<BilinearPrecalc>& precalcs, int oldDim)
+{
+    const int newDim = precalcs.size();
+    wxASSERT( oldDim > 0 && newDim > 0 );
+    const int srcpixmax = oldDim - 1;
+    if ( newDim > 1 )
+    {
+        // We want to map pixels in the range [0..newDim-1]
+        // to the range [0..oldDim-1]
+        const double scale_factor = double(oldDim-1) / (newDim-1);
+
+        for ( int dsty = 0; dsty < newDim; dsty++ )
+        {
+            // We need to calculate the source pixel to interpolate from - Y-axis
+            double srcpix = (double)dsty * scale_factor;
+
+            DoCalc(precalcs[dsty], srcpix, srcpixmax);
+        }
+    }
+    else
+    {
+        // Let's take the pixel from the center of the source image.
+        double srcpix = (double)srcpixmax / 2.0;
+
+        DoCalc(precalcs[0], srcpix, srcpixmax);
+    }
+}
+
+wxImage DoResampleBilinear(const wxImageView& src, int width, int height)
+{
+    // This function implements a Bilinear algorithm for resampling.
+    wxImage ret_image(width, height, false);
+    const bool src_alpha = src.HasAlpha();
+    unsigned char* dst_data = ret_image.GetData();
+    unsigned char* dst_alpha = nullptr;
+
+    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
+
+    if ( src_alpha )
+    {
+        ret_image.SetAlpha();
+        dst_alpha = ret_image.GetAlpha();
+    }
+
+    wxVector<BilinearPrecalc> vPrecalcs(height);
+    wxVector<BilinearPrecalc> hPrecalcs(width);
+    ResampleBilinearPrecalc(vPrecalcs, src.GetHeight());
+    ResampleBilinearPrecalc(hPrecalcs, src.GetWidth());
+
+    const int srcWidth = src.GetWidth();
 
-        for ( int dstx = 0; dstx < width; dstx++ )
+    wxForEachImageRowBand(height, width, [&](int start, int end)
+    {
+        // Buffers used if the source data needs to be converted.
+        wxVector<unsigned char> lineBuffer(static_cast<size_t>(srcWidth) * 3);
+        wxVector<unsigned char> alphaBuffer(src_alpha ? srcWidth : 0);
+
+        // Each destination row is interpolated between at most 2 consecutive
+        // source rows, which are first interpolated horizontally and cached,
+        // as they're typically reused for several destination rows when
+        // enlarging.
+        const auto fillRow = [&](int y, double* row)
         {
-            // X-axis of pixel to interpolate from
-            const BilinearPrecalc& hPrecalc = hPrecalcs[dstx];
+            const unsigned char* const line = src.GetRowRGB(y, &lineBuffer[0]);
+            const unsigned char* const alpha =
+                src_alpha ? src.GetRowAlpha(y, &alphaBuffer[0]) : nullptr;
+
+            for ( const BilinearPrecalc& hPrecalc : hPrecalcs )
+            {
+                const int x_offset1 = hPrecalc.offset1;
+                const int x_offset2 = hPrecalc.offset2;
+
+                const Pixel4d p1 =
+                    Pixel4d::FromBytes(line + x_offset1 * 3,
+                                       alpha ? alpha[x_offset1] : 0);
+                const Pixel4d p2 =
+                    Pixel4d::FromBytes(line + x_offset2 * 3,
+                                       alpha ? alpha[x_offset2] : 0);
+
+                (p1 * hPrecalc.dd1 + p2 * hPrecalc.dd).Store(row);
+                row += 4;
+            }
+        };
+
+        ResampleRowCache srcRows(width, 2, fillRow);
 
-            const int x_offset1 = hPrecalc.offset1;
-            const int x_offset2 = hPrecalc.offset2;
-            const double dx = hPrecalc.dd;
-            const double dx1 = hPrecalc.dd1;
+        unsigned char* dst = dst_data + static_cast<size_t>(start) * width * 3;
+        unsigned char* alpha = dst_alpha
+                                ? dst_alpha + static_cast<size_t>(start) * width
+                                : nullptr;
 
-            int src_pixel_index00 = y_offset1 * M_IMGDATA->m_width + x_offset1;
-            int src_pixel_index01 = y_offset1 * M_IMGDATA->m_width + x_offset2;
-            int src_pixel_index10 = y_offset2 * M_IMGDATA->m_width + x_offset1;
-            int src_pixel_index11 = y_offset2 * M_IMGDATA->m_width + x_offset2;
+        for ( int dsty = start; dsty < end; dsty++ )
+        {
+            // We need to calculate the source pixel to interpolate from - Y-axis
+            const BilinearPrecalc& vPrecalc = vPrecalcs[dsty];
 
             // first line
-            r1 = src_data[src_pixel_index00 * 3 + 0] * dx1 + src_data[src_pixel_index01 * 3 + 0] * dx;
-            g1 = src_data[src_pixel_index00 * 3 + 1] * dx1 + src_data[src_pixel_index01 * 3 + 1] * dx;
-            b1 = src_data[src_pixel_index00 * 3 + 2] * dx1 + src_data[src_pixel_index01 * 3 + 2] * dx;
-            if ( src_alpha )
-                a1 = src_alpha[src_pixel_index00] * dx1 + src_alpha[src_pixel_index01] * dx;
+            const double* row1 = srcRows.GetRow(vPrecalc.offset1);
 
             // second line
-            r2 = src_data[src_pixel_index10 * 3 + 0] * dx1 + src_data[src_pixel_index11 * 3 + 0] * dx;
-            g2 = src_data[src_pixel_index10 * 3 + 1] * dx1 + src_data[src_pixel_index11 * 3 + 1] * dx;
-            b2 = src_data[src_pixel_index10 * 3 + 2] * dx1 + src_data[src_pixel_index11 * 3 + 2] * dx;
-            if ( src_alpha )
-                a2 = src_alpha[src_pixel_index10] * dx1 + src_alpha[src_pixel_index11] * dx;
+            const double* row2 = srcRows.GetRow(vPrecalc.offset2);
 
-            // result lines
+            const double dy = vPrecalc.dd;
+            const double dy1 = vPrecalc.dd1;
 
-            dst_data[0] = static_cast<unsigned char>(r1 * dy1 + r2 * dy + .5);
-            dst_data[1] = static_cast<unsigned char>(g1 * dy1 + g2 * dy + .5);
-            dst_data[2] = static_cast<unsigned char>(b1 * dy1 + b2 * dy + .5);
-            dst_data += 3;
+            for ( int dstx = 0; dstx < width; dstx++, row1 += 4, row2 += 4 )
+            {
+                const Pixel4d p1 = Pixel4d::Load(row1);
+                const Pixel4d p2 = Pixel4d::Load(row2);
 
-            if ( src_alpha )
-                *dst_alpha++ = static_cast<unsigned char>(a1 * dy1 + a2 * dy +.5);
+                // result lines
+                const Pixel4d p = p1 * dy1 + p2 * dy + .5;
+
+                p.StoreRGB(dst);
+                dst += 3;
+
+                if ( src_alpha )
+                    *alpha++ = static_cast<unsigned char>(p.GetAlpha());
+            }
         }
-    }
+    });
 
     return ret_image;
 }
 
+} // anonymous namespace
+
+wxImage wxImage::ResampleBilinear(int width, int height) const
+{
+    wxCHECK_MSG( IsOk(), {}, "invalid image" );
+
+    return DoResampleBilinear(wxImageView(*this), width, height);
+}
+
 // The following two local functions are for the B-spline weighting of the
 // bicubic sampling algorithm
 static inline double spline_cube(double value)
@@ -973,13 +1631,9 @@ void ResampleBicubicPrecalc(wxVector<BicubicPrecalc> &aWeight, int oldDim)
     }
 }
 
-} // anonymous namespace
-
 // This is the bicubic resampling algorithm
-wxImage wxImage::ResampleBicubic(int width, int height) const
+wxImage DoResampleBicubic(const wxImageView& src, int width, int height)
 {
-    wxCHECK_MSG( IsOk(), {}, "invalid image" );
-
     // This function implements a Bicubic B-Spline algorithm for resampling.
     // This method is certainly a little slower than wxImage's default pixel
     // replication method, however for most reasonably sized images not being
@@ -1010,8 +1664,7 @@ wxImage wxImage::ResampleBicubic(int width, int height) const
 
     ret_image.Create(width, height, false);
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
+    const bool src_alpha = src.HasAlpha();
     unsigned char* dst_data = ret_image.GetData();
     unsigned char* dst_alpha = nullptr;
 
@@ -1027,296 +1680,392 @@ wxImage wxImage::ResampleBicubic(int width, int height) const
     wxVector<BicubicPrecalc> vPrecalcs(height);
     wxVector<BicubicPrecalc> hPrecalcs(width);
 
-    ResampleBicubicPrecalc(vPrecalcs, M_IMGDATA->m_height);
-    ResampleBicubicPrecalc(hPrecalcs, M_IMGDATA->m_width);
+    ResampleBicubicPrecalc(vPrecalcs, src.GetHeight());
+    ResampleBicubicPrecalc(hPrecalcs, src.GetWidth());
+
+    const int srcWidth = src.GetWidth();
 
-    for ( int dsty = 0; dsty < height; dsty++ )
+    wxForEachImageRowBand(height, width, [&](int start, int end)
     {
-        // We need to calculate the source pixel to interpolate from - Y-axis
-        const BicubicPrecalc& vPrecalc = vPrecalcs[dsty];
+        // Buffers used if the source data needs to be converted: we need one
+        // for RGB and 4 for alpha, as we use 4 alpha rows simultaneously.
+        wxVector<unsigned char> lineBuffer(static_cast<size_t>(srcWidth) * 3);
+        wxVector<unsigned char> alphaBuffer(src_alpha ? 4*srcWidth : 0);
 
-        for ( int dstx = 0; dstx < width; dstx++ )
+        // Each destination row uses at most 4 consecutive source rows, so
+        // cache them after converting to doubles. Notice that we use 1
+        // instead of alpha for the last component of the cached pixels, as we
+        // need to multiply all of them, including alpha itself, by alpha below.
+        const auto fillRow = [&](int y, double* row)
         {
-            // X-axis of pixel to interpolate from
-            const BicubicPrecalc& hPrecalc = hPrecalcs[dstx];
+            const unsigned char* line = src.GetRowRGB(y, &lineBuffer[0]);
+            for ( int x = 0; x < srcWidth; x++, line += 3, row += 4 )
+            {
+                Pixel4d::FromBytes(line, 1.0).Store(row);
+            }
+        };
+
+        ResampleRowCache srcRows(srcWidth, 4, fillRow);
+
+        unsigned char* dst = dst_data + static_cast<size_t>(start) * width * 3;
+        unsigned char* alpha = dst_alpha
+                                ? dst_alpha + static_cast<size_t>(start) * width
+                                : nullptr;
 
-            // Sums for each color channel
-            double sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
+        for ( int dsty = start; dsty < end; dsty++ )
+        {
+            // We need to calculate the source pixel to interpolate from - Y-axis
+            const BicubicPrecalc& vPrecalc = vPrecalcs[dsty];
+
+            const double* rows[4];
+            const unsigned char* alphaRows[4];
+            for ( int k = 0; k < 4; k++ )
+            {
+                rows[k] = srcRows.GetRow(vPrecalc.offset[k]);
+                alphaRows[k] = src_alpha
+                                ? src.GetRowAlpha(vPrecalc.offset[k],
+                                                  &alphaBuffer[k*srcWidth])
+                                : nullptr;
+            }
 
-            // Here we actually determine the RGBA values for the destination pixel
-            for ( int k = -1; k <= 2; k++ )
+            for ( int dstx = 0; dstx < width; dstx++ )
             {
-                // Y offset
-                const int y_offset = vPrecalc.offset[k + 1];
+                // X-axis of pixel to interpolate from
+                const BicubicPrecalc& hPrecalc = hPrecalcs[dstx];
+
+                // Sums for each color channel
+                Pixel4d sum = Pixel4d::Zero();
 
-                // Loop across the X axis
-                for ( int i = -1; i <= 2; i++ )
+                // Here we actually determine the RGBA values for the destination pixel
+                for ( int k = 0; k < 4; k++ )
                 {
-                    // X offset
-                    const int x_offset = hPrecalc.offset[i + 1];
-
-                    // Calculate the exact position where the source data
-                    // should be pulled from based on the x_offset and y_offset
-                    int src_pixel_index = y_offset*M_IMGDATA->m_width + x_offset;
-
-                    // Calculate the weight for the specified pixel according
-                    // to the bicubic b-spline kernel we're using for
-                    // interpolation
-                    const double
-                        pixel_weight = vPrecalc.weight[k + 1] * hPrecalc.weight[i + 1];
-
-                    // Create a sum of all values for each color channel
-                    // adjusted for the pixel's calculated weight
-                    if ( src_alpha )
-                    {
-                        const unsigned char a = src_alpha[src_pixel_index];
-                        sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight * a;
-                        sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight * a;
-                        sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight * a;
-                        sum_a += a * pixel_weight;
-                    }
-                    else
+                    // Loop across the X axis
+                    for ( int i = 0; i < 4; i++ )
                     {
-                        sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight;
-                        sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight;
-                        sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight;
+                        // X offset
+                        const int x_offset = hPrecalc.offset[i];
+
+                        // Calculate the weight for the specified pixel according
+                        // to the bicubic b-spline kernel we're using for
+                        // interpolation
+                        const double
+                            pixel_weight = vPrecalc.weight[k] * hPrecalc.weight[i];
+
+                        // Create a sum of all values for each color channel
+                        // adjusted for the pixel's calculated weight
+                        const Pixel4d p = Pixel4d::Load(rows[k] + x_offset * 4) * pixel_weight;
+                        if ( src_alpha )
+                            sum = sum + p * alphaRows[k][x_offset];
+                        else
+                            sum = sum + p;
                     }
                 }
-            }
 
-            // Put the data into the destination image.  The summed values are
-            // of double data type and are rounded here for accuracy
-            if ( src_alpha )
-            {
-                if (sum_a != 0)
+                // Put the data into the destination image.  The summed values are
+                // of double data type and are rounded here for accuracy
+                if ( src_alpha )
                 {
-                     dst_data[0] = (unsigned char)(sum_r / sum_a + 0.5);
-                     dst_data[1] = (unsigned char)(sum_g / sum_a + 0.5);
-                     dst_data[2] = (unsigned char)(sum_b / sum_a + 0.5);
+                    const double sum_a = sum.GetAlpha();
+                    if (sum_a != 0)
+                    {
+                        (sum / sum_a + 0.5).StoreRGB(dst);
+                    }
+                    else
+                    {
+                        dst[0] = 0;
+                        dst[1] = 0;
+                        dst[2] = 0;
+                    }
+                    *alpha++ = (unsigned char)sum_a;
                 }
                 else
                 {
-                    dst_data[0] = 0;
-                    dst_data[1] = 0;
-                    dst_data[2] = 0;
+                    (sum + 0.5).StoreRGB(dst);
                 }
-                *dst_alpha++ = (unsigned char)sum_a;
+                dst += 3;
             }
-            else
-            {
-                dst_data[0] = (unsigned char)(sum_r + 0.5);
-                dst_data[1] = (unsigned char)(sum_g + 0.5);
-                dst_data[2] = (unsigned char)(sum_b + 0.5);
-            }
-            dst_data += 3;
         }
-    }
+    });
 
     return ret_image;
 }
 
-// Blur in the horizontal direction
-wxImage wxImage::BlurHorizontal(int blurRadius) const
+} // anonymous namespace
+
+wxImage wxImage::ResampleBicubic(int width, int height) const
 {
-    wxImage ret_image(MakeEmptyClone());
+    wxCHECK_MSG( IsOk(), {}, "invalid image" );
 
-    wxCHECK( ret_image.IsOk(), ret_image );
+    return DoResampleBicubic(wxImageView(*this), width, height);
+}
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    unsigned char* dst_data = ret_image.GetData();
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_alpha = ret_image.GetAlpha();
+// ----------------------------------------------------------------------------
+// blurring
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Blur a single image row consisting of count pixels of N components each
+// (i.e. 3 for the RGB data or 1 for alpha) in place using a box of the given
+// radius. The scratch buffer must be big enough to contain count*N bytes.
+//
+// The pixels beyond the row ends are taken to be the same as the edge ones.
+// Notice that the cost of this function doesn't depend on the radius.
+//
+// T is the type used for the sums of the pixel values, which must be big
+// enough to contain (2*radius + 1)*255 + bias, where bias is added to all
+// sums before dividing them to allow rounding instead of truncating them.
+template <int N, typename T>
+void BoxBlurRow(unsigned char* row,
+                int count,
+                int radius,
+                T bias,
+                unsigned char* scratch)
+{
+    // Copy the original values, as we're going to overwrite them.
+    memcpy(scratch, row, static_cast<size_t>(count) * N);
 
     // number of pixels we average over
-    const int blurArea = blurRadius*2 + 1;
-
-    // Horizontal blurring algorithm - average all pixels in the specified blur
-    // radius in the X or horizontal direction
-    for ( int y = 0; y < M_IMGDATA->m_height; y++ )
-    {
-        // Variables used in the blurring algorithm
-        long sum_r = 0,
-             sum_g = 0,
-             sum_b = 0,
-             sum_a = 0;
-
-        long pixel_idx;
-        const unsigned char *src;
-        unsigned char *dst;
-
-        // Calculate the average of all pixels in the blur radius for the first
-        // pixel of the row
-        for ( int kernel_x = -blurRadius; kernel_x <= blurRadius; kernel_x++ )
-        {
-            // To deal with the pixels at the start of a row so it's not
-            // grabbing GOK values from memory at negative indices of the
-            // image's data or grabbing from the previous row
-            if ( kernel_x < 0 )
-                pixel_idx = y * M_IMGDATA->m_width;
-            else
-                pixel_idx = kernel_x + y * M_IMGDATA->m_width;
+    const T blurArea = 2*static_cast<T>(radius) + 1;
 
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
+    // Compute the sum for the first pixel: the box covers [-radius, radius]
+    // range, with all the pixels at negative positions being the same as the
+    // first one and those beyond the end of the row as the last one.
+    const int last = count - 1;
+    const int inside = wxMin(radius, last);
+
+    T sums[N];
+    for ( int c = 0; c < N; c++ )
+    {
+        sums[c] = bias +
+                  (static_cast<T>(radius) + 1) * scratch[c] +
+                  static_cast<T>(radius - inside) * scratch[last*N + c];
+        for ( int i = 1; i <= inside; i++ )
+            sums[c] += scratch[i*N + c];
+
+        row[c] = static_cast<unsigned char>(sums[c] / blurArea);
+    }
+
+    // Now average the values of the rest of the pixels by just moving the
+    // box along the row.
+    for ( int x = 1; x < count; x++ )
+    {
+        row += N;
+
+        const unsigned char* const out = scratch + wxMax(x - radius - 1, 0)*N;
+        const unsigned char* const in = scratch + wxMin(x + radius, last)*N;
+        for ( int c = 0; c < N; c++ )
+        {
+            sums[c] += in[c];
+            sums[c] -= out[c];
+            row[c] = static_cast<unsigned char>(sums[c] / blurArea);
         }
+    }
+}
 
-        dst = dst_data + y * M_IMGDATA->m_width*3;
-        dst[0] = (unsigned char)(sum_r / blurArea);
-        dst[1] = (unsigned char)(sum_g / blurArea);
-        dst[2] = (unsigned char)(sum_b / blurArea);
-        if ( src_alpha )
-            dst_alpha[y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
-
-        // Now average the values of the rest of the pixels by just moving the
-        // blur radius box along the row
-        for ( int x = 1; x < M_IMGDATA->m_width; x++ )
-        {
-            // Take care of edge pixels on the left edge by essentially
-            // duplicating the edge pixel
-            if ( x - blurRadius - 1 < 0 )
-                pixel_idx = y * M_IMGDATA->m_width;
-            else
-                pixel_idx = (x - blurRadius - 1) + y * M_IMGDATA->m_width;
-
-            // Subtract the value of the pixel at the left side of the blur
-            // radius box
-            src = src_data + pixel_idx*3;
-            sum_r -= src[0];
-            sum_g -= src[1];
-            sum_b -= src[2];
-            if ( src_alpha )
-                sum_a -= src_alpha[pixel_idx];
+// Blur the columns in [x1, x2) range of the image data containing width by
+// height pixels of N components each in place using a box of the given
+// radius.
+//
+// This does the same thing as BoxBlurRow() but in the vertical direction and
+// processes all the columns at once, going from top to bottom, instead of
+// doing it column by column, as this is much more cache-friendly. Because of
+// this, the scratch buffer here must be big enough to contain height*(x2-x1)
+// pixels and we also need the buffer for (x2-x1) column sums.
+template <int N, typename T>
+void BoxBlurColumns(unsigned char* data,
+                    int width,
+                    int height,
+                    int x1,
+                    int x2,
+                    int radius,
+                    T bias,
+                    unsigned char* scratch,
+                    T* sums)
+{
+    const size_t stride = static_cast<size_t>(width) * N;
+    const size_t rowLen = static_cast<size_t>(x2 - x1) * N;
+
+    data += static_cast<size_t>(x1) * N;
+
+    // Copy the original values, as we're going to overwrite them.
+    for ( int y = 0; y < height; y++ )
+        memcpy(scratch + y*rowLen, data + y*stride, rowLen);
+
+    const T blurArea = 2*static_cast<T>(radius) + 1;
+
+    const int last = height - 1;
+    const int inside = wxMin(radius, last);
+
+    const unsigned char* const firstRow = scratch;
+    const unsigned char* const lastRow = scratch + last*rowLen;
+    for ( size_t i = 0; i < rowLen; i++ )
+    {
+        sums[i] = bias +
+                  (static_cast<T>(radius) + 1) * firstRow[i] +
+                  static_cast<T>(radius - inside) * lastRow[i];
+    }
 
-            // Take care of edge pixels on the right edge
-            if ( x + blurRadius > M_IMGDATA->m_width - 1 )
-                pixel_idx = M_IMGDATA->m_width - 1 + y * M_IMGDATA->m_width;
-            else
-                pixel_idx = x + blurRadius + y * M_IMGDATA->m_width;
+    for ( int y = 1; y <= inside; y++ )
+    {
+        const unsigned char* const row = scratch + y*rowLen;
+        for ( size_t i = 0; i < rowLen; i++ )
+            sums[i] += row[i];
+    }
 
-            // Add the value of the pixel being added to the end of our box
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
+    for ( size_t i = 0; i < rowLen; i++ )
+        data[i] = static_cast<unsigned char>(sums[i] / blurArea);
 
-            // Save off the averaged data
-            dst = dst_data + x*3 + y*M_IMGDATA->m_width*3;
-            dst[0] = (unsigned char)(sum_r / blurArea);
-            dst[1] = (unsigned char)(sum_g / blurArea);
-            dst[2] = (unsigned char)(sum_b / blurArea);
-            if ( src_alpha )
-                dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
+    for ( int y = 1; y < height; y++ )
+    {
+        data += stride;
+
+        const unsigned char* const out = scratch + wxMax(y - radius - 1, 0)*rowLen;
+        const unsigned char* const in = scratch + wxMin(y + radius, last)*rowLen;
+        for ( size_t i = 0; i < rowLen; i++ )
+        {
+            sums[i] += in[i];
+            sums[i] -= out[i];
+            data[i] = static_cast<unsigned char>(sums[i] / blurArea);
         }
     }
+}
 
-    return ret_image;
+// Blur the image in place in the given direction by applying successive box
+// blur passes with the given radii to it.
+//
+// If round is true, the averaged values are rounded, otherwise they're just
+// truncated, as wxImage::Blur() has always done.
+template <typename T>
+void DoBoxBlurInPlace(wxImage& image,
+                      wxOrientation orient,
+                      const int* radii,
+                      int numRadii,
+                      bool round)
+{
+    unsigned char* const data = image.GetData();
+    unsigned char* const alpha = image.GetAlpha();
+    const int width = image.GetWidth();
+    const int height = image.GetHeight();
+
+    if ( orient == wxHORIZONTAL )
+    {
+        wxForEachImageRowBand(height, width, [=](int start, int end)
+        {
+            // Scratch buffer reused for all rows and passes.
+            wxVector<unsigned char> scratch(static_cast<size_t>(width) * 3);
+
+            for ( int y = start; y < end; y++ )
+            {
+                // Do all the passes for each row while it's still in cache.
+                for ( int pass = 0; pass < numRadii; pass++ )
+                {
+                    const int radius = radii[pass];
+                    if ( !radius )
+                        continue;
+
+                    const T bias = round ? static_cast<T>(radius) : 0;
+
+                    BoxBlurRow<3>(data + static_cast<size_t>(y) * width * 3,
+                                  width, radius, bias, &scratch[0]);
+
+                    if ( alpha )
+                    {
+                        BoxBlurRow<1>(alpha + static_cast<size_t>(y) * width,
+                                      width, radius, bias, &scratch[0]);
+                    }
+                }
+            }
+        });
+    }
+    else // wxVERTICAL
+    {
+        // We split the image in bands of columns rather than rows here.
+        wxForEachImageRowBand(width, height, [=](int start, int end)
+        {
+            const size_t bandWidth = end - start;
+
+            wxVector<unsigned char> scratch(bandWidth * height * 3);
+            wxVector<T> sums(bandWidth * 3);
+
+            for ( int pass = 0; pass < numRadii; pass++ )
+            {
+                const int radius = radii[pass];
+                if ( !radius )
+                    continue;
+
+                const T bias = round ? static_cast<T>(radius) : 0;
+
+                BoxBlurColumns<3>(data, width, height, start, end,
+                                  radius, bias, &scratch[0], &sums[0]);
+
+                if ( alpha )
+                {
+                    BoxBlurColumns<1>(alpha, width, height, start, end,
+                                      radius, bias, &scratch[0], &sums[0]);
+                }
+            }
+        });
+    }
 }
 
-// Blur in the vertical direction
-wxImage wxImage::BlurVertical(int blurRadius) const
+void BoxBlurInPlace(wxImage& image,
+                    wxOrientation orient,
+                    const int* radii,
+                    int numRadii,
+                    bool round = false)
 {
-    wxImage ret_image(MakeEmptyClone());
+    // Use 32 bit sums, which are faster to divide, unless the sums may
+    // overflow them.
+    int maxRadius = 0;
+    for ( int n = 0; n < numRadii; n++ )
+        maxRadius = wxMax(maxRadius, radii[n]);
 
-    wxCHECK( ret_image.IsOk(), ret_image );
+    const wxUint64 maxSum = (2*static_cast<wxUint64>(maxRadius) + 1) * 255 + maxRadius;
+    if ( maxSum <= 0xffffffffu )
+        DoBoxBlurInPlace<wxUint32>(image, orient, radii, numRadii, round);
+    else
+        DoBoxBlurInPlace<wxUint64>(image, orient, radii, numRadii, round);
+}
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    unsigned char* dst_data = ret_image.GetData();
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_alpha = ret_image.GetAlpha();
+} // anonymous namespace
 
-    // number of pixels we average over
-    const int blurArea = blurRadius*2 + 1;
-
-    // Vertical blurring algorithm - same as horizontal but switched the
-    // opposite direction
-    for ( int x = 0; x < M_IMGDATA->m_width; x++ )
-    {
-        // Variables used in the blurring algorithm
-        long sum_r = 0,
-             sum_g = 0,
-             sum_b = 0,
-             sum_a = 0;
-
-        long pixel_idx;
-        const unsigned char *src;
-        unsigned char *dst;
-
-        // Calculate the average of all pixels in our blur radius box for the
-        // first pixel of the column
-        for ( int kernel_y = -blurRadius; kernel_y <= blurRadius; kernel_y++ )
-        {
-            // To deal with the pixels at the start of a column so it's not
-            // grabbing GOK values from memory at negative indices of the
-            // image's data or grabbing from the previous column
-            if ( kernel_y < 0 )
-                pixel_idx = x;
-            else
-                pixel_idx = x + kernel_y * M_IMGDATA->m_width;
+wxImage wxImage::MakeBlurCopy() const
+{
+    wxImage image(MakeEmptyClone());
 
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
-        }
+    wxCHECK( image.IsOk(), image );
 
-        dst = dst_data + x*3;
-        dst[0] = (unsigned char)(sum_r / blurArea);
-        dst[1] = (unsigned char)(sum_g / blurArea);
-        dst[2] = (unsigned char)(sum_b / blurArea);
-        if ( src_alpha )
-            dst_alpha[x] = (unsigned char)(sum_a / blurArea);
-
-        // Now average the values of the rest of the pixels by just moving the
-        // box along the column from top to bottom
-        for ( int y = 1; y < M_IMGDATA->m_height; y++ )
-        {
-            // Take care of pixels that would be beyond the top edge by
-            // duplicating the top edge pixel for the column
-            if ( y - blurRadius - 1 < 0 )
-                pixel_idx = x;
-            else
-                pixel_idx = x + (y - blurRadius - 1) * M_IMGDATA->m_width;
+    const size_t size = static_cast<size_t>(M_IMGDATA->m_width) * M_IMGDATA->m_height;
 
-            // Subtract the value of the pixel at the top of our blur radius box
-            src = src_data + pixel_idx*3;
-            sum_r -= src[0];
-            sum_g -= src[1];
-            sum_b -= src[2];
-            if ( src_alpha )
-                sum_a -= src_alpha[pixel_idx];
+    memcpy(image.GetData(), M_IMGDATA->m_data, size*3);
+    if ( M_IMGDATA->m_alpha )
+        memcpy(image.GetAlpha(), M_IMGDATA->m_alpha, size);
 
-            // Take care of the pixels that would be beyond the bottom edge of
-            // the image similar to the top edge
-            if ( y + blurRadius > M_IMGDATA->m_height - 1 )
-                pixel_idx = x + (M_IMGDATA->m_height - 1) * M_IMGDATA->m_width;
-            else
-                pixel_idx = x + (blurRadius + y) * M_IMGDATA->m_width;
+    return image;
+}
 
-            // Add the value of the pixel being added to the end of our box
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
+// Blur in the horizontal direction
+wxImage wxImage::BlurHorizontal(int blurRadius) const
+{
+    wxImage ret_image(MakeBlurCopy());
 
-            // Save off the averaged data
-            dst = dst_data + (x + y * M_IMGDATA->m_width) * 3;
-            dst[0] = (unsigned char)(sum_r / blurArea);
-            dst[1] = (unsigned char)(sum_g / blurArea);
-            dst[2] = (unsigned char)(sum_b / blurArea);
-            if ( src_alpha )
-                dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
-        }
-    }
+    wxCHECK( ret_image.IsOk(), ret_image );
+
+    BoxBlurInPlace(ret_image, wxHORIZONTAL, &blurRadius, 1);
+
+    return ret_image;
+}
+
+// Blur in the vertical direction
+wxImage wxImage::BlurVertical(int blurRadius) const
+{
+    wxImage ret_image(MakeBlurCopy());
+
+    wxCHECK( ret_image.IsOk(), ret_image );
+
+    BoxBlurInPlace(ret_image, wxVERTICAL, &blurRadius, 1);
 
     return ret_image;
 }
@@ -1324,42 +2073,74 @@ wxImage wxImage::BlurVertical(int blurRadius) const
 // The new blur function
 wxImage wxImage::Blur(int blurRadius) const
 {
-    wxImage ret_image;
-    ret_image.Create(M_IMGDATA->m_width, M_IMGDATA->m_height, false);
+    wxImage ret_image(MakeBlurCopy());
+
+    wxCHECK( ret_image.IsOk(), ret_image );
 
-    // Blur the image in each direction
-    ret_image = BlurHorizontal(blurRadius);
-    ret_image = ret_image.BlurVertical(blurRadius);
+    // Blur the image in each direction, reusing the same buffer.
+    BoxBlurInPlace(ret_image, wxHORIZONTAL, &blurRadius, 1);
+    BoxBlurInPlace(ret_image, wxVERTICAL, &blurRadius, 1);
 
     return ret_image;
 }
 
-wxImage wxImage::Rotate90( bool clockwise ) const
+wxImage wxImage::GaussianBlur(double sigma) const
 {
-    wxImage image(MakeEmptyClone(Clone_SwapOrientation));
+    wxImage ret_image(MakeBlurCopy());
 
-    wxCHECK( image.IsOk(), image );
+    wxCHECK( ret_image.IsOk(), ret_image );
 
-    long height = M_IMGDATA->m_height;
-    long width  = M_IMGDATA->m_width;
+    if ( sigma <= 0 )
+        return ret_image;
 
-    if ( HasOption(wxIMAGE_OPTION_CUR_HOTSPOT_X) )
-    {
-        int hot_x = GetOptionInt( wxIMAGE_OPTION_CUR_HOTSPOT_X );
-        image.SetOption(wxIMAGE_OPTION_CUR_HOTSPOT_Y,
-                        clockwise ? hot_x : width - 1 - hot_x);
-    }
+    // Approximate the Gaussian by 3 successive box blurs: the variance of a
+    // box filter of width w is (w^2 - 1)/12 and the variances of the
+    // successive passes add up, so choose the boxes of odd widths wl and
+    // wl + 2 in such proportion that the total variance is as close to
+    // sigma^2 as possible (see "Fast Almost-Gaussian Filtering" by Peter
+    // Kovesi).
+    const int numPasses = 3;
+    const double variance = sigma*sigma;
 
-    if ( HasOption(wxIMAGE_OPTION_CUR_HOTSPOT_Y) )
+    int wl = static_cast<int>(sqrt(12*variance/numPasses + 1));
+    if ( wl % 2 == 0 )
+        wl--;
+
+    const int m = wxRound((12*variance - numPasses*wl*wl - 4*numPasses*wl - 3*numPasses)
+                            / (-4*wl - 4));
+
+    int radii[numPasses];
+    for ( int i = 0; i < numPasses; i++ )
     {
-        int hot_y = GetOptionInt( wxIMAGE_OPTION_CUR_HOTSPOT_Y );
-        image.SetOption(wxIMAGE_OPTION_CUR_HOTSPOT_X,
-                        clockwise ? height - 1 - hot_y : hot_y);
+        const int w = i < m ? wl : wl + 2;
+        radii[i] = (w - 1) / 2;
     }
 
+    // Round the results of each pass to avoid darkening the image due to the
+    // accumulated truncation errors.
+    BoxBlurInPlace(ret_image, wxHORIZONTAL, radii, numPasses, true);
+    BoxBlurInPlace(ret_image, wxVERTICAL, radii, numPasses, true);
+
+    return ret_image;
+}
+
+namespace
+{
+
+// Fill the image, which must have the size of the source view with width and
+// height swapped and alpha if the source has it, with the rotated pixels.
+void DoRotate90(const wxImageView& src, bool clockwise, wxImage& image)
+{
+    const long height = src.GetHeight();
+    const long width  = src.GetWidth();
+
     unsigned char *data = image.GetData();
     unsigned char *target_data;
 
+    // Buffer used if the source data needs to be converted, big enough for
+    // the strips used below.
+    unsigned char buffer[64];
+
     // we rotate the image in 21-pixel (63-byte) wide strips
     // to make better use of cpu cache - memory transfers
     // (note: while much better than single-pixel "strips",
@@ -1371,7 +2152,7 @@ wxImage wxImage::Rotate90( bool clockwise ) const
         for (long j = 0; j < height; j++)
         {
             const unsigned char *source_data =
-                M_IMGDATA->m_data + (j*width + ii)*3;
+                src.GetPixelsRGB(ii, j, next_ii - ii, buffer);
 
             for (long i = ii; i < next_ii; i++)
             {
@@ -1391,9 +2172,7 @@ wxImage wxImage::Rotate90( bool clockwise ) const
         ii = next_ii;
     }
 
-    const unsigned char *source_alpha = M_IMGDATA->m_alpha;
-
-    if ( source_alpha )
+    if ( src.HasAlpha() )
     {
         unsigned char *alpha_data = image.GetAlpha();
 
@@ -1403,7 +2182,8 @@ wxImage wxImage::Rotate90( bool clockwise ) const
 
             for (long j = 0; j < height; j++)
             {
-                source_alpha = M_IMGDATA->m_alpha + j*width + ii;
+                const unsigned char *source_alpha =
+                    src.GetPixelsAlpha(ii, j, next_ii - ii, buffer);
 
                 for (long i = ii; i < next_ii; i++)
                 {
@@ -1424,6 +2204,34 @@ wxImage wxImage::Rotate90( bool clockwise ) const
             ii = next_ii;
         }
     }
+}
+
+} // anonymous namespace
+
+wxImage wxImage::Rotate90( bool clockwise ) const
+{
+    wxImage image(MakeEmptyClone(Clone_SwapOrientation));
+
+    wxCHECK( image.IsOk(), image );
+
+    long height = M_IMGDATA->m_height;
+    long width  = M_IMGDATA->m_width;
+
+    if ( HasOption(wxIMAGE_OPTION_CUR_HOTSPOT_X) )
+    {
+        int hot_x = GetOptionInt( wxIMAGE_OPTION_CUR_HOTSPOT_X );
+        image.SetOption(wxIMAGE_OPTION_CUR_HOTSPOT_Y,
+                        clockwise ? hot_x : width - 1 - hot_x);
+    }
+
+    if ( HasOption(wxIMAGE_OPTION_CUR_HOTSPOT_Y) )
+    {
+        int hot_y = GetOptionInt( wxIMAGE_OPTION_CUR_HOTSPOT_Y );
+        image.SetOption(wxIMAGE_OPTION_CUR_HOTSPOT_X,
+                        clockwise ? height - 1 - hot_y : hot_y);
+    }
+
+    DoRotate90(wxImageView(*this), clockwise, image);
 
     return image;
 }
@@ -1481,26 +2289,29 @@ wxImage wxImage::Rotate180() const
     return image;
 }
 
-wxImage wxImage::Mirror( bool horizontally ) const
+namespace
 {
-    wxImage image(MakeEmptyClone());
-
-    wxCHECK( image.IsOk(), image );
 
-    long height = M_IMGDATA->m_height;
-    long width  = M_IMGDATA->m_width;
+// Fill the image, which must have the same size as the source view and alpha
+// if the source has it, with the mirrored pixels.
+void DoMirror(const wxImageView& src, bool horizontally, wxImage& image)
+{
+    const long height = src.GetHeight();
+    const long width  = src.GetWidth();
 
     unsigned char *data = image.GetData();
-    unsigned char *alpha = image.GetAlpha();
-    const unsigned char *source_data = M_IMGDATA->m_data;
-    unsigned char *target_data;
+    unsigned char *alpha = src.HasAlpha() ? image.GetAlpha() : nullptr;
+
+    // Buffer used if the source data needs to be converted.
+    wxVector<unsigned char> buffer(static_cast<size_t>(width) * 3);
 
-    if (horizontally)
+    for (long j = 0; j < height; j++)
     {
-        for (long j = 0; j < height; j++)
+        const unsigned char *source_data = src.GetRowRGB(j, &buffer[0]);
+
+        if (horizontally)
         {
-            data += width*3;
-            target_data = data-3;
+            unsigned char *target_data = data + 3*width*(j+1) - 3;
             for (long i = 0; i < width; i++)
             {
                 memcpy( target_data, source_data, 3 );
@@ -1508,52 +2319,42 @@ wxImage wxImage::Mirror( bool horizontally ) const
                 target_data -= 3;
             }
         }
+        else
+        {
+            memcpy( data + 3*width*(height-1-j), source_data, (size_t)3*width );
+        }
 
-        if (alpha != nullptr)
+        if ( alpha )
         {
-            // src_alpha starts at the first pixel and increases by 1 after each step
-            // (a step here is the copy of the alpha value of one pixel)
-            const unsigned char *src_alpha = M_IMGDATA->m_alpha;
-            // dest_alpha starts just beyond the first line, decreases before each step,
-            // and after each line is finished, increases by 2 widths (skipping the line
-            // just copied and the line that will be copied next)
-            unsigned char *dest_alpha = alpha + width;
+            const unsigned char *src_alpha = src.GetRowAlpha(j, &buffer[0]);
 
-            for (long jj = 0; jj < height; ++jj)
+            if (horizontally)
             {
-                for (long i = 0; i < width; ++i) {
+                // dest_alpha starts just beyond the end of the line and
+                // decreases before each step
+                unsigned char *dest_alpha = alpha + width*(j+1);
+                for (long i = 0; i < width; ++i)
+                {
                     *(--dest_alpha) = *(src_alpha++); // copy one pixel
                 }
-                dest_alpha += 2 * width; // advance beyond the end of the next line
             }
-        }
-    }
-    else
-    {
-        for (long i = 0; i < height; i++)
-        {
-            target_data = data + 3*width*(height-1-i);
-            memcpy( target_data, source_data, (size_t)3*width );
-            source_data += 3*width;
-        }
-
-        if ( alpha )
-        {
-            // src_alpha starts at the first pixel and increases by 1 width after each step
-            // (a step here is the copy of the alpha channel of an entire line)
-            const unsigned char *src_alpha = M_IMGDATA->m_alpha;
-            // dest_alpha starts just beyond the last line (beyond the whole image)
-            // and decreases by 1 width before each step
-            unsigned char *dest_alpha = alpha + width * height;
-
-            for (long jj = 0; jj < height; ++jj)
+            else
             {
-                dest_alpha -= width;
-                memcpy( dest_alpha, src_alpha, (size_t)width );
-                src_alpha += width;
+                memcpy( alpha + width*(height-1-j), src_alpha, (size_t)width );
             }
         }
     }
+}
+
+} // anonymous namespace
+
+wxImage wxImage::Mirror( bool horizontally ) const
+{
+    wxImage image(MakeEmptyClone());
+
+    wxCHECK( image.IsOk(), image );
+
+    DoMirror(wxImageView(*this), horizontally, image);
 
     return image;
 }
@@ -2442,149 +3243,556 @@ bool wxImage::SetMaskFromImage(const wxImage& mask,
         }
     }
 
-    SetMaskColour(r, g, b);
-    SetMask(true);
+    SetMaskColour(r, g, b);
+    SetMask(true);
+
+    return true;
+}
+
+bool wxImage::ConvertAlphaToMask(unsigned char threshold)
+{
+    if ( !HasAlpha() )
+        return false;
+
+    unsigned char mr, mg, mb;
+    if ( !FindFirstUnusedColour(&mr, &mg, &mb) )
+    {
+        wxLogError( _("No unused colour in image being masked.") );
+        return false;
+    }
+
+    return ConvertAlphaToMask(mr, mg, mb, threshold);
+}
+
+bool wxImage::ConvertAlphaToMask(unsigned char mr,
+                                 unsigned char mg,
+                                 unsigned char mb,
+                                 unsigned char threshold)
+{
+    if ( !HasAlpha() )
+        return false;
+
+    AllocExclusive();
+
+    SetMask(true);
+    SetMaskColour(mr, mg, mb);
+
+    unsigned char *imgdata = GetData();
+    unsigned char *alphadata = GetAlpha();
+
+    int w = GetWidth();
+    int h = GetHeight();
+
+    for (int y = 0; y < h; y++)
+    {
+        for (int x = 0; x < w; x++, imgdata += 3, alphadata++)
+        {
+            if (*alphadata < threshold)
+            {
+                imgdata[0] = mr;
+                imgdata[1] = mg;
+                imgdata[2] = mb;
+            }
+        }
+    }
+
+    if ( !M_IMGDATA->m_staticAlpha )
+        free(M_IMGDATA->m_alpha);
+
+    M_IMGDATA->m_alpha = nullptr;
+    M_IMGDATA->m_staticAlpha = false;
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Palette functions
+// ----------------------------------------------------------------------------
+
+#if wxUSE_PALETTE
+
+bool wxImage::HasPalette() const
+{
+    if (!IsOk())
+        return false;
+
+    return M_IMGDATA->m_palette.IsOk();
+}
+
+const wxPalette& wxImage::GetPalette() const
+{
+    wxCHECK_MSG( IsOk(), wxNullPalette, wxT("invalid image") );
+
+    return M_IMGDATA->m_palette;
+}
+
+void wxImage::SetPalette(const wxPalette& palette)
+{
+    wxCHECK_RET( IsOk(), wxT("invalid image") );
+
+    AllocExclusive();
+
+    M_IMGDATA->m_palette = palette;
+}
+
+#endif // wxUSE_PALETTE
+
+// ----------------------------------------------------------------------------
+// Option functions (arbitrary name/value mapping)
+// ----------------------------------------------------------------------------
+
+void wxImage::SetOption(const wxString& name, const wxString& value)
+{
+    AllocExclusive();
+
+    int idx = M_IMGDATA->m_optionNames.Index(name, false);
+    if ( idx == wxNOT_FOUND )
+    {
+        M_IMGDATA->m_optionNames.Add(name);
+        M_IMGDATA->m_optionValues.Add(value);
+    }
+    else
+    {
+        M_IMGDATA->m_optionNames[idx] = name;
+        M_IMGDATA->m_optionValues[idx] = value;
+    }
+}
+
+void wxImage::SetOption(const wxString& name, int value)
+{
+    wxString valStr;
+    valStr.Printf(wxT("%d"), value);
+    SetOption(name, valStr);
+}
+
+wxString wxImage::GetOption(const wxString& name) const
+{
+    if ( !M_IMGDATA )
+        return wxEmptyString;
+
+    int idx = M_IMGDATA->m_optionNames.Index(name, false);
+    if ( idx == wxNOT_FOUND )
+        return wxEmptyString;
+    else
+        return M_IMGDATA->m_optionValues[idx];
+}
+
+int wxImage::GetOptionInt(const wxString& name) const
+{
+    return wxAtoi(GetOption(name));
+}
+
+bool wxImage::HasOption(const wxString& name) const
+{
+    return M_IMGDATA ? M_IMGDATA->m_optionNames.Index(name, false) != wxNOT_FOUND
+                     : false;
+}
+
+// ----------------------------------------------------------------------------
+// parallel processing
+// ----------------------------------------------------------------------------
+
+/* static */
+void wxImage::SetMaxThreads(int maxThreads)
+{
+    wxCHECK_RET( maxThreads >= 0, wxS("invalid number of threads") );
+
+    gs_imageMaxThreads = maxThreads;
+}
+
+/* static */
+int wxImage::GetMaxThreads()
+{
+    return gs_imageMaxThreads;
+}
+
+// ----------------------------------------------------------------------------
+// wxImageView
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Convert count pixels of N bytes each with the red, green and blue
+// components at the given offsets to RGB.
+template <int R, int G, int B, int N>
+void ConvertPixelsToRGB(const unsigned char* src, int count, unsigned char* dst)
+{
+    for ( int i = 0; i < count; i++, src += N, dst += 3 )
+    {
+        dst[0] = src[R];
+        dst[1] = src[G];
+        dst[2] = src[B];
+    }
+}
+
+} // anonymous namespace
+
+wxImageView::wxImageView(const void* data,
+                         int width,
+                         int height,
+                         wxImagePixelFormat format,
+                         int stride)
+{
+    wxCHECK_RET( data, wxS("null image view data") );
+    wxCHECK_RET( width > 0 && height > 0, wxS("invalid image view size") );
+
+    const int rowSize = width * GetBytesPerPixel(format);
+    if ( !stride )
+        stride = rowSize;
+
+    wxCHECK_RET( stride >= rowSize || -stride >= rowSize,
+                 wxS("image view stride is too small") );
+
+    m_data = static_cast<const unsigned char*>(data);
+    m_width = width;
+    m_height = height;
+    m_stride = stride;
+    m_format = format;
+}
+
+wxImageView::wxImageView(const wxImage& image)
+{
+    wxCHECK_RET( image.IsOk(), wxS("invalid image") );
+
+    m_data = image.GetData();
+    m_alpha = image.GetAlpha();
+    m_width = image.GetWidth();
+    m_height = image.GetHeight();
+    m_stride = 3*m_width;
+    m_alphaStride = m_width;
+    m_format = wxIMAGE_PIXEL_FORMAT_RGB;
+}
+
+wxImageView& wxImageView::SetAlpha(const void* alpha, int stride)
+{
+    wxCHECK_MSG( IsOk(), *this, wxS("invalid image view") );
+
+    if ( !stride )
+        stride = m_width;
+
+    wxCHECK_MSG( stride >= m_width || -stride >= m_width, *this,
+                 wxS("image view alpha stride is too small") );
+
+    m_alpha = static_cast<const unsigned char*>(alpha);
+    m_alphaStride = stride;
+
+    return *this;
+}
+
+/* static */
+int wxImageView::GetBytesPerPixel(wxImagePixelFormat format)
+{
+    switch ( format )
+    {
+        case wxIMAGE_PIXEL_FORMAT_RGB:
+        case wxIMAGE_PIXEL_FORMAT_BGR:
+            return 3;
+
+        case wxIMAGE_PIXEL_FORMAT_RGBA:
+        case wxIMAGE_PIXEL_FORMAT_BGRA:
+        case wxIMAGE_PIXEL_FORMAT_ARGB:
+        case wxIMAGE_PIXEL_FORMAT_RGBX:
+        case wxIMAGE_PIXEL_FORMAT_BGRX:
+            return 4;
+
+        case wxIMAGE_PIXEL_FORMAT_GREY:
+            return 1;
+    }
+
+    wxFAIL_MSG( wxS("unknown pixel format") );
+
+    return 0;
+}
+
+bool wxImageView::HasAlpha() const
+{
+    if ( m_alpha )
+        return true;
+
+    switch ( m_format )
+    {
+        case wxIMAGE_PIXEL_FORMAT_RGBA:
+        case wxIMAGE_PIXEL_FORMAT_BGRA:
+        case wxIMAGE_PIXEL_FORMAT_ARGB:
+            return true;
+
+        case wxIMAGE_PIXEL_FORMAT_RGB:
+        case wxIMAGE_PIXEL_FORMAT_BGR:
+        case wxIMAGE_PIXEL_FORMAT_RGBX:
+        case wxIMAGE_PIXEL_FORMAT_BGRX:
+        case wxIMAGE_PIXEL_FORMAT_GREY:
+            break;
+    }
+
+    return false;
+}
+
+wxImageView wxImageView::GetSubView(const wxRect& rect) const
+{
+    wxCHECK_MSG( IsOk(), wxImageView(), wxS("invalid image view") );
+    wxCHECK_MSG( !rect.IsEmpty() &&
+                    wxRect(GetSize()).Contains(rect), wxImageView(),
+                 wxS("invalid subview rectangle") );
+
+    wxImageView view(*this);
+    view.m_data += static_cast<ptrdiff_t>(rect.y) * m_stride +
+                    rect.x * GetBytesPerPixel(m_format);
+    if ( m_alpha )
+        view.m_alpha += static_cast<ptrdiff_t>(rect.y) * m_alphaStride + rect.x;
+    view.m_width = rect.width;
+    view.m_height = rect.height;
+
+    return view;
+}
+
+const unsigned char*
+wxImageView::GetPixelsRGB(int x, int y, int count, unsigned char* buffer) const
+{
+    wxASSERT_MSG( x >= 0 && count >= 0 && x + count <= m_width &&
+                    y >= 0 && y < m_height,
+                  wxS("invalid image view pixels") );
+
+    const unsigned char* const src = m_data +
+                                     static_cast<ptrdiff_t>(y) * m_stride +
+                                     x * GetBytesPerPixel(m_format);
+
+    switch ( m_format )
+    {
+        case wxIMAGE_PIXEL_FORMAT_RGB:
+            // No conversion needed.
+            return src;
+
+        case wxIMAGE_PIXEL_FORMAT_BGR:
+            ConvertPixelsToRGB<2, 1, 0, 3>(src, count, buffer);
+            break;
+
+        case wxIMAGE_PIXEL_FORMAT_RGBA:
+        case wxIMAGE_PIXEL_FORMAT_RGBX:
+            ConvertPixelsToRGB<0, 1, 2, 4>(src, count, buffer);
+            break;
+
+        case wxIMAGE_PIXEL_FORMAT_BGRA:
+        case wxIMAGE_PIXEL_FORMAT_BGRX:
+            ConvertPixelsToRGB<2, 1, 0, 4>(src, count, buffer);
+            break;
+
+        case wxIMAGE_PIXEL_FORMAT_ARGB:
+            ConvertPixelsToRGB<1, 2, 3, 4>(src, count, buffer);
+            break;
+
+        case wxIMAGE_PIXEL_FORMAT_GREY:
+            ConvertPixelsToRGB<0, 0, 0, 1>(src, count, buffer);
+            break;
+    }
 
-    return true;
+    return buffer;
 }
 
-bool wxImage::ConvertAlphaToMask(unsigned char threshold)
+const unsigned char*
+wxImageView::GetPixelsAlpha(int x, int y, int count, unsigned char* buffer) const
 {
-    if ( !HasAlpha() )
-        return false;
+    wxASSERT_MSG( x >= 0 && count >= 0 && x + count <= m_width &&
+                    y >= 0 && y < m_height,
+                  wxS("invalid image view pixels") );
 
-    unsigned char mr, mg, mb;
-    if ( !FindFirstUnusedColour(&mr, &mg, &mb) )
+    if ( m_alpha )
+        return m_alpha + static_cast<ptrdiff_t>(y) * m_alphaStride + x;
+
+    int offset;
+    switch ( m_format )
     {
-        wxLogError( _("No unused colour in image being masked.") );
-        return false;
+        case wxIMAGE_PIXEL_FORMAT_RGBA:
+        case wxIMAGE_PIXEL_FORMAT_BGRA:
+            offset = 3;
+            break;
+
+        case wxIMAGE_PIXEL_FORMAT_ARGB:
+            offset = 0;
+            break;
+
+        case wxIMAGE_PIXEL_FORMAT_RGB:
+        case wxIMAGE_PIXEL_FORMAT_BGR:
+        case wxIMAGE_PIXEL_FORMAT_RGBX:
+        case wxIMAGE_PIXEL_FORMAT_BGRX:
+        case wxIMAGE_PIXEL_FORMAT_GREY:
+        default:
+            return nullptr;
     }
 
-    return ConvertAlphaToMask(mr, mg, mb, threshold);
+    const unsigned char* src = m_data +
+                               static_cast<ptrdiff_t>(y) * m_stride +
+                               x * 4 + offset;
+    for ( int i = 0; i < count; i++, src += 4 )
+        buffer[i] = *src;
+
+    return buffer;
 }
 
-bool wxImage::ConvertAlphaToMask(unsigned char mr,
-                                 unsigned char mg,
-                                 unsigned char mb,
-                                 unsigned char threshold)
+wxImage wxImageView::ToImage() const
 {
-    if ( !HasAlpha() )
-        return false;
-
-    AllocExclusive();
-
-    SetMask(true);
-    SetMaskColour(mr, mg, mb);
+    wxCHECK_MSG( IsOk(), wxImage(), wxS("invalid image view") );
 
-    unsigned char *imgdata = GetData();
-    unsigned char *alphadata = GetAlpha();
+    wxImage image(m_width, m_height, false);
+    unsigned char* const data = image.GetData();
+    wxCHECK_MSG( data, image, wxS("unable to create image") );
 
-    int w = GetWidth();
-    int h = GetHeight();
+    unsigned char* alpha = nullptr;
+    if ( HasAlpha() )
+    {
+        image.SetAlpha();
+        alpha = image.GetAlpha();
+    }
 
-    for (int y = 0; y < h; y++)
+    const size_t width = m_width;
+    wxForEachImageRowBand(m_height, m_width, [=](int start, int end)
     {
-        for (int x = 0; x < w; x++, imgdata += 3, alphadata++)
+        for ( int y = start; y < end; y++ )
         {
-            if (*alphadata < threshold)
+            // Convert directly into the image if necessary.
+            unsigned char* const dst = data + y * width * 3;
+            const unsigned char* const src = GetRowRGB(y, dst);
+            if ( src != dst )
+                memcpy(dst, src, width * 3);
+
+            if ( alpha )
             {
-                imgdata[0] = mr;
-                imgdata[1] = mg;
-                imgdata[2] = mb;
+                unsigned char* const dstAlpha = alpha + y * width;
+                const unsigned char* const srcAlpha = GetRowAlpha(y, dstAlpha);
+                if ( srcAlpha != dstAlpha )
+                    memcpy(dstAlpha, srcAlpha, width);
             }
         }
-    }
+    });
 
-    if ( !M_IMGDATA->m_staticAlpha )
-        free(M_IMGDATA->m_alpha);
+    return image;
+}
 
-    M_IMGDATA->m_alpha = nullptr;
-    M_IMGDATA->m_staticAlpha = false;
+wxImage
+wxImageView::Scale(int width, int height, wxImageResizeQuality quality) const
+{
+    wxCHECK_MSG( IsOk(), wxImage(), wxS("invalid image view") );
 
-    return true;
-}
+    // can't scale to 0 size
+    wxCHECK_MSG( (width > 0) && (height > 0), wxImage(),
+                 wxS("invalid new image size") );
 
-// ----------------------------------------------------------------------------
-// Palette functions
-// ----------------------------------------------------------------------------
+    if ( width == m_width && height == m_height )
+        return ToImage();
 
-#if wxUSE_PALETTE
+    // This does the same thing as wxImage::Scale(), see the comments there.
+    switch ( quality )
+    {
+        case wxIMAGE_QUALITY_NORMAL:
+            if ( width <= m_width && height <= m_height )
+            {
+                const double shrinkFactorX = double(m_width) / width;
+                const double shrinkFactorY = double(m_height) / height;
 
-bool wxImage::HasPalette() const
-{
-    if (!IsOk())
-        return false;
+                const int shrinkInt(wxMin(shrinkFactorX, shrinkFactorY));
 
-    return M_IMGDATA->m_palette.IsOk();
+                wxImage image = DoResampleBilinear(*this,
+                                                   width * shrinkInt,
+                                                   height * shrinkInt);
+                if ( shrinkInt != 1 )
+                    image = image.ResampleBox(width, height);
+                return image;
+            }
+            return DoResampleBox(*this, width, height);
+
+        case wxIMAGE_QUALITY_FAST:
+        case wxIMAGE_QUALITY_NEAREST:
+            if ( m_width % width == 0 && m_width >= width &&
+                    m_height % height == 0 && m_height >= height )
+            {
+                return DoShrinkBy(*this, m_width / width, m_height / height);
+            }
+            return DoResampleNearest(*this, width, height);
+
+        case wxIMAGE_QUALITY_BILINEAR:
+            return DoResampleBilinear(*this, width, height);
+
+        case wxIMAGE_QUALITY_BICUBIC:
+            return DoResampleBicubic(*this, width, height);
+
+        case wxIMAGE_QUALITY_BOX_AVERAGE:
+            return DoResampleBox(*this, width, height);
+
+        case wxIMAGE_QUALITY_HIGH:
+            return width < m_width && height < m_height
+                        ? DoResampleBox(*this, width, height)
+                        : DoResampleBicubic(*this, width, height);
+    }
+
+    wxFAIL_MSG( wxS("unknown resize quality") );
+
+    return wxImage();
 }
 
-const wxPalette& wxImage::GetPalette() const
+wxImage wxImageView::Rotate90(bool clockwise) const
 {
-    wxCHECK_MSG( IsOk(), wxNullPalette, wxT("invalid image") );
+    wxCHECK_MSG( IsOk(), wxImage(), wxS("invalid image view") );
 
-    return M_IMGDATA->m_palette;
+    wxImage image(m_height, m_width, false);
+    wxCHECK_MSG( image.IsOk(), image, wxS("unable to create image") );
+
+    if ( HasAlpha() )
+        image.SetAlpha();
+
+    DoRotate90(*this, clockwise, image);
+
+    return image;
 }
 
-void wxImage::SetPalette(const wxPalette& palette)
+wxImage wxImageView::Mirror(bool horizontally) const
 {
-    wxCHECK_RET( IsOk(), wxT("invalid image") );
+    wxCHECK_MSG( IsOk(), wxImage(), wxS("invalid image view") );
 
-    AllocExclusive();
+    wxImage image(m_width, m_height, false);
+    wxCHECK_MSG( image.IsOk(), image, wxS("unable to create image") );
 
-    M_IMGDATA->m_palette = palette;
-}
+    if ( HasAlpha() )
+        image.SetAlpha();
 
-#endif // wxUSE_PALETTE
+    DoMirror(*this, horizontally, image);
 
-// ----------------------------------------------------------------------------
-// Option functions (arbitrary name/value mapping)
-// ----------------------------------------------------------------------------
+    return image;
+}
 
-void wxImage::SetOption(const wxString& name, const wxString& value)
+wxImage wxImageView::AsImage() const
 {
-    AllocExclusive();
+    wxCHECK_MSG( IsOk(), wxImage(), wxS("invalid image view") );
 
-    int idx = M_IMGDATA->m_optionNames.Index(name, false);
-    if ( idx == wxNOT_FOUND )
-    {
-        M_IMGDATA->m_optionNames.Add(name);
-        M_IMGDATA->m_optionValues.Add(value);
-    }
-    else
+    if ( m_format == wxIMAGE_PIXEL_FORMAT_RGB &&
+            m_stride == 3*m_width &&
+                (!m_alpha || m_alphaStride == m_width) )
     {
-        M_IMGDATA->m_optionNames[idx] = name;
-        M_IMGDATA->m_optionValues[idx] = value;
+        // The data is in the format used by wxImage, so we can just use it
+        // directly: static data is not freed by wxImage and this image is
+        // only used for saving, which doesn't modify it.
+        wxImage image(m_width, m_height,
+                      const_cast<unsigned char*>(m_data), true);
+        if ( m_alpha )
+            image.SetAlpha(const_cast<unsigned char*>(m_alpha), true);
+
+        return image;
     }
-}
 
-void wxImage::SetOption(const wxString& name, int value)
-{
-    wxString valStr;
-    valStr.Printf(wxT("%d"), value);
-    SetOption(name, valStr);
+    return ToImage();
 }
 
-wxString wxImage::GetOption(const wxString& name) const
-{
-    if ( !M_IMGDATA )
-        return wxEmptyString;
-
-    int idx = M_IMGDATA->m_optionNames.Index(name, false);
-    if ( idx == wxNOT_FOUND )
-        return wxEmptyString;
-    else
-        return M_IMGDATA->m_optionValues[idx];
-}
+#if wxUSE_STREAMS
 
-int wxImage::GetOptionInt(const wxString& name) const
+bool wxImageView::SaveFile(wxOutputStream& stream, wxBitmapType type) const
 {
-    return wxAtoi(GetOption(name));
+    return AsImage().SaveFile(stream, type);
 }
 
-bool wxImage::HasOption(const wxString& name) const
+#endif // wxUSE_STREAMS
+
+bool wxImageView::SaveFile(const wxString& name, wxBitmapType type) const
 {
-    return M_IMGDATA ? M_IMGDATA->m_optionNames.Index(name, false) != wxNOT_FOUND
-                     : false;
+    return AsImage().SaveFile(name, type);
 }
 
 // ----------------------------------------------------------------------------
@@ -3520,6 +4728,42 @@ bool wxImageHandler::CallDoCanRead(wxInputStream& stream)
             .CallIfCanSeek(&wxImageHandler::DoCanRead, this);
 }
 
+bool wxImageHandler::LoadRows(wxImageRowConsumer& consumer,
+                              wxInputStream& stream,
+                              bool verbose,
+                              int index)
+{
+    wxImage image;
+
+    const wxSize maxSize = consumer.GetMaxSize();
+    if ( maxSize.x > 0 )
+        image.SetOption(wxIMAGE_OPTION_MAX_WIDTH, maxSize.x);
+    if ( maxSize.y > 0 )
+        image.SetOption(wxIMAGE_OPTION_MAX_HEIGHT, maxSize.y);
+
+    if ( !LoadFile(&image, stream, verbose, index) )
+        return false;
+
+    const int width = image.GetWidth();
+    const int height = image.GetHeight();
+    const unsigned char* const data = image.GetData();
+    const unsigned char* const alpha = image.GetAlpha();
+
+    if ( !consumer.OnImageStart(width, height, alpha != nullptr) )
+        return false;
+
+    for ( int y = 0; y < height; y++ )
+    {
+        const size_t offset = static_cast<size_t>(y) * width;
+        if ( !consumer.OnImageRow(y,
+                                  data + offset * 3,
+                                  alpha ? alpha + offset : nullptr) )
+            return false;
+    }
+
+    return true;
+}
+
 #endif // wxUSE_STREAMS
 
 /* static */
@@ -3730,11 +4974,8 @@ wxImage wxImage::Rotate(double angle,
         *offset_after_rotation = wxPoint (x1a, y1a);
     }
 
-    // the rotated (destination) image is always accessed sequentially via this
-    // pointer, there is no need for pointer-based arrays here
-    unsigned char *dst = rotated.GetData();
-
-    unsigned char *alpha_dst = has_alpha ? rotated.GetAlpha() : nullptr;
+    unsigned char * const rotated_data = rotated.GetData();
+    unsigned char * const rotated_alpha = has_alpha ? rotated.GetAlpha() : nullptr;
 
     // if the original image has a mask, use its RGB values as the blank pixel,
     // else, fall back to default (black).
@@ -3757,188 +4998,199 @@ wxImage wxImage::Rotate(double angle,
     const int rH = rotated.GetHeight();
     const int rW = rotated.GetWidth();
 
-    // do the (interpolating) test outside of the loops, so that it is done
-    // only once, instead of repeating it for each pixel.
-    if (interpolating)
+    wxForEachImageRowBand(rH, rW, [&](int start, int end)
     {
-        for (int y = 0; y < rH; y++)
+        // the rotated (destination) image is always accessed sequentially via
+        // these pointers, there is no need for pointer-based arrays here
+        unsigned char *dst = rotated_data + static_cast<size_t>(start) * rW * 3;
+
+        unsigned char *alpha_dst = has_alpha
+                                    ? rotated_alpha + static_cast<size_t>(start) * rW
+                                    : nullptr;
+
+        // do the (interpolating) test outside of the loops, so that it is done
+        // only once, instead of repeating it for each pixel.
+        if (interpolating)
         {
-            for (int x = 0; x < rW; x++)
+            for (int y = start; y < end; y++)
             {
-                wxRealPoint src = wxRotatePoint (x + x1a, y + y1a, cos_angle, -sin_angle, p0);
-
-                if (-0.25 < src.x && src.x < w - 0.75 &&
-                    -0.25 < src.y && src.y < h - 0.75)
+                for (int x = 0; x < rW; x++)
                 {
-                    // interpolate using the 4 enclosing grid-points.  Those
-                    // points can be obtained using floor and ceiling of the
-                    // exact coordinates of the point
-                    int x1, y1, x2, y2;
+                    wxRealPoint src = wxRotatePoint (x + x1a, y + y1a, cos_angle, -sin_angle, p0);
 
-                    if (0 < src.x && src.x < w - 1)
-                    {
-                        x1 = (int) floor(src.x);
-                        x2 = (int) ceil(src.x);
-                    }
-                    else    // else means that x is near one of the borders (0 or width-1)
+                    if (-0.25 < src.x && src.x < w - 0.75 &&
+                        -0.25 < src.y && src.y < h - 0.75)
                     {
-                        x1 = x2 = wxRound (src.x);
-                    }
+                        // interpolate using the 4 enclosing grid-points.  Those
+                        // points can be obtained using floor and ceiling of the
+                        // exact coordinates of the point
+                        int x1, y1, x2, y2;
 
-                    if (0 < src.y && src.y < h - 1)
-                    {
-                        y1 = (int) floor(src.y);
-                        y2 = (int) ceil(src.y);
-                    }
-                    else
-                    {
-                        y1 = y2 = wxRound (src.y);
-                    }
+                        if (0 < src.x && src.x < w - 1)
+                        {
+                            x1 = (int) floor(src.x);
+                            x2 = (int) ceil(src.x);
+                        }
+                        else    // else means that x is near one of the borders (0 or width-1)
+                        {
+                            x1 = x2 = wxRound (src.x);
+                        }
 
-                    // get four points and the distances (square of the distance,
-                    // for efficiency reasons) for the interpolation formula
+                        if (0 < src.y && src.y < h - 1)
+                        {
+                            y1 = (int) floor(src.y);
+                            y2 = (int) ceil(src.y);
+                        }
+                        else
+                        {
+                            y1 = y2 = wxRound (src.y);
+                        }
 
-                    // GRG: Do not calculate the points until they are
-                    //      really needed -- this way we can calculate
-                    //      just one, instead of four, if d1, d2, d3
-                    //      or d4 are < wxROTATE_EPSILON
+                        // get four points and the distances (square of the distance,
+                        // for efficiency reasons) for the interpolation formula
 
-                    const double d1 = (src.x - x1) * (src.x - x1) + (src.y - y1) * (src.y - y1);
-                    const double d2 = (src.x - x2) * (src.x - x2) + (src.y - y1) * (src.y - y1);
-                    const double d3 = (src.x - x2) * (src.x - x2) + (src.y - y2) * (src.y - y2);
-                    const double d4 = (src.x - x1) * (src.x - x1) + (src.y - y2) * (src.y - y2);
+                        // GRG: Do not calculate the points until they are
+                        //      really needed -- this way we can calculate
+                        //      just one, instead of four, if d1, d2, d3
+                        //      or d4 are < wxROTATE_EPSILON
 
-                    // Now interpolate as a weighted average of the four surrounding
-                    // points, where the weights are the distances to each of those points
+                        const double d1 = (src.x - x1) * (src.x - x1) + (src.y - y1) * (src.y - y1);
+                        const double d2 = (src.x - x2) * (src.x - x2) + (src.y - y1) * (src.y - y1);
+                        const double d3 = (src.x - x2) * (src.x - x2) + (src.y - y2) * (src.y - y2);
+                        const double d4 = (src.x - x1) * (src.x - x1) + (src.y - y2) * (src.y - y2);
 
-                    // If the point is exactly at one point of the grid of the source
-                    // image, then don't interpolate -- just assign the pixel
+                        // Now interpolate as a weighted average of the four surrounding
+                        // points, where the weights are the distances to each of those points
 
-                    // d1,d2,d3,d4 are positive -- no need for abs()
-                    if (d1 < wxROTATE_EPSILON)
-                    {
-                        unsigned char *p = data[y1] + (3 * x1);
-                        *(dst++) = *(p++);
-                        *(dst++) = *(p++);
-                        *(dst++) = *p;
+                        // If the point is exactly at one point of the grid of the source
+                        // image, then don't interpolate -- just assign the pixel
 
-                        if (has_alpha)
-                            *(alpha_dst++) = *(alpha[y1] + x1);
-                    }
-                    else if (d2 < wxROTATE_EPSILON)
-                    {
-                        unsigned char *p = data[y1] + (3 * x2);
-                        *(dst++) = *(p++);
-                        *(dst++) = *(p++);
-                        *(dst++) = *p;
+                        // d1,d2,d3,d4 are positive -- no need for abs()
+                        if (d1 < wxROTATE_EPSILON)
+                        {
+                            unsigned char *p = data[y1] + (3 * x1);
+                            *(dst++) = *(p++);
+                            *(dst++) = *(p++);
+                            *(dst++) = *p;
 
-                        if (has_alpha)
-                            *(alpha_dst++) = *(alpha[y1] + x2);
-                    }
-                    else if (d3 < wxROTATE_EPSILON)
-                    {
-                        unsigned char *p = data[y2] + (3 * x2);
-                        *(dst++) = *(p++);
-                        *(dst++) = *(p++);
-                        *(dst++) = *p;
+                            if (has_alpha)
+                                *(alpha_dst++) = *(alpha[y1] + x1);
+                        }
+                        else if (d2 < wxROTATE_EPSILON)
+                        {
+                            unsigned char *p = data[y1] + (3 * x2);
+                            *(dst++) = *(p++);
+                            *(dst++) = *(p++);
+                            *(dst++) = *p;
 
-                        if (has_alpha)
-                            *(alpha_dst++) = *(alpha[y2] + x2);
-                    }
-                    else if (d4 < wxROTATE_EPSILON)
-                    {
-                        unsigned char *p = data[y2] + (3 * x1);
-                        *(dst++) = *(p++);
-                        *(dst++) = *(p++);
-                        *(dst++) = *p;
+                            if (has_alpha)
+                                *(alpha_dst++) = *(alpha[y1] + x2);
+                        }
+                        else if (d3 < wxROTATE_EPSILON)
+                        {
+                            unsigned char *p = data[y2] + (3 * x2);
+                            *(dst++) = *(p++);
+                            *(dst++) = *(p++);
+                            *(dst++) = *p;
 
-                        if (has_alpha)
-                            *(alpha_dst++) = *(alpha[y2] + x1);
-                    }
-                    else
-                    {
-                        // weights for the weighted average are proportional to the inverse of the distance
-                        unsigned char *v1 = data[y1] + (3 * x1);
-                        unsigned char *v2 = data[y1] + (3 * x2);
-                        unsigned char *v3 = data[y2] + (3 * x2);
-                        unsigned char *v4 = data[y2] + (3 * x1);
-
-                        const double w1 = 1/d1, w2 = 1/d2, w3 = 1/d3, w4 = 1/d4;
-
-                        // GRG: Unrolled.
-
-                        *(dst++) = (unsigned char)
-                            ( (w1 * *(v1++) + w2 * *(v2++) +
-                               w3 * *(v3++) + w4 * *(v4++)) /
-                              (w1 + w2 + w3 + w4) );
-                        *(dst++) = (unsigned char)
-                            ( (w1 * *(v1++) + w2 * *(v2++) +
-                               w3 * *(v3++) + w4 * *(v4++)) /
-                              (w1 + w2 + w3 + w4) );
-                        *(dst++) = (unsigned char)
-                            ( (w1 * *v1 + w2 * *v2 +
-                               w3 * *v3 + w4 * *v4) /
-                              (w1 + w2 + w3 + w4) );
+                            if (has_alpha)
+                                *(alpha_dst++) = *(alpha[y2] + x2);
+                        }
+                        else if (d4 < wxROTATE_EPSILON)
+                        {
+                            unsigned char *p = data[y2] + (3 * x1);
+                            *(dst++) = *(p++);
+                            *(dst++) = *(p++);
+                            *(dst++) = *p;
 
-                        if (has_alpha)
+                            if (has_alpha)
+                                *(alpha_dst++) = *(alpha[y2] + x1);
+                        }
+                        else
                         {
-                            v1 = alpha[y1] + (x1);
-                            v2 = alpha[y1] + (x2);
-                            v3 = alpha[y2] + (x2);
-                            v4 = alpha[y2] + (x1);
+                            // weights for the weighted average are proportional to the inverse of the distance
+                            unsigned char *v1 = data[y1] + (3 * x1);
+                            unsigned char *v2 = data[y1] + (3 * x2);
+                            unsigned char *v3 = data[y2] + (3 * x2);
+                            unsigned char *v4 = data[y2] + (3 * x1);
+
+                            const double w1 = 1/d1, w2 = 1/d2, w3 = 1/d3, w4 = 1/d4;
+
+                            // GRG: Unrolled.
 
-                            *(alpha_dst++) = (unsigned char)
+                            *(dst++) = (unsigned char)
+                                ( (w1 * *(v1++) + w2 * *(v2++) +
+                                   w3 * *(v3++) + w4 * *(v4++)) /
+                                  (w1 + w2 + w3 + w4) );
+                            *(dst++) = (unsigned char)
+                                ( (w1 * *(v1++) + w2 * *(v2++) +
+                                   w3 * *(v3++) + w4 * *(v4++)) /
+                                  (w1 + w2 + w3 + w4) );
+                            *(dst++) = (unsigned char)
                                 ( (w1 * *v1 + w2 * *v2 +
                                    w3 * *v3 + w4 * *v4) /
                                   (w1 + w2 + w3 + w4) );
+
+                            if (has_alpha)
+                            {
+                                v1 = alpha[y1] + (x1);
+                                v2 = alpha[y1] + (x2);
+                                v3 = alpha[y2] + (x2);
+                                v4 = alpha[y2] + (x1);
+
+                                *(alpha_dst++) = (unsigned char)
+                                    ( (w1 * *v1 + w2 * *v2 +
+                                       w3 * *v3 + w4 * *v4) /
+                                      (w1 + w2 + w3 + w4) );
+                            }
                         }
                     }
-                }
-                else
-                {
-                    *(dst++) = blank_r;
-                    *(dst++) = blank_g;
-                    *(dst++) = blank_b;
+                    else
+                    {
+                        *(dst++) = blank_r;
+                        *(dst++) = blank_g;
+                        *(dst++) = blank_b;
 
-                    if (has_alpha)
-                        *(alpha_dst++) = 0;
+                        if (has_alpha)
+                            *(alpha_dst++) = 0;
+                    }
                 }
             }
         }
-    }
-    else // not interpolating
-    {
-        for (int y = 0; y < rH; y++)
+        else // not interpolating
         {
-            for (int x = 0; x < rW; x++)
+            for (int y = start; y < end; y++)
             {
-                wxRealPoint src = wxRotatePoint (x + x1a, y + y1a, cos_angle, -sin_angle, p0);
+                for (int x = 0; x < rW; x++)
+                {
+                    wxRealPoint src = wxRotatePoint (x + x1a, y + y1a, cos_angle, -sin_angle, p0);
 
-                const int xs = wxRound (src.x);      // wxRound rounds to the
-                const int ys = wxRound (src.y);      // closest integer
+                    const int xs = wxRound (src.x);      // wxRound rounds to the
+                    const int ys = wxRound (src.y);      // closest integer
 
-                if (0 <= xs && xs < w && 0 <= ys && ys < h)
-                {
-                    unsigned char *p = data[ys] + (3 * xs);
-                    *(dst++) = *(p++);
-                    *(dst++) = *(p++);
-                    *(dst++) = *p;
+                    if (0 <= xs && xs < w && 0 <= ys && ys < h)
+                    {
+                        unsigned char *p = data[ys] + (3 * xs);
+                        *(dst++) = *(p++);
+                        *(dst++) = *(p++);
+                        *(dst++) = *p;
 
-                    if (has_alpha)
-                        *(alpha_dst++) = *(alpha[ys] + (xs));
-                }
-                else
-                {
-                    *(dst++) = blank_r;
-                    *(dst++) = blank_g;
-                    *(dst++) = blank_b;
+                        if (has_alpha)
+                            *(alpha_dst++) = *(alpha[ys] + (xs));
+                    }
+                    else
+                    {
+                        *(dst++) = blank_r;
+                        *(dst++) = blank_g;
+                        *(dst++) = blank_b;
 
-                    if (has_alpha)
-                        *(alpha_dst++) = 255;
+                        if (has_alpha)
+                            *(alpha_dst++) = 255;
+                    }
                 }
             }
         }
-    }
+    });
 
     delete [] data;
     delete [] alpha;
@@ -3952,13 +5204,19 @@ void wxImage::ApplyToAllPixels(const F& func)
 {
     AllocExclusive();
 
-    const size_t size = GetWidth() * GetHeight();
-    unsigned char *data = GetData();
+    const int width = GetWidth();
+    unsigned char* const data = GetData();
 
-    for ( size_t i = 0; i < size; i++, data += 3 )
+    wxForEachImageRowBand(GetHeight(), width, [=, &func](int start, int end)
     {
-        func(data);
-    }
+        unsigned char* p = data + static_cast<size_t>(start) * width * 3;
+        const size_t size = static_cast<size_t>(end - start) * width;
+
+        for ( size_t i = 0; i < size; i++, p += 3 )
+        {
+            func(p);
+        }
+    });
 }
 
 // A module to allow wxImage initialization/cleanup
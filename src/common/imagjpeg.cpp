@@ -224,6 +224,33 @@ static inline void wx_cmyk_to_rgb(unsigned char* rgb, const unsigned char* cmyk)
     rgb[2] = (unsigned char)((c > 255) ? 0 : (255 - c));
 }
 
+// Choose the largest downscaling factor supported by libjpeg IDCT itself, i.e.
+// 1/2, 1/4 or 1/8, for which the image still doesn't fit into the given size:
+// this is much cheaper than decoding the full image and rescaling it later as
+// the skipped DCT coefficients are not even computed.
+static void wx_jpeg_set_max_size(j_decompress_ptr cinfo,
+                                 unsigned maxWidth,
+                                 unsigned maxHeight)
+{
+    // all libjpeg versions support power of 2 scale factors up to 8, any
+    // further reduction must be done by the caller
+    static const unsigned MAX_SCALE_DENOM = 8;
+
+    if ( !maxWidth && !maxHeight )
+        return;
+
+    unsigned scale = 1;
+    while ( scale < MAX_SCALE_DENOM &&
+                ((maxWidth && (cinfo->image_width / scale > maxWidth)) ||
+                 (maxHeight && (cinfo->image_height / scale > maxHeight))) )
+    {
+        scale *= 2;
+    }
+
+    cinfo->scale_num = 1;
+    cinfo->scale_denom = scale;
+}
+
 // temporarily disable the warning C4611 (interaction between '_setjmp' and
 // C++ object destruction is non-portable) - I don't see any dtors here
 #ifdef __VISUALC__
@@ -280,16 +307,9 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
         bytesPerPixel = 3;
     }
 
-    // scale the picture to fit in the specified max size if necessary
-    if ( maxWidth > 0 || maxHeight > 0 )
-    {
-        unsigned& scale = cinfo.scale_denom;
-        while ( (maxWidth && (cinfo.image_width / scale > maxWidth)) ||
-                    (maxHeight && (cinfo.image_height / scale > maxHeight)) )
-        {
-            scale *= 2;
-        }
-    }
+    // scale the picture to fit in the specified max size if necessary, any
+    // remaining scaling is done by wxImage::DoLoad()
+    wx_jpeg_set_max_size( &cinfo, maxWidth, maxHeight );
 
     jpeg_start_decompress( &cinfo );
 
@@ -349,6 +369,104 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     return true;
 }
 
+bool wxJPEGHandler::LoadRows(wxImageRowConsumer& consumer,
+                             wxInputStream& stream,
+                             bool verbose,
+                             int WXUNUSED(index))
+{
+    struct jpeg_decompress_struct cinfo;
+    wx_error_mgr jerr;
+
+    cinfo.err = jpeg_std_error( &jerr );
+    jerr.error_exit = wx_error_exit;
+
+    if (!verbose)
+        cinfo.err->output_message = wx_ignore_message;
+
+    /* Establish the setjmp return context for wx_error_exit to use. */
+    if (setjmp(jerr.setjmp_buffer)) {
+      if (verbose)
+      {
+        wxLogError(_("JPEG: Couldn't load - file is probably corrupted."));
+      }
+      (cinfo.src->term_source)(&cinfo);
+      jpeg_destroy_decompress(&cinfo);
+      return false;
+    }
+
+    jpeg_create_decompress( &cinfo );
+    wx_jpeg_io_src( &cinfo, stream );
+    jpeg_read_header( &cinfo, TRUE );
+
+    int bytesPerPixel;
+    if ((cinfo.out_color_space == JCS_CMYK) || (cinfo.out_color_space == JCS_YCCK))
+    {
+        cinfo.out_color_space = JCS_CMYK;
+        bytesPerPixel = 4;
+    }
+    else // all the rest is treated as RGB
+    {
+        cinfo.out_color_space = JCS_RGB;
+        bytesPerPixel = 3;
+    }
+
+    const wxSize maxSize = consumer.GetMaxSize();
+    wx_jpeg_set_max_size( &cinfo, wxMax(maxSize.x, 0), wxMax(maxSize.y, 0) );
+
+    jpeg_start_decompress( &cinfo );
+
+    if ( !consumer.OnImageStart(cinfo.output_width, cinfo.output_height, false) )
+    {
+        (cinfo.src->term_source)(&cinfo);
+        jpeg_destroy_decompress( &cinfo );
+        return false;
+    }
+
+    unsigned stride = cinfo.output_width * bytesPerPixel;
+    JSAMPARRAY tempbuf = (*cinfo.mem->alloc_sarray)
+                            ((j_common_ptr) &cinfo, JPOOL_IMAGE, stride, 1 );
+
+    // buffer for the rows converted from CMYK, if necessary: notice that it
+    // is freed by jpeg_destroy_decompress(), even in case of error
+    unsigned char* rgb = nullptr;
+    if (cinfo.out_color_space != JCS_RGB)
+    {
+        rgb = static_cast<unsigned char*>((*cinfo.mem->alloc_large)
+                ((j_common_ptr) &cinfo, JPOOL_IMAGE, 3 * cinfo.output_width));
+    }
+
+    while ( cinfo.output_scanline < cinfo.output_height )
+    {
+        const JDIMENSION y = cinfo.output_scanline;
+        jpeg_read_scanlines( &cinfo, tempbuf, 1 );
+
+        const unsigned char* row = (const unsigned char*) tempbuf[0];
+        if (cinfo.out_color_space != JCS_RGB) // CMYK
+        {
+            unsigned char* ptr = rgb;
+            for (size_t i = 0; i < cinfo.output_width; i++)
+            {
+                wx_cmyk_to_rgb(ptr, row);
+                ptr += 3;
+                row += 4;
+            }
+
+            row = rgb;
+        }
+
+        if ( !consumer.OnImageRow(y, row, nullptr) )
+        {
+            (cinfo.src->term_source)(&cinfo);
+            jpeg_destroy_decompress( &cinfo );
+            return false;
+        }
+    }
+
+    jpeg_finish_decompress( &cinfo );
+    jpeg_destroy_decompress( &cinfo );
+    return true;
+}
+
 typedef struct {
     struct jpeg_destination_mgr pub;
 
@@ -22,20 +22,27 @@
 
 #include "wx/imagpng.h"
 #include "wx/versioninfo.h"
+#include "wx/mstream.h"
+#include "wx/zstream.h"
+#include "wx/private/image.h"
 
 #ifndef WX_PRECOMP
     #include "wx/log.h"
     #include "wx/intl.h"
     #include "wx/palette.h"
     #include "wx/stream.h"
+    #include "wx/utils.h"
 #endif
 
 #include "png.h"
 
 // For memcpy
 #include <string.h>
+#include <stdlib.h>
+#include <limits.h>
 
 #include <unordered_map>
+#include <vector>
 
 #define wxIMAGE_OPTION_PNG_DESCRIPTION_KEY "Description"
 
@@ -109,9 +116,11 @@ struct wxPNGImageData
     {
         lines = nullptr;
         m_buf = nullptr;
+        m_rowBuf = nullptr;
         info_ptr = (png_infop) nullptr;
         png_ptr = (png_structp) nullptr;
         ok = false;
+        cancelled = false;
     }
 
     bool Alloc(png_uint_32 width, png_uint_32 height, unsigned char* buf)
@@ -144,6 +153,7 @@ struct wxPNGImageData
     ~wxPNGImageData()
     {
         free(m_buf);
+        free(m_rowBuf);
         free( lines );
 
         if ( png_ptr )
@@ -157,11 +167,31 @@ struct wxPNGImageData
 
     void DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo);
 
+    // Same as DoLoadPNGFile() but passes the rows to the consumer instead of
+    // storing them in wxImage.
+    void DoLoadPNGRows(wxImageRowConsumer& consumer, wxPNGInfoStruct& wxinfo);
+
+    // Pass the row in the format returned by libpng to the consumer and set
+    // "cancelled" and return false if it asks to stop.
+    bool SendRow(wxImageRowConsumer& consumer,
+                 png_uint_32 y,
+                 const unsigned char* row,
+                 png_uint_32 width,
+                 bool hasAlpha);
+
     unsigned char** lines;
     unsigned char* m_buf;
+
+    // Buffer used for splitting RGBA rows into RGB and alpha in
+    // DoLoadPNGRows().
+    unsigned char* m_rowBuf;
+
     png_infop info_ptr;
     png_structp png_ptr;
     bool ok;
+
+    // Set if loading was stopped by wxImageRowConsumer.
+    bool cancelled;
 };
 
 } // anonymous namespace
@@ -455,6 +485,143 @@ wxPNGImageData::DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo)
     ok = true;
 }
 
+bool
+wxPNGImageData::SendRow(wxImageRowConsumer& consumer,
+                        png_uint_32 y,
+                        const unsigned char* row,
+                        png_uint_32 width,
+                        bool hasAlpha)
+{
+    bool cont;
+    if ( hasAlpha )
+    {
+        unsigned char* rgb = m_rowBuf;
+        unsigned char* alpha = m_rowBuf + 3*width;
+        for ( png_uint_32 x = 0; x < width; x++ )
+        {
+            *rgb++ = *row++;
+            *rgb++ = *row++;
+            *rgb++ = *row++;
+            *alpha++ = *row++;
+        }
+
+        cont = consumer.OnImageRow(y, m_rowBuf, m_rowBuf + 3*width);
+    }
+    else
+    {
+        cont = consumer.OnImageRow(y, row, nullptr);
+    }
+
+    if ( !cont )
+        cancelled = true;
+
+    return cont;
+}
+
+void
+wxPNGImageData::DoLoadPNGRows(wxImageRowConsumer& consumer,
+                              wxPNGInfoStruct& wxinfo)
+{
+    png_uint_32 width, height = 0;
+    int bit_depth, color_type;
+
+    png_ptr = png_create_read_struct
+                          (
+                            PNG_LIBPNG_VER_STRING,
+                            nullptr,
+                            wx_PNG_error,
+                            wx_PNG_warning
+                          );
+    if (!png_ptr)
+        return;
+
+    png_set_read_fn( png_ptr, &wxinfo, wx_PNG_stream_reader);
+
+    info_ptr = png_create_info_struct( png_ptr );
+    if (!info_ptr)
+        return;
+
+    if (setjmp(wxinfo.jmpbuf))
+        return;
+
+    png_read_info( png_ptr, info_ptr );
+    png_get_IHDR( png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, nullptr, nullptr, nullptr );
+
+    png_set_expand(png_ptr);
+    png_set_gray_to_rgb(png_ptr);
+    png_set_strip_16( png_ptr );
+    png_set_packing( png_ptr );
+
+    // Unlike DoLoadPNGFile(), we can't check whether all pixels are opaque
+    // before passing them to the consumer, so always provide alpha if the
+    // image has it.
+    const bool hasAlpha =
+        (color_type & PNG_COLOR_MASK_ALPHA) ||
+        png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS);
+
+    // Interlaced images must be read entirely before any row is complete.
+    const bool interlaced = png_set_interlace_handling(png_ptr) > 1;
+
+    png_read_update_info(png_ptr, info_ptr);
+
+    if ( !consumer.OnImageStart((int)width, (int)height, hasAlpha) )
+    {
+        cancelled = true;
+        return;
+    }
+
+    if ( hasAlpha )
+    {
+        m_rowBuf = static_cast<unsigned char*>(malloc(4 * (size_t)width));
+        if ( !m_rowBuf )
+            return;
+    }
+
+    if ( interlaced )
+    {
+        // Alloc() allocates RGBA rows if it's not given the buffer, so we
+        // need to allocate the buffer for RGB rows ourselves.
+        if ( !hasAlpha )
+        {
+            m_buf = static_cast<unsigned char*>(malloc(3 * (size_t)width * height));
+            if ( !m_buf )
+                return;
+        }
+
+        if ( !Alloc(width, height, m_buf) )
+            return;
+
+        png_read_image( png_ptr, lines );
+
+        for ( png_uint_32 y = 0; y < height; y++ )
+        {
+            if ( !SendRow(consumer, y, lines[y], width, hasAlpha) )
+                return;
+        }
+    }
+    else
+    {
+        m_buf = static_cast<unsigned char*>
+                (
+                    malloc((hasAlpha ? 4 : 3) * (size_t)width)
+                );
+        if ( !m_buf )
+            return;
+
+        for ( png_uint_32 y = 0; y < height; y++ )
+        {
+            png_read_row( png_ptr, m_buf, nullptr );
+
+            if ( !SendRow(consumer, y, m_buf, width, hasAlpha) )
+                return;
+        }
+    }
+
+    png_read_end( png_ptr, info_ptr );
+
+    ok = true;
+}
+
 bool
 wxPNGHandler::LoadFile(wxImage *image,
                        wxInputStream& stream,
@@ -486,6 +653,32 @@ wxPNGHandler::LoadFile(wxImage *image,
     return true;
 }
 
+bool
+wxPNGHandler::LoadRows(wxImageRowConsumer& consumer,
+                       wxInputStream& stream,
+                       bool verbose,
+                       int WXUNUSED(index))
+{
+    wxPNGInfoStruct wxinfo;
+    wxinfo.verbose = verbose;
+    wxinfo.stream.in = &stream;
+
+    wxPNGImageData data;
+    data.DoLoadPNGRows(consumer, wxinfo);
+
+    if ( !data.ok )
+    {
+        if ( verbose && !data.cancelled )
+        {
+           wxLogError(_("Couldn't load a PNG image - file is corrupted or not enough memory."));
+        }
+
+        return false;
+    }
+
+    return true;
+}
+
 // ----------------------------------------------------------------------------
 // SaveFile() palette helpers
 // ----------------------------------------------------------------------------
@@ -524,6 +717,374 @@ static long PaletteAdd(PaletteMap *palette, const png_color_8& clr)
     return index;
 }
 
+// ----------------------------------------------------------------------------
+// SaveFile() parallel compression helpers
+// ----------------------------------------------------------------------------
+
+#if wxUSE_ZLIB
+
+namespace
+{
+
+// Function filling the given row of the image in PNG format.
+typedef std::function<void (int y, unsigned char *data)> PNGRowFunc;
+
+// Apply the filter of the given type to the row of len bytes, "prev" is the
+// previous row or null for the first one. Output includes the filter byte.
+void PNGFilterRow(int type,
+                  const unsigned char *row,
+                  const unsigned char *prev,
+                  size_t len,
+                  size_t bpp,
+                  unsigned char *out)
+{
+    *out++ = (unsigned char)type;
+
+    size_t i;
+    switch ( type )
+    {
+        case PNG_FILTER_VALUE_SUB:
+            for ( i = 0; i < bpp; i++ )
+                out[i] = row[i];
+            for ( ; i < len; i++ )
+                out[i] = (unsigned char)(row[i] - row[i - bpp]);
+            return;
+
+        case PNG_FILTER_VALUE_UP:
+            for ( i = 0; i < len; i++ )
+                out[i] = (unsigned char)(row[i] - (prev ? prev[i] : 0));
+            return;
+
+        case PNG_FILTER_VALUE_AVG:
+            for ( i = 0; i < len; i++ )
+            {
+                const unsigned a = i >= bpp ? row[i - bpp] : 0;
+                const unsigned b = prev ? prev[i] : 0;
+                out[i] = (unsigned char)(row[i] - ((a + b) >> 1));
+            }
+            return;
+
+        case PNG_FILTER_VALUE_PAETH:
+            for ( i = 0; i < len; i++ )
+            {
+                const int a = i >= bpp ? row[i - bpp] : 0;
+                const int b = prev ? prev[i] : 0;
+                const int c = prev && i >= bpp ? prev[i - bpp] : 0;
+
+                const int pa = abs(b - c);
+                const int pb = abs(a - c);
+                const int pc = abs(a + b - 2*c);
+
+                int pred;
+                if ( pa <= pb && pa <= pc )
+                    pred = a;
+                else if ( pb <= pc )
+                    pred = b;
+                else
+                    pred = c;
+
+                out[i] = (unsigned char)(row[i] - pred);
+            }
+            return;
+    }
+
+    memcpy(out, row, len);
+}
+
+// Return the sum of absolute values of the filtered bytes as signed values,
+// used for choosing the filter in the same way as libpng does it.
+unsigned long PNGFilterCost(const unsigned char *filtered, size_t len)
+{
+    unsigned long sum = 0;
+    for ( size_t i = 0; i < len; i++ )
+        sum += filtered[i] < 128 ? filtered[i] : 256 - filtered[i];
+
+    return sum;
+}
+
+// Computes the Adler-32 checksum of the filtered data in the same way as
+// zlib, this is needed to produce a valid zlib stream from the raw deflate
+// data compressed in blocks.
+class PNGAdler32
+{
+public:
+    PNGAdler32() : m_a(1), m_b(0) { }
+
+    void Update(const unsigned char *data, size_t len)
+    {
+        while ( len )
+        {
+            // this is the maximal number of bytes which can be processed
+            // without overflowing 32 bits, as in zlib
+            size_t n = wxMin(len, (size_t)5552);
+            len -= n;
+
+            while ( n-- )
+            {
+                m_a += *data++;
+                m_b += m_a;
+            }
+
+            m_a %= BASE;
+            m_b %= BASE;
+        }
+    }
+
+    // Combine with the checksum of the data of the given length following
+    // the data used for this checksum.
+    void Combine(const PNGAdler32& other, wxUint64 len)
+    {
+        const wxUint32 rem = (wxUint32)(len % BASE);
+
+        wxUint32 a = m_a + other.m_a + BASE - 1;
+        wxUint32 b = (wxUint32)(((wxUint64)rem * m_a) % BASE);
+        b += m_b + other.m_b + BASE - rem;
+
+        m_a = a % BASE;
+        m_b = b % BASE;
+    }
+
+    wxUint32 GetValue() const { return (m_b << 16) | m_a; }
+
+private:
+    enum { BASE = 65521 };
+
+    wxUint32 m_a,
+             m_b;
+};
+
+// Filters and compresses rows in independent blocks, possibly in parallel.
+class PNGBlockCompressor
+{
+public:
+    PNGBlockCompressor(const PNGRowFunc& fillRow,
+                       int height,
+                       size_t rowLen,
+                       size_t bpp,
+                       int level,
+                       int filters)
+        : m_fillRow(fillRow),
+          m_height(height),
+          m_rowLen(rowLen),
+          m_bpp(bpp),
+          m_level(level),
+          m_filters(filters)
+    {
+        // The size of the uncompressed data per block: it must be big enough
+        // for compression to not suffer from splitting the data, but not too
+        // big to still have enough blocks to use all the threads.
+        static const size_t BLOCK_SIZE = 512*1024;
+
+        m_rowsPerBlock = wxMax(1, (int)(BLOCK_SIZE / (rowLen + 1)));
+
+        const int numBlocks = (height + m_rowsPerBlock - 1) / m_rowsPerBlock;
+        m_blocks.resize(numBlocks);
+    }
+
+    // Compress all the blocks, return false on error.
+    bool Compress()
+    {
+        wxForEachImageRowBand
+        (
+            (int)m_blocks.size(),
+            (int)wxMin((size_t)INT_MAX, m_rowsPerBlock*m_rowLen),
+            [this](int start, int end)
+            {
+                for ( int n = start; n < end; n++ )
+                    CompressBlock(n);
+            }
+        );
+
+        for ( const Block& block : m_blocks )
+        {
+            if ( !block.ok )
+                return false;
+        }
+
+        return true;
+    }
+
+    // Write all the data as IDAT chunks.
+    void Write(png_structp png_ptr) const
+    {
+        static const png_byte IDAT[] = { 'I', 'D', 'A', 'T', '\0' };
+
+        // Combine the checksums of all blocks.
+        PNGAdler32 adler = m_blocks[0].adler;
+        for ( size_t n = 1; n < m_blocks.size(); n++ )
+            adler.Combine(m_blocks[n].adler, m_blocks[n].len);
+
+        const wxUint32 adlerValue = adler.GetValue();
+        const png_byte trailer[] =
+        {
+            (png_byte)(adlerValue >> 24),
+            (png_byte)(adlerValue >> 16),
+            (png_byte)(adlerValue >> 8),
+            (png_byte)adlerValue
+        };
+
+        // Use the standard zlib header corresponding to the compression
+        // level, see RFC 1950.
+        const int flevel = m_level == -1 ? 2
+                                         : m_level < 2 ? 0
+                                                       : m_level < 6 ? 1
+                                                                     : m_level == 6 ? 2
+                                                                                    : 3;
+        png_byte header[] = { 0x78, (png_byte)(flevel << 6) };
+        header[1] |= 31 - ((header[0] << 8) | header[1]) % 31;
+
+        // Write each block as its own chunk, with the zlib header in the
+        // first one and the checksum in the last one.
+        for ( size_t n = 0; n < m_blocks.size(); n++ )
+        {
+            const std::vector<unsigned char>& data = m_blocks[n].data;
+            const bool first = n == 0,
+                       last = n == m_blocks.size() - 1;
+
+            png_write_chunk_start(png_ptr, IDAT,
+                                  (png_uint_32)(data.size() +
+                                                (first ? sizeof(header) : 0) +
+                                                (last ? sizeof(trailer) : 0)));
+            if ( first )
+                png_write_chunk_data(png_ptr, header, sizeof(header));
+            if ( !data.empty() )
+                png_write_chunk_data(png_ptr, &data[0], data.size());
+            if ( last )
+                png_write_chunk_data(png_ptr, trailer, sizeof(trailer));
+            png_write_chunk_end(png_ptr);
+        }
+    }
+
+private:
+    struct Block
+    {
+        Block() : len(0), ok(false) { }
+
+        std::vector<unsigned char> data;    // raw deflate data
+        PNGAdler32 adler;                   // checksum of the filtered data
+        wxUint64 len;                       // length of the filtered data
+        bool ok;
+    };
+
+    // Filter rows [start, end) and pass them to the given function.
+    template <typename F>
+    void FilterRows(int start, int end, F func) const
+    {
+        std::vector<unsigned char> prev(m_rowLen),
+                                   row(m_rowLen),
+                                   best(m_rowLen + 1),
+                                   filtered(m_rowLen + 1);
+
+        if ( start > 0 )
+            m_fillRow(start - 1, &prev[0]);
+
+        for ( int y = start; y < end; y++ )
+        {
+            m_fillRow(y, &row[0]);
+
+            const unsigned char* const prevRow = y > 0 ? &prev[0] : nullptr;
+
+            unsigned long bestCost = ULONG_MAX;
+            for ( int type = PNG_FILTER_VALUE_NONE;
+                  type <= PNG_FILTER_VALUE_PAETH;
+                  type++ )
+            {
+                if ( !(m_filters & (PNG_FILTER_NONE << type)) )
+                    continue;
+
+                PNGFilterRow(type, &row[0], prevRow, m_rowLen, m_bpp,
+                             &filtered[0]);
+
+                const unsigned long cost = PNGFilterCost(&filtered[1], m_rowLen);
+                if ( cost < bestCost )
+                {
+                    bestCost = cost;
+                    best.swap(filtered);
+                }
+            }
+
+            func(&best[0], m_rowLen + 1);
+
+            prev.swap(row);
+        }
+    }
+
+    void CompressBlock(int n)
+    {
+        Block& block = m_blocks[n];
+
+        const int start = n*m_rowsPerBlock;
+        const int end = wxMin(start + m_rowsPerBlock, m_height);
+        const bool last = end == m_height;
+
+        wxMemoryOutputStream mem;
+        wxZlibOutputStream zstream(mem, m_level, wxZLIB_NO_HEADER);
+
+        // Use the end of the previous block as dictionary to avoid losing
+        // compression efficiency at the block boundaries, as pigz does.
+        if ( start > 0 )
+        {
+            static const size_t DICT_SIZE = 32768;
+
+            const int dictRows = (int)wxMin((size_t)start,
+                                            (DICT_SIZE + m_rowLen) / (m_rowLen + 1));
+
+            std::vector<unsigned char> dict;
+            FilterRows(start - dictRows, start,
+                       [&dict](const unsigned char *data, size_t len)
+                       {
+                           dict.insert(dict.end(), data, data + len);
+                       });
+
+            const size_t dictLen = wxMin(dict.size(), DICT_SIZE);
+            if ( !zstream.SetDictionary((const char *)&dict[dict.size() - dictLen],
+                                        dictLen) )
+                return;
+        }
+
+        FilterRows(start, end,
+                   [&block, &zstream](const unsigned char *data, size_t len)
+                   {
+                       block.adler.Update(data, len);
+                       block.len += len;
+                       zstream.Write(data, len);
+                   });
+
+        // All blocks except the last one must end on a byte boundary without
+        // terminating the deflate stream, which is what Sync() does, but the
+        // destructor would still terminate it, so remember where to stop.
+        if ( last )
+            zstream.Close();
+        else
+            zstream.Sync();
+
+        if ( !zstream.IsOk() )
+            return;
+
+        block.data.resize(mem.TellO());
+        if ( !block.data.empty() )
+            mem.CopyTo(&block.data[0], block.data.size());
+
+        block.ok = true;
+    }
+
+    const PNGRowFunc& m_fillRow;
+    const int m_height;
+    const size_t m_rowLen,
+                 m_bpp;
+    const int m_level,
+              m_filters;
+
+    int m_rowsPerBlock;
+    std::vector<Block> m_blocks;
+
+    wxDECLARE_NO_COPY_CLASS(PNGBlockCompressor);
+};
+
+} // anonymous namespace
+
+#endif // wxUSE_ZLIB
+
 // ----------------------------------------------------------------------------
 // writing PNGs
 // ----------------------------------------------------------------------------
@@ -696,14 +1257,54 @@ bool wxPNGHandler::SaveFile( wxImage *image, wxOutputStream& stream, bool verbos
                                   : PNG_COLOR_TYPE_GRAY;
     }
 
+    // the compression profile only provides the defaults for the options
+    // which can be overridden individually
+    int iFilter = -1;
+    int iLevel = -1;
+    int iMemLevel = -1;
+    switch ( image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_PROFILE) )
+    {
+        case wxPNG_COMPRESSION_DEFAULT:
+            break;
+
+        case wxPNG_COMPRESSION_FAST:
+            // a single cheap filter and the fastest deflate level
+            iFilter = PNG_FILTER_SUB;
+            iLevel = 1;
+            break;
+
+        case wxPNG_COMPRESSION_BALANCED:
+            iFilter = PNG_FILTER_SUB | PNG_FILTER_PAETH;
+            iLevel = 4;
+            break;
+
+        case wxPNG_COMPRESSION_SMALL:
+            iFilter = PNG_ALL_FILTERS;
+            iLevel = 9;
+            iMemLevel = 9;
+            break;
+
+        default:
+            wxFAIL_MSG( wxT("unknown wxPNG_COMPRESSION_XXX") );
+    }
+
     if (image->HasOption(wxIMAGE_OPTION_PNG_FILTER))
-        png_set_filter( png_ptr, PNG_FILTER_TYPE_BASE, image->GetOptionInt(wxIMAGE_OPTION_PNG_FILTER) );
+        iFilter = image->GetOptionInt(wxIMAGE_OPTION_PNG_FILTER);
 
     if (image->HasOption(wxIMAGE_OPTION_PNG_COMPRESSION_LEVEL))
-        png_set_compression_level( png_ptr, image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_LEVEL) );
+        iLevel = image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_LEVEL);
 
     if (image->HasOption(wxIMAGE_OPTION_PNG_COMPRESSION_MEM_LEVEL))
-        png_set_compression_mem_level( png_ptr, image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_MEM_LEVEL) );
+        iMemLevel = image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_MEM_LEVEL);
+
+    if (iFilter != -1)
+        png_set_filter( png_ptr, PNG_FILTER_TYPE_BASE, iFilter );
+
+    if (iLevel != -1)
+        png_set_compression_level( png_ptr, iLevel );
+
+    if (iMemLevel != -1)
+        png_set_compression_mem_level( png_ptr, iMemLevel );
 
     if (image->HasOption(wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY))
         png_set_compression_strategy( png_ptr, image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY) );
@@ -795,22 +1396,18 @@ bool wxPNGHandler::SaveFile( wxImage *image, wxOutputStream& stream, bool verbos
     png_set_shift( png_ptr, &sig_bit );
     png_set_packing( png_ptr );
 
-    unsigned char *
-        data = (unsigned char *)malloc( image->GetWidth() * iElements );
-    if ( !data )
-    {
-        png_destroy_write_struct( &png_ptr, (png_infopp)nullptr );
-        return false;
-    }
-
     const unsigned char *
-        pAlpha = (const unsigned char *)(bHasAlpha ? image->GetAlpha() : nullptr);
+        pAlphaData = (const unsigned char *)(bHasAlpha ? image->GetAlpha() : nullptr);
 
-    const unsigned char *pColors = image->GetData();
+    const unsigned char *pColorData = image->GetData();
 
-    for (int y = 0; y != iHeight; ++y)
+    const auto fillRow = [=, &palette](int y, unsigned char *pData)
     {
-        unsigned char *pData = data;
+        const size_t offset = (size_t)y * iWidth;
+        const unsigned char *pColors = pColorData + 3*offset;
+        const unsigned char *pAlpha = pAlphaData ? pAlphaData + offset
+                                                 : nullptr;
+
         for (int x = 0; x != iWidth; x++)
         {
             png_color_8 clr;
@@ -883,6 +1480,58 @@ bool wxPNGHandler::SaveFile( wxImage *image, wxOutputStream& stream, bool verbos
                     *pData++ = 0;
             }
         }
+    };
+
+#if wxUSE_ZLIB
+    // When using parallel compression, we filter and compress the data
+    // ourselves, which is only done for whole bytes per pixel, and write it
+    // directly as IDAT chunks, which means that we can't use png_write_end()
+    // as libpng doesn't know about them, so write IEND directly too.
+    if ( image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_PARALLEL) &&
+            (iBitDepth == 8 || iBitDepth == 16) )
+    {
+        // use the same default filters as libpng
+        if ( iFilter == -1 )
+            iFilter = bUsePalette ? PNG_FILTER_NONE : PNG_ALL_FILTERS;
+        else if ( iFilter <= PNG_FILTER_VALUE_PAETH )
+            iFilter = PNG_FILTER_NONE << iFilter;
+
+        if ( !(iFilter & PNG_ALL_FILTERS) )
+            iFilter = PNG_FILTER_NONE;
+
+        PNGBlockCompressor compressor(fillRow, iHeight, iWidth * iElements,
+                                      iElements, iLevel, iFilter);
+        if ( !compressor.Compress() )
+        {
+            png_destroy_write_struct( &png_ptr, (png_infopp)&info_ptr );
+            if (verbose)
+            {
+               wxLogError(_("Couldn't save PNG image."));
+            }
+            return false;
+        }
+
+        static const png_byte IEND[] = { 'I', 'E', 'N', 'D', '\0' };
+
+        compressor.Write( png_ptr );
+        png_write_chunk( png_ptr, IEND, nullptr, 0 );
+        png_destroy_write_struct( &png_ptr, (png_infopp)&info_ptr );
+
+        return true;
+    }
+#endif // wxUSE_ZLIB
+
+    unsigned char *
+        data = (unsigned char *)malloc( image->GetWidth() * iElements );
+    if ( !data )
+    {
+        png_destroy_write_struct( &png_ptr, (png_infopp)nullptr );
+        return false;
+    }
+
+    for (int y = 0; y != iHeight; ++y)
+    {
+        fillRow(y, data);
 
         png_bytep row_ptr = data;
         png_write_rows( png_ptr, &row_ptr, 1 );
@@ -580,6 +580,268 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     return true;
 }
 
+namespace
+{
+
+// Convert a row of pixels in ABGR format used by libtiff RGBA functions to
+// RGB and alpha (if the latter is non-null).
+void
+ConvertTIFFRow(const wxUint32* raster, wxUint32 w,
+               unsigned char* rgb, unsigned char* alpha)
+{
+    for (wxUint32 x = 0; x < w; x++, raster++)
+    {
+        *(rgb++) = (unsigned char)TIFFGetR(*raster);
+        *(rgb++) = (unsigned char)TIFFGetG(*raster);
+        *(rgb++) = (unsigned char)TIFFGetB(*raster);
+        if ( alpha )
+            *(alpha++) = (unsigned char)TIFFGetA(*raster);
+    }
+}
+
+} // anonymous namespace
+
+bool wxTIFFHandler::LoadRows( wxImageRowConsumer& consumer, wxInputStream& stream, bool verbose, int index )
+{
+    if (index == -1)
+        index = 0;
+
+    TIFF *tif = TIFFwxOpen( stream, "image", "r" );
+
+    if (!tif)
+    {
+        if (verbose)
+        {
+            wxLogError( _("TIFF: Error loading image.") );
+        }
+
+        return false;
+    }
+
+    if (!TIFFSetDirectory( tif, (tdir_t)index ))
+    {
+        if (verbose)
+        {
+            wxLogError( _("Invalid TIFF image index.") );
+        }
+
+        TIFFClose( tif );
+
+        return false;
+    }
+
+    wxUint32 w, h;
+
+    TIFFGetField( tif, TIFFTAG_IMAGEWIDTH, &w );
+    TIFFGetField( tif, TIFFTAG_IMAGELENGTH, &h );
+
+    wxUint16 samplesPerPixel = 0;
+    (void) TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesPerPixel);
+
+    wxUint16 bitsPerSample = 0;
+    (void) TIFFGetFieldDefaulted(tif, TIFFTAG_BITSPERSAMPLE, &bitsPerSample);
+
+    wxUint16 extraSamples;
+    wxUint16* samplesInfo;
+    TIFFGetFieldDefaulted(tif, TIFFTAG_EXTRASAMPLES,
+                          &extraSamples, &samplesInfo);
+
+    wxUint16 photometric;
+    if (!TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, &photometric))
+    {
+        photometric = PHOTOMETRIC_MINISWHITE;
+    }
+    const bool hasAlpha = (extraSamples >= 1
+        && ((samplesInfo[0] == EXTRASAMPLE_UNSPECIFIED)
+            || samplesInfo[0] == EXTRASAMPLE_ASSOCALPHA
+            || samplesInfo[0] == EXTRASAMPLE_UNASSALPHA))
+        || (extraSamples == 0 && samplesPerPixel == 4
+            && photometric == PHOTOMETRIC_RGB);
+
+    wxUint16 planarConfig = PLANARCONFIG_CONTIG;
+    (void) TIFFGetField(tif, TIFFTAG_PLANARCONFIG, &planarConfig);
+
+    char msg[1024] = "";
+
+    // Grey images with alpha are read scanline by scanline, as in LoadFile(),
+    // while all the other ones are decoded using libtiff RGBA functions in
+    // chunks corresponding to the strips or rows of tiles, so that no data
+    // is decoded more than once.
+    const bool useScanlines =
+        (planarConfig == PLANARCONFIG_CONTIG && samplesPerPixel == 2
+            && extraSamples == 1)
+        &&
+        (
+            ( !TIFFRGBAImageOK(tif, msg) )
+            || (bitsPerSample == 8)
+        );
+
+    TIFFRGBAImage img;
+    wxUint32 rowsPerChunk = 1;
+    if ( !useScanlines )
+    {
+        if ( !TIFFRGBAImageOK(tif, msg) || !TIFFRGBAImageBegin(&img, tif, 0, msg) )
+        {
+            if (verbose)
+            {
+                wxLogError( _("TIFF: Error reading image.") );
+            }
+
+            TIFFClose( tif );
+
+            return false;
+        }
+
+        img.req_orientation = ORIENTATION_TOPLEFT;
+
+        wxUint16 orientation = ORIENTATION_TOPLEFT;
+        (void) TIFFGetFieldDefaulted(tif, TIFFTAG_ORIENTATION, &orientation);
+
+        if ( orientation != ORIENTATION_TOPLEFT )
+        {
+            // Rows are not stored in top to bottom order, so we have to
+            // decode the entire image before returning any of them.
+            rowsPerChunk = h;
+        }
+        else if ( TIFFIsTiled(tif) )
+        {
+            TIFFGetField(tif, TIFFTAG_TILELENGTH, &rowsPerChunk);
+        }
+        else
+        {
+            TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &rowsPerChunk);
+        }
+
+        if ( !rowsPerChunk || rowsPerChunk > h )
+            rowsPerChunk = h;
+    }
+
+    // guard against integer overflow during multiplication which could result
+    // in allocating a too small buffer and then overflowing it
+    const double bytesNeeded = (double)w * (double)rowsPerChunk * sizeof(wxUint32);
+    if ( bytesNeeded >= wxUINT32_MAX )
+    {
+        if ( verbose )
+        {
+            wxLogError( _("TIFF: Image size is abnormally big.") );
+        }
+
+        if ( !useScanlines )
+            TIFFRGBAImageEnd(&img);
+        TIFFClose(tif);
+
+        return false;
+    }
+
+    wxUint32* const raster = (wxUint32*) _TIFFmalloc( (wxUint32)bytesNeeded );
+
+    // buffer for the converted row, containing RGB followed by alpha
+    unsigned char* const row = (unsigned char*) _TIFFmalloc( 4 * w );
+
+    unsigned char* const scanline = useScanlines
+        ? (unsigned char *)_TIFFmalloc(TIFFScanlineSize(tif))
+        : nullptr;
+
+    const bool allocated = raster && row && (scanline || !useScanlines);
+    bool ok = allocated;
+    if ( !allocated )
+    {
+        if (verbose)
+        {
+            wxLogError( _("TIFF: Couldn't allocate memory.") );
+        }
+    }
+
+    bool cancelled = false;
+    if ( ok && !consumer.OnImageStart((int)w, (int)h, hasAlpha) )
+    {
+        ok = false;
+        cancelled = true;
+    }
+
+    unsigned char* const rgb = row;
+    unsigned char* const alpha = hasAlpha ? row + 3 * w : nullptr;
+
+    for ( wxUint32 y = 0; ok && y < h; y += rowsPerChunk )
+    {
+        const wxUint32 rows = wxMin(rowsPerChunk, h - y);
+
+        if ( useScanlines )
+        {
+            if (TIFFReadScanline(tif, scanline, y, 0) != 1)
+            {
+                ok = false;
+                break;
+            }
+
+            // See the comments in LoadFile().
+            const bool isGreyScale = (bitsPerSample == 8);
+            const bool minIsWhite = (photometric == PHOTOMETRIC_MINISWHITE);
+            const int minValue =  minIsWhite ? 255 : 0;
+            const int maxValue = 255 - minValue;
+
+            for (wxUint32 x = 0; x < w; ++x)
+            {
+                if (isGreyScale)
+                {
+                    wxUint8 val = minIsWhite ? 255 - scanline[x*2] : scanline[x*2];
+                    wxUint8 a = minIsWhite ? 255 - scanline[x*2+1] : scanline[x*2+1];
+                    raster[x] = val + (val << 8) + (val << 16) + (a << 24);
+                }
+                else
+                {
+                    int mask = scanline[x*2/8] << ((x*2)%8);
+
+                    wxUint8 val = mask & 128 ? maxValue : minValue;
+                    raster[x] = val + (val << 8) + (val << 16)
+                        + ((mask & 64 ? maxValue : minValue) << 24);
+                }
+            }
+        }
+        else
+        {
+            img.row_offset = y;
+            img.col_offset = 0;
+            if ( !TIFFRGBAImageGet(&img, raster, w, rows) )
+            {
+                ok = false;
+                break;
+            }
+        }
+
+        for ( wxUint32 n = 0; n < rows; n++ )
+        {
+            ConvertTIFFRow(raster + n * w, w, rgb, alpha);
+
+            if ( !consumer.OnImageRow(y + n, rgb, alpha) )
+            {
+                ok = false;
+                cancelled = true;
+                break;
+            }
+        }
+    }
+
+    if ( !ok && !cancelled && allocated && verbose )
+    {
+        wxLogError( _("TIFF: Error reading image.") );
+    }
+
+    if ( scanline )
+        _TIFFfree( scanline );
+    if ( row )
+        _TIFFfree( row );
+    if ( raster )
+        _TIFFfree( raster );
+
+    if ( !useScanlines )
+        TIFFRGBAImageEnd(&img);
+
+    TIFFClose( tif );
+
+    return ok;
+}
+
 int wxTIFFHandler::DoGetImageCount( wxInputStream& stream )
 {
     TIFF *tif = TIFFwxOpen( stream, "image", "r" );
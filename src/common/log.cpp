@@ -49,6 +49,8 @@
 
 #include <stdlib.h>
 
+#include <atomic>
+
 #if defined(__WINDOWS__)
     // This header includes <windows.h> and declares wxMSWFormatMessage().
     #include "wx/msw/private.h"
@@ -103,6 +105,20 @@ thread_local wxLog* wxPerThreadLogger = nullptr;
 
 thread_local bool wxPerThreadLoggingDisabled = false;
 
+// the active log target if it is asynchronous: unlike wxLog::ms_pLogger,
+// which is only used by the main thread, this one is used by the other
+// threads too, so it's only set by SetActiveTarget() for the targets which
+// can be used from any thread
+std::atomic<wxLog*> gs_asyncLogger{nullptr};
+
+// number of threads currently using gs_asyncLogger: the threads which
+// entered OnLog() before the last change of gs_asyncLoggerEpoch are counted
+// in one slot and those which entered it after it in the other one, so that
+// SetActiveTarget() can wait until all threads that may still use the
+// previous target are done, without being held up by the new ones
+std::atomic<unsigned> gs_asyncLoggerEpoch{0};
+std::atomic<int> gs_asyncLoggerUsers[2];
+
 } // anonymous namespace
 
 #endif // wxUSE_THREADS
@@ -162,6 +178,12 @@ inline ComponentLevelsMap& GetComponentLevels()
     return s_componentLevels;
 }
 
+// set to true when the first component level is set and never reset, as the
+// map above never shrinks: this allows GetComponentLevel() to avoid locking
+// GetLevelsCS() in the common case when no component levels are used at all,
+// which matters when logging from many threads at once
+std::atomic<bool> gs_hasComponentLevels{false};
+
 } // anonymous namespace
 
 // ============================================================================
@@ -371,6 +393,34 @@ wxLog::OnLog(wxLogLevel level,
         logger = wxPerThreadLogger;
         if ( !logger )
         {
+            // asynchronous targets can be used from any thread and don't
+            // need the messages to be buffered, but notice that we must never
+            // use ms_pLogger itself here, as it may be deleted by the main
+            // thread at any moment
+            unsigned epoch = gs_asyncLoggerEpoch.load();
+            for ( ;; )
+            {
+                ++gs_asyncLoggerUsers[epoch & 1];
+
+                // if the epoch changed in the meanwhile, SetActiveTarget()
+                // may be not waiting for this slot, so use the new one
+                const unsigned epochNow = gs_asyncLoggerEpoch.load();
+                if ( epochNow == epoch )
+                    break;
+
+                --gs_asyncLoggerUsers[epoch & 1];
+                epoch = epochNow;
+            }
+
+            std::atomic<int>& users = gs_asyncLoggerUsers[epoch & 1];
+            wxLog * const loggerAsync = gs_asyncLogger.load();
+            if ( loggerAsync )
+                loggerAsync->DoLogRecord(level, msg, info);
+            --users;
+
+            if ( loggerAsync )
+                return;
+
             if ( ms_pLogger )
             {
                 // buffer the messages until they can be shown from the main
@@ -398,7 +448,10 @@ wxLog::OnLog(wxLogLevel level,
             return;
     }
 
-    logger->CallDoLogNow(level, msg, info);
+    if ( logger->IsAsync() )
+        logger->DoLogRecord(level, msg, info);
+    else
+        logger->CallDoLogNow(level, msg, info);
 }
 
 void
@@ -539,6 +592,20 @@ wxLog *wxLog::SetActiveTarget(wxLog *pLogger)
     wxLog *pOldLogger = ms_pLogger;
     ms_pLogger = pLogger;
 
+#if wxUSE_THREADS
+    gs_asyncLogger = pLogger && pLogger->IsAsync() ? pLogger : nullptr;
+
+    // the caller may delete the old target as soon as we return, so wait
+    // until the other threads that could be logging to it are done: as they
+    // don't see it any more, this can't take long
+    if ( pOldLogger && pOldLogger->IsAsync() )
+    {
+        const unsigned epoch = gs_asyncLoggerEpoch++;
+        while ( gs_asyncLoggerUsers[epoch & 1].load() )
+            wxThread::Yield();
+    }
+#endif // wxUSE_THREADS
+
     return pOldLogger;
 }
 
@@ -589,12 +656,17 @@ void wxLog::SetComponentLevel(const wxString& component, wxLogLevel level)
         wxCRIT_SECT_LOCKER(lock, GetLevelsCS());
 
         GetComponentLevels()[component] = level;
+
+        gs_hasComponentLevels.store(true, std::memory_order_release);
     }
 }
 
 /* static */
 wxLogLevel wxLog::GetComponentLevel(const wxString& componentOrig)
 {
+    if ( !gs_hasComponentLevels.load(std::memory_order_acquire) )
+        return GetLogLevel();
+
     wxCRIT_SECT_LOCKER(lock, GetLevelsCS());
 
     // Make a copy before modifying it in the loop.
@@ -0,0 +1,684 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/logasync.cpp
+// Purpose:     wxLogAsync implementation
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#if wxUSE_LOG && wxUSE_THREADS
+
+#include "wx/logasync.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/intl.h"
+    #include "wx/string.h"
+#endif
+
+#include "wx/thread.h"
+#include "wx/time.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// constants
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// How long does the background thread sleep if it's not woken up, in ms.
+const unsigned long FLUSH_INTERVAL = 100;
+
+// Size of the cache line used to avoid false sharing between the producer
+// and the consumer fields of the ring buffer.
+const size_t CACHE_LINE_SIZE = 64;
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxLogAsyncRing: queue of log records from a single thread
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// This is a fixed size single producer, single consumer queue: only the
+// thread owning it can push records into it and only one consumer, i.e. the
+// background thread or Flush(), can remove them at any given moment. This
+// allows it to work without any locking.
+//
+// The ring is shared by the thread owning it and wxLogAsyncData using it,
+// which may be destroyed in any order, so each of them marks it when it's
+// done with it to let the other one know that it can forget about it.
+class wxLogAsyncRing
+{
+public:
+    wxLogAsyncRing(unsigned long serial, size_t size)
+        : m_serial(serial),
+          m_mask(size - 1),
+          m_records(new Record[size]),
+          m_orphaned(false),
+          m_detached(false),
+          m_head(0),
+          m_dropped(0),
+          m_tail(0)
+    {
+    }
+
+    // Return the serial number of wxLogAsyncData this ring belongs to.
+    unsigned long GetSerial() const { return m_serial; }
+
+    // Called when the thread owning this ring exits: no more records will be
+    // pushed into it after this.
+    void SetOrphaned() { m_orphaned.store(true, std::memory_order_release); }
+    bool IsOrphaned() const { return m_orphaned.load(std::memory_order_acquire); }
+
+    // Called when wxLogAsyncData owning this ring is destroyed: it can't be
+    // used for logging any more after this.
+    void SetDetached() { m_detached.store(true, std::memory_order_relaxed); }
+    bool IsDetached() const { return m_detached.load(std::memory_order_relaxed); }
+
+
+    // Producer side: may only be called from the thread owning this ring.
+
+    // Return false if there is no space for the record.
+    bool Push(wxLogLevel level, const wxString& msg, const wxLogRecordInfo& info)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if ( head - m_tail.load(std::memory_order_acquire) > m_mask )
+            return false;
+
+        // Note that assigning to the existing objects reuses the memory
+        // already allocated by them, if possible.
+        Record& record = m_records[head & m_mask];
+        record.level = level;
+        record.msg = msg;
+        record.info = info;
+
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool IsFull() const
+    {
+        return m_head.load(std::memory_order_relaxed) -
+                m_tail.load(std::memory_order_acquire) > m_mask;
+    }
+
+    void IncDropped() { m_dropped.fetch_add(1, std::memory_order_relaxed); }
+
+
+    // Consumer side.
+
+    size_t GetDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // Call the given function for all queued records and remove them, return
+    // their number.
+    template <typename F>
+    size_t Consume(const F& func)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        const size_t count = head - tail;
+
+        for ( ; tail != head; ++tail )
+        {
+            const Record& record = m_records[tail & m_mask];
+            func(record.level, record.msg, record.info);
+
+            // Let the producer reuse this record as soon as possible.
+            m_tail.store(tail + 1, std::memory_order_release);
+        }
+
+        return count;
+    }
+
+private:
+    struct Record
+    {
+        wxLogLevel level = 0;
+        wxString msg;
+        wxLogRecordInfo info;
+    };
+
+    const unsigned long m_serial;
+    const size_t m_mask;
+    const std::unique_ptr<Record[]> m_records;
+
+    std::atomic<bool> m_orphaned;
+    std::atomic<bool> m_detached;
+
+    // Fields modified by the producer.
+wxCLANG_WARNING_SUPPRESS(unused-private-field)
+    char m_padProducer[CACHE_LINE_SIZE];
+    std::atomic<size_t> m_head;
+    std::atomic<size_t> m_dropped;
+
+    // Field modified by the consumer.
+    char m_padConsumer[CACHE_LINE_SIZE];
+wxCLANG_WARNING_RESTORE(unused-private-field)
+    std::atomic<size_t> m_tail;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncRing);
+};
+
+// All the rings used by the current thread: they are identified by the serial
+// number of wxLogAsyncData they belong to, as we can't use wxLogAsync pointer
+// for this, as it could be reused by another object after the original one
+// is destroyed.
+class wxLogAsyncThreadRings
+{
+public:
+    wxLogAsyncThreadRings() = default;
+
+    // Let the consumers know that they can free our rings once they output
+    // all the records remaining in them.
+    ~wxLogAsyncThreadRings()
+    {
+        for ( const auto& ring : m_rings )
+            ring->SetOrphaned();
+    }
+
+    wxLogAsyncRing* Find(unsigned long serial)
+    {
+        // Check the last used ring first, as it's almost always the right one.
+        if ( m_current && m_current->GetSerial() == serial )
+            return m_current;
+
+        for ( const auto& ring : m_rings )
+        {
+            if ( ring->GetSerial() == serial )
+            {
+                m_current = ring.get();
+                return m_current;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void Add(const std::shared_ptr<wxLogAsyncRing>& ring)
+    {
+        // Forget about the rings of the already destroyed objects.
+        m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(),
+                                     [](const std::shared_ptr<wxLogAsyncRing>& r)
+                                     {
+                                        return r->IsDetached();
+                                     }),
+                      m_rings.end());
+
+        m_rings.push_back(ring);
+        m_current = ring.get();
+    }
+
+private:
+    std::vector<std::shared_ptr<wxLogAsyncRing>> m_rings;
+    wxLogAsyncRing* m_current = nullptr;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncThreadRings);
+};
+
+thread_local wxLogAsyncThreadRings wxLogAsyncCurrentRings;
+
+// Set while the current thread outputs the queued records: the messages
+// logged during this time must never wait for space in the ring, as it could
+// only be freed by this thread itself.
+thread_local bool wxLogAsyncConsuming = false;
+
+std::atomic<unsigned long> wxLogAsyncLastSerial(0);
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxLogAsyncData: all the data of wxLogAsync
+// ----------------------------------------------------------------------------
+
+class wxLogAsyncData
+{
+public:
+    typedef std::function<void (wxLogLevel,
+                                const wxString&,
+                                const wxLogRecordInfo&)> LogFunc;
+
+    wxLogAsyncData(const LogFunc& logFunc, size_t bufferSize);
+
+    // Stops the background thread and outputs all the remaining records.
+    ~wxLogAsyncData();
+
+
+    // Producer side.
+
+    // Return the ring for the current thread, creating it if necessary.
+    wxLogAsyncRing* GetRing();
+
+    // Wake up the background thread if it's sleeping.
+    void WakeUp();
+
+    // Called when the given ring of the current thread is full and we need
+    // to wait until the consumer removes some records from it.
+    void WaitForSpace(wxLogAsyncRing* ring);
+
+
+    // Consumer side.
+
+    // Output all the queued records, return their number.
+    size_t ProcessRecords();
+
+    // Output all the queued records and flush the target.
+    void Flush(wxLog* target);
+
+    void ThreadMain();
+
+
+    size_t GetDroppedCount() const;
+    size_t GetLoggedCount() const
+        { return m_logged.load(std::memory_order_relaxed); }
+
+private:
+    // Implementation of ProcessRecords(), must be called with m_consumerCS
+    // locked.
+    size_t DoProcessRecords();
+
+    class Thread : public wxThread
+    {
+    public:
+        explicit Thread(wxLogAsyncData& data)
+            : wxThread(wxTHREAD_JOINABLE),
+              m_data(data)
+        {
+        }
+
+    protected:
+        void* Entry() override
+        {
+            m_data.ThreadMain();
+            return nullptr;
+        }
+
+    private:
+        wxLogAsyncData& m_data;
+    };
+
+    // Passes the records to the real log target.
+    const LogFunc m_logFunc;
+
+    const unsigned long m_serial;
+    const size_t m_bufferSize;
+
+    // All the rings, a new one is added when a thread logs a message for the
+    // first time and it is removed once the thread exits and all the records
+    // in it are output.
+    std::vector<std::shared_ptr<wxLogAsyncRing>> m_rings;
+    bool m_ringsChanged;
+
+    // Number of messages dropped in the already removed rings.
+    size_t m_droppedRemoved;
+
+    // Protects all the fields above.
+    mutable wxCriticalSection m_ringsCS;
+
+    // Consumer data, protected by m_consumerCS.
+    wxCriticalSection m_consumerCS;
+    std::vector<wxLogAsyncRing*> m_consumerRings;
+    std::vector<wxLogAsyncRing*> m_consumerOrphans;
+    size_t m_droppedReported;
+
+    std::atomic<size_t> m_logged;
+
+    // Used for waking up the producers waiting for space in their rings:
+    // the consumer only signals the condition if m_waitingForSpace is non 0.
+    wxMutex m_spaceMutex;
+    wxCondition m_spaceCond;
+    std::atomic<int> m_waitingForSpace;
+
+    // Used for waking up the background thread.
+    wxSemaphore m_wakeUp;
+    std::atomic<bool> m_sleeping;
+    std::atomic<bool> m_stop;
+
+    // May be null if creating the thread failed.
+    Thread* m_thread;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncData);
+};
+
+wxLogAsyncData::wxLogAsyncData(const LogFunc& logFunc, size_t bufferSize)
+    : m_logFunc(logFunc),
+      m_serial(++wxLogAsyncLastSerial),
+      m_bufferSize(bufferSize),
+      m_ringsChanged(false),
+      m_droppedRemoved(0),
+      m_droppedReported(0),
+      m_logged(0),
+      m_spaceCond(m_spaceMutex),
+      m_waitingForSpace(0),
+      m_sleeping(false),
+      m_stop(false)
+{
+    m_thread = new Thread(*this);
+    if ( m_thread->Run() != wxTHREAD_NO_ERROR )
+    {
+        delete m_thread;
+        m_thread = nullptr;
+
+        wxLogDebug("Failed to start asynchronous logging thread.");
+    }
+}
+
+wxLogAsyncData::~wxLogAsyncData()
+{
+    if ( m_thread )
+    {
+        m_stop = true;
+        m_wakeUp.Post();
+
+        m_thread->Wait();
+        delete m_thread;
+    }
+
+    ProcessRecords();
+
+    // The threads still alive may keep their rings for a while, but they
+    // must not use them any more.
+    for ( const auto& ring : m_rings )
+        ring->SetDetached();
+}
+
+wxLogAsyncRing* wxLogAsyncData::GetRing()
+{
+    wxLogAsyncThreadRings& rings = wxLogAsyncCurrentRings;
+
+    wxLogAsyncRing* ring = rings.Find(m_serial);
+    if ( !ring )
+    {
+        std::shared_ptr<wxLogAsyncRing>
+            ringNew(std::make_shared<wxLogAsyncRing>(m_serial, m_bufferSize));
+
+        {
+            wxCriticalSectionLocker lock(m_ringsCS);
+
+            m_rings.push_back(ringNew);
+            m_ringsChanged = true;
+        }
+
+        rings.Add(ringNew);
+        ring = ringNew.get();
+    }
+
+    return ring;
+}
+
+void wxLogAsyncData::WakeUp()
+{
+    // This fence pairs with the one in ThreadMain(): it ensures that either
+    // we see that the thread is sleeping or the thread sees our record.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if ( m_sleeping.load(std::memory_order_relaxed) && m_sleeping.exchange(false) )
+        m_wakeUp.Post();
+}
+
+void wxLogAsyncData::WaitForSpace(wxLogAsyncRing* ring)
+{
+    if ( m_thread )
+    {
+        wxMutexLocker lock(m_spaceMutex);
+
+        ++m_waitingForSpace;
+
+        // This fence pairs with the one in DoProcessRecords(): it ensures
+        // that either we see the space freed by the consumer or it sees that
+        // we're waiting and signals the condition, which it can only do after
+        // we start waiting for it, as we hold the mutex until then.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        WakeUp();
+
+        while ( ring->IsFull() )
+            m_spaceCond.Wait();
+
+        --m_waitingForSpace;
+    }
+    else
+    {
+        // Without the background thread, we have to do its work ourselves.
+        ProcessRecords();
+    }
+}
+
+size_t wxLogAsyncData::ProcessRecords()
+{
+    wxCriticalSectionLocker lock(m_consumerCS);
+
+    return DoProcessRecords();
+}
+
+void wxLogAsyncData::Flush(wxLog* target)
+{
+    wxCriticalSectionLocker lock(m_consumerCS);
+
+    DoProcessRecords();
+
+    target->Flush();
+}
+
+size_t wxLogAsyncData::DoProcessRecords()
+{
+    {
+        wxCriticalSectionLocker lock(m_ringsCS);
+
+        if ( m_ringsChanged )
+        {
+            m_consumerRings.clear();
+            for ( const auto& r : m_rings )
+                m_consumerRings.push_back(r.get());
+
+            m_ringsChanged = false;
+        }
+    }
+
+    const bool consumingOld = wxLogAsyncConsuming;
+    wxLogAsyncConsuming = true;
+
+    size_t count = 0;
+    for ( wxLogAsyncRing* ring : m_consumerRings )
+    {
+        // Check this before consuming the records: if the thread had already
+        // exited, this ring will be empty after doing it.
+        const bool orphaned = ring->IsOrphaned();
+
+        count += ring->Consume(m_logFunc);
+
+        if ( orphaned )
+            m_consumerOrphans.push_back(ring);
+    }
+
+    m_logged.fetch_add(count, std::memory_order_relaxed);
+
+    if ( count )
+    {
+        // Wake up the producers waiting for space, see WaitForSpace().
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if ( m_waitingForSpace.load(std::memory_order_relaxed) )
+        {
+            wxMutexLocker lock(m_spaceMutex);
+            m_spaceCond.Broadcast();
+        }
+    }
+
+    if ( !m_consumerOrphans.empty() )
+    {
+        wxCriticalSectionLocker lock(m_ringsCS);
+
+        m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(),
+                                     [this](const std::shared_ptr<wxLogAsyncRing>& r)
+                                     {
+                                        if ( std::find(m_consumerOrphans.begin(),
+                                                       m_consumerOrphans.end(),
+                                                       r.get()) == m_consumerOrphans.end() )
+                                            return false;
+
+                                        m_droppedRemoved += r->GetDropped();
+                                        return true;
+                                     }),
+                      m_rings.end());
+        m_ringsChanged = true;
+
+        m_consumerOrphans.clear();
+    }
+
+    const size_t dropped = GetDroppedCount();
+    if ( dropped != m_droppedReported )
+    {
+        wxLogRecordInfo info(__FILE__, __LINE__, __WXFUNCTION__, wxLOG_COMPONENT);
+        info.timestampMS = wxGetUTCTimeMillis().GetValue();
+
+        m_logFunc(wxLOG_Warning,
+                  wxString::Format(_("%lu log messages were dropped."),
+                                   static_cast<unsigned long>(dropped - m_droppedReported)),
+                  info);
+
+        m_droppedReported = dropped;
+    }
+
+    wxLogAsyncConsuming = consumingOld;
+
+    return count;
+}
+
+void wxLogAsyncData::ThreadMain()
+{
+    for ( ;; )
+    {
+        if ( ProcessRecords() )
+            continue;
+
+        if ( m_stop )
+            break;
+
+        // Ask the producers to wake us up, but check if any of them logged
+        // something before seeing this flag first.
+        m_sleeping = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if ( !ProcessRecords() && !m_stop )
+            m_wakeUp.WaitTimeout(FLUSH_INTERVAL);
+
+        m_sleeping = false;
+    }
+}
+
+size_t wxLogAsyncData::GetDroppedCount() const
+{
+    wxCriticalSectionLocker lock(m_ringsCS);
+
+    size_t dropped = m_droppedRemoved;
+    for ( const auto& r : m_rings )
+        dropped += r->GetDropped();
+
+    return dropped;
+}
+
+// ============================================================================
+// wxLogAsync implementation
+// ============================================================================
+
+wxLogAsync::wxLogAsync(wxLog* target,
+                       wxLogAsyncPolicy policy,
+                       size_t bufferSize)
+    : m_target(target),
+      m_policy(policy)
+{
+    wxASSERT_MSG( target, "log target must be specified" );
+
+    // Use the next power of 2 to allow indexing the ring using a mask.
+    size_t size = 2;
+    while ( size < bufferSize )
+        size *= 2;
+
+    m_data.reset(new wxLogAsyncData
+                 (
+                    [this](wxLogLevel level,
+                           const wxString& msg,
+                           const wxLogRecordInfo& info)
+                    {
+                        m_target->CallDoLogNow(level, msg, info);
+                    },
+                    size
+                 ));
+}
+
+wxLogAsync::~wxLogAsync()
+{
+    // We shouldn't be deleted while still being the active target, but if we
+    // are, at least ensure that the other threads stop using us before our
+    // data is destroyed.
+    if ( ms_pLogger == this )
+        SetActiveTarget(nullptr);
+
+    // This outputs all the remaining messages.
+    m_data.reset();
+
+    m_target->Flush();
+    delete m_target;
+}
+
+size_t wxLogAsync::GetDroppedCount() const
+{
+    return m_data->GetDroppedCount();
+}
+
+size_t wxLogAsync::GetLoggedCount() const
+{
+    return m_data->GetLoggedCount();
+}
+
+void wxLogAsync::Flush()
+{
+    m_data->Flush(m_target);
+}
+
+void wxLogAsync::DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info)
+{
+    wxLogAsyncRing* const ring = m_data->GetRing();
+
+    if ( !ring->Push(level, msg, info) )
+    {
+        if ( m_policy == wxLOG_ASYNC_DROP || wxLogAsyncConsuming )
+        {
+            ring->IncDropped();
+            return;
+        }
+
+        do
+        {
+            m_data->WaitForSpace(ring);
+        }
+        while ( !ring->Push(level, msg, info) );
+    }
+
+    m_data->WakeUp();
+}
+
+#endif // wxUSE_LOG && wxUSE_THREADS
@@ -0,0 +1,551 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/logbinary.cpp
+// Purpose:     wxLogBinary and wxLogBinaryReader implementation
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#if wxUSE_LOG && wxUSE_STREAMS
+
+#include "wx/logbinary.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/string.h"
+#endif
+
+#include "wx/strconv.h"
+
+#include <string.h>
+
+#include <string>
+#include <unordered_map>
+
+// ----------------------------------------------------------------------------
+// constants
+// ----------------------------------------------------------------------------
+
+// The format of the binary log is:
+//
+//  - The signature "wxLOGBIN" followed by the format version.
+//  - Any number of entries, each of which starts with a tag byte:
+//
+//    - Tag_String: string id, length and UTF-8 contents. Defines a string
+//      used for the file, function and component names, which are written
+//      only once and referenced by their id in the records.
+//    - Tag_Thread: thread index and thread id. Defines a thread referenced
+//      by its index in the records.
+//    - Tag_Record: level, difference of the time stamp with the time stamp
+//      of the previous record, thread index, file name id, line, function
+//      name id, component id and the message length and UTF-8 contents.
+//      Index or id of 0 means that the corresponding information is not
+//      available.
+//
+// All the numbers are encoded using variable length encoding, with 7 bits
+// per byte and the high bit set in all bytes but the last one, and the time
+// stamp differences, which can be negative, are zigzag-encoded first.
+
+namespace
+{
+
+const char SIGNATURE[] = "wxLOGBIN";
+const size_t SIGNATURE_LEN = 8;
+
+enum
+{
+    Tag_String = 1,
+    Tag_Thread,
+    Tag_Record
+};
+
+// Maximal length of a number in variable length encoding.
+const size_t VARINT_MAX_LEN = 10;
+
+inline wxULongLong_t ZigZagEncode(wxLongLong_t value)
+{
+    return (static_cast<wxULongLong_t>(value) << 1) ^
+                static_cast<wxULongLong_t>(value >> 63);
+}
+
+inline wxLongLong_t ZigZagDecode(wxULongLong_t value)
+{
+    return static_cast<wxLongLong_t>(value >> 1) ^
+                -static_cast<wxLongLong_t>(value & 1);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// wxLogBinaryData: implementation of wxLogBinary
+// ============================================================================
+
+class wxLogBinaryData
+{
+public:
+    wxLogBinaryData(wxOutputStream* stream, size_t bufferSize)
+        : m_stream(stream),
+          m_bufferSize(bufferSize)
+    {
+        m_buffer.reserve(bufferSize + 256);
+
+        PutBytes(SIGNATURE, SIGNATURE_LEN);
+        PutVarUInt(wxLOG_BINARY_VERSION);
+    }
+
+    bool IsOk() const { return m_stream && m_stream->IsOk(); }
+
+    void LogRecord(wxLogLevel level,
+                   const wxString& msg,
+                   const wxLogRecordInfo& info);
+
+    void Flush()
+    {
+        WriteBuffer();
+
+        if ( m_stream )
+            m_stream->Sync();
+    }
+
+private:
+    void PutByte(unsigned char value)
+    {
+        m_buffer.push_back(value);
+    }
+
+    void PutBytes(const void* data, size_t len)
+    {
+        const unsigned char* const p = static_cast<const unsigned char*>(data);
+        m_buffer.insert(m_buffer.end(), p, p + len);
+    }
+
+    void PutVarUInt(wxULongLong_t value)
+    {
+        unsigned char buf[VARINT_MAX_LEN];
+        size_t len = 0;
+        while ( value >= 0x80 )
+        {
+            buf[len++] = static_cast<unsigned char>(value | 0x80);
+            value >>= 7;
+        }
+        buf[len++] = static_cast<unsigned char>(value);
+
+        PutBytes(buf, len);
+    }
+
+    void PutMessage(const wxString& msg);
+
+    // Return the id of the given string, defining it if necessary.
+    unsigned GetStringId(const char* str);
+
+#if wxUSE_THREADS
+    // Return the index of the given thread, defining it if necessary.
+    unsigned GetThreadIndex(wxThreadIdType threadId);
+#endif // wxUSE_THREADS
+
+    void WriteBuffer()
+    {
+        if ( m_buffer.empty() )
+            return;
+
+        if ( IsOk() )
+            m_stream->Write(m_buffer.data(), m_buffer.size());
+
+        m_buffer.clear();
+    }
+
+
+    wxOutputStream* const m_stream;
+    const size_t m_bufferSize;
+
+    // Data not written to the stream yet.
+    std::vector<unsigned char> m_buffer;
+
+    // Buffer used for converting the messages to UTF-8.
+    std::vector<char> m_utf8;
+
+    // The strings are looked up using their pointers because the same
+    // pointers, coming from __FILE__ and similar macros, are almost always
+    // used for the same strings, but their contents is still checked, as
+    // nothing guarantees it.
+    struct StringEntry
+    {
+        unsigned id;
+        std::string str;
+    };
+    std::unordered_map<const char*, StringEntry> m_strings;
+    unsigned m_lastStringId = 0;
+
+#if wxUSE_THREADS
+    std::unordered_map<wxThreadIdType, unsigned> m_threads;
+    wxThreadIdType m_lastThreadId = 0;
+    unsigned m_lastThreadIndex = 0;
+#endif // wxUSE_THREADS
+
+    wxLongLong_t m_lastTimestamp = 0;
+};
+
+unsigned wxLogBinaryData::GetStringId(const char* str)
+{
+    if ( !str )
+        return 0;
+
+    StringEntry& entry = m_strings[str];
+    if ( entry.id && entry.str == str )
+        return entry.id;
+
+    // Either a new string or a different string at the same address.
+    entry.id = ++m_lastStringId;
+    entry.str = str;
+
+    PutByte(Tag_String);
+    PutVarUInt(entry.id);
+    PutVarUInt(entry.str.length());
+    PutBytes(entry.str.data(), entry.str.length());
+
+    return entry.id;
+}
+
+#if wxUSE_THREADS
+
+unsigned wxLogBinaryData::GetThreadIndex(wxThreadIdType threadId)
+{
+    // Consecutive records are very likely to come from the same thread.
+    if ( m_lastThreadIndex && threadId == m_lastThreadId )
+        return m_lastThreadIndex;
+
+    unsigned& index = m_threads[threadId];
+    if ( !index )
+    {
+        index = static_cast<unsigned>(m_threads.size());
+
+        PutByte(Tag_Thread);
+        PutVarUInt(index);
+        PutVarUInt(static_cast<wxULongLong_t>(threadId));
+    }
+
+    m_lastThreadId = threadId;
+    m_lastThreadIndex = index;
+
+    return index;
+}
+
+#endif // wxUSE_THREADS
+
+void wxLogBinaryData::PutMessage(const wxString& msg)
+{
+#if wxUSE_UNICODE_UTF8
+    const wxScopedCharBuffer utf8 = msg.utf8_str();
+    PutVarUInt(utf8.length());
+    PutBytes(utf8.data(), utf8.length());
+#else // wchar_t-based wxString
+    // Convert directly into the buffer reused for all messages to avoid
+    // allocating memory every time: a single wchar_t can't take more than 4
+    // bytes in UTF-8.
+    const size_t maxLen = 4*msg.length() + 1;
+    if ( m_utf8.size() < maxLen )
+        m_utf8.resize(maxLen);
+
+    size_t len = wxConvUTF8.FromWChar(m_utf8.data(), maxLen,
+                                      msg.wc_str(), msg.length());
+    if ( len == wxCONV_FAILED )
+    {
+        // This can only happen for invalid strings, e.g. containing
+        // unpaired surrogates, and it's better to lose the non-ASCII
+        // characters than the entire message in this case.
+        const wxScopedCharBuffer ascii = msg.ToAscii();
+        len = ascii.length();
+        memcpy(m_utf8.data(), ascii.data(), len);
+    }
+
+    PutVarUInt(len);
+    PutBytes(m_utf8.data(), len);
+#endif // wxUSE_UNICODE_UTF8/!wxUSE_UNICODE_UTF8
+}
+
+void wxLogBinaryData::LogRecord(wxLogLevel level,
+                                const wxString& msg,
+                                const wxLogRecordInfo& info)
+{
+    // Define the strings and the thread first, as this adds their
+    // definitions to the buffer before the record itself.
+    const unsigned fileId = GetStringId(info.filename);
+    const unsigned funcId = GetStringId(info.func);
+    const unsigned componentId = GetStringId(info.component);
+
+#if wxUSE_THREADS
+    const unsigned threadIndex = GetThreadIndex(info.threadId);
+#else
+    const unsigned threadIndex = 0;
+#endif
+
+    PutByte(Tag_Record);
+    PutVarUInt(level);
+    PutVarUInt(ZigZagEncode(info.timestampMS - m_lastTimestamp));
+    PutVarUInt(threadIndex);
+    PutVarUInt(fileId);
+    PutVarUInt(static_cast<unsigned>(info.line));
+    PutVarUInt(funcId);
+    PutVarUInt(componentId);
+    PutMessage(msg);
+
+    m_lastTimestamp = info.timestampMS;
+
+    if ( m_buffer.size() >= m_bufferSize )
+        WriteBuffer();
+}
+
+// ============================================================================
+// wxLogBinary implementation
+// ============================================================================
+
+wxLogBinary::wxLogBinary(wxOutputStream* stream, size_t bufferSize)
+    : m_data(new wxLogBinaryData(stream, bufferSize))
+{
+    wxASSERT_MSG( stream, "output stream must be specified" );
+}
+
+wxLogBinary::~wxLogBinary()
+{
+    // Don't call our Flush() which could output the last repeated message
+    // summary, as wxLog dtor does it anyhow, but ensure that everything is
+    // written to the stream.
+    m_data->Flush();
+}
+
+bool wxLogBinary::IsOk() const
+{
+    return m_data->IsOk();
+}
+
+void wxLogBinary::Flush()
+{
+    wxLog::Flush();
+
+    m_data->Flush();
+}
+
+void wxLogBinary::DoLogRecord(wxLogLevel level,
+                              const wxString& msg,
+                              const wxLogRecordInfo& info)
+{
+    m_data->LogRecord(level, msg, info);
+}
+
+// ============================================================================
+// wxLogBinaryReader implementation
+// ============================================================================
+
+wxLogBinaryReader::wxLogBinaryReader(wxInputStream& stream)
+    : m_stream(stream),
+      m_lastTimestamp(0),
+      m_version(0),
+      m_ok(false)
+{
+    char signature[SIGNATURE_LEN];
+    if ( !m_stream.ReadAll(signature, SIGNATURE_LEN) ||
+            memcmp(signature, SIGNATURE, SIGNATURE_LEN) != 0 )
+        return;
+
+    m_ok = true;
+
+    wxULongLong_t version;
+    if ( !ReadVarUInt(version) || version == 0 || version > wxLOG_BINARY_VERSION )
+    {
+        m_ok = false;
+        return;
+    }
+
+    m_version = static_cast<unsigned>(version);
+}
+
+bool wxLogBinaryReader::ReadByte(unsigned char& value)
+{
+    const int c = m_stream.GetC();
+    if ( c == wxEOF )
+    {
+        m_ok = false;
+        return false;
+    }
+
+    value = static_cast<unsigned char>(c);
+
+    return true;
+}
+
+bool wxLogBinaryReader::ReadVarUInt(wxULongLong_t& value)
+{
+    value = 0;
+    for ( unsigned shift = 0; shift < 7*VARINT_MAX_LEN; shift += 7 )
+    {
+        unsigned char c;
+        if ( !ReadByte(c) )
+            return false;
+
+        value |= static_cast<wxULongLong_t>(c & 0x7f) << shift;
+        if ( !(c & 0x80) )
+            return true;
+    }
+
+    // Too long number.
+    m_ok = false;
+    return false;
+}
+
+bool wxLogBinaryReader::ReadUTF8(wxString& str)
+{
+    wxULongLong_t len;
+    if ( !ReadVarUInt(len) )
+        return false;
+
+    if ( !len )
+    {
+        str.clear();
+        return true;
+    }
+
+    // Don't try to allocate huge amounts of memory for corrupted data.
+    if ( len > 0x7fffffff )
+    {
+        m_ok = false;
+        return false;
+    }
+
+    m_utf8.resize(static_cast<size_t>(len));
+    if ( !m_stream.ReadAll(m_utf8.data(), m_utf8.size()) )
+    {
+        m_ok = false;
+        return false;
+    }
+
+    str = wxString::FromUTF8(m_utf8.data(), m_utf8.size());
+
+    return true;
+}
+
+bool wxLogBinaryReader::ReadStringRef(wxString& str)
+{
+    wxULongLong_t id;
+    if ( !ReadVarUInt(id) )
+        return false;
+
+    if ( !id )
+    {
+        str.clear();
+        return true;
+    }
+
+    if ( id > m_strings.size() )
+    {
+        m_ok = false;
+        return false;
+    }
+
+    str = m_strings[static_cast<size_t>(id - 1)];
+
+    return true;
+}
+
+bool wxLogBinaryReader::ReadRecord(wxLogBinaryRecord& record)
+{
+    while ( m_ok )
+    {
+        const int tag = m_stream.GetC();
+        if ( tag == wxEOF )
+        {
+            // This is the normal end of the log, unless an error occurred.
+            if ( !m_stream.Eof() )
+                m_ok = false;
+
+            return false;
+        }
+
+        wxULongLong_t id;
+        switch ( tag )
+        {
+            case Tag_String:
+                {
+                    wxString str;
+                    if ( !ReadVarUInt(id) || !ReadUTF8(str) )
+                        return false;
+
+                    // Strings are defined in order, but the same string may
+                    // be defined again.
+                    if ( id == m_strings.size() + 1 )
+                        m_strings.push_back(str);
+                    else if ( id && id <= m_strings.size() )
+                        m_strings[static_cast<size_t>(id - 1)] = str;
+                    else
+                        m_ok = false;
+                }
+                break;
+
+            case Tag_Thread:
+                {
+                    wxULongLong_t threadId;
+                    if ( !ReadVarUInt(id) || !ReadVarUInt(threadId) )
+                        return false;
+
+                    if ( id != m_threads.size() + 1 )
+                    {
+                        m_ok = false;
+                        break;
+                    }
+
+                    m_threads.push_back(threadId);
+                }
+                break;
+
+            case Tag_Record:
+                {
+                    wxULongLong_t level,
+                                  timestampDiff,
+                                  threadIndex,
+                                  line;
+                    if ( !ReadVarUInt(level) ||
+                            !ReadVarUInt(timestampDiff) ||
+                                !ReadVarUInt(threadIndex) ||
+                                    !ReadStringRef(record.filename) ||
+                                        !ReadVarUInt(line) ||
+                                            !ReadStringRef(record.func) ||
+                                                !ReadStringRef(record.component) ||
+                                                    !ReadUTF8(record.msg) )
+                        return false;
+
+                    if ( threadIndex > m_threads.size() )
+                    {
+                        m_ok = false;
+                        break;
+                    }
+
+                    m_lastTimestamp += ZigZagDecode(timestampDiff);
+
+                    record.level = static_cast<wxLogLevel>(level);
+                    record.timestampMS = m_lastTimestamp;
+                    record.threadId = threadIndex
+                                        ? m_threads[static_cast<size_t>(threadIndex - 1)]
+                                        : 0;
+                    record.line = static_cast<int>(line);
+                }
+                return true;
+
+            default:
+                m_ok = false;
+        }
+    }
+
+    return false;
+}
+
+#endif // wxUSE_LOG && wxUSE_STREAMS
@@ -180,6 +180,13 @@ size_t wxMemoryOutputStream::OnSysWrite(const void *buffer, size_t nbytes)
     return newpos - oldpos;
 }
 
+wxOutputStream& wxMemoryOutputStream::WriteV(const wxIOVec *vec, size_t count)
+{
+    // the stream buffer grows only once to accommodate all the data
+    m_lastcount = m_o_streambuf->Write(vec, count);
+    return *this;
+}
+
 wxFileOffset wxMemoryOutputStream::OnSysSeek(wxFileOffset pos, wxSeekMode mode)
 {
     return m_o_streambuf->Seek(pos, mode);
@@ -44,9 +44,17 @@
     #include "wx/msw/private.h"
 #endif
 
+#include "wx/private/image.h"
+
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif
+
 #include <stdlib.h>
 #include <string.h>
 
+#include <vector>
+
 namespace
 {
 
@@ -329,6 +337,57 @@ prescan_quantize (j_decompress_ptr cinfo, JSAMPARRAY input_buf,
 }
 
 
+/*
+ * Prescan all rows of the image, possibly using several threads each of
+ * which collects its own histogram, merged into the main one at the end.
+ * Notice that the result is the same as when doing it serially because the
+ * cells are saturated in the same way.
+ */
+
+void
+prescan_parallel (j_decompress_ptr cinfo, JSAMPARRAY input_buf, int num_rows)
+{
+  my_cquantize_ptr cquantize = (my_cquantize_ptr) cinfo->cquantize;
+
+#if wxUSE_THREADS
+  wxCriticalSection cs;
+#endif
+
+  wxForEachImageRowBand(num_rows, cinfo->output_width,
+    [&](int start, int end)
+    {
+      if (start == 0 && end == num_rows) {
+        /* no need for a separate histogram if there is a single band */
+        prescan_quantize(cinfo, input_buf, nullptr, num_rows);
+        return;
+      }
+
+      my_cquantizer band = *cquantize;
+      std::vector<histcell> cells(HIST_C0_ELEMS*HIST_C1_ELEMS*HIST_C2_ELEMS);
+      hist2d planes[HIST_C0_ELEMS];
+      for (int i = 0; i < HIST_C0_ELEMS; i++)
+        planes[i] = (hist2d) &cells[i*HIST_C1_ELEMS*HIST_C2_ELEMS];
+      band.histogram = planes;
+
+      j_decompress band_cinfo = *cinfo;
+      band_cinfo.cquantize = &band;
+      prescan_quantize(&band_cinfo, input_buf + start, nullptr, end - start);
+
+#if wxUSE_THREADS
+      wxCriticalSectionLocker lock(cs);
+#endif
+      for (int i = 0; i < HIST_C0_ELEMS; i++) {
+        histptr dst = (histptr) cquantize->histogram[i];
+        const histcell *src = &cells[i*HIST_C1_ELEMS*HIST_C2_ELEMS];
+        for (int j = 0; j < HIST_C1_ELEMS*HIST_C2_ELEMS; j++) {
+          const unsigned sum = (unsigned) dst[j] + src[j];
+          dst[j] = (histcell) (sum > 0xffff ? 0xffff : sum);
+        }
+      }
+    });
+}
+
+
 /*
  * Next we have the really interesting routines: selection of a colormap
  * given the completed histogram.
@@ -988,20 +1047,47 @@ fill_inverse_cmap (j_decompress_ptr cinfo, int c0, int c1, int c2)
 }
 
 
+/*
+ * Fill the entire inverse colormap instead of doing it lazily, this is
+ * required for using it from several threads. As the update boxes are
+ * independent, they can be filled in parallel too.
+ */
+
+static void
+fill_all_inverse_cmap (j_decompress_ptr cinfo)
+{
+  /* Each box is filled by comparing every cell in it with the colours */
+  /* close to it, so use the number of colours to estimate the cost of */
+  /* filling a slice of boxes in terms of the number of processed pixels. */
+  const int slice_cost = (BOX_C0_ELEMS * HIST_C1_ELEMS * HIST_C2_ELEMS) *
+                         (cinfo->actual_number_of_colors / 16 + 1);
+
+  wxForEachImageRowBand(HIST_C0_ELEMS >> BOX_C0_LOG, slice_cost,
+    [cinfo](int start, int end)
+    {
+      for (int c0 = start << BOX_C0_LOG; c0 < end << BOX_C0_LOG; c0 += BOX_C0_ELEMS)
+        for (int c1 = 0; c1 < HIST_C1_ELEMS; c1 += BOX_C1_ELEMS)
+          for (int c2 = 0; c2 < HIST_C2_ELEMS; c2 += BOX_C2_ELEMS)
+            fill_inverse_cmap(cinfo, c0, c1, c2);
+    });
+}
+
+
 /*
  * Map some rows of pixels to the output colormapped representation.
  */
 
-#if 0
 void
 pass2_no_dither (j_decompress_ptr cinfo,
          JSAMPARRAY input_buf, JSAMPARRAY output_buf, int num_rows)
 /* This version performs no dithering */
+/* Notice that the inverse colormap must have been filled by */
+/* fill_all_inverse_cmap() before, as this function may be called */
+/* concurrently from several threads and so doesn't update the cache. */
 {
   my_cquantize_ptr cquantize = (my_cquantize_ptr) cinfo->cquantize;
   hist3d histogram = cquantize->histogram;
   JSAMPROW inptr, outptr;
-  histptr cachep;
   int c0, c1, c2;
   int row;
   JDIMENSION col;
@@ -1015,17 +1101,72 @@ pass2_no_dither (j_decompress_ptr cinfo,
       c0 = GETJSAMPLE(*inptr++) >> C0_SHIFT;
       c1 = GETJSAMPLE(*inptr++) >> C1_SHIFT;
       c2 = GETJSAMPLE(*inptr++) >> C2_SHIFT;
-      cachep = & histogram[c0][c1][c2];
-      /* If we have not seen this color before, find nearest colormap entry */
-      /* and update the cache */
-      if (*cachep == 0)
-    fill_inverse_cmap(cinfo, c0,c1,c2);
       /* Now emit the colormap index for this cell */
-      *outptr++ = (JSAMPLE) (*cachep - 1);
+      *outptr++ = (JSAMPLE) (histogram[c0][c1][c2] - 1);
+    }
+  }
+}
+
+/* 8x8 Bayer threshold matrix used for ordered dithering */
+static const unsigned char bayer_matrix[8][8] = {
+  {  0, 32,  8, 40,  2, 34, 10, 42 },
+  { 48, 16, 56, 24, 50, 18, 58, 26 },
+  { 12, 44,  4, 36, 14, 46,  6, 38 },
+  { 60, 28, 52, 20, 62, 30, 54, 22 },
+  {  3, 35, 11, 43,  1, 33,  9, 41 },
+  { 51, 19, 59, 27, 49, 17, 57, 25 },
+  { 15, 47,  7, 39, 13, 45,  5, 37 },
+  { 63, 31, 55, 23, 61, 29, 53, 21 }
+};
+
+void
+pass2_ordered_dither (j_decompress_ptr cinfo,
+         JSAMPARRAY input_buf, JSAMPARRAY output_buf,
+         int first_row, int num_rows)
+/* This version performs ordered dithering */
+/* As pass2_no_dither(), this requires the complete inverse colormap, but, */
+/* unlike Floyd-Steinberg dithering, doesn't depend on the previous rows, */
+/* so can be used for any band of rows starting at first_row. */
+{
+  my_cquantize_ptr cquantize = (my_cquantize_ptr) cinfo->cquantize;
+  hist3d histogram = cquantize->histogram;
+  JSAMPROW inptr, outptr;
+  int row;
+  JDIMENSION col;
+  JDIMENSION width = cinfo->output_width;
+  JSAMPLE *range_limit = cinfo->sample_range_limit;
+  int dither[8][8];
+  int i, j;
+
+  /* Scale the matrix values to be symmetric around 0 and to cover about */
+  /* half of the distance between the colours of a uniform palette with */
+  /* the same number of entries, i.e. 256/cbrt(number of colours): this */
+  /* gives the smallest error in practice, while still avoiding banding. */
+  {
+    int spread = 1;
+    while ((spread + 1) * (spread + 1) * (spread + 1) <=
+           cinfo->actual_number_of_colors)
+      spread++;
+    spread = (MAXJSAMPLE + 1) / spread;
+
+    for (i = 0; i < 8; i++)
+      for (j = 0; j < 8; j++)
+        dither[i][j] = ((2 * bayer_matrix[i][j] - 63) * spread) / 256;
+  }
+
+  for (row = 0; row < num_rows; row++) {
+    const int *dither_row = dither[(first_row + row) & 7];
+    inptr = input_buf[row];
+    outptr = output_buf[row];
+    for (col = 0; col < width; col++) {
+      const int d = dither_row[col & 7];
+      int c0 = GETJSAMPLE(range_limit[GETJSAMPLE(*inptr++) + d]) >> C0_SHIFT;
+      int c1 = GETJSAMPLE(range_limit[GETJSAMPLE(*inptr++) + d]) >> C1_SHIFT;
+      int c2 = GETJSAMPLE(range_limit[GETJSAMPLE(*inptr++) + d]) >> C2_SHIFT;
+      *outptr++ = (JSAMPLE) (histogram[c0][c1][c2] - 1);
     }
   }
 }
-#endif
 
 void
 pass2_fs_dither (j_decompress_ptr cinfo,
@@ -1420,7 +1561,7 @@ prepare_range_limit_table (j_decompress_ptr cinfo)
 wxIMPLEMENT_DYNAMIC_CLASS(wxQuantize, wxObject);
 
 void wxQuantize::DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, unsigned char **out_rows,
-    unsigned char *palette, int desiredNoColours)
+    unsigned char *palette, int desiredNoColours, int flags)
 {
     j_decompress dec;
     my_cquantize_ptr cquantize;
@@ -1434,11 +1575,31 @@ void wxQuantize::DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, uns
 
 
     cquantize->pub.start_pass(&dec, true);
-    cquantize->pub.color_quantize(&dec, in_rows, out_rows, h);
+    prescan_parallel(&dec, in_rows, h);
     cquantize->pub.finish_pass(&dec);
 
     cquantize->pub.start_pass(&dec, false);
-    cquantize->pub.color_quantize(&dec, in_rows, out_rows, h);
+    if ( flags & (wxQUANTIZE_NO_DITHER | wxQUANTIZE_ORDERED_DITHER) )
+    {
+        // Unlike Floyd-Steinberg dithering, these methods process each row
+        // independently, so they can be done in parallel.
+        fill_all_inverse_cmap(&dec);
+
+        const bool ordered = (flags & wxQUANTIZE_ORDERED_DITHER) != 0;
+        wxForEachImageRowBand(h, w, [&](int start, int end)
+        {
+            if ( ordered )
+                pass2_ordered_dither(&dec, in_rows + start, out_rows + start,
+                                     start, end - start);
+            else
+                pass2_no_dither(&dec, in_rows + start, out_rows + start,
+                                end - start);
+        });
+    }
+    else
+    {
+        cquantize->pub.color_quantize(&dec, in_rows, out_rows, h);
+    }
     cquantize->pub.finish_pass(&dec);
 
 
@@ -1507,7 +1668,8 @@ bool wxQuantize::Quantize(const wxImage& src, wxImage& dest,
         outrows[i] = data8bit + w * i;
 
     //RGB->palette
-    DoQuantize(w, h, rows, outrows, palette, desiredNoColours);
+    DoQuantize(w, h, rows, outrows, palette, desiredNoColours,
+               flags & (wxQUANTIZE_NO_DITHER | wxQUANTIZE_ORDERED_DITHER));
 
     delete[] rows;
     delete[] outrows;
@@ -31,6 +31,13 @@
     #include "wx/crt.h"
 #endif //WX_PRECOMP
 
+#include "wx/thread.h"
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 // At least FreeBSD requires this.
 #if defined(__UNIX__)
 #   include <sys/types.h>
@@ -90,6 +97,10 @@ namespace
 #define REG_NOSUB     0x0020    // Don't return matches.
 #define REG_NOTEMPTY  0x0100    // Same as PCRE2_NOTEMPTY.
 
+// Non-standard flags.
+#define REG_NOJIT       0x1000  // Don't use JIT compiler.
+#define REG_NOUTFCHECK  0x2000  // Same as PCRE2_NO_UTF_CHECK.
+
 enum
 {
     REG_NOERROR = 0,    // Must be 0.
@@ -100,13 +111,32 @@ enum
 
 typedef size_t regoff_t;
 
+// Compiled PCRE code which can be shared by several regex_t objects, as the
+// code itself is never modified after compiling it and only the match data
+// is specific to each object.
+class wxRegExCode
+{
+public:
+    explicit wxRegExCode(pcre2_code* code) : m_code(code) { }
+    ~wxRegExCode() { pcre2_code_free(m_code); }
+
+    pcre2_code* get() const { return m_code; }
+
+private:
+    pcre2_code* const m_code;
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExCode);
+};
+
+typedef std::shared_ptr<wxRegExCode> wxRegExCodePtr;
+
 struct regex_t
 {
     // This is the only "public" field -- not that it really matters anyhow for
     // this private struct.
     size_t re_nsub;
 
-    pcre2_code* code;
+    wxRegExCodePtr code;
     pcre2_match_data* match_data;
 
     int errorcode;
@@ -119,6 +149,13 @@ struct regmatch_t
     regoff_t rm_eo;
 };
 
+// Non-standard function using the already compiled code for the regex.
+void wx_reguse(regex_t* preg, const wxRegExCodePtr& code)
+{
+    preg->code = code;
+    preg->match_data = pcre2_match_data_create_from_pattern(code->get(), nullptr);
+}
+
 int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
 {
     // PCRE2_UTF is required in order to handle non-ASCII characters when using
@@ -141,17 +178,17 @@ int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
     else
         options |= PCRE2_DOTALL;
 
-    preg->code = pcre2_compile
-                 (
-                    (PCRE2_SPTR)pattern,
-                    PCRE2_ZERO_TERMINATED,
-                    options,
-                    &preg->errorcode,
-                    &preg->erroroffset,
-                    nullptr                    // use default context
-                 );
-
-    if ( !preg->code )
+    pcre2_code* const code = pcre2_compile
+                             (
+                                (PCRE2_SPTR)pattern,
+                                PCRE2_ZERO_TERMINATED,
+                                options,
+                                &preg->errorcode,
+                                &preg->erroroffset,
+                                nullptr                // use default context
+                             );
+
+    if ( !code )
     {
         // Don't bother translating PCRE error to the most appropriate POSIX
         // error code, there is no way to do it losslessly and the main thing
@@ -159,7 +196,14 @@ int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
         return REG_BADPAT;
     }
 
-    preg->match_data = pcre2_match_data_create_from_pattern(preg->code, nullptr);
+    // Use the JIT compiler, which makes matching several times faster, unless
+    // asked not to. This fails if PCRE was built without JIT support or if
+    // it's not available for the current platform, but we don't need to
+    // check for it as pcre2_match() just uses the interpreter in this case.
+    if ( !(cflags & REG_NOJIT) )
+        pcre2_jit_compile(code, PCRE2_JIT_COMPLETE);
+
+    wx_reguse(preg, std::make_shared<wxRegExCode>(code));
 
     return REG_NOERROR;
 }
@@ -176,17 +220,36 @@ wx_regexec(const regex_t* preg, const wxRegChar* string, size_t len,
         options |= PCRE2_NOTEOL;
     if ( eflags & REG_NOTEMPTY )
         options |= PCRE2_NOTEMPTY;
-
-    const int rc = pcre2_match
-                   (
-                        preg->code,
-                        (PCRE2_SPTR)string,
-                        len,
-                        0,                      // start offset
-                        options,
-                        preg->match_data,
-                        nullptr                    // use default context
-                   );
+    if ( eflags & REG_NOUTFCHECK )
+        options |= PCRE2_NO_UTF_CHECK;
+
+    int rc = pcre2_match
+             (
+                preg->code->get(),
+                (PCRE2_SPTR)string,
+                len,
+                0,                      // start offset
+                options,
+                preg->match_data,
+                nullptr                 // use default context
+             );
+
+    // The JIT code uses a stack of fixed size, which may be insufficient for
+    // some patterns and subjects, in which case fall back to the interpreter
+    // which doesn't have this limitation.
+    if ( rc == PCRE2_ERROR_JIT_STACKLIMIT )
+    {
+        rc = pcre2_match
+             (
+                preg->code->get(),
+                (PCRE2_SPTR)string,
+                len,
+                0,
+                options | PCRE2_NO_JIT,
+                preg->match_data,
+                nullptr
+             );
+    }
 
     if ( rc == PCRE2_ERROR_NOMATCH )
         return REG_NOMATCH;
@@ -245,9 +308,191 @@ wx_regerror(int errcode, const regex_t* preg, wxRegErrorChar* errbuf, size_t err
 void wx_regfree(regex_t* preg)
 {
     pcre2_match_data_free(preg->match_data);
-    pcre2_code_free(preg->code);
+    preg->match_data = nullptr;
+
+    preg->code.reset();
+}
+
+// ----------------------------------------------------------------------------
+// wxRegExCache: process-wide cache of the compiled regexes
+// ----------------------------------------------------------------------------
+
+// This cache allows to avoid compiling the same regex again when the same
+// pattern is used by several wxRegEx objects, which is common when wxRegEx is
+// used as a local variable. It keeps the most recently used patterns and
+// discards the least recently used one when its size limit is reached.
+class wxRegExCache
+{
+public:
+    static wxRegExCache& Get()
+    {
+        static wxRegExCache s_cache;
+        return s_cache;
+    }
+
+    // Return the code compiled for the given pattern and flags or null if
+    // it's not in the cache.
+    wxRegExCodePtr Find(const wxString& expr, int flags)
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif // wxUSE_THREADS
+
+        if ( !m_maxSize )
+            return wxRegExCodePtr();
+
+        const Index::const_iterator it = m_index.find(Key(expr, flags));
+        if ( it == m_index.end() )
+            return wxRegExCodePtr();
+
+        // Move the entry to the front of the list as it's the most recently
+        // used one now.
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+        return it->second->code;
+    }
+
+    void Add(const wxString& expr, int flags, const wxRegExCodePtr& code)
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif // wxUSE_THREADS
+
+        if ( !m_maxSize )
+            return;
+
+        const Key key(expr, flags);
+
+        // Another thread could have compiled the same pattern in the meanwhile,
+        // just use the latest code in this case.
+        const Index::iterator it = m_index.find(key);
+        if ( it != m_index.end() )
+        {
+            it->second->code = code;
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return;
+        }
+
+        m_entries.push_front(Entry(key, code));
+        m_index[key] = m_entries.begin();
+
+        Shrink();
+    }
+
+    void SetMaxSize(size_t maxSize)
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif // wxUSE_THREADS
+
+        m_maxSize = maxSize;
+
+        Shrink();
+    }
+
+private:
+    wxRegExCache() : m_maxSize(64) { }
+
+    // Remove the least recently used entries until the cache size doesn't
+    // exceed the maximal one. Must be called with the lock held.
+    void Shrink()
+    {
+        while ( m_entries.size() > m_maxSize )
+        {
+            m_index.erase(m_entries.back().key);
+            m_entries.pop_back();
+        }
+    }
+
+    struct Key
+    {
+        Key(const wxString& expr_, int flags_) : expr(expr_), flags(flags_) { }
+
+        bool operator==(const Key& other) const
+        {
+            return flags == other.flags && expr == other.expr;
+        }
+
+        wxString expr;
+        int flags;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return std::hash<wxString>()(key.expr) ^ static_cast<size_t>(key.flags);
+        }
+    };
+
+    struct Entry
+    {
+        Entry(const Key& key_, const wxRegExCodePtr& code_)
+            : key(key_), code(code_)
+        {
+        }
+
+        Key key;
+        wxRegExCodePtr code;
+    };
+
+    // The entries in the order of their use, from the most recently used one.
+    typedef std::list<Entry> Entries;
+    Entries m_entries;
+
+    typedef std::unordered_map<Key, Entries::iterator, KeyHash> Index;
+    Index m_index;
+
+    size_t m_maxSize;
+
+#if wxUSE_THREADS
+    wxCriticalSection m_cs;
+#endif // wxUSE_THREADS
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExCache);
+};
+
+#ifndef WXREGEX_CONVERT_TO_MB
+
+// Return the offset in bytes in the given UTF-8 string corresponding to the
+// given offset in the same string converted to wchar_t.
+size_t UTF8OffsetFromWide(const char* text, size_t len, size_t offset)
+{
+    size_t pos = 0;
+    for ( size_t n = 0; n < offset && pos < len; )
+    {
+        // The text was already successfully converted from UTF-8, so we don't
+        // need to check for its validity here.
+        const unsigned char c = static_cast<unsigned char>(text[pos]);
+        if ( c < 0x80 )
+        {
+            pos += 1;
+        }
+        else if ( c < 0xe0 )
+        {
+            pos += 2;
+        }
+        else if ( c < 0xf0 )
+        {
+            pos += 3;
+        }
+        else
+        {
+            pos += 4;
+
+            // Characters outside of the BMP use surrogate pairs in UTF-16.
+            if ( sizeof(wchar_t) == 2 )
+                n++;
+        }
+
+        n++;
+    }
+
+    return pos;
 }
 
+#endif // !WXREGEX_CONVERT_TO_MB
+
 } // anonymous namespace
 
 // ----------------------------------------------------------------------------
@@ -296,7 +541,11 @@ public:
 
     // RE operations
     bool Compile(wxString expr, int flags = 0);
-    bool Matches(const wxRegChar *str, int flags, size_t len) const;
+    bool Matches(const wxRegChar *str, int flags, size_t len,
+                 bool checkUTF = true) const;
+#ifndef WXREGEX_CONVERT_TO_MB
+    bool MatchesUTF8(const char *str, int flags, size_t len) const;
+#endif
     bool GetMatch(size_t *start, size_t *len, size_t index = 0) const;
     size_t GetMatchCount() const;
     int Replace(wxString *pattern, const wxString& replacement,
@@ -306,6 +555,9 @@ private:
     // return the string containing the error message for the given err code
     wxString GetErrorMsg(int errorcode) const;
 
+    // set up the members after successfully compiling the RE
+    void OnCompiled(int flags);
+
     // init the members
     void Init()
     {
@@ -341,6 +593,11 @@ private:
 
     // true if m_RegEx is valid
     bool            m_isCompiled;
+
+#ifndef WXREGEX_CONVERT_TO_MB
+    // buffer used by MatchesUTF8() for the text converted from UTF-8
+    std::vector<wchar_t> m_textWide;
+#endif
 };
 
 
@@ -951,9 +1208,24 @@ bool wxRegExImpl::Compile(wxString expr, int flags)
 {
     Reinit();
 
-    wxASSERT_MSG( !(flags & ~(wxRE_ADVANCED | wxRE_BASIC | wxRE_ICASE | wxRE_NOSUB | wxRE_NEWLINE)),
+    wxASSERT_MSG( !(flags & ~(wxRE_ADVANCED | wxRE_BASIC | wxRE_ICASE | wxRE_NOSUB | wxRE_NEWLINE | wxRE_NOJIT)),
                   wxT("unrecognized flags in wxRegEx::Compile") );
 
+    // Reuse the already compiled code if we have it.
+    wxRegExCache& cache = wxRegExCache::Get();
+    if ( const wxRegExCodePtr code = cache.Find(expr, flags) )
+    {
+        wx_reguse(&m_RegEx, code);
+        OnCompiled(flags);
+
+        return true;
+    }
+
+    // Remember the original expression and flags for adding them to the cache
+    // later as both of them can be modified below.
+    const wxString exprOrig = expr;
+    const int flagsOrig = flags;
+
     // Deal with the directors and embedded options first (this can modify
     // flags).
     expr = ConvertMetasyntax(expr, flags);
@@ -979,6 +1251,8 @@ bool wxRegExImpl::Compile(wxString expr, int flags)
         flagsRE |= REG_NOSUB;
     if ( flags & wxRE_NEWLINE )
         flagsRE |= REG_NEWLINE;
+    if ( flags & wxRE_NOJIT )
+        flagsRE |= REG_NOJIT;
 
 #ifndef WXREGEX_CONVERT_TO_MB
     const wxChar *exprstr = expr.c_str();
@@ -999,28 +1273,36 @@ bool wxRegExImpl::Compile(wxString expr, int flags)
     }
     else // ok
     {
-        // don't allocate the matches array now, but do it later if necessary
-        if ( flags & wxRE_NOSUB )
-        {
-            // we don't need it at all
-            m_nMatches = 0;
-        }
-        else
-        {
-            // we will alloc the array later (only if really needed) but count
-            // the number of sub-expressions in the regex right now
-            m_nMatches = pcre2_get_ovector_count(m_RegEx.match_data);
-        }
+        cache.Add(exprOrig, flagsOrig, m_RegEx.code);
 
-        m_isCompiled = true;
+        OnCompiled(flags);
     }
 
     return IsValid();
 }
 
+void wxRegExImpl::OnCompiled(int flags)
+{
+    // don't allocate the matches array now, but do it later if necessary
+    if ( flags & wxRE_NOSUB )
+    {
+        // we don't need it at all
+        m_nMatches = 0;
+    }
+    else
+    {
+        // we will alloc the array later (only if really needed) but count
+        // the number of sub-expressions in the regex right now
+        m_nMatches = pcre2_get_ovector_count(m_RegEx.match_data);
+    }
+
+    m_isCompiled = true;
+}
+
 bool wxRegExImpl::Matches(const wxRegChar *str,
                           int flags,
-                          size_t len) const
+                          size_t len,
+                          bool checkUTF) const
 {
     wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
 
@@ -1035,6 +1317,8 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
         flagsRE |= REG_NOTEOL;
     if ( flags & wxRE_NOTEMPTY )
         flagsRE |= REG_NOTEMPTY;
+    if ( !checkUTF )
+        flagsRE |= REG_NOUTFCHECK;
 
     // allocate matches array if needed
     wxRegExImpl *self = wxConstCast(this, wxRegExImpl);
@@ -1066,6 +1350,48 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
     }
 }
 
+#ifndef WXREGEX_CONVERT_TO_MB
+
+bool wxRegExImpl::MatchesUTF8(const char *str, int flags, size_t len) const
+{
+    const size_t lenWide = wxConvUTF8.ToWChar(nullptr, 0, str, len);
+    if ( lenWide == wxCONV_FAILED )
+    {
+        wxLogError(_("Failed to find match for regular expression: %s"),
+                   _("invalid UTF-8 text"));
+        return false;
+    }
+
+    // reuse the same buffer for all calls to avoid allocating it every time
+    wxRegExImpl *self = wxConstCast(this, wxRegExImpl);
+    if ( m_textWide.size() <= lenWide )
+        self->m_textWide.resize(lenWide + 1);
+
+    wxConvUTF8.ToWChar(&self->m_textWide[0], lenWide, str, len);
+
+    if ( !Matches(&m_textWide[0], flags, lenWide) )
+        return false;
+
+    // translate the offsets of the matches from wide characters to bytes
+    if ( m_Matches )
+    {
+        regmatch_t* const matches = m_Matches->get();
+        for ( size_t n = 0; n < m_nMatches; n++ )
+        {
+            regmatch_t& m = matches[n];
+            if ( m.rm_so == static_cast<regoff_t>(-1) )
+                continue;
+
+            m.rm_so = UTF8OffsetFromWide(str, len, m.rm_so);
+            m.rm_eo = UTF8OffsetFromWide(str, len, m.rm_eo);
+        }
+    }
+
+    return true;
+}
+
+#endif // !WXREGEX_CONVERT_TO_MB
+
 bool wxRegExImpl::GetMatch(size_t *start, size_t *len, size_t index) const
 {
     wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
@@ -1132,10 +1458,14 @@ int wxRegExImpl::Replace(wxString *text,
 
     // note that "^" shouldn't match after the first call to Matches() so we
     // use wxRE_NOTBOL to prevent it from happening
+    //
+    // also, the entire text is checked for validity by the first call, so
+    // there is no need to do it again for each subsequent match
     while ( (!maxMatches || countRepl < maxMatches) &&
              Matches(textstr + matchStart,
                      countRepl ? wxRE_NOTBOL : 0,
-                     textlen - matchStart) )
+                     textlen - matchStart,
+                     countRepl == 0) )
     {
         // the string possibly contains back references: we need to calculate
         // the replacement text anew after each match
@@ -1267,6 +1597,30 @@ bool wxRegEx::Matches(const wxString& str, int flags) const
     return m_impl->Matches(textstr, flags, textlen);
 }
 
+bool wxRegEx::Matches(const wxChar *text, int flags, size_t len) const
+{
+    wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
+
+#ifndef WXREGEX_CONVERT_TO_MB
+    // the text can be used directly, without any conversion
+    return m_impl->Matches(text, flags, len);
+#else
+    return Matches(wxString(text, len), flags);
+#endif
+}
+
+bool wxRegEx::MatchesUTF8(const char *text, size_t len, int flags) const
+{
+    wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
+
+#ifndef WXREGEX_CONVERT_TO_MB
+    return m_impl->MatchesUTF8(text, flags, len);
+#else
+    // the text can be used directly, without any conversion
+    return m_impl->Matches(text, flags, len);
+#endif
+}
+
 bool wxRegEx::GetMatch(size_t *start, size_t *len, size_t index) const
 {
     wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
@@ -1303,6 +1657,12 @@ int wxRegEx::Replace(wxString *pattern,
     return m_impl->Replace(pattern, replacement, maxMatches);
 }
 
+/* static */
+void wxRegEx::SetCacheSize(size_t size)
+{
+    wxRegExCache::Get().SetMaxSize(size);
+}
+
 wxString wxRegEx::QuoteMeta(const wxString& str)
 {
     static const wxString s_strMetaChars = wxS("\\^$.|?*+()[]{}");
@@ -44,6 +44,30 @@ size_t wxSocketOutputStream::OnSysWrite(const void *buffer, size_t size)
     return ret;
 }
 
+wxOutputStream& wxSocketOutputStream::WriteV(const wxIOVec *vec, size_t count)
+{
+    size_t total = 0;
+    for ( size_t n = 0; n < count; n++ )
+        total += vec[n].size;
+
+    // wxSocketBase doesn't support vectored writes, but sending a lot of
+    // small chunks separately is expensive, so gather them in a single buffer
+    // if they're not too big.
+    if ( count < 2 || total > 64*1024 )
+        return wxOutputStream::WriteV(vec, count);
+
+    wxCharBuffer buf(total);
+    char *p = buf.data();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        if ( vec[n].size )
+            memcpy(p, vec[n].data, vec[n].size);
+        p += vec[n].size;
+    }
+
+    return Write(buf.data(), total);
+}
+
 // ---------------------------------------------------------------------------
 // wxSocketInputStream
 // ---------------------------------------------------------------------------
@@ -57,6 +57,17 @@
     #define WC_UTF16
 #endif
 
+// SSE2 and NEON are used for the ASCII fast paths when they're always
+// available, see wxSkipASCIIPrefix()
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define wxSTRCONV_USE_SSE2
+    #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define wxSTRCONV_USE_NEON
+    #include <arm_neon.h>
+#endif
+
 
 // ============================================================================
 // implementation
@@ -943,6 +954,208 @@ extern const unsigned char tableUtf8Lengths[256] = {
                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0   // F5..FF
 };
 
+// ----------------------------------------------------------------------------
+// ASCII fast paths
+// ----------------------------------------------------------------------------
+
+// These functions process the ASCII characters, which are the same in UTF-8
+// and wchar_t strings, in blocks instead of one by one. As in wxImage code,
+// we only use SSE2 and NEON, which are always available on x86-64 and
+// AArch64 respectively, and fall back to processing 8 bytes at once in a
+// 64-bit word elsewhere.
+//
+// All of them stop at the first block containing a non-ASCII character and
+// return the number of characters processed, the rest of the string must be
+// handled by the caller.
+
+namespace
+{
+
+// mask selecting the high bits of all bytes of a 64-bit word
+const wxUint64 ASCII_WORD_MASK = wxULL(0x8080808080808080);
+
+inline wxUint64 LoadWord(const char *p)
+{
+    wxUint64 w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+} // anonymous namespace
+
+size_t wxSkipASCIIPrefix(const char *src, size_t len)
+{
+    size_t n = 0;
+
+#if defined(wxSTRCONV_USE_SSE2)
+    for ( ; n + 16 <= len; n += 16 )
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(src + n));
+        if ( _mm_movemask_epi8(v) )
+            break;
+    }
+#elif defined(wxSTRCONV_USE_NEON)
+    for ( ; n + 16 <= len; n += 16 )
+    {
+        const uint8x16_t v = vld1q_u8((const uint8_t *)(src + n));
+        if ( vmaxvq_u8(v) & 0x80 )
+            break;
+    }
+#endif
+
+    for ( ; n + 8 <= len; n += 8 )
+    {
+        if ( LoadWord(src + n) & ASCII_WORD_MASK )
+            break;
+    }
+
+    return n;
+}
+
+size_t wxWidenASCIIPrefix(wchar_t *dst, const char *src, size_t len)
+{
+    if ( !dst )
+        return wxSkipASCIIPrefix(src, len);
+
+    size_t n = 0;
+
+#if defined(wxSTRCONV_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; n + 16 <= len; n += 16 )
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(src + n));
+        if ( _mm_movemask_epi8(v) )
+            break;
+
+        const __m128i lo = _mm_unpacklo_epi8(v, zero);
+        const __m128i hi = _mm_unpackhi_epi8(v, zero);
+        __m128i * const out = (__m128i *)(dst + n);
+#ifdef WC_UTF16
+        _mm_storeu_si128(out, lo);
+        _mm_storeu_si128(out + 1, hi);
+#else
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+#endif
+    }
+#elif defined(wxSTRCONV_USE_NEON)
+    for ( ; n + 16 <= len; n += 16 )
+    {
+        const uint8x16_t v = vld1q_u8((const uint8_t *)(src + n));
+        if ( vmaxvq_u8(v) & 0x80 )
+            break;
+
+        const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+        const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+#ifdef WC_UTF16
+        uint16_t * const out = (uint16_t *)(dst + n);
+        vst1q_u16(out, lo);
+        vst1q_u16(out + 8, hi);
+#else
+        uint32_t * const out = (uint32_t *)(dst + n);
+        vst1q_u32(out, vmovl_u16(vget_low_u16(lo)));
+        vst1q_u32(out + 4, vmovl_u16(vget_high_u16(lo)));
+        vst1q_u32(out + 8, vmovl_u16(vget_low_u16(hi)));
+        vst1q_u32(out + 12, vmovl_u16(vget_high_u16(hi)));
+#endif
+    }
+#endif
+
+    for ( ; n + 8 <= len; n += 8 )
+    {
+        if ( LoadWord(src + n) & ASCII_WORD_MASK )
+            break;
+
+        for ( size_t i = n; i < n + 8; i++ )
+            dst[i] = (unsigned char)src[i];
+    }
+
+    return n;
+}
+
+size_t wxNarrowASCIIPrefix(char *dst, const wchar_t *src, size_t len)
+{
+    // Unlike above, use blocks of 8 characters even with SIMD: they're big
+    // enough for wchar_t and using them avoids wasting time on checking the
+    // longer blocks which contain a non-ASCII character in mixed strings.
+    size_t n = 0;
+
+#if defined(wxSTRCONV_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; n + 8 <= len; n += 8 )
+    {
+        const __m128i * const in = (const __m128i *)(src + n);
+#ifdef WC_UTF16
+        const __m128i a = _mm_loadu_si128(in);
+        const __m128i nonASCII = _mm_and_si128(a, _mm_set1_epi16(~0x7F));
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi16(nonASCII, zero)) != 0xFFFF )
+            break;
+
+        if ( dst )
+            _mm_storel_epi64((__m128i *)(dst + n), _mm_packus_epi16(a, a));
+#else
+        const __m128i a = _mm_loadu_si128(in);
+        const __m128i b = _mm_loadu_si128(in + 1);
+        const __m128i nonASCII = _mm_and_si128(_mm_or_si128(a, b),
+                                               _mm_set1_epi32(~0x7F));
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi32(nonASCII, zero)) != 0xFFFF )
+            break;
+
+        if ( dst )
+        {
+            // all values are small, so saturation never happens when packing
+            const __m128i ab = _mm_packs_epi32(a, b);
+            _mm_storel_epi64((__m128i *)(dst + n), _mm_packus_epi16(ab, ab));
+        }
+#endif
+    }
+#elif defined(wxSTRCONV_USE_NEON)
+    for ( ; n + 8 <= len; n += 8 )
+    {
+#ifdef WC_UTF16
+        const uint16x8_t a = vld1q_u16((const uint16_t *)(src + n));
+        if ( vmaxvq_u16(a) >= 0x80 )
+            break;
+
+        if ( dst )
+            vst1_u8((uint8_t *)(dst + n), vmovn_u16(a));
+#else
+        const uint32_t * const in = (const uint32_t *)(src + n);
+        const uint32x4_t a = vld1q_u32(in);
+        const uint32x4_t b = vld1q_u32(in + 4);
+        if ( vmaxvq_u32(vorrq_u32(a, b)) >= 0x80 )
+            break;
+
+        if ( dst )
+        {
+            const uint16x8_t ab = vcombine_u16(vmovn_u32(a), vmovn_u32(b));
+            vst1_u8((uint8_t *)(dst + n), vmovn_u16(ab));
+        }
+#endif
+    }
+#else // no SIMD
+    for ( ; n + 8 <= len; n += 8 )
+    {
+        wxUint32 all = 0;
+        for ( size_t i = n; i < n + 8; i++ )
+            all |= (wxUint32)src[i];
+
+        if ( all >= 0x80 )
+            break;
+
+        if ( dst )
+        {
+            for ( size_t i = n; i < n + 8; i++ )
+                dst[i] = (char)src[i];
+        }
+    }
+#endif // SIMD
+
+    return n;
+}
+
 size_t
 wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
                             const char *src, size_t srcLen) const
@@ -953,8 +1166,32 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
     if ( srcLen == wxNO_LEN )
         srcLen = strlen(src) + 1;
 
+    // try converting ASCII characters in blocks initially and after each
+    // non-ASCII character, but not for each character of the short runs of
+    // ASCII characters which can't be converted in this way
+    bool tryBlocks = true;
+
     for ( const char *p = src; ; p++ )
     {
+        // convert as many ASCII characters as possible at once, the first
+        // non-ASCII one, if any, is handled below
+        if ( tryBlocks && srcLen && (unsigned char)*p < 0x80 )
+        {
+            tryBlocks = false;
+
+            const size_t
+                n = wxWidenASCIIPrefix(out, p, out ? wxMin(srcLen, dstLen)
+                                                   : srcLen);
+            p += n;
+            srcLen -= n;
+            written += n;
+            if ( out )
+            {
+                out += n;
+                dstLen -= n;
+            }
+        }
+
         if ( (srcLen == wxNO_LEN ? !*p : !srcLen) )
         {
             // all done successfully, just add the trailing NUL if we are not
@@ -993,6 +1230,8 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
         }
         else
         {
+            tryBlocks = true;
+
             unsigned len = tableUtf8Lengths[c];
             if ( !len )
                 break;
@@ -1066,8 +1305,34 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
     size_t written = 0;
 
     const wchar_t* const end = srcLen == wxNO_LEN ? nullptr : src + srcLen;
+
+    // end of the part of the string which may be converted in blocks
+    const wchar_t* const last = end ? end : src + wxWcslen(src);
+
+    // see the comment in ToWChar() above
+    bool tryBlocks = true;
+
     for ( const wchar_t *wp = src; ; )
     {
+        // convert as many ASCII characters as possible at once, the first
+        // non-ASCII one, if any, is handled below
+        if ( tryBlocks && wp != last && (wxUint32)*wp < 0x80 )
+        {
+            tryBlocks = false;
+
+            const size_t left = last - wp;
+            const size_t
+                n = wxNarrowASCIIPrefix(out, wp, out ? wxMin(left, dstLen)
+                                                     : left);
+            wp += n;
+            written += n;
+            if ( out )
+            {
+                out += n;
+                dstLen -= n;
+            }
+        }
+
         if ( end ? wp == end : !*wp )
         {
             // all done successfully, just add the trailing NUL if we are not
@@ -1106,6 +1371,9 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
         code = *wp++ & 0x7fffffff;
 #endif
 
+        if ( code > 0x7F )
+            tryBlocks = true;
+
         unsigned len;
         if ( code <= 0x7F )
         {
@@ -27,6 +27,7 @@
 
 #ifndef WX_PRECOMP
     #include "wx/log.h"
+    #include "wx/utils.h"
 #endif
 
 #include <ctype.h>
@@ -34,6 +35,8 @@
 #include "wx/textfile.h"
 #include "wx/scopeguard.h"
 
+#include <vector>
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
@@ -41,6 +44,11 @@
 // the temporary buffer size used when copying from stream to stream
 #define BUF_TEMP_SIZE 4096
 
+// the initial and the maximal size of the adaptive buffer used by default by
+// wxBufferedInputStream
+#define BUF_READ_INITIAL_SIZE 4096
+#define BUF_READ_MAX_SIZE (256*1024)
+
 // ============================================================================
 // implementation
 // ============================================================================
@@ -60,6 +68,7 @@ void wxStreamBuffer::InitBuffer()
     m_buffer_start =
     m_buffer_end =
     m_buffer_pos = nullptr;
+    m_buffer_size = 0;
 
     // if we are going to allocate the buffer, we should free it later as well
     m_destroybuf = true;
@@ -69,6 +78,13 @@ void wxStreamBuffer::Init()
 {
     InitBuffer();
 
+    m_size_initial =
+    m_size_max =
+    m_full_reads = 0;
+
+    m_sysCalls =
+    m_bytesCopied = 0;
+
     m_fixed = true;
 }
 
@@ -102,11 +118,20 @@ wxStreamBuffer::wxStreamBuffer(const wxStreamBuffer& buffer)
     m_buffer_start = buffer.m_buffer_start;
     m_buffer_end = buffer.m_buffer_end;
     m_buffer_pos = buffer.m_buffer_pos;
+    m_buffer_size = buffer.m_buffer_size;
     m_fixed = buffer.m_fixed;
     m_flushable = buffer.m_flushable;
     m_stream = buffer.m_stream;
     m_mode = buffer.m_mode;
     m_destroybuf = false;
+
+    // we don't own the buffer, so we can't resize it
+    m_size_initial = m_buffer_size;
+    m_size_max =
+    m_full_reads = 0;
+
+    m_sysCalls =
+    m_bytesCopied = 0;
 }
 
 void wxStreamBuffer::FreeBuffer()
@@ -150,6 +175,8 @@ void wxStreamBuffer::SetBufferIO(void *start,
 
     m_buffer_start = (char *)start;
     m_buffer_end   = m_buffer_start + len;
+    m_buffer_size  = len;
+    m_size_initial = len;
 
     // if we own it, we free it
     m_destroybuf = takeOwnership;
@@ -172,8 +199,43 @@ void wxStreamBuffer::SetBufferIO(size_t bufsize)
     }
 }
 
+void wxStreamBuffer::SetMaxBufferSize(size_t size)
+{
+    // the current size is used as the initial one
+    m_size_initial = m_buffer_size;
+    m_size_max = size;
+    m_full_reads = 0;
+}
+
+bool wxStreamBuffer::ResizeReadBuffer(size_t size)
+{
+    // the buffer is empty, so there is no need to preserve its contents
+    char * const start = (char *)malloc(size);
+    if ( !start )
+        return false;
+
+    free(m_buffer_start);
+
+    m_buffer_start =
+    m_buffer_end =
+    m_buffer_pos = start;
+    m_buffer_size = size;
+
+    return true;
+}
+
 void wxStreamBuffer::ResetBuffer()
 {
+    // the buffered data is discarded, typically because of seeking, so the
+    // stream isn't read sequentially any more
+    if ( m_mode == read && m_flushable )
+    {
+        if ( m_size_max && m_destroybuf && m_buffer_size > m_size_initial )
+            ResizeReadBuffer(m_size_initial);
+
+        m_full_reads = 0;
+    }
+
     if ( m_stream )
     {
         m_stream->Reset();
@@ -204,6 +266,7 @@ void wxStreamBuffer::Truncate()
     m_buffer_start = new_start;
     m_buffer_end = m_buffer_start + new_size;
     m_buffer_pos = m_buffer_end;
+    m_buffer_size = new_size;
 }
 
 // fill the buffer with as much data as possible (only for read buffers)
@@ -215,13 +278,27 @@ bool wxStreamBuffer::FillBuffer()
     if ( !inStream )
         return false;
 
-    size_t count = inStream->OnSysRead(GetBufferStart(), GetBufferSize());
+    // if the buffer was filled completely and all of it was consumed, the
+    // stream is probably being read sequentially, so let an adaptive buffer
+    // grow to read more data at once
+    if ( m_full_reads && m_size_max > m_buffer_size && m_destroybuf )
+        ResizeReadBuffer(wxMin(2*m_buffer_size, m_size_max));
+
+    // notice that we always try to fill the entire buffer, even if the
+    // previous read returned less data
+    size_t count = inStream->OnSysRead(m_buffer_start, m_buffer_size);
+    m_sysCalls++;
     if ( !count )
         return false;
 
     m_buffer_end = m_buffer_start + count;
     m_buffer_pos = m_buffer_start;
 
+    if ( count == m_buffer_size )
+        m_full_reads++;
+    else
+        m_full_reads = 0;
+
     return true;
 }
 
@@ -240,6 +317,7 @@ bool wxStreamBuffer::FlushBuffer()
 
     size_t current = m_buffer_pos - m_buffer_start;
     size_t count = outStream->OnSysWrite(m_buffer_start, current);
+    m_sysCalls++;
     if ( count != current )
         return false;
 
@@ -268,48 +346,58 @@ void wxStreamBuffer::GetFromBuffer(void *buffer, size_t size)
 
     memcpy(buffer, m_buffer_pos, size);
     m_buffer_pos += size;
+    m_bytesCopied += size;
 }
 
 // copy the contents of the provided buffer into this one
-void wxStreamBuffer::PutToBuffer(const void *buffer, size_t size)
+bool wxStreamBuffer::ReserveBytesLeft(size_t size)
 {
-    size_t left = GetBytesLeft();
+    if ( size <= GetBytesLeft() )
+        return true;
 
-    if ( size > left )
+    // we can't realloc the fixed buffer
+    if ( m_fixed )
+        return false;
+
+    // realloc the buffer to have enough space for the data
+    size_t delta = m_buffer_pos - m_buffer_start;
+    size_t new_size = delta + size;
+
+    char *startOld = m_buffer_start;
+    m_buffer_start = (char *)realloc(m_buffer_start, new_size);
+    if ( !m_buffer_start )
     {
-        if ( m_fixed )
-        {
-            // we can't realloc the buffer, so just copy what we can
-            size = left;
-        }
-        else // !m_fixed
-        {
-            // realloc the buffer to have enough space for the data
-            if ( m_buffer_pos + size > m_buffer_end )
-            {
-                size_t delta = m_buffer_pos - m_buffer_start;
-                size_t new_size = delta + size;
+        // don't leak memory if realloc() failed
+        m_buffer_start = startOld;
 
-                char *startOld = m_buffer_start;
-                m_buffer_start = (char *)realloc(m_buffer_start, new_size);
-                if ( !m_buffer_start )
-                {
-                    // don't leak memory if realloc() failed
-                    m_buffer_start = startOld;
+        return false;
+    }
 
-                    // what else can we do?
-                    return;
-                }
+    // adjust the pointers invalidated by realloc()
+    m_buffer_pos = m_buffer_start + delta;
+    m_buffer_end = m_buffer_start + new_size;
+    m_buffer_size = new_size;
 
-                // adjust the pointers invalidated by realloc()
-                m_buffer_pos = m_buffer_start + delta;
-                m_buffer_end = m_buffer_start + new_size;
-            } // else: the buffer is big enough
+    return true;
+}
+
+void wxStreamBuffer::PutToBuffer(const void *buffer, size_t size)
+{
+    if ( !ReserveBytesLeft(size) )
+    {
+        if ( !m_fixed )
+        {
+            // what else can we do?
+            return;
         }
+
+        // we can't realloc the buffer, so just copy what we can
+        size = GetBytesLeft();
     }
 
     memcpy(m_buffer_pos, buffer, size);
     m_buffer_pos += size;
+    m_bytesCopied += size;
 }
 
 void wxStreamBuffer::PutChar(char c)
@@ -322,6 +410,7 @@ void wxStreamBuffer::PutChar(char c)
     if ( !HasBuffer() )
     {
         outStream->OnSysWrite(&c, sizeof(c));
+        m_sysCalls++;
     }
     else
     {
@@ -367,6 +456,7 @@ char wxStreamBuffer::GetChar()
     if ( !HasBuffer() )
     {
         inStream->OnSysRead(&c, sizeof(c));
+        m_sysCalls++;
     }
     else
     {
@@ -404,13 +494,40 @@ size_t wxStreamBuffer::Read(void *buffer, size_t size)
         wxCHECK_MSG( inStream, 0, wxT("should have a stream in wxStreamBuffer") );
 
         readBytes = inStream->OnSysRead(buffer, size);
+        m_sysCalls++;
     }
     else // we have a buffer, use it
     {
         size_t orig_size = size;
 
+        // bypass the empty buffer for the reads at least as big as it, as
+        // there is nothing to gain by copying the data through it
+        wxInputStream * const inStream = m_flushable ? GetInputStream()
+                                                     : nullptr;
+
         while ( size > 0 )
         {
+            if ( inStream && !GetBytesLeft() && size >= m_buffer_size )
+            {
+                const size_t count = inStream->OnSysRead(buffer, size);
+                m_sysCalls++;
+
+                // the data previously in the buffer is not before the
+                // current position any more
+                m_buffer_end =
+                m_buffer_pos = m_buffer_start;
+
+                if ( !count )
+                {
+                    SetError(wxSTREAM_EOF);
+                    break;
+                }
+
+                size -= count;
+                buffer = (char *)buffer + count;
+                continue;
+            }
+
             size_t left = GetDataLeft();
 
             // if the requested number of bytes if greater than the buffer
@@ -421,6 +538,9 @@ size_t wxStreamBuffer::Read(void *buffer, size_t size)
                 size -= left;
                 buffer = (char *)buffer + left;
 
+                if ( inStream && size >= m_buffer_size )
+                    continue;
+
                 if ( !FillBuffer() )
                 {
                     SetError(wxSTREAM_EOF);
@@ -486,6 +606,7 @@ size_t wxStreamBuffer::Write(const void *buffer, size_t size)
 
         // no buffer, just forward the call to the stream
         ret = outStream->OnSysWrite(buffer, size);
+        m_sysCalls++;
     }
     else // we [may] have a buffer, use it
     {
@@ -538,6 +659,41 @@ size_t wxStreamBuffer::Write(const void *buffer, size_t size)
     return ret;
 }
 
+size_t wxStreamBuffer::Write(const wxIOVec *vec, size_t count)
+{
+    wxCHECK_MSG( vec || !count, 0, wxT("null vector pointer") );
+
+    // if the buffer can grow, make it big enough for all the data at once
+    // instead of reallocating it for every chunk
+    if ( !m_fixed )
+    {
+        size_t total = 0;
+        for ( size_t n = 0; n < count; n++ )
+            total += vec[n].size;
+
+        ReserveBytesLeft(total);
+    }
+
+    size_t ret = 0;
+    for ( size_t n = 0; n < count; n++ )
+    {
+        // allow empty chunks without any data
+        if ( !vec[n].size )
+            continue;
+
+        const size_t written = Write(vec[n].data, vec[n].size);
+        ret += written;
+
+        if ( written != vec[n].size )
+            break;
+    }
+
+    if (m_stream)
+        m_stream->m_lastcount = ret;
+
+    return ret;
+}
+
 size_t wxStreamBuffer::Write(wxStreamBuffer *sbuf)
 {
     wxCHECK_MSG( m_mode != read, 0, wxT("can't write to this buffer") );
@@ -1084,6 +1240,28 @@ wxOutputStream& wxOutputStream::Write(const void *buffer, size_t size)
     return *this;
 }
 
+wxOutputStream& wxOutputStream::WriteV(const wxIOVec *vec, size_t count)
+{
+    wxCHECK_MSG( vec || !count, *this, wxT("null vector pointer") );
+
+    size_t total = 0;
+    for ( size_t n = 0; n < count; n++ )
+    {
+        // allow empty chunks without any data
+        if ( !vec[n].size )
+            continue;
+
+        const size_t written = Write(vec[n].data, vec[n].size).LastWrite();
+        total += written;
+
+        if ( written != vec[n].size )
+            break;
+    }
+
+    m_lastcount = total;
+    return *this;
+}
+
 wxOutputStream& wxOutputStream::Write(wxInputStream& stream_in)
 {
     stream_in.Read(*this);
@@ -1352,7 +1530,17 @@ wxBufferedInputStream::wxBufferedInputStream(wxInputStream& stream,
                                              wxStreamBuffer *buffer)
                      : wxFilterInputStream(stream)
 {
-    m_i_streambuf = CreateBufferIfNeeded(*this, buffer);
+    if ( buffer )
+    {
+        m_i_streambuf = buffer;
+    }
+    else
+    {
+        // the default buffer grows when reading big streams sequentially
+        m_i_streambuf = CreateBufferIfNeeded(*this, nullptr,
+                                             BUF_READ_INITIAL_SIZE);
+        m_i_streambuf->SetMaxBufferSize(BUF_READ_MAX_SIZE);
+    }
 }
 
 wxBufferedInputStream::wxBufferedInputStream(wxInputStream& stream,
@@ -1495,6 +1683,49 @@ wxOutputStream& wxBufferedOutputStream::Write(const void *buffer, size_t size)
     return *this;
 }
 
+wxOutputStream& wxBufferedOutputStream::WriteV(const wxIOVec *vec, size_t count)
+{
+    wxCHECK_MSG( vec || !count, *this, wxT("null vector pointer") );
+
+    size_t total = 0;
+    for ( size_t n = 0; n < count; n++ )
+        total += vec[n].size;
+
+    // small writes are just buffered, as usual
+    if ( total <= m_o_streambuf->GetBytesLeft() )
+    {
+        m_lastcount = m_o_streambuf->Write(vec, count);
+        return *this;
+    }
+
+    // otherwise pass the buffered data together with the new data to the
+    // parent stream, to write all of it at once without copying it
+    const size_t buffered = m_o_streambuf->GetIntPosition();
+
+    std::vector<wxIOVec> all;
+    all.reserve(count + 1);
+    if ( buffered )
+        all.push_back({ m_o_streambuf->GetBufferStart(), buffered });
+    all.insert(all.end(), vec, vec + count);
+
+    m_parent_o_stream->WriteV(all.data(), all.size());
+
+    const size_t written = m_parent_o_stream->LastWrite();
+    if ( written < buffered )
+    {
+        // we couldn't even write the data which was already buffered
+        m_lastcount = 0;
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+        return *this;
+    }
+
+    m_o_streambuf->SetIntPosition(0);
+
+    m_lastcount = written - buffered;
+    m_lasterror = m_parent_o_stream->GetLastError();
+    return *this;
+}
+
 wxFileOffset wxBufferedOutputStream::SeekO(wxFileOffset pos, wxSeekMode mode)
 {
     Sync();
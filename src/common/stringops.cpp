@@ -142,7 +142,17 @@ bool wxStringOperationsUtf8::IsValidUtf8String(const char *str, size_t len)
         }
 
         if ( b <= 0x7F ) // 00..7F
+        {
+            // skip all the following ASCII characters at once if we can
+            if ( end != nullptr )
+            {
+                const size_t n = wxSkipASCIIPrefix((const char*)c, end - c);
+                if ( n )
+                    c += n - 1;
+            }
+
             continue;
+        }
 
         else if ( b < 0xC2 ) // invalid lead bytes: 80..C1
             return false;
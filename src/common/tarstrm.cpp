@@ -223,12 +223,16 @@ wxUint32 wxTarHeaderBlock::SumField(int id)
 
 bool wxTarHeaderBlock::Read(wxInputStream& in)
 {
-    bool ok = true;
+    // read the whole block at once, then distribute it into the fields
+    char block[TAR_BLOCKSIZE];
 
-    for (int id = 0; id < TAR_NUMFIELDS && ok; id++)
-        ok = in.Read(Get(id), Len(id)).LastRead() == Len(id);
+    if (in.Read(block, sizeof(block)).LastRead() != sizeof(block))
+        return false;
 
-    return ok;
+    for (int id = 0; id < TAR_NUMFIELDS; id++)
+        memcpy(Get(id), block + Offset(id), Len(id));
+
+    return true;
 }
 
 bool wxTarHeaderBlock::Write(wxOutputStream& out)
@@ -246,17 +250,41 @@ inline bool wxTarHeaderBlock::WriteField(wxOutputStream& out, int id)
     return out.Write(Get(id), Len(id)).LastWrite() == Len(id);
 }
 
-wxTarNumber wxTarHeaderBlock::GetOctal(int id)
+// Numeric fields are normally octal, but GNU tar and others store the values
+// too big for them in base-256, marked by setting the high bit of the first
+// byte. This is used for the sizes of the files of 8GB and more.
+//
+static wxTarNumber ParseTarNumber(const char *field, size_t len)
 {
+    const unsigned char *p = (const unsigned char*)field;
+    const unsigned char *end = p + len;
     wxTarNumber n = 0;
-    const char *p = Get(id);
-    while (*p == ' ')
+
+    if (p < end && (*p & 0x80)) {
+        // negative numbers aren't meaningful for any of the fields read
+        if (*p & 0x40)
+            return 0;
+        n = *p++ & 0x3f;
+        while (p < end) {
+            if (n >> (sizeof(n) * 8 - 9))
+                return 0;
+            n = (n << 8) | *p++;
+        }
+        return n;
+    }
+
+    while (p < end && *p == ' ')
         p++;
-    while (*p >= '0' && *p < '8')
+    while (p < end && *p >= '0' && *p < '8')
         n = (n << 3) | (*p++ - '0');
     return n;
 }
 
+wxTarNumber wxTarHeaderBlock::GetOctal(int id)
+{
+    return ParseTarNumber(Get(id), Len(id));
+}
+
 bool wxTarHeaderBlock::SetOctal(int id, wxTarNumber n)
 {
     // set an octal field, return true if the number fits
@@ -457,7 +485,8 @@ wxTarEntry::wxTarEntry(const wxString& name /*=wxEmptyString*/,
     m_UserName(wxGetTarUser().uname),
     m_GroupName(wxGetTarUser().gname),
     m_DevMajor(~0),
-    m_DevMinor(~0)
+    m_DevMinor(~0),
+    m_IsSparse(false)
 {
     if (!name.empty())
         SetName(name);
@@ -484,7 +513,9 @@ wxTarEntry::wxTarEntry(const wxTarEntry& e)
     m_UserName(e.m_UserName),
     m_GroupName(e.m_GroupName),
     m_DevMajor(e.m_DevMajor),
-    m_DevMinor(e.m_DevMinor)
+    m_DevMinor(e.m_DevMinor),
+    m_IsSparse(e.m_IsSparse),
+    m_SparseMap(e.m_SparseMap)
 {
 }
 
@@ -507,6 +538,8 @@ wxTarEntry& wxTarEntry::operator=(const wxTarEntry& e)
         m_GroupName = e.m_GroupName;
         m_DevMajor = e.m_DevMajor;
         m_DevMinor = e.m_DevMinor;
+        m_IsSparse = e.m_IsSparse;
+        m_SparseMap = e.m_SparseMap;
     }
     return *this;
 }
@@ -641,6 +674,10 @@ void wxTarInputStream::Init()
     m_pos = wxInvalidOffset;
     m_offset = 0;
     m_size = wxInvalidOffset;
+    m_dataPos = 0;
+    m_dataSize = 0;
+    m_isSparse = false;
+    m_region = 0;
     m_sumType = SUM_UNKNOWN;
     m_tarType = TYPE_USTAR;
     m_hdr = new wxTarHeaderBlock;
@@ -670,8 +707,6 @@ wxTarEntry *wxTarInputStream::GetNextEntry()
     entry->SetGroupId(GetHeaderNumber(TAR_UID));
     entry->SetSize(GetHeaderNumber(TAR_SIZE));
 
-    entry->SetOffset(m_offset);
-
     entry->SetDateTime(GetHeaderDate(wxT("mtime")));
     entry->SetAccessTime(GetHeaderDate(wxT("atime")));
     entry->SetCreateTime(GetHeaderDate(wxT("ctime")));
@@ -693,11 +728,19 @@ wxTarEntry *wxTarInputStream::GetNextEntry()
     if (isDir)
         entry->SetIsDir();
 
+    // this can read further blocks holding the map, so the data offset is
+    // only known after it
+    if (!ReadSparseMap(*entry)) {
+        m_lasterror = wxSTREAM_READ_ERROR;
+        return nullptr;
+    }
+
+    entry->SetOffset(m_offset);
+
     if (m_HeaderRecs)
         m_HeaderRecs->clear();
 
-    m_size = GetDataSize(*entry);
-    m_pos = 0;
+    SetupEntry(*entry);
 
     return entry.release();
 }
@@ -711,8 +754,7 @@ bool wxTarInputStream::OpenEntry(wxTarEntry& entry)
             && m_parent_i_stream->SeekI(offset) == offset)
     {
         m_offset = offset;
-        m_size = GetDataSize(entry);
-        m_pos = 0;
+        SetupEntry(entry);
         m_lasterror = wxSTREAM_NO_ERROR;
         return true;
     } else {
@@ -734,8 +776,8 @@ bool wxTarInputStream::CloseEntry()
     if (!IsOpened())
         return true;
 
-    wxFileOffset size = RoundUpSize(m_size);
-    wxFileOffset remainder = size - m_pos;
+    wxFileOffset size = RoundUpSize(m_dataSize);
+    wxFileOffset remainder = size - m_dataPos;
 
     if (remainder && m_parent_i_stream->IsSeekable()) {
         wxLogNull nolog;
@@ -745,7 +787,7 @@ bool wxTarInputStream::CloseEntry()
     }
 
     if (remainder) {
-        const int BUFSIZE = 8192;
+        const int BUFSIZE = 65536;
         wxCharBuffer buf(BUFSIZE);
 
         while (remainder > 0 && m_parent_i_stream->IsOk())
@@ -843,7 +885,11 @@ wxString wxTarInputStream::GetExtendedHeader(const wxString& key) const
 
 wxString wxTarInputStream::GetHeaderPath() const
 {
-    wxString path(GetExtendedHeader(wxS("path")));
+    // sparse files in the pax format store a made up name in "path"
+    wxString path(GetExtendedHeader(wxS("GNU.sparse.name")));
+
+    if (path.empty())
+        path = GetExtendedHeader(wxS("path"));
 
     if (!path.empty())
         return path;
@@ -960,6 +1006,17 @@ bool wxTarInputStream::ReadExtendedHeader(wxTarHeaderRecords*& recs)
         wxString key = wxString::FromUTF8(pKey);
         wxString value = wxString::FromUTF8(p);
 
+        // the sparse map of the pax format 0.0 uses repeated keys, so collect
+        // them into a single record as used by the format 0.1
+        if (key == wxS("GNU.sparse.offset") ||
+                key == wxS("GNU.sparse.numbytes")) {
+            wxString& map = (*recs)[wxS("GNU.sparse.map")];
+            if (!map.empty())
+                map += wxS(',');
+            map += value;
+            continue;
+        }
+
         // an empty value unsets a previously given value
         if (value.empty())
             recs->erase(key);
@@ -975,6 +1032,314 @@ bool wxTarInputStream::ReadExtendedHeader(wxTarHeaderRecords*& recs)
     return true;
 }
 
+// Check the regions of a sparse file are in order, don't overlap and lie
+// within the file.
+//
+static bool IsValidSparseMap(const wxTarSparseMap& map, wxFileOffset size)
+{
+    wxFileOffset end = 0;
+
+    for (const wxTarSparseRegion& r : map) {
+        if (r.offset < end || r.size < 0 || r.size > size - r.offset)
+            return false;
+        end = r.offset + r.size;
+    }
+
+    return true;
+}
+
+// Sparse files store only the regions holding data, followed by a map
+// giving their positions in the file. There are several formats: the old
+// GNU format uses the type 'S' and fields in the header block, while the
+// pax formats 0.0 and 0.1 use extended header records and the pax format
+// 1.0 stores the map in front of the data.
+
+bool wxTarInputStream::ReadSparseMap(wxTarEntry& entry)
+{
+    bool ok = true;
+
+    if (m_tarType == TYPE_GNUTAR) {
+        if (entry.GetTypeFlag() != 'S')
+            return true;
+        ok = ReadGnuSparseMap(entry);
+    }
+    else if (m_tarType == TYPE_USTAR) {
+        wxString major = GetExtendedHeader(wxS("GNU.sparse.major"));
+        wxString map = GetExtendedHeader(wxS("GNU.sparse.map"));
+        wxLongLong_t size = 0;
+
+        if (!major.empty()) {
+            if (major != wxS("1") ||
+                    GetExtendedHeader(wxS("GNU.sparse.minor")) != wxS("0")) {
+                wxLogError(_("unsupported sparse file format in tar"));
+                return false;
+            }
+            ok = GetExtendedHeader(wxS("GNU.sparse.realsize")).ToLongLong(&size)
+                 && ReadPaxSparseData(entry);
+        }
+        else if (!map.empty()) {
+            ok = GetExtendedHeader(wxS("GNU.sparse.size")).ToLongLong(&size)
+                 && ReadPaxSparseMap(entry, map);
+        }
+        else {
+            return true;
+        }
+
+        if (ok)
+            entry.SetSize(size);
+    }
+    else {
+        return true;
+    }
+
+    if (ok && !IsValidSparseMap(entry.m_SparseMap, entry.GetSize()))
+        ok = false;
+
+    if (!ok) {
+        wxLogError(_("invalid sparse file map in tar"));
+        return false;
+    }
+
+    entry.m_IsSparse = true;
+    return true;
+}
+
+// The old GNU format stores up to four regions in the header block itself,
+// followed by as many extension blocks of 21 regions each as needed.
+
+bool wxTarInputStream::ReadGnuSparseMap(wxTarEntry& entry)
+{
+    enum {
+        SPARSE_ENTRY_LEN = 12,      // the offset and size fields of a region
+        SPARSE_HDR_OFFSET = 386,    // regions in the header block
+        SPARSE_HDR_COUNT = 4,
+        SPARSE_HDR_EXTENDED = 482,
+        SPARSE_HDR_REALSIZE = 483,
+        SPARSE_EXT_COUNT = 21,      // regions in an extension block
+        SPARSE_EXT_EXTENDED = 504
+    };
+
+    // these fields overlap the ustar prefix field
+    const char *hdr = m_hdr->Get(TAR_PREFIX) - m_hdr->Offset(TAR_PREFIX);
+
+    wxTarSparseMap& map = entry.m_SparseMap;
+    map.clear();
+
+    const char *p = hdr + SPARSE_HDR_OFFSET;
+    int count = SPARSE_HDR_COUNT;
+    bool extended = hdr[SPARSE_HDR_EXTENDED] != 0;
+    char block[TAR_BLOCKSIZE];
+
+    for (;;) {
+        for (int i = 0; i < count; i++) {
+            // an empty slot marks the end of the regions in this block
+            if (!*p)
+                break;
+            wxFileOffset offset = ParseTarNumber(p, SPARSE_ENTRY_LEN);
+            p += SPARSE_ENTRY_LEN;
+            wxFileOffset size = ParseTarNumber(p, SPARSE_ENTRY_LEN);
+            p += SPARSE_ENTRY_LEN;
+            map.push_back(wxTarSparseRegion(offset, size));
+        }
+
+        if (!extended)
+            break;
+
+        if (m_parent_i_stream->Read(block, sizeof(block)).LastRead()
+                != sizeof(block))
+            return false;
+        m_offset += TAR_BLOCKSIZE;
+
+        p = block;
+        count = SPARSE_EXT_COUNT;
+        extended = block[SPARSE_EXT_EXTENDED] != 0;
+    }
+
+    entry.SetSize(ParseTarNumber(hdr + SPARSE_HDR_REALSIZE, SPARSE_ENTRY_LEN));
+    entry.SetTypeFlag(wxTAR_REGTYPE);
+    return true;
+}
+
+// The pax format 0.1 stores the map in a single record as a comma separated
+// list of offsets and sizes, and ReadExtendedHeader() converts the format 0.0
+// to it too.
+
+bool wxTarInputStream::ReadPaxSparseMap(wxTarEntry& entry, const wxString& map)
+{
+    wxTarSparseMap& regions = entry.m_SparseMap;
+    regions.clear();
+
+    wxArrayString values = wxSplit(map, wxS(','), 0);
+    if (values.size() % 2)
+        return false;
+
+    for (size_t i = 0; i < values.size(); i += 2) {
+        wxLongLong_t offset, size;
+        if (!values[i].ToLongLong(&offset) || !values[i + 1].ToLongLong(&size))
+            return false;
+        regions.push_back(wxTarSparseRegion(offset, size));
+    }
+
+    return true;
+}
+
+// The pax format 1.0 stores the map in decimal at the start of the entry's
+// data, padded to a whole number of blocks: first the number of regions,
+// then an offset and a size for each of them, all on separate lines.
+
+bool wxTarInputStream::ReadPaxSparseData(wxTarEntry& entry)
+{
+    wxTarSparseMap& regions = entry.m_SparseMap;
+    regions.clear();
+
+    // each region takes at least four bytes, which bounds their number
+    const wxFileOffset maxCount = entry.GetSize() / 4;
+
+    std::vector<wxFileOffset> values;
+    wxFileOffset count = -1;
+    wxFileOffset n = 0;
+    bool digits = false;
+    char block[TAR_BLOCKSIZE];
+
+    while (count < 0 || (wxFileOffset)values.size() < 2 * count) {
+        if (m_parent_i_stream->Read(block, sizeof(block)).LastRead()
+                != sizeof(block))
+            return false;
+        m_offset += TAR_BLOCKSIZE;
+
+        for (size_t i = 0; i < sizeof(block); i++) {
+            const char c = block[i];
+
+            if (c >= '0' && c <= '9') {
+                if (n > (wxINT64_MAX - 9) / 10)
+                    return false;
+                n = n * 10 + (c - '0');
+                digits = true;
+                continue;
+            }
+
+            if (c != '\n' || !digits)
+                return false;
+
+            if (count < 0) {
+                if (n > maxCount)
+                    return false;
+                count = n;
+                values.reserve(2 * count);
+            } else {
+                values.push_back(n);
+            }
+
+            n = 0;
+            digits = false;
+
+            // the rest of the block is padding
+            if ((wxFileOffset)values.size() == 2 * count)
+                break;
+        }
+    }
+
+    for (size_t i = 0; i < values.size(); i += 2)
+        regions.push_back(wxTarSparseRegion(values[i], values[i + 1]));
+
+    return true;
+}
+
+void wxTarInputStream::SetupEntry(const wxTarEntry& entry)
+{
+    m_isSparse = entry.IsSparse();
+    m_sparseStart.clear();
+    m_region = 0;
+
+    if (m_isSparse) {
+        m_sparse = entry.GetSparseMap();
+
+        // the position of each region within the stored data
+        wxFileOffset start = 0;
+        m_sparseStart.reserve(m_sparse.size());
+        for (const wxTarSparseRegion& r : m_sparse) {
+            m_sparseStart.push_back(start);
+            start += r.size;
+        }
+
+        m_size = entry.GetSize();
+        m_dataSize = start;
+    } else {
+        m_sparse.clear();
+        m_size = m_dataSize = GetDataSize(entry);
+    }
+
+    m_pos = m_dataPos = 0;
+}
+
+// Read from a sparse entry, the holes read as zeros without touching the
+// parent stream.
+
+size_t wxTarInputStream::ReadSparse(char *buffer, size_t size)
+{
+    size_t done = 0;
+
+    while (done < size) {
+        // skip any regions ending before the current position
+        while (m_region < m_sparse.size() &&
+                m_sparse[m_region].offset + m_sparse[m_region].size <= m_pos)
+            m_region++;
+
+        const wxFileOffset left = size - done;
+
+        if (m_region == m_sparse.size() || m_pos < m_sparse[m_region].offset) {
+            wxFileOffset holeEnd = m_region < m_sparse.size()
+                                   ? m_sparse[m_region].offset : m_size;
+            size_t len = (size_t)wxMin(left, holeEnd - m_pos);
+
+            memset(buffer + done, 0, len);
+            done += len;
+            m_pos += len;
+        } else {
+            const wxTarSparseRegion& r = m_sparse[m_region];
+            size_t len = (size_t)wxMin(left, r.offset + r.size - m_pos);
+            size_t lastread =
+                m_parent_i_stream->Read(buffer + done, len).LastRead();
+
+            done += lastread;
+            m_pos += lastread;
+            m_dataPos += lastread;
+
+            if (lastread < len)
+                break;
+        }
+    }
+
+    return done;
+}
+
+// Return the position within the stored data corresponding to the given
+// position in a sparse entry, i.e. the position of the next byte to be
+// read from the parent, and the index of the region containing it.
+
+wxFileOffset wxTarInputStream::GetSparseDataPos(wxFileOffset pos,
+                                                size_t *region) const
+{
+    size_t lo = 0, hi = m_sparse.size();
+
+    // find the first region ending after pos
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (m_sparse[mid].offset + m_sparse[mid].size <= pos)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    *region = lo;
+
+    if (lo == m_sparse.size())
+        return m_dataSize;
+
+    const wxTarSparseRegion& r = m_sparse[lo];
+    return m_sparseStart[lo] + (pos > r.offset ? pos - r.offset : 0);
+}
+
 wxFileOffset wxTarInputStream::OnSysSeek(wxFileOffset pos, wxSeekMode mode)
 {
     if (!IsOpened()) {
@@ -990,10 +1355,18 @@ wxFileOffset wxTarInputStream::OnSysSeek(wxFileOffset pos, wxSeekMode mode)
         case wxFromEnd:     pos += m_size; break;
     }
 
-    if (pos < 0 || m_parent_i_stream->SeekI(m_offset + pos) == wxInvalidOffset)
+    if (pos < 0)
+        return wxInvalidOffset;
+
+    size_t region = 0;
+    wxFileOffset dataPos = m_isSparse ? GetSparseDataPos(pos, &region) : pos;
+
+    if (m_parent_i_stream->SeekI(m_offset + dataPos) == wxInvalidOffset)
         return wxInvalidOffset;
 
     m_pos = pos;
+    m_dataPos = dataPos;
+    m_region = region;
     return m_pos;
 }
 
@@ -1011,8 +1384,15 @@ size_t wxTarInputStream::OnSysRead(void *buffer, size_t size)
     else if (m_pos + size > m_size + (size_t)0)
         size = m_size - m_pos;
 
-    size_t lastread = m_parent_i_stream->Read(buffer, size).LastRead();
-    m_pos += lastread;
+    size_t lastread;
+
+    if (m_isSparse) {
+        lastread = ReadSparse(static_cast<char*>(buffer), size);
+    } else {
+        lastread = m_parent_i_stream->Read(buffer, size).LastRead();
+        m_pos += lastread;
+        m_dataPos = m_pos;
+    }
 
     if (m_pos >= m_size) {
         m_lasterror = wxSTREAM_EOF;
@@ -1029,6 +1409,69 @@ size_t wxTarInputStream::OnSysRead(void *buffer, size_t size)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Tar index
+
+bool wxTarIndex::Load(wxInputStream& stream, wxMBConv& conv /*=wxConvLocal*/)
+{
+    Clear();
+    m_conv = &conv;
+
+    // the entries are opened by seeking to them, so an index of a stream
+    // which can't be seeked in would be useless
+    wxCHECK_MSG(stream.IsSeekable(), false,
+                wxT("wxTarIndex requires a seekable stream"));
+
+    wxTarInputStream tar(stream, conv);
+    wxTarEntry *entry;
+
+    // the entry's data is skipped by seeking
+    while ((entry = tar.GetNextEntry()) != nullptr)
+        m_entries.Add(entry);
+
+    m_ok = tar.GetLastError() == wxSTREAM_EOF;
+    if (!m_ok) {
+        Clear();
+        return false;
+    }
+
+    return true;
+}
+
+void wxTarIndex::Clear()
+{
+    m_entries.Clear();
+    m_ok = false;
+}
+
+wxTarInputStream *wxTarIndex::OpenEntry(wxInputStream& stream,
+                                        const wxTarEntry& entry) const
+{
+    return DoOpenEntry(new wxTarInputStream(stream, *m_conv), entry);
+}
+
+wxTarInputStream *wxTarIndex::OpenEntry(wxInputStream *stream,
+                                        const wxTarEntry& entry) const
+{
+    return DoOpenEntry(new wxTarInputStream(stream, *m_conv), entry);
+}
+
+wxTarInputStream *wxTarIndex::DoOpenEntry(wxTarInputStream *tar,
+                                          const wxTarEntry& entry) const
+{
+    std::unique_ptr<wxTarInputStream> stream(tar);
+
+    wxCHECK(m_ok && tar->IsSeekable(), nullptr);
+
+    // open a private copy, the index's entries are shared between threads
+    wxTarEntry copy(entry);
+    if (!tar->OpenEntry(copy))
+        return nullptr;
+
+    return stream.release();
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Output stream
 
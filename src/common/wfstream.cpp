@@ -17,9 +17,20 @@
 
 #ifndef WX_PRECOMP
     #include "wx/stream.h"
+    #include "wx/intl.h"
+    #include "wx/log.h"
 #endif
 
 #include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __WINDOWS__
+    #include "wx/msw/wrapwin.h"
+    #include <io.h>
+#elif defined(__UNIX__)
+    #include <sys/mman.h>
+    #include <fcntl.h>
+#endif
 
 #if wxUSE_FILE
 
@@ -27,9 +38,34 @@
 // wxFileInputStream
 // ----------------------------------------------------------------------------
 
+namespace
+{
+
+// the values of wxFileInputStream::m_accessHint
+enum
+{
+    AccessHint_Normal,
+    AccessHint_Sequential,
+    AccessHint_Unsupported
+};
+
+// the number of successive reads after which the file is considered to be
+// read sequentially
+const unsigned SEQUENTIAL_READS = 2;
+
+} // anonymous namespace
+
+void wxFileInputStream::Init()
+{
+    m_readPos = wxInvalidOffset;
+    m_seqReads = 0;
+    m_accessHint = AccessHint_Normal;
+}
+
 wxFileInputStream::wxFileInputStream(const wxString& fileName)
   : wxInputStream()
 {
+    Init();
     m_file = new wxFile(fileName, wxFile::read);
     m_file_destroy = true;
     if ( !m_file->IsOpened() )
@@ -39,18 +75,21 @@ wxFileInputStream::wxFileInputStream(const wxString& fileName)
 wxFileInputStream::wxFileInputStream()
   : wxInputStream()
 {
+    Init();
     m_file_destroy = false;
     m_file = nullptr;
 }
 
 wxFileInputStream::wxFileInputStream(wxFile& file)
 {
+    Init();
     m_file = &file;
     m_file_destroy = false;
 }
 
 wxFileInputStream::wxFileInputStream(int fd)
 {
+    Init();
     m_file = new wxFile(fd);
     m_file_destroy = true;
 }
@@ -87,6 +126,12 @@ size_t wxFileInputStream::OnSysRead(void *buffer, size_t size)
     {
         // normal case
         m_lasterror = wxSTREAM_NO_ERROR;
+
+        if ( m_readPos != wxInvalidOffset )
+            m_readPos += ret;
+
+        if ( ++m_seqReads == SEQUENTIAL_READS )
+            SetSequentialAccess(true);
     }
 
     return ret;
@@ -94,7 +139,40 @@ size_t wxFileInputStream::OnSysRead(void *buffer, size_t size)
 
 wxFileOffset wxFileInputStream::OnSysSeek(wxFileOffset pos, wxSeekMode mode)
 {
-    return m_file->Seek(pos, mode);
+    const wxFileOffset newPos = m_file->Seek(pos, mode);
+
+    // skipping forward doesn't prevent the read-ahead from being useful, but
+    // going back does
+    if ( newPos != wxInvalidOffset )
+    {
+        if ( m_readPos == wxInvalidOffset || newPos < m_readPos )
+        {
+            m_seqReads = 0;
+            SetSequentialAccess(false);
+        }
+
+        m_readPos = newPos;
+    }
+
+    return newPos;
+}
+
+void wxFileInputStream::SetSequentialAccess(bool sequential)
+{
+    const int hint = sequential ? AccessHint_Sequential : AccessHint_Normal;
+    if ( m_accessHint == hint || m_accessHint == AccessHint_Unsupported )
+        return;
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    // this doubles the read-ahead window of Linux, for example
+    if ( posix_fadvise(m_file->fd(), 0, 0, sequential ? POSIX_FADV_SEQUENTIAL
+                                                      : POSIX_FADV_NORMAL) == 0 )
+        m_accessHint = hint;
+    else // e.g. not a regular file, don't try again
+        m_accessHint = AccessHint_Unsupported;
+#else
+    m_accessHint = AccessHint_Unsupported;
+#endif
 }
 
 wxFileOffset wxFileInputStream::OnSysTell() const
@@ -157,6 +235,15 @@ size_t wxFileOutputStream::OnSysWrite(const void *buffer, size_t size)
     return ret;
 }
 
+wxOutputStream& wxFileOutputStream::WriteV(const wxIOVec *vec, size_t count)
+{
+    m_lastcount = m_file->WriteV(vec, count);
+
+    m_lasterror = m_file->Error() ? wxSTREAM_WRITE_ERROR : wxSTREAM_NO_ERROR;
+
+    return *this;
+}
+
 wxFileOffset wxFileOutputStream::OnSysTell() const
 {
     return m_file->Tell();
@@ -259,6 +346,195 @@ bool wxFileStream::IsOk() const
     return wxFileOutputStream::IsOk() && wxFileInputStream::IsOk();
 }
 
+// ----------------------------------------------------------------------------
+// wxMappedFileInputStream
+// ----------------------------------------------------------------------------
+
+// The file contents, either mapped into memory or, if this is impossible,
+// e.g. because the file is not a regular file, just read into memory.
+class wxMappedFileData
+{
+public:
+    explicit wxMappedFileData(const wxString& fileName)
+    {
+        m_data = nullptr;
+        m_length = 0;
+        m_mapped = false;
+        m_ok = false;
+
+        wxFile file(fileName);
+        if ( !file.IsOpened() )
+            return;
+
+        // Only regular files can be mapped and only if they're not empty:
+        // note that some special files, e.g. those under /proc, can also
+        // appear as regular files that are either empty or don't support
+        // seeking to their end, but still have some contents, so we still
+        // need to read them.
+        wxFileOffset length = wxInvalidOffset;
+        if ( file.GetKind() == wxFILE_KIND_DISK )
+        {
+            wxLogNull noLog;
+            length = file.Length();
+        }
+
+        if ( length != wxInvalidOffset )
+        {
+            m_length = static_cast<size_t>(length);
+            if ( static_cast<wxFileOffset>(m_length) != length )
+            {
+                wxLogError(_("File \"%s\" is too big to be read in memory."),
+                           fileName);
+                return;
+            }
+
+            if ( m_length && Map(file) )
+            {
+                m_mapped = true;
+                m_ok = true;
+                return;
+            }
+        }
+
+        // Fall back to reading the entire file.
+        m_ok = ReadAll(file, fileName);
+    }
+
+    ~wxMappedFileData()
+    {
+        if ( !m_data )
+            return;
+
+        if ( m_mapped )
+        {
+#ifdef __WINDOWS__
+            ::UnmapViewOfFile(m_data);
+#elif defined(__UNIX__)
+            munmap(m_data, m_length);
+#endif
+        }
+        else
+        {
+            free(m_data);
+        }
+    }
+
+    const void* GetData() const { return m_data; }
+    size_t GetLength() const { return m_length; }
+    bool IsMapped() const { return m_mapped; }
+    bool IsOk() const { return m_ok; }
+
+private:
+    // Read the file until EOF, without relying on its length, which may be
+    // unknown or wrong for the special files.
+    bool ReadAll(wxFile& file, const wxString& fileName)
+    {
+        // Use the reported length as a hint for the initial buffer size, but
+        // always leave space for more data to be able to detect EOF without
+        // reallocating the buffer for the files with the correct length.
+        size_t size = m_length ? m_length + 1 : 4096;
+        m_length = 0;
+
+        for ( ;; )
+        {
+            void* const data = realloc(m_data, size);
+            if ( !data )
+            {
+                wxLogError(_("Not enough memory to read file \"%s\"."),
+                           fileName);
+                return false;
+            }
+
+            m_data = data;
+
+            const ssize_t count = file.Read(static_cast<char*>(m_data) + m_length,
+                                            size - m_length);
+            if ( count == wxInvalidOffset )
+                return false;
+
+            if ( !count )
+                break;
+
+            m_length += count;
+            if ( m_length == size )
+                size *= 2;
+        }
+
+        // Don't keep the buffer for the empty files, this is consistent with
+        // mapping them.
+        if ( !m_length )
+        {
+            free(m_data);
+            m_data = nullptr;
+        }
+
+        return true;
+    }
+
+    bool Map(const wxFile& file)
+    {
+#ifdef __WINDOWS__
+        const HANDLE hFile = (HANDLE)_get_osfhandle(file.fd());
+        if ( hFile == INVALID_HANDLE_VALUE )
+            return false;
+
+        const HANDLE hMapping = ::CreateFileMapping(hFile, nullptr,
+                                                    PAGE_READONLY,
+                                                    0, 0, nullptr);
+        if ( !hMapping )
+            return false;
+
+        // The view keeps the mapping object alive, so it can be closed now.
+        m_data = ::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, m_length);
+        ::CloseHandle(hMapping);
+#elif defined(__UNIX__)
+        // The mapping remains valid after closing the file descriptor.
+        m_data = mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, file.fd(), 0);
+        if ( m_data == MAP_FAILED )
+            m_data = nullptr;
+#else
+        wxUnusedVar(file);
+#endif
+
+        return m_data != nullptr;
+    }
+
+    void* m_data;
+    size_t m_length;
+    bool m_mapped;
+    bool m_ok;
+
+    wxDECLARE_NO_COPY_CLASS(wxMappedFileData);
+};
+
+wxMappedFileInputStream::wxMappedFileInputStream(const wxString& fileName)
+    : wxMappedFileInputStream(new wxMappedFileData(fileName))
+{
+}
+
+wxMappedFileInputStream::wxMappedFileInputStream(wxMappedFileData* data)
+    : wxMemoryInputStream(data->GetData(), data->GetLength()),
+      m_data(data)
+{
+    if ( !m_data->IsOk() )
+        m_lasterror = wxSTREAM_READ_ERROR;
+}
+
+wxMappedFileInputStream::~wxMappedFileInputStream()
+{
+    delete m_data;
+}
+
+const void* wxMappedFileInputStream::GetData() const
+{
+    return m_data->GetData();
+}
+
+bool wxMappedFileInputStream::IsMapped() const
+{
+    return m_data->IsMapped();
+}
+
 #endif // wxUSE_FILE
 
 #if wxUSE_FFILE
@@ -20,10 +20,12 @@
     #include "wx/utils.h"
 #endif
 
+#include "wx/atomic.h"
 #include "wx/datstrm.h"
 #include "wx/zstream.h"
 #include "wx/mstream.h"
 #include "wx/wfstream.h"
+#include "wx/zstdstream.h"
 #include "zlib.h"
 
 #include <memory>
@@ -32,7 +34,8 @@
 // value for the 'version needed to extract' field (20 means 2.0)
 enum {
     VERSION_NEEDED_TO_EXTRACT = 20,
-    Z64_VERSION_NEEDED_TO_EXTRACT = 45 // File uses ZIP64 format extensions
+    Z64_VERSION_NEEDED_TO_EXTRACT = 45, // File uses ZIP64 format extensions
+    ZSTD_VERSION_NEEDED_TO_EXTRACT = 63 // File uses Zstandard compression
 };
 
 // signatures for the various records (PKxx)
@@ -592,14 +595,17 @@ bool wxZlibInputStream2::Open(wxInputStream& stream)
 
 /////////////////////////////////////////////////////////////////////////////
 // Class to hold wxZipEntry's Extra and LocalExtra fields
+//
+// The reference count is atomic since copies of the entries held by a
+// wxZipIndex share these and can be made from several threads at once.
 
 class wxZipMemory
 {
 public:
     wxZipMemory() : m_data(nullptr), m_size(0), m_capacity(0), m_ref(1) { }
 
-    wxZipMemory *AddRef() { m_ref++; return this; }
-    void Release() { if (--m_ref == 0) delete this; }
+    wxZipMemory *AddRef() { wxAtomicInc(m_ref); return this; }
+    void Release() { if (wxAtomicDec(m_ref) == 0) delete this; }
 
     char *GetData() const { return m_data; }
     size_t GetSize() const { return m_size; }
@@ -613,7 +619,7 @@ private:
     char *m_data;
     size_t m_size;
     size_t m_capacity;
-    int m_ref;
+    wxAtomicInt m_ref;
 
     wxSUPPRESS_GCC_PRIVATE_DTOR_WARNING(wxZipMemory)
 };
@@ -623,7 +629,7 @@ wxZipMemory *wxZipMemory::Unique(size_t size)
     wxZipMemory *zm;
 
     if (m_ref > 1) {
-        --m_ref;
+        wxAtomicDec(m_ref);
         zm = new wxZipMemory;
     } else {
         zm = this;
@@ -1113,7 +1119,8 @@ size_t wxZipEntry::WriteLocal(wxOutputStream& stream, wxMBConv& conv, wxZipArchi
         m_CompressedSize >= 0xffffffff || m_Size >= 0xffffffff )
         m_z64infoOffset = LOCAL_SIZE + nameLen;
     wxUint16 versionNeeded =
-        (m_z64infoOffset > 0) ? Z64_VERSION_NEEDED_TO_EXTRACT : int(m_VersionNeeded);
+        (m_z64infoOffset > 0) ? wxMax(int(Z64_VERSION_NEEDED_TO_EXTRACT), int(m_VersionNeeded))
+                              : int(m_VersionNeeded);
 
     wxDataOutputStream ds(stream);
 
@@ -1232,7 +1239,8 @@ size_t wxZipEntry::WriteCentral(wxOutputStream& stream, wxMBConv& conv) const
     }
 
     wxUint16 versionNeeded =
-        (z64Required || m_z64infoOffset) ? Z64_VERSION_NEEDED_TO_EXTRACT : GetVersionNeeded();
+        (z64Required || m_z64infoOffset) ? wxMax(int(Z64_VERSION_NEEDED_TO_EXTRACT), GetVersionNeeded())
+                                         : GetVersionNeeded();
 
     wxDataOutputStream ds(stream);
 
@@ -2041,6 +2049,11 @@ wxInputStream *wxZipInputStream::OpenDecompressor(wxInputStream& stream)
                 m_inflate->Open(stream);
             return m_inflate;
 
+#if wxUSE_LIBZSTD
+        case wxZIP_METHOD_ZSTD:
+            return new wxZstdInputStream(stream, wxZSTD_SINGLE_FRAME);
+#endif // wxUSE_LIBZSTD
+
         default:
             wxLogError(_("unsupported Zip compression method"));
     }
@@ -2141,6 +2154,81 @@ size_t wxZipInputStream::OnSysRead(void *buffer, size_t size)
     return count;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Index
+
+bool wxZipIndex::Load(wxInputStream& stream, wxMBConv& conv /*=wxConvLocal*/)
+{
+    Clear();
+    m_conv = &conv;
+
+    // the entries are located using the central directory, which can only
+    // be read from a seekable stream
+    wxCHECK_MSG(stream.IsSeekable(), false,
+                wxT("wxZipIndex requires a seekable stream"));
+
+    wxZipInputStream zip(stream, conv);
+    wxZipEntry *entry;
+
+    while ((entry = zip.GetNextEntry()) != nullptr) {
+        // store detached copies so the index doesn't refer to 'zip'
+        m_entries.Add(new wxZipEntry(*entry));
+        delete entry;
+    }
+
+    m_ok = zip.GetLastError() == wxSTREAM_EOF;
+    if (!m_ok) {
+        Clear();
+        return false;
+    }
+
+    m_comment = zip.GetComment();
+    return true;
+}
+
+void wxZipIndex::Clear()
+{
+    m_entries.Clear();
+    m_comment.clear();
+    m_ok = false;
+}
+
+wxZipInputStream *wxZipIndex::OpenEntry(wxInputStream& stream,
+                                        const wxZipEntry& entry) const
+{
+    return DoOpenEntry(new wxZipInputStream(stream, *m_conv), entry);
+}
+
+wxZipInputStream *wxZipIndex::OpenEntry(wxInputStream *stream,
+                                        const wxZipEntry& entry) const
+{
+    return DoOpenEntry(new wxZipInputStream(stream, *m_conv), entry);
+}
+
+wxZipInputStream *wxZipIndex::DoOpenEntry(wxZipInputStream *zip,
+                                          const wxZipEntry& entry) const
+{
+    std::unique_ptr<wxZipInputStream> stream(zip);
+
+    wxCHECK(m_ok && zip->m_parent_i_stream->IsSeekable(), nullptr);
+
+    // The central directory has already been read, so position the new
+    // stream as if it had been iterated to the end, which avoids it
+    // searching for the end record again.
+    zip->m_position = 0;
+    zip->m_parentSeekable = true;
+    zip->m_signature = END_MAGIC;
+
+    // Open a private copy, as opening updates the entry's local extra field
+    // and the index's entries must stay unmodified for the other threads.
+    wxZipEntry copy(entry);
+    if (!zip->OpenEntry(copy))
+        return nullptr;
+
+    return stream.release();
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Output stream
 
@@ -2174,6 +2262,7 @@ void wxZipOutputStream::Init(int level)
     m_entrySize = 0;
     m_comp = nullptr;
     m_level = level;
+    m_maxThreads = 1;
     m_offsetAdjustment = wxInvalidOffset;
     m_endrecWritten = false;
     m_format = wxZIP_FORMAT_DEFAULT;
@@ -2355,9 +2444,23 @@ wxOutputStream *wxZipOutputStream::OpenCompressor(
             else
                 m_deflate->Open(stream);
 
+            m_deflate->SetMaxThreads(m_maxThreads);
+
             return m_deflate;
         }
 
+#if wxUSE_LIBZSTD
+        case wxZIP_METHOD_ZSTD:
+            entry.SetVersionNeeded(wxMax(entry.GetVersionNeeded(),
+                                         int(ZSTD_VERSION_NEEDED_TO_EXTRACT)));
+            entry.SetFlags(entry.GetFlags() | wxZIP_SUMS_FOLLOW);
+
+            // Zip compression levels are between 0 and 9, and 0 means "store"
+            // in zip but "default" for zstd, so only pass the valid levels.
+            return new wxZstdOutputStream(stream, GetLevel() > 0 ? GetLevel()
+                                                                 : -1);
+#endif // wxUSE_LIBZSTD
+
         default:
             wxLogError(_("unsupported Zip compression method"));
     }
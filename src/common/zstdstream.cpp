@@ -0,0 +1,373 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/zstdstream.cpp
+// Purpose:     Implementation of Zstandard stream classes
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#if wxUSE_LIBZSTD && wxUSE_STREAMS
+
+#include "wx/zstdstream.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+    #include "wx/translation.h"
+#endif // WX_PRECOMP
+
+#include <zstd.h>
+
+using namespace wxPrivate;
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Functions
+// ----------------------------------------------------------------------------
+
+wxVersionInfo wxGetLibZstdVersionInfo()
+{
+    const unsigned ver = ZSTD_versionNumber();
+
+    return wxVersionInfo
+           (
+            "libzstd",
+            ver / 10000,
+            (ver % 10000) / 100,
+            ver % 100
+           );
+}
+
+// ----------------------------------------------------------------------------
+// wxZstdData: common helpers for compression and decompression
+// ----------------------------------------------------------------------------
+
+wxZstdData::wxZstdData(size_t bufSize)
+{
+    // Use the buffer sizes recommended by libzstd, which are big enough to
+    // hold a whole compressed block, to avoid any extra copying.
+    m_bufSize = bufSize;
+    m_streamBuf = new wxUint8[m_bufSize];
+    m_pos = 0;
+}
+
+wxZstdData::~wxZstdData()
+{
+    delete [] m_streamBuf;
+}
+
+// ----------------------------------------------------------------------------
+// wxZstdInputStream: decompression
+// ----------------------------------------------------------------------------
+
+wxZstdInputStream::wxZstdInputStream(wxInputStream& stream, int flags)
+    : wxFilterInputStream(stream),
+      wxZstdData(ZSTD_DStreamInSize())
+{
+    Init(flags);
+}
+
+wxZstdInputStream::wxZstdInputStream(wxInputStream* stream, int flags)
+    : wxFilterInputStream(stream),
+      wxZstdData(ZSTD_DStreamInSize())
+{
+    Init(flags);
+}
+
+wxZstdInputStream::~wxZstdInputStream()
+{
+    ZSTD_freeDCtx(m_dctx);
+}
+
+void wxZstdInputStream::Init(int flags)
+{
+    wxASSERT_MSG( !(flags & ~wxZSTD_SINGLE_FRAME),
+                  wxT("unknown wxZstdInputStream flags") );
+
+    m_flags = flags;
+    m_inPos =
+    m_inSize = 0;
+    m_atFrameEnd =
+    m_eof = false;
+
+    m_dctx = ZSTD_createDCtx();
+    if ( !m_dctx )
+    {
+        wxLogError(_("Failed to allocate memory for Zstandard decompression."));
+        m_lasterror = wxSTREAM_READ_ERROR;
+    }
+}
+
+size_t wxZstdInputStream::OnSysRead(void* outbuf, size_t size)
+{
+    ZSTD_outBuffer out = { outbuf, size, 0 };
+
+    // Decompress input as long as we don't have any errors (including EOF, as
+    // it doesn't make sense to continue after it either) and have space to
+    // decompress it to.
+    while ( m_lasterror == wxSTREAM_NO_ERROR && !m_eof &&
+                out.pos < out.size )
+    {
+        // Get more input data if needed.
+        if ( m_inPos == m_inSize )
+        {
+            m_parent_i_stream->Read(m_streamBuf, m_bufSize);
+            m_inPos = 0;
+            m_inSize = m_parent_i_stream->LastRead();
+
+            if ( !m_inSize )
+            {
+                // It's fine to reach the end of the underlying stream after
+                // the end of a frame, there are just no more frames.
+                if ( m_atFrameEnd )
+                {
+                    m_eof = true;
+                    break;
+                }
+
+                if ( m_parent_i_stream->GetLastError() == wxSTREAM_EOF )
+                {
+                    // We have reached end of the underlying stream before
+                    // the end of the frame.
+                    wxLogError(_("Zstandard decompression error: %s"),
+                               _("input is truncated"));
+                }
+
+                // Still return the data decompressed so far below.
+                m_lasterror = wxSTREAM_READ_ERROR;
+                break;
+            }
+        }
+
+        ZSTD_inBuffer in = { m_streamBuf, m_inSize, m_inPos };
+        const size_t rc = ZSTD_decompressStream(m_dctx, &out, &in);
+        m_inPos = in.pos;
+
+        if ( ZSTD_isError(rc) )
+        {
+            wxLogError(_("Zstandard decompression error: %s"),
+                       ZSTD_getErrorName(rc));
+
+            m_lasterror = wxSTREAM_READ_ERROR;
+            break;
+        }
+
+        // When 0 is returned, the end of the frame (which may also be a
+        // skippable frame without any data) was reached and all its data was
+        // output. By default, just continue with the next frame, if any, as
+        // ZSTD_decompressStream() starts decompressing it automatically.
+        m_atFrameEnd = rc == 0;
+
+        if ( m_atFrameEnd && (m_flags & wxZSTD_SINGLE_FRAME) )
+        {
+            // Unread any data taken from past the end of the frame, so that
+            // any additional data can be read from the underlying stream, as
+            // zip entries without the compressed size in the header need.
+            if ( m_inPos < m_inSize )
+            {
+                m_parent_i_stream->Reset();
+                m_parent_i_stream->Ungetch(m_streamBuf + m_inPos,
+                                           m_inSize - m_inPos);
+                m_inPos = m_inSize;
+            }
+
+            m_eof = true;
+        }
+    }
+
+    // Only report EOF when we couldn't fill the buffer, the last chunk of
+    // data must still be returned successfully.
+    if ( m_eof && out.pos < out.size )
+        m_lasterror = wxSTREAM_EOF;
+
+    // Return the number of bytes actually read, this may be less than the
+    // requested size if we hit EOF or an error.
+    m_pos += out.pos;
+    return out.pos;
+}
+
+// ----------------------------------------------------------------------------
+// wxZstdOutputStream: compression
+// ----------------------------------------------------------------------------
+
+wxZstdOutputStream::wxZstdOutputStream(wxOutputStream& stream, int level)
+    : wxFilterOutputStream(stream),
+      wxZstdData(ZSTD_CStreamOutSize())
+{
+    Init(level);
+}
+
+wxZstdOutputStream::wxZstdOutputStream(wxOutputStream* stream, int level)
+    : wxFilterOutputStream(stream),
+      wxZstdData(ZSTD_CStreamOutSize())
+{
+    Init(level);
+}
+
+wxZstdOutputStream::~wxZstdOutputStream()
+{
+    Close();
+
+    ZSTD_freeCCtx(m_cctx);
+}
+
+void wxZstdOutputStream::Init(int level)
+{
+    m_cctx = ZSTD_createCCtx();
+    if ( !m_cctx )
+    {
+        wxLogError(_("Failed to allocate memory for Zstandard compression."));
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+        return;
+    }
+
+    if ( level == -1 )
+    {
+        level = ZSTD_CLEVEL_DEFAULT;
+    }
+    else
+    {
+        wxASSERT_MSG( level >= ZSTD_minCLevel() && level <= ZSTD_maxCLevel(),
+                      wxT("Invalid Zstandard compression level") );
+    }
+
+    size_t rc = ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_compressionLevel, level);
+
+    // Also store the checksum of the data, as zstd command line tool does.
+    if ( !ZSTD_isError(rc) )
+        rc = ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_checksumFlag, 1);
+
+    if ( ZSTD_isError(rc) )
+    {
+        wxLogError(_("Failed to initialize Zstandard compression: %s"),
+                   ZSTD_getErrorName(rc));
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+    }
+}
+
+bool wxZstdOutputStream::DoCompress(const void *buffer, size_t size, int mode)
+{
+    // The context is freed when the stream is closed.
+    if ( !m_cctx )
+        return false;
+
+    const ZSTD_EndDirective directive = static_cast<ZSTD_EndDirective>(mode);
+
+    ZSTD_inBuffer in = { buffer, size, 0 };
+
+    // Continue until all input is consumed and, when flushing, all output is
+    // written, but stop at first error as it's useless to try to continue
+    // after it.
+    while ( m_lasterror == wxSTREAM_NO_ERROR )
+    {
+        ZSTD_outBuffer out = { m_streamBuf, m_bufSize, 0 };
+
+        const size_t remaining = ZSTD_compressStream2(m_cctx, &out, &in,
+                                                      directive);
+        if ( ZSTD_isError(remaining) )
+        {
+            wxLogError(_("Zstandard compression error: %s"),
+                       ZSTD_getErrorName(remaining));
+            m_lasterror = wxSTREAM_WRITE_ERROR;
+            break;
+        }
+
+        if ( out.pos )
+        {
+            m_parent_o_stream->Write(m_streamBuf, out.pos);
+            if ( m_parent_o_stream->LastWrite() != out.pos )
+            {
+                m_lasterror = wxSTREAM_WRITE_ERROR;
+                break;
+            }
+        }
+
+        const bool done = directive == ZSTD_e_continue ? in.pos == in.size
+                                                       : remaining == 0;
+        if ( done )
+            return true;
+    }
+
+    return false;
+}
+
+size_t wxZstdOutputStream::OnSysWrite(const void *inbuf, size_t size)
+{
+    if ( !DoCompress(inbuf, size, ZSTD_e_continue) )
+        return 0;
+
+    m_pos += size;
+    return size;
+}
+
+bool wxZstdOutputStream::DoFlush(bool finish)
+{
+    return DoCompress(nullptr, 0, finish ? ZSTD_e_end : ZSTD_e_flush);
+}
+
+bool wxZstdOutputStream::Close()
+{
+    // Don't finish the frame more than once, e.g. when called from the dtor
+    // after being called explicitly.
+    if ( m_cctx )
+    {
+        const bool ok = DoFlush(true);
+
+        ZSTD_freeCCtx(m_cctx);
+        m_cctx = nullptr;
+
+        if ( !ok )
+            return false;
+    }
+
+    return wxFilterOutputStream::Close() && IsOk();
+}
+
+// ----------------------------------------------------------------------------
+// wxZstdClassFactory: allow creating streams from extension/MIME type
+// ----------------------------------------------------------------------------
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxZstdClassFactory, wxFilterClassFactory);
+
+static wxZstdClassFactory g_wxZstdClassFactory;
+
+wxZstdClassFactory::wxZstdClassFactory()
+{
+    if ( this == &g_wxZstdClassFactory )
+        PushFront();
+}
+
+const wxChar * const *
+wxZstdClassFactory::GetProtocols(wxStreamProtocolType type) const
+{
+    static const wxChar *mime[] = { wxT("application/zstd"), nullptr };
+    static const wxChar *encs[] = { wxT("zstd"), nullptr };
+    static const wxChar *exts[] = { wxT(".zst"), nullptr };
+
+    const wxChar* const* ret = nullptr;
+    switch ( type )
+    {
+        case wxSTREAM_PROTOCOL: ret = encs; break;
+        case wxSTREAM_MIMETYPE: ret = mime; break;
+        case wxSTREAM_ENCODING: ret = encs; break;
+        case wxSTREAM_FILEEXT:  ret = exts; break;
+    }
+
+    return ret;
+}
+
+#endif // wxUSE_LIBZSTD && wxUSE_STREAMS
@@ -23,6 +23,11 @@
     #include "wx/utils.h"
 #endif
 
+#include "wx/thread.h"
+
+#include <functional>
+#include <vector>
+
 
 // normally, the compiler options should contain -I../zlib, but it is
 // apparently not the case for all MSW makefiles and so, unless we use
@@ -274,6 +279,437 @@ bool wxZlibInputStream::SetDictionary(const wxMemoryBuffer &buf)
 }
 
 
+//////////////////////
+// wxZlibParallelDeflate
+//////////////////////
+
+// Compresses the data written to wxZlibOutputStream in parallel mode.
+//
+// The input is split into blocks which are compressed independently, each
+// of them using the end of the previous block as preset dictionary, so that
+// the compression ratio is almost the same as for a single stream. All the
+// blocks except the last one end with a sync flush, so that their output is
+// byte aligned and can be simply concatenated, with the header and trailer
+// written separately and the trailer checksum combined from the checksums of
+// the individual blocks.
+//
+// The blocks are accumulated in batches of as many blocks as there are
+// threads and each batch is compressed and written out at once.
+
+class wxZlibParallelDeflate
+{
+public:
+    wxZlibParallelDeflate(int level, int flags,
+                          unsigned numThreads, size_t blockSize)
+        : m_level(level),
+          m_flags(flags),
+          m_blockSize(blockSize),
+          m_blocks(wxMax(numThreads, 1u))
+    {
+        Reset();
+    }
+
+    unsigned GetNumThreads() const { return static_cast<unsigned>(m_blocks.size()); }
+    size_t GetBlockSize() const { return m_blockSize; }
+
+    // Discard any pending data and prepare for writing a new stream.
+    void Reset();
+
+    // Append the data to the current batch, compressing and writing it out
+    // when it is full. Returns false on write error.
+    bool Write(wxOutputStream& out, const void *buffer, size_t size);
+
+    // Compress and write out all the pending data. If final is true, also
+    // finish the stream and prepare for writing a new one.
+    bool Flush(wxOutputStream& out, bool final);
+
+private:
+    // The preset dictionary size, i.e. the deflate window size.
+    enum { DICT_SIZE = 1 << MAX_WBITS };
+
+    struct Block
+    {
+        std::vector<unsigned char> input;
+        std::vector<unsigned char> output;
+        uLong check = 0;
+        bool ok = false;
+    };
+
+    bool WriteHeader(wxOutputStream& out);
+    bool WriteTrailer(wxOutputStream& out);
+
+    // Compress the given block of the current batch.
+    void CompressBlock(size_t n, bool last, bool final);
+
+    // Compress all the blocks of the current batch and write them out.
+    bool CompressBatch(wxOutputStream& out, bool final);
+
+    const int m_level;
+    const int m_flags;
+    const size_t m_blockSize;
+
+    std::vector<Block> m_blocks;
+
+    // Number of the block being filled in the current batch.
+    size_t m_current;
+
+    // The end of the input preceding the current batch, used as dictionary
+    // for its first block.
+    std::vector<unsigned char> m_dict;
+
+    bool m_headerWritten;
+
+    // Checksum and length of all the input of the current stream.
+    uLong m_check;
+    wxUint32 m_length;
+
+    // True after the stream was finished and before it is reset or any more
+    // data is written to it.
+    bool m_finished;
+
+    wxDECLARE_NO_COPY_CLASS(wxZlibParallelDeflate);
+};
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+class wxZlibBlockThread : public wxThread
+{
+public:
+    explicit wxZlibBlockThread(const std::function<void ()>& func)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_func(func)
+    {
+    }
+
+protected:
+    void* Entry() override
+    {
+        m_func();
+        return nullptr;
+    }
+
+private:
+    const std::function<void ()> m_func;
+};
+
+} // anonymous namespace
+
+#endif // wxUSE_THREADS
+
+void wxZlibParallelDeflate::Reset()
+{
+    for ( Block& block : m_blocks )
+        block.input.clear();
+
+    m_current = 0;
+    m_dict.clear();
+    m_headerWritten = false;
+    m_check = m_flags == wxZLIB_GZIP ? crc32(0, nullptr, 0)
+                                     : adler32(0, nullptr, 0);
+    m_length = 0;
+    m_finished = false;
+}
+
+bool wxZlibParallelDeflate::WriteHeader(wxOutputStream& out)
+{
+    m_headerWritten = true;
+
+    switch ( m_flags )
+    {
+        case wxZLIB_ZLIB:
+        {
+            // See RFC 1950: deflate with 32KiB window and the level hint.
+            const int level = m_level == Z_DEFAULT_COMPRESSION ? 6 : m_level;
+            const int flevel = level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+
+            const unsigned char cmf = 0x78;
+            unsigned char flg = static_cast<unsigned char>(flevel << 6);
+            flg += 31 - (cmf * 256 + flg) % 31;
+
+            const unsigned char header[] = { cmf, flg };
+            return out.Write(header, sizeof(header)).LastWrite() == sizeof(header);
+        }
+
+        case wxZLIB_GZIP:
+        {
+            // See RFC 1952: no name nor modification time, unknown OS.
+            const unsigned char xfl = m_level == 9 ? 2 : m_level == 1 ? 4 : 0;
+            const unsigned char header[] =
+                { 0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, xfl, 0xff };
+            return out.Write(header, sizeof(header)).LastWrite() == sizeof(header);
+        }
+    }
+
+    return true;
+}
+
+bool wxZlibParallelDeflate::WriteTrailer(wxOutputStream& out)
+{
+    unsigned char trailer[8];
+    size_t len = 0;
+
+    switch ( m_flags )
+    {
+        case wxZLIB_ZLIB:
+            // Adler-32 in big endian order.
+            for ( int shift = 24; shift >= 0; shift -= 8 )
+                trailer[len++] = static_cast<unsigned char>(m_check >> shift);
+            break;
+
+        case wxZLIB_GZIP:
+            // CRC-32 and the input length modulo 2^32 in little endian order.
+            for ( int shift = 0; shift < 32; shift += 8 )
+                trailer[len++] = static_cast<unsigned char>(m_check >> shift);
+            for ( int shift = 0; shift < 32; shift += 8 )
+                trailer[len++] = static_cast<unsigned char>(m_length >> shift);
+            break;
+    }
+
+    return !len || out.Write(trailer, len).LastWrite() == len;
+}
+
+void wxZlibParallelDeflate::CompressBlock(size_t n, bool last, bool final)
+{
+    Block& block = m_blocks[n];
+    block.ok = false;
+    block.output.clear();
+
+    // Use the end of the previous input as the dictionary.
+    const unsigned char *dict = nullptr;
+    size_t dictLen = 0;
+    if ( n > 0 )
+    {
+        const std::vector<unsigned char>& prev = m_blocks[n - 1].input;
+        dictLen = wxMin(prev.size(), static_cast<size_t>(DICT_SIZE));
+        dict = prev.data() + prev.size() - dictLen;
+    }
+    else if ( !m_dict.empty() )
+    {
+        dict = m_dict.data();
+        dictLen = m_dict.size();
+    }
+
+    z_stream z;
+    memset(&z, 0, sizeof(z));
+    if ( deflateInit2(&z, m_level, Z_DEFLATED, -MAX_WBITS,
+                      8, Z_DEFAULT_STRATEGY) != Z_OK )
+        return;
+
+    if ( dictLen && deflateSetDictionary(&z, dict, dictLen) != Z_OK )
+    {
+        deflateEnd(&z);
+        return;
+    }
+
+    const int flush = last && final ? Z_FINISH : Z_SYNC_FLUSH;
+
+    // Leave some space for the sync flush marker too.
+    block.output.resize(deflateBound(&z, block.input.size()) + 16);
+
+    z.next_in = block.input.data();
+    z.avail_in = static_cast<uInt>(block.input.size());
+
+    size_t outLen = 0;
+    for ( ;; )
+    {
+        z.next_out = block.output.data() + outLen;
+        z.avail_out = static_cast<uInt>(block.output.size() - outLen);
+
+        const int err = deflate(&z, flush);
+        outLen = block.output.size() - z.avail_out;
+
+        if ( err == Z_STREAM_END || (err == Z_OK && z.avail_out != 0) )
+            break;
+
+        if ( err != Z_OK && err != Z_BUF_ERROR )
+        {
+            deflateEnd(&z);
+            return;
+        }
+
+        block.output.resize(block.output.size() * 2);
+    }
+
+    deflateEnd(&z);
+    block.output.resize(outLen);
+
+    switch ( m_flags )
+    {
+        case wxZLIB_ZLIB:
+            block.check = adler32(adler32(0, nullptr, 0),
+                                  block.input.data(), block.input.size());
+            break;
+
+        case wxZLIB_GZIP:
+            block.check = crc32(crc32(0, nullptr, 0),
+                                block.input.data(), block.input.size());
+            break;
+    }
+
+    block.ok = true;
+}
+
+bool wxZlibParallelDeflate::CompressBatch(wxOutputStream& out, bool final)
+{
+    // Number of blocks in this batch, the current one is only included if it
+    // has any data or if we need to finish the stream.
+    size_t count = m_current;
+    if ( count < m_blocks.size() &&
+            (!m_blocks[count].input.empty() || final) )
+        count++;
+
+    if ( !count )
+    {
+        // Even if there is nothing to compress, the data following Sync()
+        // must not depend on the data of the previous batch.
+        m_dict.clear();
+        return true;
+    }
+
+    const auto compress = [=](size_t n)
+    {
+        CompressBlock(n, n == count - 1, final);
+    };
+
+#if wxUSE_THREADS
+    // Compress the first block in this thread and the other ones in the
+    // worker threads.
+    std::vector<wxZlibBlockThread*> threads;
+    size_t n;
+    for ( n = 1; n < count; n++ )
+    {
+        wxZlibBlockThread* const
+            thread = new wxZlibBlockThread([=]() { compress(n); });
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            break;
+        }
+
+        threads.push_back(thread);
+    }
+
+    compress(0);
+
+    // Do whatever couldn't be done in the worker threads here.
+    for ( ; n < count; n++ )
+        compress(n);
+
+    for ( wxZlibBlockThread* thread : threads )
+    {
+        thread->Wait();
+        delete thread;
+    }
+#else // !wxUSE_THREADS
+    for ( size_t n = 0; n < count; n++ )
+        compress(n);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    if ( !m_headerWritten && !WriteHeader(out) )
+        return false;
+
+    for ( size_t i = 0; i < count; i++ )
+    {
+        const Block& block = m_blocks[i];
+        if ( !block.ok )
+        {
+            wxLogError(_("Can't write to deflate stream: %s"),
+                       _("compression failed"));
+            return false;
+        }
+
+        const size_t len = block.output.size();
+        if ( out.Write(block.output.data(), len).LastWrite() != len )
+            return false;
+
+        switch ( m_flags )
+        {
+            case wxZLIB_ZLIB:
+                m_check = adler32_combine(m_check, block.check,
+                                          static_cast<z_off_t>(block.input.size()));
+                break;
+
+            case wxZLIB_GZIP:
+                m_check = crc32_combine(m_check, block.check,
+                                        static_cast<z_off_t>(block.input.size()));
+                break;
+        }
+
+        m_length += static_cast<wxUint32>(block.input.size());
+    }
+
+    // Keep the end of the input as dictionary for the next batch, unless the
+    // batch was flushed, as Sync() must make the following data independent
+    // of the preceding one, just as Z_FULL_FLUSH does.
+    m_dict.clear();
+    if ( !final && m_current == m_blocks.size() )
+    {
+        const std::vector<unsigned char>& last = m_blocks[count - 1].input;
+        const size_t dictLen = wxMin(last.size(), static_cast<size_t>(DICT_SIZE));
+        m_dict.assign(last.end() - dictLen, last.end());
+    }
+
+    for ( size_t i = 0; i < count; i++ )
+    {
+        m_blocks[i].input.clear();
+        m_blocks[i].output.clear();
+    }
+
+    m_current = 0;
+
+    return !final || WriteTrailer(out);
+}
+
+bool wxZlibParallelDeflate::Write(wxOutputStream& out,
+                                  const void *buffer,
+                                  size_t size)
+{
+    const unsigned char *data = static_cast<const unsigned char*>(buffer);
+
+    m_finished = false;
+
+    while ( size )
+    {
+        std::vector<unsigned char>& input = m_blocks[m_current].input;
+        if ( input.capacity() < m_blockSize )
+            input.reserve(m_blockSize);
+
+        const size_t len = wxMin(size, m_blockSize - input.size());
+        input.insert(input.end(), data, data + len);
+        data += len;
+        size -= len;
+
+        if ( input.size() == m_blockSize && ++m_current == m_blocks.size() )
+        {
+            if ( !CompressBatch(out, false) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool wxZlibParallelDeflate::Flush(wxOutputStream& out, bool final)
+{
+    // Don't write another empty stream if we're closed more than once.
+    if ( m_finished )
+        return true;
+
+    const bool ok = CompressBatch(out, final);
+
+    if ( final )
+    {
+        Reset();
+        m_finished = true;
+    }
+
+    return ok;
+}
+
+
 //////////////////////
 // wxZlibOutputStream
 //////////////////////
@@ -297,6 +733,7 @@ wxZlibOutputStream::wxZlibOutputStream(wxOutputStream *stream,
 void wxZlibOutputStream::Init(int level, int flags)
 {
   m_deflate = nullptr;
+  m_parallel = nullptr;
   m_z_buffer = new unsigned char[ZSTREAM_BUFFER_SIZE];
   m_z_size = ZSTREAM_BUFFER_SIZE;
   m_pos = 0;
@@ -310,6 +747,9 @@ void wxZlibOutputStream::Init(int level, int flags)
     wxASSERT_MSG(level >= 0 && level <= 9, wxT("wxZlibOutputStream compression level must be between 0 and 9!"));
   }
 
+  m_level = level;
+  m_flags = flags;
+
   // if gzip is asked for but not supported...
   if (flags == wxZLIB_GZIP && !CanHandleGZip()) {
     wxLogError(_("Gzip not supported by this version of zlib"));
@@ -349,6 +789,7 @@ bool wxZlibOutputStream::Close()
   DoFlush(true);
    deflateEnd(m_deflate);
    wxDELETE(m_deflate);
+   wxDELETE(m_parallel);
    wxDELETEA(m_z_buffer);
 
   return wxFilterOutputStream::Close() && IsOk();
@@ -361,6 +802,14 @@ void wxZlibOutputStream::DoFlush(bool final)
   if (!IsOk())
     return;
 
+  if (m_parallel) {
+    if (!m_parallel->Flush(*m_parent_o_stream, final)) {
+      m_lasterror = wxSTREAM_WRITE_ERROR;
+      wxLogDebug(wxT("wxZlibOutputStream: Error writing to underlying stream"));
+    }
+    return;
+  }
+
   int err = Z_OK;
   bool done = false;
 
@@ -396,6 +845,16 @@ size_t wxZlibOutputStream::OnSysWrite(const void *buffer, size_t size)
   if (!IsOk() || !size)
     return 0;
 
+  if (m_parallel) {
+    if (!m_parallel->Write(*m_parent_o_stream, buffer, size)) {
+      m_lasterror = wxSTREAM_WRITE_ERROR;
+      wxLogDebug(wxT("wxZlibOutputStream: Error writing to underlying stream"));
+      return 0;
+    }
+    m_pos += size;
+    return size;
+  }
+
   int err = Z_OK;
   m_deflate->next_in = const_cast<unsigned char*>(static_cast<const unsigned char*>(buffer));
   m_deflate->avail_in = size;
@@ -436,6 +895,10 @@ size_t wxZlibOutputStream::OnSysWrite(const void *buffer, size_t size)
 
 bool wxZlibOutputStream::SetDictionary(const char *data, size_t datalen)
 {
+    // The blocks compressed in parallel use their own dictionaries.
+    wxCHECK_MSG( !m_parallel, false,
+                 wxT("Can't set dictionary when compressing in parallel") );
+
     return deflateSetDictionary(m_deflate, reinterpret_cast<const Bytef*>(data), datalen) == Z_OK;
 }
 
@@ -444,5 +907,53 @@ bool wxZlibOutputStream::SetDictionary(const wxMemoryBuffer &buf)
     return SetDictionary((char*)buf.GetData(), buf.GetDataLen());
 }
 
+bool wxZlibOutputStream::SetMaxThreads(unsigned maxThreads, size_t blockSize)
+{
+    wxCHECK_MSG( m_pos == 0, false,
+                 wxT("Must be called before writing any data") );
+
+    if ( !m_deflate )
+        return false;
+
+    if ( maxThreads == 0 )
+    {
+#if wxUSE_THREADS
+        const int numCPUs = wxThread::GetCPUCount();
+        maxThreads = numCPUs > 0 ? static_cast<unsigned>(numCPUs) : 1;
+#else
+        maxThreads = 1;
+#endif
+    }
+
+    // The default block size is the same as used by pigz: it is big enough
+    // for splitting the data to not affect the compression ratio much but
+    // small enough to keep all the threads busy.
+    if ( blockSize == 0 )
+        blockSize = 128*1024;
+
+    if ( m_parallel && maxThreads == m_parallel->GetNumThreads()
+            && blockSize == m_parallel->GetBlockSize() )
+    {
+        // Just reuse the existing buffers.
+        m_parallel->Reset();
+        return true;
+    }
+
+    wxDELETE(m_parallel);
+
+    if ( maxThreads > 1 )
+    {
+        m_parallel = new wxZlibParallelDeflate(m_level, m_flags,
+                                               maxThreads, blockSize);
+    }
+
+    return true;
+}
+
+unsigned wxZlibOutputStream::GetMaxThreads() const
+{
+    return m_parallel ? m_parallel->GetNumThreads() : 1;
+}
+
 #endif
   // wxUSE_ZLIB && wxUSE_STREAMS
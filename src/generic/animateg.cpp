@@ -387,6 +387,7 @@ bool wxGenericAnimationCtrl::RebuildBackingStoreUpToFrame(unsigned int frame)
     }
 
     // finally draw this frame
+    SaveAreaUnderFrame(dc, frame);
     DrawFrame(dc, frame);
 
     return true;
@@ -418,11 +419,16 @@ void wxGenericAnimationCtrl::IncrementalUpdateBackingStore()
             break;
 
         case wxANIM_TOPREVIOUS:
-            // this disposal should never be used too often.
-            // E.g. GIF specification explicitly say to keep the usage of this
-            //      disposal limited to the minimum.
-            // In fact it may require a lot of time to restore
-            if (m_currentFrame == 1)
+            // we normally have the area covered by the previous frame saved
+            // by SaveAreaUnderFrame() and just need to restore it, but if we
+            // don't, fall back to redrawing all the frames up to it, which
+            // may require a lot of time
+            if (m_bmpUnderFrame.IsOk())
+            {
+                dc.DrawBitmap(m_bmpUnderFrame, m_posUnderFrame,
+                              false /* no mask */);
+            }
+            else if (m_currentFrame == 1)
             {
                 // if 0-th frame disposal is to restore to previous frame,
                 // the best we can do is to restore to background
@@ -440,9 +446,44 @@ void wxGenericAnimationCtrl::IncrementalUpdateBackingStore()
     }
 
     // now just draw the current frame on the top of the backing store
+    SaveAreaUnderFrame(dc, m_currentFrame);
     DrawFrame(dc, m_currentFrame);
 }
 
+void wxGenericAnimationCtrl::SaveAreaUnderFrame(wxDC& dc, unsigned int frame)
+{
+    if (AnimationImplGetDisposalMethod(frame) != wxANIM_TOPREVIOUS)
+    {
+        m_bmpUnderFrame = wxNullBitmap;
+        return;
+    }
+
+    // only the part of the frame inside the backing store needs to be saved
+    wxRect rect(AnimationImplGetFramePosition(frame),
+                AnimationImplGetFrameSize(frame));
+    rect.Intersect(wxRect(m_backingStore.GetSize()));
+    if (rect.IsEmpty())
+    {
+        m_bmpUnderFrame = wxNullBitmap;
+        return;
+    }
+
+    // reuse the existing bitmap if possible, as consecutive frames with this
+    // disposal usually have the same size
+    if (!m_bmpUnderFrame.IsOk() || m_bmpUnderFrame.GetSize() != rect.GetSize())
+    {
+        if (!m_bmpUnderFrame.Create(rect.GetSize()))
+        {
+            m_bmpUnderFrame = wxNullBitmap;
+            return;
+        }
+    }
+
+    wxMemoryDC dcSaved(m_bmpUnderFrame);
+    dcSaved.Blit(wxPoint(0, 0), rect.GetSize(), &dc, rect.GetPosition());
+    m_posUnderFrame = rect.GetPosition();
+}
+
 void wxGenericAnimationCtrl::DisplayStaticImage()
 {
     wxASSERT(!IsPlaying());
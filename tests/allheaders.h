@@ -192,6 +192,7 @@
 #include <wx/iconbndl.h>
 #include <wx/icon.h>
 #include <wx/iconloc.h>
+#include <wx/imagbatch.h>
 #include <wx/imagbmp.h>
 #include <wx/image.h>
 #include <wx/imaggif.h>
@@ -15,8 +15,11 @@
 #if wxUSE_STREAMS
 
 #include "archivetest.h"
+#include "wx/mstream.h"
 #include "wx/tarstrm.h"
 
+#include <memory>
+
 using std::string;
 
 
@@ -69,4 +72,346 @@ CppUnit::Test *tartest::makeTest(
 CPPUNIT_TEST_SUITE_REGISTRATION(tartest);
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(tartest, "archive/tar");
 
+
+///////////////////////////////////////////////////////////////////////////////
+// Tests of the features not covered by the generic archive tests above
+
+namespace
+{
+
+// Helper for building tar archives by hand, to test formats that
+// wxTarOutputStream doesn't write.
+class TarBuilder
+{
+public:
+    // Add a header block, the size field is only set if it is not empty.
+    void AddHeader(const std::string& name,
+                   char typeflag,
+                   const std::string& size,
+                   bool gnu = false)
+    {
+        char block[512] = { 0 };
+        memcpy(block, name.data(), name.size());
+        memcpy(block + 100, "0000644", 7);
+        memcpy(block + 124, size.data(), size.size());
+        block[156] = typeflag;
+        memcpy(block + 257, gnu ? "ustar  " : "ustar\0" "00", 8);
+        m_last = m_data.size();
+        m_data.append(block, sizeof(block));
+        SetChecksum();
+    }
+
+    // Add a regular file header with the octal size.
+    void AddFile(const std::string& name, size_t size)
+    {
+        AddHeader(name, '0', Octal(size, 11));
+    }
+
+    // Add a pax extended header with the given records.
+    void AddPax(const std::vector<std::pair<std::string, std::string>>& recs)
+    {
+        std::string data;
+        for ( const auto& rec : recs )
+        {
+            const std::string body = " " + rec.first + "=" + rec.second + "\n";
+            // The length includes the length field itself.
+            size_t len = body.size() + 1;
+            while ( std::to_string(len).size() + body.size() > len )
+                len++;
+            data += std::to_string(len) + body;
+        }
+
+        AddHeader("PaxHeaders/file", 'x', Octal(data.size(), 11));
+        AddData(data);
+    }
+
+    // Modify the last header block and recompute its checksum.
+    void Patch(size_t offset, const std::string& value)
+    {
+        m_data.replace(m_last + offset, value.size(), value);
+        SetChecksum();
+    }
+
+    // Add data padded to a whole number of blocks.
+    void AddData(const std::string& data)
+    {
+        m_data += data;
+        m_data.append((512 - data.size() % 512) % 512, '\0');
+    }
+
+    void Finish() { m_data.append(1024, '\0'); }
+
+    const std::string& Get() const { return m_data; }
+
+    static std::string Octal(size_t n, size_t width)
+    {
+        std::string s(width, '0');
+        for ( size_t i = width; i > 0 && n; i-- , n >>= 3 )
+            s[i - 1] = static_cast<char>('0' + (n & 7));
+        return s;
+    }
+
+private:
+    void SetChecksum()
+    {
+        char* const block = &m_data[m_last];
+        memset(block + 148, ' ', 8);
+        unsigned sum = 0;
+        for ( int i = 0; i < 512; i++ )
+            sum += static_cast<unsigned char>(block[i]);
+        memcpy(block + 148, Octal(sum, 6).c_str(), 7);
+    }
+
+    std::string m_data;
+    size_t m_last = 0;
+};
+
+std::string ReadTarEntry(wxInputStream& in)
+{
+    wxMemoryOutputStream out;
+    in.Read(out);
+    std::string buf(out.GetSize(), '\0');
+    if ( !buf.empty() )
+        out.CopyTo(&buf[0], buf.size());
+    return buf;
+}
+
+// Logical contents of the sparse file used by the tests: a hole of 1000
+// bytes, then "first", a hole up to 5000, "second" and a final hole.
+const wxFileOffset SPARSE_SIZE = 10000;
+
+std::string GetSparseContents()
+{
+    std::string s(SPARSE_SIZE, '\0');
+    s.replace(1000, 5, "first");
+    s.replace(5000, 6, "second");
+    return s;
+}
+
+void CheckSparseEntry(wxTarInputStream& tar)
+{
+    std::unique_ptr<wxTarEntry> entry(tar.GetNextEntry());
+    REQUIRE( entry );
+    CHECK( entry->GetName(wxPATH_UNIX) == "sparse.bin" );
+    CHECK( entry->GetTypeFlag() == wxTAR_REGTYPE );
+    CHECK( entry->IsSparse() );
+    CHECK( entry->GetSize() == SPARSE_SIZE );
+
+    const wxTarSparseMap& map = entry->GetSparseMap();
+    REQUIRE( map.size() == 3 );
+    CHECK( map[0].offset == 1000 );
+    CHECK( map[0].size == 5 );
+    CHECK( map[1].offset == 5000 );
+    CHECK( map[1].size == 6 );
+    CHECK( map[2].offset == SPARSE_SIZE );
+    CHECK( map[2].size == 0 );
+
+    CHECK( ReadTarEntry(tar) == GetSparseContents() );
+    CHECK( tar.GetLastError() == wxSTREAM_EOF );
+
+    // Seeking must work both into holes and into the data regions.
+    const std::string contents = GetSparseContents();
+    const wxFileOffset positions[] = { 5002, 0, 999, 1003, 4999, 9990 };
+    for ( wxFileOffset pos : positions )
+    {
+        INFO( "Seeking to " << pos );
+        REQUIRE( tar.SeekI(pos) == pos );
+        char buf[10];
+        tar.Read(buf, sizeof(buf));
+        REQUIRE( tar.LastRead() == sizeof(buf) );
+        CHECK( std::string(buf, sizeof(buf)) == contents.substr(pos, 10) );
+    }
+
+    // And the entry following the sparse one must be found.
+    entry.reset(tar.GetNextEntry());
+    REQUIRE( entry );
+    CHECK( entry->GetName(wxPATH_UNIX) == "after.txt" );
+    CHECK( !entry->IsSparse() );
+    CHECK( ReadTarEntry(tar) == "after" );
+
+    CHECK( tar.GetNextEntry() == nullptr );
+    CHECK( tar.GetLastError() == wxSTREAM_EOF );
+}
+
+void AddAfterEntry(TarBuilder& tb)
+{
+    tb.AddFile("after.txt", 5);
+    tb.AddData("after");
+    tb.Finish();
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxTarIndex", "[archive][tar]")
+{
+    const int count = 20;
+
+    wxMemoryOutputStream mem;
+    {
+        wxTarOutputStream tar(mem);
+        for ( int n = 0; n < count; n++ )
+        {
+            tar.PutNextEntry(wxString::Format("dir/file%d.txt", n));
+            const std::string data(n * 100, static_cast<char>('a' + n));
+            tar.Write(data.data(), data.size());
+        }
+
+        // A later entry with the same name replaces the earlier one.
+        tar.PutNextEntry("dir/file3.txt");
+        tar.Write("replaced", 8);
+
+        REQUIRE( tar.Close() );
+    }
+
+    wxMemoryInputStream in(mem);
+
+    wxTarIndex index(in);
+    REQUIRE( index.IsOk() );
+    CHECK( index.GetCount() == count + 1 );
+    CHECK( index.GetEntry(5).GetInternalName() == "dir/file5.txt" );
+    CHECK( index.Find("dir/nosuchfile.txt") == nullptr );
+
+    const wxTarEntry* entry = index.Find("dir/file3.txt", wxPATH_UNIX);
+    REQUIRE( entry );
+    std::unique_ptr<wxTarInputStream> tar(index.OpenEntry(in, *entry));
+    REQUIRE( tar );
+    CHECK( ReadTarEntry(*tar) == "replaced" );
+
+    // Open the entries in reverse order, reusing the same parent stream.
+    for ( int n = count - 1; n >= 0; n-- )
+    {
+        if ( n == 3 )
+            continue;
+
+        entry = index.Find(wxString::Format("dir/file%d.txt", n), wxPATH_UNIX);
+        REQUIRE( entry );
+
+        tar.reset(index.OpenEntry(in, *entry));
+        REQUIRE( tar );
+        CHECK( ReadTarEntry(*tar) ==
+                std::string(n * 100, static_cast<char>('a' + n)) );
+        CHECK( tar->GetLastError() == wxSTREAM_EOF );
+    }
+
+    // The entries couldn't be opened from a non-seekable stream, so loading
+    // the index from it fails immediately.
+    TestOutputStream pipeOut(PipeIn);
+    const wxStreamBuffer* const buf = mem.GetOutputStreamBuffer();
+    pipeOut.Write(buf->GetBufferStart(), buf->GetBufferSize());
+    TestInputStream pipeIn(pipeOut, 0);
+
+    WX_ASSERT_FAILS_WITH_ASSERT( index.Load(pipeIn) );
+    CHECK( !index.IsOk() );
+    CHECK( index.GetCount() == 0 );
+}
+
+TEST_CASE("wxTarInputStream::Sparse", "[archive][tar]")
+{
+    TarBuilder tb;
+
+    SECTION("PAX 1.0")
+    {
+        const std::string map = "3\n1000\n5\n5000\n6\n10000\n0\n";
+        tb.AddPax({{"GNU.sparse.major", "1"},
+                   {"GNU.sparse.minor", "0"},
+                   {"GNU.sparse.name", "sparse.bin"},
+                   {"GNU.sparse.realsize", "10000"}});
+        tb.AddFile("GNUSparseFile.0/sparse.bin", 512 + 11);
+        tb.AddData(map);
+        tb.AddData("firstsecond");
+    }
+
+    SECTION("PAX 0.1")
+    {
+        tb.AddPax({{"GNU.sparse.size", "10000"},
+                   {"GNU.sparse.numblocks", "3"},
+                   {"GNU.sparse.name", "sparse.bin"},
+                   {"GNU.sparse.map", "1000,5,5000,6,10000,0"}});
+        tb.AddFile("GNUSparseFile.0/sparse.bin", 11);
+        tb.AddData("firstsecond");
+    }
+
+    SECTION("PAX 0.0")
+    {
+        tb.AddPax({{"GNU.sparse.size", "10000"},
+                   {"GNU.sparse.numblocks", "3"},
+                   {"GNU.sparse.offset", "1000"},
+                   {"GNU.sparse.numbytes", "5"},
+                   {"GNU.sparse.offset", "5000"},
+                   {"GNU.sparse.numbytes", "6"},
+                   {"GNU.sparse.offset", "10000"},
+                   {"GNU.sparse.numbytes", "0"},
+                   {"path", "sparse.bin"}});
+        tb.AddFile("GNUSparseFile.0/sparse.bin", 11);
+        tb.AddData("firstsecond");
+    }
+
+    SECTION("Old GNU")
+    {
+        tb.AddHeader("sparse.bin", 'S', TarBuilder::Octal(11, 11), true);
+        // The first region is in the header, the others in an extension.
+        tb.Patch(386, TarBuilder::Octal(1000, 11));
+        tb.Patch(398, TarBuilder::Octal(5, 11));
+        tb.Patch(482, "\\1");
+        tb.Patch(483, TarBuilder::Octal(SPARSE_SIZE, 11));
+
+        std::string ext(512, '\0');
+        ext.replace(0, 11, TarBuilder::Octal(5000, 11));
+        ext.replace(12, 11, TarBuilder::Octal(6, 11));
+        ext.replace(24, 11, TarBuilder::Octal(SPARSE_SIZE, 11));
+        ext.replace(36, 11, TarBuilder::Octal(0, 11));
+        tb.AddData(ext);
+        tb.AddData("firstsecond");
+    }
+
+    AddAfterEntry(tb);
+
+    wxMemoryInputStream in(tb.Get().data(), tb.Get().size());
+    wxTarInputStream tar(in);
+    CheckSparseEntry(tar);
+}
+
+TEST_CASE("wxTarInputStream::BadSparseMap", "[archive][tar]")
+{
+    TarBuilder tb;
+    tb.AddPax({{"GNU.sparse.size", "100"},
+               {"GNU.sparse.map", "50,10,20,10"}});
+    tb.AddFile("sparse.bin", 20);
+    tb.AddData(std::string(20, 'x'));
+    tb.Finish();
+
+    wxMemoryInputStream in(tb.Get().data(), tb.Get().size());
+    wxTarInputStream tar(in);
+
+    wxLogNull noLog;
+    CHECK( tar.GetNextEntry() == nullptr );
+    CHECK( tar.GetLastError() == wxSTREAM_READ_ERROR );
+}
+
+TEST_CASE("wxTarInputStream::Base256", "[archive][tar]")
+{
+    // The size is stored in the base-256 encoding used for the big files.
+    std::string size(12, '\0');
+    size[0] = '\x80';
+    size[10] = '\x01';
+    size[11] = '\x02';
+
+    TarBuilder tb;
+    tb.AddHeader("big.bin", '0', size, true);
+    tb.AddData(std::string(0x102, 'b'));
+    AddAfterEntry(tb);
+
+    wxMemoryInputStream in(tb.Get().data(), tb.Get().size());
+    wxTarInputStream tar(in);
+
+    std::unique_ptr<wxTarEntry> entry(tar.GetNextEntry());
+    REQUIRE( entry );
+    CHECK( entry->GetSize() == 0x102 );
+    CHECK( ReadTarEntry(tar) == std::string(0x102, 'b') );
+
+    entry.reset(tar.GetNextEntry());
+    REQUIRE( entry );
+    CHECK( entry->GetName(wxPATH_UNIX) == "after.txt" );
+}
+
 #endif // wxUSE_STREAMS
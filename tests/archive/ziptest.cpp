@@ -15,10 +15,15 @@
 #if wxUSE_STREAMS && wxUSE_ZIPSTREAM
 
 #include "archivetest.h"
+#include "wx/mstream.h"
 #include "wx/zipstrm.h"
 
 #include <memory>
 
+#if wxUSE_THREADS
+    #include <thread>
+#endif
+
 using std::string;
 
 
@@ -250,4 +255,212 @@ CppUnit::Test *ziptest::makeTest(
 CPPUNIT_TEST_SUITE_REGISTRATION(ziptest);
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ziptest, "archive/zip");
 
+
+///////////////////////////////////////////////////////////////////////////////
+// wxZipIndex
+
+namespace
+{
+
+wxString GetIndexTestData(int n)
+{
+    wxString data;
+    for ( int i = 0; i < 100 + n * 37; i++ )
+        data << wxString::Format("entry %d line %d\n", n, i);
+    return data;
+}
+
+wxString ReadIndexTestEntry(wxInputStream& in)
+{
+    wxMemoryOutputStream out;
+    in.Read(out);
+    const size_t size = out.GetSize();
+    std::string buf(size, '\0');
+    out.CopyTo(&buf[0], size);
+    return wxString::FromAscii(buf.c_str(), size);
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxZipIndex", "[archive][zip]")
+{
+    const int count = 20;
+
+    wxMemoryOutputStream mem;
+    {
+        wxZipOutputStream zip(mem);
+        zip.SetComment("Index test");
+        for ( int n = 0; n < count; n++ )
+        {
+            wxZipEntry* const entry =
+                new wxZipEntry(wxString::Format("dir/file%d.txt", n));
+            if ( n % 2 )
+                entry->SetMethod(wxZIP_METHOD_STORE);
+            zip.PutNextEntry(entry);
+            const wxCharBuffer data = GetIndexTestData(n).ToAscii();
+            zip.Write(data.data(), data.length());
+        }
+        REQUIRE( zip.Close() );
+    }
+
+    wxMemoryInputStream in(mem);
+
+    wxZipIndex index(in);
+    REQUIRE( index.IsOk() );
+    CHECK( index.GetCount() == count );
+    CHECK( index.GetComment() == "Index test" );
+
+    CHECK( index.GetEntry(3).GetInternalName() == "dir/file3.txt" );
+    CHECK( index.Find("dir/nosuchfile.txt") == nullptr );
+
+    // Open the entries in reverse order, reusing the same parent stream.
+    for ( int n = count - 1; n >= 0; n-- )
+    {
+        const wxZipEntry* const entry =
+            index.Find(wxString::Format("dir/file%d.txt", n), wxPATH_UNIX);
+        REQUIRE( entry );
+
+        std::unique_ptr<wxZipInputStream> zip(index.OpenEntry(in, *entry));
+        REQUIRE( zip );
+        CHECK( ReadIndexTestEntry(*zip) == GetIndexTestData(n) );
+        CHECK( zip->GetLastError() == wxSTREAM_EOF );
+    }
+
+#if wxUSE_THREADS
+    // Read all entries from several threads at once, each one using its own
+    // view of the same data.
+    const void* const data = in.GetInputStreamBuffer()->GetBufferStart();
+    const size_t size = mem.GetSize();
+
+    const int threadCount = 4;
+    int failures[threadCount] = { 0 };
+    std::vector<std::thread> threads;
+    for ( int t = 0; t < threadCount; t++ )
+    {
+        threads.emplace_back([&, t]()
+        {
+            for ( int i = 0; i < count * 3; i++ )
+            {
+                const int n = (i * 7 + t) % count;
+                std::unique_ptr<wxZipInputStream> zip(index.OpenEntry(
+                    new wxMemoryInputStream(data, size), index.GetEntry(n)));
+                if ( !zip || ReadIndexTestEntry(*zip) != GetIndexTestData(n) )
+                    failures[t]++;
+            }
+        });
+    }
+
+    for ( auto& thread : threads )
+        thread.join();
+
+    for ( int t = 0; t < threadCount; t++ )
+        CHECK( failures[t] == 0 );
+#endif // wxUSE_THREADS
+}
+
+TEST_CASE("wxZipOutputStream::Parallel", "[archive][zip]")
+{
+    const int count = 5;
+
+    wxMemoryOutputStream mem;
+    {
+        wxZipOutputStream zip(mem);
+        zip.SetMaxThreads(4);
+        CHECK( zip.GetMaxThreads() == 4 );
+
+        for ( int n = 0; n < count; n++ )
+        {
+            zip.PutNextEntry(wxString::Format("file%d.txt", n));
+
+            // Make the entries big enough to be split into several blocks.
+            for ( int i = 0; i < 10 * n; i++ )
+            {
+                const wxCharBuffer data = GetIndexTestData(n).ToAscii();
+                zip.Write(data.data(), data.length());
+            }
+        }
+        REQUIRE( zip.Close() );
+    }
+
+    wxMemoryInputStream in(mem);
+    wxZipInputStream zip(in);
+
+    for ( int n = 0; n < count; n++ )
+    {
+        std::unique_ptr<wxZipEntry> entry(zip.GetNextEntry());
+        REQUIRE( entry );
+        CHECK( entry->GetMethod() == (n ? wxZIP_METHOD_DEFLATE
+                                        : wxZIP_METHOD_STORE) );
+
+        wxString expected;
+        for ( int i = 0; i < 10 * n; i++ )
+            expected += GetIndexTestData(n);
+
+        CHECK( ReadIndexTestEntry(zip) == expected );
+        CHECK( zip.GetLastError() == wxSTREAM_EOF );
+    }
+}
+
+#if wxUSE_LIBZSTD
+
+TEST_CASE("wxZipOutputStream::Zstd", "[archive][zip][zstd]")
+{
+    const int count = 3;
+
+    wxMemoryOutputStream mem;
+    {
+        wxZipOutputStream zip(mem);
+
+        for ( int n = 0; n < count; n++ )
+        {
+            wxZipEntry* const entry =
+                new wxZipEntry(wxString::Format("file%d.txt", n));
+            entry->SetMethod(wxZIP_METHOD_ZSTD);
+            REQUIRE( zip.PutNextEntry(entry) );
+
+            for ( int i = 0; i <= 100 * n; i++ )
+            {
+                const wxCharBuffer data = GetIndexTestData(n).ToAscii();
+                zip.Write(data.data(), data.length());
+            }
+        }
+        REQUIRE( zip.Close() );
+    }
+
+    // Check that the entries can be read both sequentially...
+    wxMemoryInputStream in(mem);
+    wxZipInputStream zip(in);
+
+    for ( int n = 0; n < count; n++ )
+    {
+        std::unique_ptr<wxZipEntry> entry(zip.GetNextEntry());
+        REQUIRE( entry );
+        CHECK( entry->GetMethod() == wxZIP_METHOD_ZSTD );
+
+        wxString expected;
+        for ( int i = 0; i <= 100 * n; i++ )
+            expected += GetIndexTestData(n);
+
+        CHECK( ReadIndexTestEntry(zip) == expected );
+        CHECK( zip.GetLastError() == wxSTREAM_EOF );
+    }
+
+    // ... and using the index.
+    in.SeekI(0);
+    wxZipIndex index(in);
+    REQUIRE( index.IsOk() );
+    REQUIRE( index.GetCount() == count );
+
+    const wxZipEntry* const entry = index.Find("file2.txt");
+    REQUIRE( entry );
+    CHECK( entry->GetMethod() == wxZIP_METHOD_ZSTD );
+
+    std::unique_ptr<wxZipInputStream> entryStream(index.OpenEntry(in, *entry));
+    REQUIRE( entryStream );
+    CHECK( wxFileOffset(ReadIndexTestEntry(*entryStream).length())
+            == entry->GetSize() );
+}
+
+#endif // wxUSE_LIBZSTD
+
 #endif // wxUSE_STREAMS && wxUSE_ZIPSTREAM
@@ -0,0 +1,104 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/archive.cpp
+// Purpose:     Compression and archive streams benchmarks
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/mstream.h"
+#include "wx/zipstrm.h"
+#include "wx/zstream.h"
+
+#include "bench.h"
+
+#include <vector>
+
+namespace
+{
+
+// Return the data to compress: the size in MiB is given by the numeric
+// parameter (16 by default).
+//
+// The data is neither trivially compressible nor random, to be
+// representative of the real files.
+const std::vector<unsigned char>& GetTestData()
+{
+    static std::vector<unsigned char> s_data;
+
+    const size_t size = Bench::GetNumericParameter(16) * 1024 * 1024;
+    if ( s_data.size() != size )
+    {
+        s_data.resize(size);
+
+        wxUint32 seed = 1;
+        for ( size_t n = 0; n < size; n++ )
+        {
+            seed = seed * 1103515245 + 12345;
+            const unsigned r = (seed >> 16) & 0x7fff;
+
+            // Mostly text-like bytes with occasional repetitions.
+            s_data[n] = r % 8 == 0 && n > 1000
+                            ? s_data[n - 1 - r % 1000]
+                            : static_cast<unsigned char>('a' + r % 26);
+        }
+    }
+
+    return s_data;
+}
+
+bool CompressZlib(unsigned maxThreads)
+{
+    const std::vector<unsigned char>& data = GetTestData();
+
+    wxMemoryOutputStream mos;
+    wxZlibOutputStream zos(mos, wxZ_DEFAULT_COMPRESSION, wxZLIB_GZIP);
+    zos.SetMaxThreads(maxThreads);
+
+    return zos.Write(data.data(), data.size()).IsOk() && zos.Close();
+}
+
+bool CompressZip(unsigned maxThreads)
+{
+    const std::vector<unsigned char>& data = GetTestData();
+
+    wxMemoryOutputStream mos;
+    wxZipOutputStream zip(mos);
+    zip.SetMaxThreads(maxThreads);
+
+    // Split the data into a few entries, as in a real archive.
+    const size_t count = 4;
+    const size_t size = data.size() / count;
+    for ( size_t n = 0; n < count; n++ )
+    {
+        if ( !zip.PutNextEntry(wxString::Format("file%zu", n)) )
+            return false;
+
+        if ( !zip.Write(&data[n * size], size).IsOk() )
+            return false;
+    }
+
+    return zip.Close();
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(ZlibCompress)
+{
+    return CompressZlib(1);
+}
+
+BENCHMARK_FUNC(ZlibCompressParallel)
+{
+    return CompressZlib(0);
+}
+
+BENCHMARK_FUNC(ZipCompress)
+{
+    return CompressZip(1);
+}
+
+BENCHMARK_FUNC(ZipCompressParallel)
+{
+    return CompressZip(0);
+}
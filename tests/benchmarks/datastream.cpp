@@ -0,0 +1,133 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/datastream.cpp
+// Purpose:     wxDataInputStream and wxDataOutputStream benchmarks
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/datstrm.h"
+#include "wx/mstream.h"
+
+#include "bench.h"
+
+#include <vector>
+
+namespace
+{
+
+// Return the number of values to use: it is given by the numeric parameter
+// in thousands (1000, i.e. a million values, by default).
+size_t GetCount()
+{
+    return Bench::GetNumericParameter(1000) * 1000;
+}
+
+template <typename T>
+const std::vector<T>& GetValues()
+{
+    static std::vector<T> s_values;
+
+    const size_t count = GetCount();
+    if ( s_values.size() != count )
+    {
+        s_values.resize(count);
+        for ( size_t n = 0; n < count; n++ )
+            s_values[n] = static_cast<T>(n * 7 + 1);
+    }
+
+    return s_values;
+}
+
+// Use the byte order different from the native one, so that the values
+// always need to be swapped, as this is the most common use case.
+const bool BIG_ENDIAN_ORDER = wxBYTE_ORDER != wxBIG_ENDIAN;
+
+bool Write32(bool bulk)
+{
+    const std::vector<wxUint32>& values = GetValues<wxUint32>();
+
+    wxMemoryOutputStream mos;
+    wxDataOutputStream out(mos);
+    out.BigEndianOrdered(BIG_ENDIAN_ORDER);
+
+    if ( bulk )
+    {
+        out.Write32(&values[0], values.size());
+    }
+    else
+    {
+        for ( size_t n = 0; n < values.size(); n++ )
+            out.Write32(values[n]);
+    }
+
+    return static_cast<size_t>(mos.GetLength()) == values.size() * sizeof(wxUint32);
+}
+
+// Return the serialized representation of the values returned by
+// GetValues<double>().
+const std::vector<char>& GetDoubleData()
+{
+    static std::vector<char> s_data;
+
+    const std::vector<double>& values = GetValues<double>();
+    if ( s_data.size() != values.size() * sizeof(double) )
+    {
+        wxMemoryOutputStream mos;
+        wxDataOutputStream out(mos);
+        out.BigEndianOrdered(BIG_ENDIAN_ORDER);
+        out.UseBasicPrecisions();
+        out.WriteDouble(&values[0], values.size());
+
+        s_data.resize(static_cast<size_t>(mos.GetLength()));
+        mos.CopyTo(&s_data[0], s_data.size());
+    }
+
+    return s_data;
+}
+
+bool ReadDouble(bool bulk)
+{
+    const std::vector<double>& values = GetValues<double>();
+    const std::vector<char>& data = GetDoubleData();
+
+    wxMemoryInputStream mis(&data[0], data.size());
+    wxDataInputStream in(mis);
+    in.BigEndianOrdered(BIG_ENDIAN_ORDER);
+    in.UseBasicPrecisions();
+
+    std::vector<double> result(values.size());
+    if ( bulk )
+    {
+        in.ReadDouble(&result[0], result.size());
+    }
+    else
+    {
+        for ( size_t n = 0; n < result.size(); n++ )
+            result[n] = in.ReadDouble();
+    }
+
+    return result == values;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(DataStreamWrite32)
+{
+    return Write32(false);
+}
+
+BENCHMARK_FUNC(DataStreamWrite32Array)
+{
+    return Write32(true);
+}
+
+BENCHMARK_FUNC(DataStreamReadDouble)
+{
+    return ReadDouble(false);
+}
+
+BENCHMARK_FUNC(DataStreamReadDoubleArray)
+{
+    return ReadDouble(true);
+}
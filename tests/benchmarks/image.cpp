@@ -8,6 +8,9 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include "wx/image.h"
+#include "wx/imagbatch.h"
+#include "wx/mstream.h"
+#include "wx/quantize.h"
 
 #include "bench.h"
 
@@ -43,6 +46,21 @@ BENCHMARK_FUNC(LoadPNG)
     return image.LoadFile("horse.png");
 }
 
+// Use the numeric parameter to specify the number of threads to use (0 means
+// using all CPUs) to check how loading scales with the number of threads.
+BENCHMARK_FUNC(LoadBatchJPEG)
+{
+    if ( !wxImage::FindHandler(wxBITMAP_TYPE_JPEG) )
+        wxImage::AddHandler(new wxJPEGHandler);
+
+    wxImageBatchLoader loader;
+    loader.SetMaxThreads(Bench::GetNumericParameter(0));
+    for ( int n = 0; n < 64; n++ )
+        loader.Add("horse.jpg");
+
+    return loader.Load();
+}
+
 #if wxUSE_LIBTIFF
 BENCHMARK_FUNC(LoadTIFF)
 {
@@ -118,3 +136,132 @@ BENCHMARK_FUNC(ShrinkHighQuality)
     return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
                        wxIMAGE_QUALITY_HIGH).IsOk();
 }
+
+// Large image, of the size typical for the photos or scans, used for the
+// benchmarks of creating thumbnails.
+static const wxImage& GetLargeTestImage()
+{
+    static wxImage s_image;
+    if ( !s_image.IsOk() )
+    {
+        const wxImage& image = GetTestImage();
+        if ( image.IsOk() )
+            s_image = image.Scale(6000, 4000, wxIMAGE_QUALITY_BILINEAR);
+    }
+
+    return s_image;
+}
+
+static bool MakeThumbnail(wxImageResizeQuality quality)
+{
+    const wxImage& image = GetLargeTestImage();
+    const int size = Bench::GetNumericParameter(256);
+    return image.Scale(size, size*image.GetHeight()/image.GetWidth(),
+                       quality).IsOk();
+}
+
+BENCHMARK_FUNC(ThumbnailNormal)
+{
+    return MakeThumbnail(wxIMAGE_QUALITY_NORMAL);
+}
+
+BENCHMARK_FUNC(ThumbnailBoxAverage)
+{
+    return MakeThumbnail(wxIMAGE_QUALITY_BOX_AVERAGE);
+}
+
+BENCHMARK_FUNC(ThumbnailBilinear)
+{
+    return MakeThumbnail(wxIMAGE_QUALITY_BILINEAR);
+}
+
+BENCHMARK_FUNC(ThumbnailBicubic)
+{
+    return MakeThumbnail(wxIMAGE_QUALITY_BICUBIC);
+}
+
+BENCHMARK_FUNC(ThumbnailHighQuality)
+{
+    return MakeThumbnail(wxIMAGE_QUALITY_HIGH);
+}
+
+BENCHMARK_FUNC(ThumbnailHighQualityAlpha)
+{
+    static wxImage s_image;
+    if ( !s_image.IsOk() )
+    {
+        s_image = GetLargeTestImage().Copy();
+        s_image.InitAlpha();
+    }
+
+    return s_image.Scale(256, 256*s_image.GetHeight()/s_image.GetWidth(),
+                         wxIMAGE_QUALITY_HIGH).IsOk();
+}
+
+// Quantize the large image to the number of colours given by the parameter
+// using different dithering methods: Floyd-Steinberg gives the best quality
+// but is the slowest and can't use multiple threads.
+static bool QuantizeLargeImage(int flags)
+{
+    wxImage dest;
+    return wxQuantize::Quantize(GetLargeTestImage(), dest, nullptr,
+                                Bench::GetNumericParameter(236), nullptr,
+                                wxQUANTIZE_FILL_DESTINATION_IMAGE | flags);
+}
+
+BENCHMARK_FUNC(QuantizeFloydSteinberg)
+{
+    return QuantizeLargeImage(0);
+}
+
+BENCHMARK_FUNC(QuantizeNoDither)
+{
+    return QuantizeLargeImage(wxQUANTIZE_NO_DITHER);
+}
+
+BENCHMARK_FUNC(QuantizeOrderedDither)
+{
+    return QuantizeLargeImage(wxQUANTIZE_ORDERED_DITHER);
+}
+
+// Save the 4K image using the PNG compression profile given by the parameter
+// (wxPNG_COMPRESSION_FAST by default), sequentially or in parallel using all
+// the available CPUs.
+static bool SavePNGImage(bool parallel)
+{
+    if ( !wxImage::FindHandler(wxBITMAP_TYPE_PNG) )
+        wxImage::AddHandler(new wxPNGHandler);
+
+    static wxImage s_image;
+    if ( !s_image.IsOk() )
+    {
+        const wxImage& image = GetTestImage();
+        if ( !image.IsOk() )
+            return false;
+
+        s_image = image.Scale(3840, 2160, wxIMAGE_QUALITY_BILINEAR);
+    }
+
+    s_image.SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_PROFILE,
+                      Bench::GetNumericParameter(wxPNG_COMPRESSION_FAST));
+    s_image.SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_PARALLEL, parallel);
+
+    wxImage::SetMaxThreads(parallel ? 0 : 1);
+
+    wxMemoryOutputStream mos;
+    const bool ok = s_image.SaveFile(mos, wxBITMAP_TYPE_PNG);
+
+    wxImage::SetMaxThreads(1);
+
+    return ok;
+}
+
+BENCHMARK_FUNC(SavePNG)
+{
+    return SavePNGImage(false);
+}
+
+BENCHMARK_FUNC(SavePNGParallel)
+{
+    return SavePNGImage(true);
+}
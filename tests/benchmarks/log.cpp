@@ -10,6 +10,12 @@
 #include "bench.h"
 
 #include "wx/log.h"
+#include "wx/logasync.h"
+#include "wx/logbinary.h"
+
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif
 
 // This class is used to check that the arguments of log functions are not
 // evaluated.
@@ -106,3 +112,119 @@ BENCHMARK_FUNC(LogTraceInactive)
 
     return true;
 }
+
+// Log target formatting the messages as text, as the standard log targets
+// do, but not outputting them anywhere.
+class TextDiscardingLog : public wxLog
+{
+protected:
+    virtual void DoLogText(const wxString& msg) override
+    {
+        m_len = msg.length();
+    }
+
+private:
+    size_t m_len = 0;
+};
+
+BENCHMARK_FUNC(LogText)
+{
+    static TextDiscardingLog s_log;
+    wxLog* const logOld = wxLog::SetActiveTarget(&s_log);
+
+    wxLogMessage("Processing item %d of %d", 17, 42);
+
+    wxLog::SetActiveTarget(logOld);
+
+    return true;
+}
+
+#if wxUSE_STREAMS
+
+BENCHMARK_FUNC(LogBinary)
+{
+    // Counting stream doesn't store the data written to it.
+    static wxCountingOutputStream s_stream;
+    static wxLogBinary s_log(&s_stream);
+    wxLog* const logOld = wxLog::SetActiveTarget(&s_log);
+
+    wxLogMessage("Processing item %d of %d", 17, 42);
+
+    wxLog::SetActiveTarget(logOld);
+
+    return true;
+}
+
+#endif // wxUSE_STREAMS
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+// Log target discarding all messages.
+class NoOpLog : public wxLog
+{
+protected:
+    virtual void DoLogRecord(wxLogLevel,
+                             const wxString&,
+                             const wxLogRecordInfo&) override
+    {
+    }
+};
+
+// Thread logging many messages as fast as possible.
+class LogBenchThread : public wxThread
+{
+public:
+    LogBenchThread() : wxThread(wxTHREAD_JOINABLE) { }
+
+protected:
+    virtual void* Entry() override
+    {
+        for ( int n = 0; n < 1000; n++ )
+            wxLogMessage("Message %d from a worker thread", n);
+
+        return nullptr;
+    }
+};
+
+// Log 1000 messages from each of 8 threads simultaneously using the given
+// log target and wait until all of them are processed.
+bool LogFromThreads(wxLog* log)
+{
+    wxLog* const logOld = wxLog::SetActiveTarget(log);
+
+    LogBenchThread threads[8];
+    for ( auto& thread : threads )
+        thread.Run();
+
+    for ( auto& thread : threads )
+        thread.Wait();
+
+    wxLog::FlushActive();
+
+    wxLog::SetActiveTarget(logOld);
+
+    return true;
+}
+
+} // anonymous namespace
+
+// Messages logged from the worker threads are added to a single buffer
+// protected by a critical section and then passed to the target by Flush().
+BENCHMARK_FUNC(LogThreadsBuffered)
+{
+    NoOpLog log;
+    return LogFromThreads(&log);
+}
+
+// Each thread uses its own buffer and the messages are passed to the target
+// by a background thread.
+BENCHMARK_FUNC(LogThreadsAsync)
+{
+    wxLogAsync log(new NoOpLog, wxLOG_ASYNC_BLOCK);
+    return LogFromThreads(&log);
+}
+
+#endif // wxUSE_THREADS
@@ -12,6 +12,9 @@
 
 #include "bench.h"
 
+#include <string>
+#include <vector>
+
 namespace
 {
 
@@ -76,3 +79,95 @@ BENCHMARK_FUNC(UTF16Sys)
     return ConvertToMB(wxCSConv("UTF-16LE"));
 }
 
+
+// ----------------------------------------------------------------------------
+// UTF-8 benchmarks
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// minimal size of the UTF-8 strings used for the benchmarks below
+const size_t UTF8_TEST_SIZE = 64*1024;
+
+// return a long ASCII string or a string with some non-ASCII characters
+const std::string& GetUTF8String(bool ascii)
+{
+    static std::string s_ascii, s_mixed;
+
+    std::string& s = ascii ? s_ascii : s_mixed;
+    if ( s.empty() )
+    {
+        const wxScopedCharBuffer
+            text = wxConvUTF8.cWC2MB(ascii ? TEST_STRING
+                                           : L"Lorem ipsum dolor sit amèt, "
+                                             L"лорем "
+                                             L"consectetur adipisicing élit, "
+                                             L"sed do € eiusmod tempor. ");
+        while ( s.size() < UTF8_TEST_SIZE )
+            s += text.data();
+    }
+
+    return s;
+}
+
+const wxWCharBuffer& GetWCharString(bool ascii)
+{
+    static wxWCharBuffer s_ascii, s_mixed;
+
+    wxWCharBuffer& s = ascii ? s_ascii : s_mixed;
+    if ( !s.length() )
+        s = wxConvUTF8.cMB2WC(GetUTF8String(ascii).c_str());
+
+    return s;
+}
+
+bool ConvertUTF8ToWC(bool ascii)
+{
+    const std::string& s = GetUTF8String(ascii);
+
+    // the output can't be longer than the input
+    static std::vector<wchar_t> s_buf;
+    s_buf.resize(s.size());
+    return wxConvUTF8.ToWChar(s_buf.data(), s_buf.size(),
+                              s.data(), s.size()) != wxCONV_FAILED;
+}
+
+bool ConvertWCToUTF8(bool ascii)
+{
+    const wxWCharBuffer& s = GetWCharString(ascii);
+
+    const size_t len = GetUTF8String(ascii).size();
+
+    static std::vector<char> s_buf;
+    s_buf.resize(len);
+    return wxConvUTF8.FromWChar(s_buf.data(), len, s.data(), s.length()) == len;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(UTF8ToWCASCII)
+{
+    return ConvertUTF8ToWC(true);
+}
+
+BENCHMARK_FUNC(UTF8ToWCMixed)
+{
+    return ConvertUTF8ToWC(false);
+}
+
+BENCHMARK_FUNC(UTF8LenWCASCII)
+{
+    const std::string& s = GetUTF8String(true);
+    return wxConvUTF8.ToWChar(nullptr, 0, s.data(), s.size()) == s.size();
+}
+
+BENCHMARK_FUNC(UTF8FromWCASCII)
+{
+    return ConvertWCToUTF8(true);
+}
+
+BENCHMARK_FUNC(UTF8FromWCMixed)
+{
+    return ConvertWCToUTF8(false);
+}
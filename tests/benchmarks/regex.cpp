@@ -23,6 +23,24 @@ BENCHMARK_FUNC(RECompile)
     return wxRegEx(RE_SIMPLE).IsValid();
 }
 
+BENCHMARK_FUNC(RECompileUncached)
+{
+    wxRegEx::SetCacheSize(0);
+    const bool ok = wxRegEx(RE_SIMPLE).IsValid();
+    wxRegEx::SetCacheSize(64);
+
+    return ok;
+}
+
+BENCHMARK_FUNC(RECompileUncachedNoJIT)
+{
+    wxRegEx::SetCacheSize(0);
+    const bool ok = wxRegEx(RE_SIMPLE, wxRE_NOJIT).IsValid();
+    wxRegEx::SetCacheSize(64);
+
+    return ok;
+}
+
 BENCHMARK_FUNC(REMatch)
 {
     static wxRegEx re(RE_SIMPLE);
@@ -70,5 +88,68 @@ BENCHMARK_FUNC(REFindTD)
         p += start + len;
     }
 
-    return matches == 21; // result of "grep -c"
+    // This is the result of "grep -c" plus one for the match spanning two
+    // lines, as "[^<]" matches new lines too when using PCRE.
+    return matches == 22;
+}
+
+namespace
+{
+
+// Find all matches in the given text without converting it to wxString.
+int CountMatches(const wxRegEx& re, const wxString& text)
+{
+    const wxChar* p = text.wc_str();
+    size_t remaining = text.length();
+
+    int matches = 0;
+    for ( ; re.Matches(p, 0, remaining); ++matches )
+    {
+        size_t start, len;
+        if ( !re.GetMatch(&start, &len) )
+            return -1;
+
+        p += start + len;
+        remaining -= start + len;
+    }
+
+    return matches;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(REFindTDLen)
+{
+    static wxRegEx re("<td>[^<]*</td>", wxRE_ICASE | wxRE_NEWLINE);
+
+    return CountMatches(re, GetTestText()) == 22;
+}
+
+BENCHMARK_FUNC(REFindTDNoJIT)
+{
+    static wxRegEx re("<td>[^<]*</td>", wxRE_ICASE | wxRE_NEWLINE | wxRE_NOJIT);
+
+    return CountMatches(re, GetTestText()) == 22;
+}
+
+BENCHMARK_FUNC(REFindTDUTF8)
+{
+    static wxRegEx re("<td>[^<]*</td>", wxRE_ICASE | wxRE_NEWLINE);
+    static const wxScopedCharBuffer text = GetTestText().utf8_str();
+
+    const char* p = text.data();
+    size_t remaining = text.length();
+
+    int matches = 0;
+    for ( ; re.MatchesUTF8(p, remaining); ++matches )
+    {
+        size_t start, len;
+        if ( !re.GetMatch(&start, &len) )
+            return false;
+
+        p += start + len;
+        remaining -= start + len;
+    }
+
+    return matches == 22;
 }
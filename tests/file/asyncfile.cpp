@@ -0,0 +1,311 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/file/asyncfile.cpp
+// Purpose:     wxAsyncFile unit test
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+
+#if wxUSE_FILE && wxUSE_THREADS
+
+#include "wx/asyncfile.h"
+#include "wx/evtloop.h"
+#include "wx/module.h"
+#include "wx/timer.h"
+
+#include "testfile.h"
+
+#include <map>
+#include <memory>
+
+namespace
+{
+
+// Event handler collecting all wxEVT_ASYNC_FILE events and optionally exiting
+// the active event loop once the expected number of them is received.
+class AsyncFileHandler : public wxEvtHandler
+{
+public:
+    explicit AsyncFileHandler(size_t expected = 0)
+        : m_expected(expected)
+    {
+        Bind(wxEVT_ASYNC_FILE, &AsyncFileHandler::OnEvent, this);
+    }
+
+    // Process the events already queued for this handler.
+    void ProcessQueued()
+    {
+        wxTheApp->ProcessPendingEvents();
+    }
+
+    const wxAsyncFileEvent& Get(long request) const
+    {
+        const auto it = m_events.find(request);
+        REQUIRE( it != m_events.end() );
+        return *it->second;
+    }
+
+    size_t GetCount() const { return m_events.size(); }
+
+private:
+    void OnEvent(wxAsyncFileEvent& event)
+    {
+        CHECK( m_events.count(event.GetRequest()) == 0 );
+
+        m_events[event.GetRequest()].reset(
+            static_cast<wxAsyncFileEvent*>(event.Clone()));
+
+        if ( m_events.size() == m_expected )
+            wxEventLoopBase::GetActive()->ScheduleExit();
+    }
+
+    const size_t m_expected;
+    std::map<long, std::unique_ptr<wxAsyncFileEvent>> m_events;
+};
+
+std::string MakeData(size_t size)
+{
+    std::string data(size, '\0');
+    for ( size_t n = 0; n < size; n++ )
+        data[n] = static_cast<char>('a' + n % 23);
+
+    return data;
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests implementation
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxAsyncFile::ReadWrite", "[file][async]")
+{
+    TestFile tf;
+
+    const std::string data = MakeData(100000);
+    const size_t chunkSize = 10000;
+    const size_t numChunks = data.size() / chunkSize;
+
+    AsyncFileHandler handler;
+
+    {
+        wxAsyncFile file(tf.GetName(), wxFile::write, &handler, 17);
+        REQUIRE( file.IsOpened() );
+
+        // Write the chunks in reverse order to check that the offsets are
+        // respected.
+        std::vector<long> requests;
+        for ( size_t n = numChunks; n > 0; n-- )
+        {
+            const size_t offset = (n - 1) * chunkSize;
+            requests.push_back(file.Write(offset, &data[offset], chunkSize));
+            CHECK( requests.back() > 0 );
+        }
+
+        file.Wait();
+        CHECK( file.GetPendingCount() == 0 );
+
+        handler.ProcessQueued();
+        REQUIRE( handler.GetCount() == numChunks );
+
+        for ( long request : requests )
+        {
+            const wxAsyncFileEvent& event = handler.Get(request);
+            CHECK( event.GetId() == 17 );
+            CHECK( event.GetOperation() == wxASYNC_FILE_WRITE );
+            CHECK( event.IsOk() );
+            CHECK( event.GetCount() == chunkSize );
+        }
+    }
+
+    wxFile fin(tf.GetName());
+    wxString contents;
+    REQUIRE( fin.ReadAll(&contents, wxConvISO8859_1) );
+    CHECK( contents.ToStdString(wxConvISO8859_1) == data );
+
+    AsyncFileHandler handler2;
+    wxAsyncFile file(tf.GetName(), wxFile::read, &handler2);
+    REQUIRE( file.IsOpened() );
+
+    const long reqMiddle = file.Read(12345, 1000);
+    const long reqEnd = file.Read(data.size() - 10, 100);
+    const long reqPastEnd = file.Read(data.size() + 10, 100);
+    file.Wait();
+
+    handler2.ProcessQueued();
+    REQUIRE( handler2.GetCount() == 3 );
+
+    const wxAsyncFileEvent& middle = handler2.Get(reqMiddle);
+    CHECK( middle.GetOperation() == wxASYNC_FILE_READ );
+    CHECK( middle.IsOk() );
+    CHECK( middle.GetOffset() == 12345 );
+    CHECK( middle.GetSize() == 1000 );
+    REQUIRE( middle.GetCount() == 1000 );
+    CHECK( memcmp(middle.GetData().GetData(), &data[12345], 1000) == 0 );
+
+    const wxAsyncFileEvent& end = handler2.Get(reqEnd);
+    CHECK( end.IsOk() );
+    REQUIRE( end.GetCount() == 10 );
+    CHECK( end.GetData().GetDataLen() == 10 );
+    CHECK( memcmp(end.GetData().GetData(), &data[data.size() - 10], 10) == 0 );
+
+    const wxAsyncFileEvent& pastEnd = handler2.Get(reqPastEnd);
+    CHECK( pastEnd.IsOk() );
+    CHECK( pastEnd.GetCount() == 0 );
+}
+
+TEST_CASE("wxAsyncFile::Error", "[file][async]")
+{
+    TestFile tf;
+
+    AsyncFileHandler handler;
+    wxAsyncFile file(tf.GetName(), wxFile::read, &handler);
+    REQUIRE( file.IsOpened() );
+
+    const char buf[] = "data";
+    const long request = file.Write(0, buf, sizeof(buf));
+    file.Wait();
+
+    handler.ProcessQueued();
+    REQUIRE( handler.GetCount() == 1 );
+
+    const wxAsyncFileEvent& event = handler.Get(request);
+    CHECK( !event.IsOk() );
+    CHECK( !event.WasCancelled() );
+    CHECK( event.GetErrorCode() != 0 );
+    CHECK( event.GetCount() == 0 );
+}
+
+TEST_CASE("wxAsyncFile::Cancel", "[file][async]")
+{
+    TestFile tf;
+
+    const std::string data = MakeData(1000);
+    {
+        wxFile fout(tf.GetName(), wxFile::write);
+        REQUIRE( fout.Write(data.data(), data.size()) == data.size() );
+    }
+
+    const unsigned maxThreadsOrig = wxAsyncFile::GetMaxThreads();
+    wxAsyncFile::SetMaxThreads(1);
+
+    AsyncFileHandler handler;
+    wxAsyncFile file(tf.GetName(), wxFile::read, &handler);
+    REQUIRE( file.IsOpened() );
+
+    const size_t count = 200;
+    std::vector<long> requests;
+    for ( size_t n = 0; n < count; n++ )
+        requests.push_back(file.Read(n, 100));
+
+    // We can't know which requests are still pending, but each of them must
+    // result in exactly one event, either cancelled or successful.
+    std::map<long, bool> cancelled;
+    cancelled[requests.back()] = file.Cancel(requests.back());
+    file.CancelAll();
+    file.Wait();
+
+    wxAsyncFile::SetMaxThreads(maxThreadsOrig);
+
+    handler.ProcessQueued();
+    REQUIRE( handler.GetCount() == count );
+
+    for ( long request : requests )
+    {
+        const wxAsyncFileEvent& event = handler.Get(request);
+        if ( event.WasCancelled() )
+        {
+            CHECK( !event.IsOk() );
+            CHECK( event.GetCount() == 0 );
+        }
+        else
+        {
+            CHECK( event.IsOk() );
+            CHECK( event.GetCount() == 100 );
+        }
+    }
+
+    if ( cancelled[requests.back()] )
+        CHECK( handler.Get(requests.back()).WasCancelled() );
+}
+
+TEST_CASE("wxAsyncFile::Shutdown", "[file][async]")
+{
+    TestFile tf;
+
+    // Simulate the library shutdown by using the module stopping the threads
+    // directly.
+    std::unique_ptr<wxModule>
+        module(wxDynamicCast(wxCreateDynamicObject("wxAsyncFileModule"), wxModule));
+    REQUIRE( module );
+
+    AsyncFileHandler handler;
+    wxAsyncFile file(tf.GetName(), wxFile::read_write, &handler);
+    REQUIRE( file.IsOpened() );
+
+    module->OnExit();
+
+    // Using the file after shutdown must not start any new threads.
+    CHECK( file.Write(0, "data", 4) == 0 );
+    CHECK( !file.Cancel(1) );
+    file.CancelAll();
+    CHECK( file.GetPendingCount() == 0 );
+
+    // But it must work again after the library is initialized again.
+    REQUIRE( module->OnInit() );
+
+    const long request = file.Write(0, "data", 4);
+    CHECK( request != 0 );
+    file.Wait();
+
+    handler.ProcessQueued();
+    CHECK( handler.Get(request).IsOk() );
+    CHECK( file.Close() );
+}
+
+TEST_CASE("wxAsyncFile::EventLoop", "[file][async]")
+{
+    TestFile tf;
+
+    const std::string data = MakeData(4096);
+    {
+        wxFile fout(tf.GetName(), wxFile::write);
+        REQUIRE( fout.Write(data.data(), data.size()) == data.size() );
+    }
+
+    const size_t count = 8;
+    AsyncFileHandler handler(count);
+    wxAsyncFile file(tf.GetName(), wxFile::read, &handler);
+    REQUIRE( file.IsOpened() );
+
+    wxEventLoop loop;
+
+    // Don't wait forever if the events are never received.
+    wxTimer timer;
+    timer.Bind(wxEVT_TIMER, [&loop](wxTimerEvent&) { loop.ScheduleExit(1); });
+    timer.StartOnce(10000);
+
+    std::vector<long> requests;
+    for ( size_t n = 0; n < count; n++ )
+        requests.push_back(file.Read(n * 512, 512));
+
+    // The loop must be woken up by the completion events and exit once all of
+    // them are processed by the handler.
+    REQUIRE( loop.Run() == 0 );
+
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const wxAsyncFileEvent& event = handler.Get(requests[n]);
+        CHECK( event.IsOk() );
+        REQUIRE( event.GetCount() == 512 );
+        CHECK( memcmp(event.GetData().GetData(), &data[n * 512], 512) == 0 );
+    }
+}
+
+#endif // wxUSE_FILE && wxUSE_THREADS
@@ -21,9 +21,15 @@
 
 #if wxUSE_FILESYSTEM
 
+#include "wx/fs_arc.h"
 #include "wx/fs_data.h"
+#include "wx/fs_filter.h"
 #include "wx/fs_mem.h"
+#include "wx/mstream.h"
 #include "wx/sstream.h"
+#include "wx/tarstrm.h"
+#include "wx/zipstrm.h"
+#include "wx/zstream.h"
 
 #include <memory>
 
@@ -272,4 +278,201 @@ TEST_CASE("wxFileSystem::MemoryFSHandler", "[filesys][memoryfshandler][find]")
     CHECK( fs.FindNext() == "" );
 }
 
+#if wxUSE_FS_ARCHIVE && wxUSE_ZIPSTREAM
+
+TEST_CASE("wxFileSystem::ArchiveFSHandler", "[filesys][archivefshandler]")
+{
+    // Install wxMemoryFSHandler and wxArchiveFSHandler for this test only.
+    class AutoArchiveFSHandlers
+    {
+    public:
+        AutoArchiveFSHandlers()
+            : m_memoryHandler(new wxMemoryFSHandler()),
+              m_archiveHandler(new wxArchiveFSHandler())
+        {
+            wxFileSystem::AddHandler(m_memoryHandler.get());
+            wxFileSystem::AddHandler(m_archiveHandler.get());
+        }
+
+        ~AutoArchiveFSHandlers()
+        {
+            wxFileSystem::RemoveHandler(m_archiveHandler.get());
+            wxFileSystem::RemoveHandler(m_memoryHandler.get());
+        }
+
+    private:
+        std::unique_ptr<wxMemoryFSHandler> const m_memoryHandler;
+        std::unique_ptr<wxArchiveFSHandler> const m_archiveHandler;
+    } autoArchiveFSHandlers;
+
+    wxMemoryOutputStream mem;
+    {
+        wxZipOutputStream zip(mem);
+        zip.PutNextEntry("index.html");
+        zip.Write("index", 5);
+        zip.PutNextEntry("docs/a.html");
+        zip.Write("first", 5);
+        zip.PutNextEntry("docs/b.txt");
+        zip.Write("second", 6);
+        zip.PutNextEntry("docs/sub/c.html");
+        zip.Write("third", 5);
+        zip.PutNextDirEntry("empty");
+        REQUIRE( zip.Close() );
+    }
+
+    const wxStreamBuffer* const buf = mem.GetOutputStreamBuffer();
+    wxMemoryFSHandler::AddFile("test.zip", buf->GetBufferStart(),
+                               buf->GetBufferSize());
+
+    const size_t maxSize = wxArchiveFSHandler::GetCacheMaxSize();
+    wxArchiveFSHandler::ClearCache();
+
+    wxFileSystem fs;
+
+    const auto readFile = [&fs](const wxString& location)
+    {
+        std::unique_ptr<wxFSFile> file(fs.OpenFile(location));
+        if ( !file )
+            return wxString("<not found>");
+
+        wxStringOutputStream out;
+        file->GetStream()->Read(out);
+        return out.GetString();
+    };
+
+    SECTION("OpenFile")
+    {
+        CHECK( readFile("memory:test.zip#zip:docs/a.html") == "first" );
+
+        wxArchiveFSCacheStats stats = wxArchiveFSHandler::GetCacheStats();
+        CHECK( stats.archives == 1 );
+        CHECK( stats.entries == 5 );
+        CHECK( stats.lookups == 1 );
+        CHECK( stats.misses == 1 );
+        CHECK( stats.cachedFiles == 1 );
+        CHECK( stats.cachedBytes == 5 );
+
+        // The second time the cached contents should be used.
+        CHECK( readFile("memory:test.zip#zip:docs/a.html") == "first" );
+        CHECK( readFile("memory:test.zip#zip:docs/../index.html") == "index" );
+        CHECK( readFile("memory:test.zip#zip:docs/missing.html") == "<not found>" );
+
+        stats = wxArchiveFSHandler::GetCacheStats();
+        CHECK( stats.archives == 1 );
+        CHECK( stats.lookups == 4 );
+        CHECK( stats.lookupFailures == 1 );
+        CHECK( stats.hits == 1 );
+        CHECK( stats.misses == 2 );
+        CHECK( stats.cachedFiles == 2 );
+    }
+
+    SECTION("Eviction")
+    {
+        // Only files using at most a quarter of the cache are kept in it.
+        wxArchiveFSHandler::SetCacheMaxSize(20);
+
+        CHECK( readFile("memory:test.zip#zip:index.html") == "index" );
+        CHECK( readFile("memory:test.zip#zip:docs/a.html") == "first" );
+        CHECK( readFile("memory:test.zip#zip:docs/b.txt") == "second" );
+
+        wxArchiveFSCacheStats stats = wxArchiveFSHandler::GetCacheStats();
+        CHECK( stats.cachedFiles == 2 );
+        CHECK( stats.cachedBytes == 10 );
+        CHECK( stats.evictions == 0 );
+
+        // Reducing the size evicts the least recently used files first.
+        CHECK( readFile("memory:test.zip#zip:index.html") == "index" );
+        wxArchiveFSHandler::SetCacheMaxSize(8);
+
+        stats = wxArchiveFSHandler::GetCacheStats();
+        CHECK( stats.cachedFiles == 1 );
+        CHECK( stats.evictions == 1 );
+        CHECK( readFile("memory:test.zip#zip:index.html") == "index" );
+        CHECK( wxArchiveFSHandler::GetCacheStats().hits == 2 );
+
+        wxArchiveFSHandler::SetCacheMaxSize(0);
+
+        stats = wxArchiveFSHandler::GetCacheStats();
+        CHECK( stats.cachedFiles == 0 );
+        CHECK( stats.evictions == 2 );
+
+        CHECK( readFile("memory:test.zip#zip:docs/a.html") == "first" );
+        CHECK( wxArchiveFSHandler::GetCacheStats().cachedFiles == 0 );
+    }
+
+    SECTION("Find")
+    {
+        CHECK( fs.FindFirst("memory:test.zip#zip:docs/*.html", wxFILE)
+                == "memory:test.zip#zip:docs/a.html" );
+        CHECK( fs.FindNext() == "" );
+
+        CHECK( fs.FindFirst("memory:test.zip#zip:*", wxDIR)
+                == "memory:test.zip#zip:/docs" );
+        CHECK( fs.FindNext() == "memory:test.zip#zip:/empty" );
+        CHECK( fs.FindNext() == "" );
+
+        CHECK( fs.FindFirst("memory:test.zip#zip:docs/*")
+                == "memory:test.zip#zip:docs/a.html" );
+        CHECK( fs.FindNext() == "memory:test.zip#zip:docs/b.txt" );
+        CHECK( fs.FindNext() == "memory:test.zip#zip:docs/sub" );
+        CHECK( fs.FindNext() == "" );
+    }
+
+#if wxUSE_TARSTREAM && wxUSE_ZLIB
+    SECTION("NonSeekable")
+    {
+        // Archives inside compressed files can't be seeked in and use a
+        // backing file, check that the files too big to be cached are still
+        // read correctly from it.
+        wxFilterFSHandler filterHandler;
+        wxFileSystem::AddHandler(&filterHandler);
+
+        wxString big;
+        for ( int n = 0; n < 1000; n++ )
+            big += wxString::Format("line %d\n", n);
+
+        wxMemoryOutputStream memTar;
+        {
+            wxZlibOutputStream gzip(memTar, wxZ_DEFAULT_COMPRESSION,
+                                    wxZLIB_GZIP);
+            wxTarOutputStream tar(gzip);
+            // The size must be specified as the output is not seekable.
+            tar.PutNextEntry("small.txt", wxDateTime::Now(), 5);
+            tar.Write("small", 5);
+            tar.PutNextEntry("big.txt", wxDateTime::Now(), big.length());
+            tar.Write(big.utf8_str(), big.length());
+            REQUIRE( tar.Close() );
+            REQUIRE( gzip.Close() );
+        }
+
+        const wxStreamBuffer* const bufTar = memTar.GetOutputStreamBuffer();
+        wxMemoryFSHandler::AddFile("test.tar.gz", bufTar->GetBufferStart(),
+                                   bufTar->GetBufferSize());
+
+        wxArchiveFSHandler::SetCacheMaxSize(100);
+
+        for ( int n = 0; n < 2; n++ )
+        {
+            CHECK( readFile("memory:test.tar.gz#gzip:#tar:big.txt") == big );
+            CHECK( readFile("memory:test.tar.gz#gzip:#tar:small.txt") == "small" );
+        }
+
+        const wxArchiveFSCacheStats stats = wxArchiveFSHandler::GetCacheStats();
+        CHECK( stats.archives == 1 );
+        CHECK( stats.cachedFiles == 1 );
+        CHECK( stats.cachedBytes == 5 );
+
+        wxArchiveFSHandler::ClearCache();
+        wxMemoryFSHandler::RemoveFile("test.tar.gz");
+        wxFileSystem::RemoveHandler(&filterHandler);
+    }
+#endif // wxUSE_TARSTREAM && wxUSE_ZLIB
+
+    wxArchiveFSHandler::ClearCache();
+    wxArchiveFSHandler::SetCacheMaxSize(maxSize);
+    wxMemoryFSHandler::RemoveFile("test.zip");
+}
+
+#endif // wxUSE_FS_ARCHIVE && wxUSE_ZIPSTREAM
+
 #endif // wxUSE_FILESYSTEM
@@ -20,10 +20,13 @@
 #endif // WX_PRECOMP
 
 #include "wx/anidecod.h" // wxImageArray
+#include "wx/gifdecod.h"
+#include "wx/imagbatch.h"
 #include "wx/bitmap.h"
 #include "wx/cursor.h"
 #include "wx/icon.h"
 #include "wx/palette.h"
+#include "wx/quantize.h"
 #include "wx/url.h"
 #include "wx/log.h"
 #include "wx/mstream.h"
@@ -42,6 +45,7 @@
 #endif
 
 #include "testimage.h"
+#include "testlog.h"
 
 #include <memory>
 
@@ -1097,6 +1101,64 @@ TEST_CASE_METHOD(ImageHandlersInit, "wxImage::PNGDescription", "[image]")
         + wxString(wxT('c'), 256));
 }
 
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::PNGCompression", "[image][png]")
+{
+    wxImage image("horse.png");
+    REQUIRE( image.IsOk() );
+
+    // Use an image big enough to be split into several blocks when using
+    // parallel compression.
+    image.Rescale(800, 800, wxIMAGE_QUALITY_BILINEAR);
+    SetAlpha(&image);
+
+    const int profiles[] =
+    {
+        wxPNG_COMPRESSION_DEFAULT,
+        wxPNG_COMPRESSION_FAST,
+        wxPNG_COMPRESSION_BALANCED,
+        wxPNG_COMPRESSION_SMALL,
+    };
+
+    wxImage::SetMaxThreads(4);
+
+    for ( int profile : profiles )
+    {
+        for ( int parallel = 0; parallel < 2; parallel++ )
+        {
+            INFO("Profile " << profile << ", parallel=" << parallel);
+
+            image.SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_PROFILE, profile);
+            image.SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_PARALLEL, parallel);
+
+            wxMemoryOutputStream memOut;
+            REQUIRE( image.SaveFile(memOut, wxBITMAP_TYPE_PNG) );
+
+            wxMemoryInputStream memIn(memOut);
+            wxImage actual;
+            REQUIRE( actual.LoadFile(memIn, wxBITMAP_TYPE_PNG) );
+
+            CHECK_THAT( actual, RGBASameAs(image) );
+        }
+    }
+
+    // Also check saving a palettised image with explicitly specified filter.
+    wxImage grey = image.ConvertToGreyscale();
+    grey.ClearAlpha();
+    grey.SetOption(wxIMAGE_OPTION_PNG_FORMAT, wxPNG_TYPE_PALETTE);
+    grey.SetOption(wxIMAGE_OPTION_PNG_FILTER, 2 /* PNG_FILTER_VALUE_UP */);
+    grey.SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_PARALLEL, 1);
+
+    wxMemoryOutputStream memOut;
+    REQUIRE( grey.SaveFile(memOut, wxBITMAP_TYPE_PNG) );
+
+    wxMemoryInputStream memIn(memOut);
+    wxImage actual;
+    REQUIRE( actual.LoadFile(memIn, wxBITMAP_TYPE_PNG) );
+    CHECK_THAT( actual, RGBSameAs(grey) );
+
+    wxImage::SetMaxThreads(1);
+}
+
 #if wxUSE_LIBTIFF
 static void TestTIFFImage(const wxString& option, int value,
     const wxImage *compareImage = nullptr)
@@ -1302,6 +1364,72 @@ TEST_CASE_METHOD(ImageHandlersInit, "wxImage::GIFComment", "[image]")
 #endif //wxUSE_PALETTE
 }
 
+TEST_CASE_METHOD(ImageHandlersInit, "wxGIFDecoder::Frames", "[image][gif]")
+{
+#if wxUSE_PALETTE
+    wxImage image("horse.gif");
+    REQUIRE( image.IsOk() );
+
+    wxImageArray images;
+    images.push_back(image);
+    for ( int i = 1; i < 3; ++i )
+    {
+        images.push_back(images[i-1].Rotate90());
+        images[i].SetPalette(images[0].GetPalette());
+    }
+
+    wxMemoryOutputStream memOut;
+    REQUIRE( wxGIFHandler().SaveAnimation(images, &memOut) );
+
+    wxMemoryInputStream memIn(memOut);
+    wxGIFDecoder decoder;
+    REQUIRE( decoder.LoadGIF(memIn) == wxGIF_OK );
+    REQUIRE( decoder.GetFrameCount() == 3 );
+
+    // Frames are decoded on demand, check that this works in any order and
+    // when decoding the same frame more than once.
+    const unsigned int order[] = { 2, 0, 1, 2 };
+    for ( unsigned int n : order )
+    {
+        wxINFO_FMT("Decoding GIF frame %u", n);
+
+        wxImage frame;
+        REQUIRE( decoder.ConvertToImage(n, &frame) );
+        CHECK_THAT( frame, RGBSameAs(images[n]) );
+    }
+
+    // Also check that the raw data returned by GetData() is the same, this
+    // only keeps the last used frame, so check switching between them too.
+    const unsigned int dataOrder[] = { 1, 2, 1 };
+    for ( unsigned int n : dataOrder )
+    {
+        wxINFO_FMT("Getting data of GIF frame %u", n);
+
+        const unsigned char* const pal = decoder.GetPalette(n);
+        const unsigned char* const data = decoder.GetData(n);
+        REQUIRE( data );
+        CHECK( decoder.GetData(n) == data );
+
+        const unsigned char* const rgb = images[n].GetData();
+        const int count = images[n].GetWidth()*images[n].GetHeight();
+        for ( int i = 0; i < count; ++i )
+        {
+            if ( memcmp(pal + 3*data[i], rgb + 3*i, 3) != 0 )
+            {
+                FAIL_CHECK("Pixel " << i << " differs");
+                break;
+            }
+        }
+
+        // Converting the frame to image should use the data of the frame
+        // returned by GetData() and still work.
+        wxImage frame;
+        REQUIRE( decoder.ConvertToImage(n, &frame) );
+        CHECK_THAT( frame, RGBSameAs(images[n]) );
+    }
+#endif // wxUSE_PALETTE
+}
+
 TEST_CASE_METHOD(ImageHandlersInit, "wxImage::BadGIF", "[image][gif][error]")
 {
     wxImage image("image/bad_truncated.gif");
@@ -2503,6 +2631,434 @@ TEST_CASE("wxImage::SizeLimits", "[image]")
 #endif // SIZEOF_VOID_P == 8
 }
 
+TEST_CASE("wxImage::Blur", "[image][blur]")
+{
+    // Use an image with a single white pixel in the middle of a black one.
+    wxImage image(51, 31);
+    image.InitAlpha();
+    memset(image.GetAlpha(), 0, 51*31);
+    image.SetRGB(25, 15, 0xff, 0xff, 0xff);
+    image.SetAlpha(25, 15, 0xff);
+
+    SECTION("Box")
+    {
+        const wxImage blurred = image.Blur(1);
+        CHECK_THAT( blurred,
+                    RGBASameAs(image.BlurHorizontal(1).BlurVertical(1)) );
+
+        // The value must be spread uniformly over 3x3 square.
+        CHECK( blurred.GetRed(24, 14) == 0xff/9 );
+        CHECK( blurred.GetRed(26, 16) == 0xff/9 );
+        CHECK( blurred.GetAlpha(25, 15) == 0xff/9 );
+        CHECK( blurred.GetRed(27, 15) == 0 );
+
+        // Using radius bigger than the image size must work too.
+        CHECK( image.Blur(100).IsOk() );
+    }
+
+    SECTION("Gaussian")
+    {
+        CHECK_THAT( image.GaussianBlur(0), RGBASameAs(image) );
+
+        const wxImage blurred = image.GaussianBlur(1.5);
+        const int center = blurred.GetRed(25, 15);
+        CHECK( center > 0 );
+        CHECK( center < 0xff );
+        CHECK( blurred.GetAlpha(25, 15) == center );
+
+        // The result must be symmetric and decreasing away from the centre.
+        CHECK( blurred.GetRed(23, 15) == blurred.GetRed(27, 15) );
+        CHECK( blurred.GetRed(25, 13) == blurred.GetRed(25, 17) );
+        CHECK( blurred.GetRed(23, 15) < center );
+        CHECK( blurred.GetRed(0, 0) == 0 );
+
+        // Uniform image must remain unchanged.
+        wxImage uniform(20, 10);
+        uniform.SetRGB(wxRect(0, 0, 20, 10), 10, 20, 30);
+        CHECK_THAT( uniform.GaussianBlur(5), RGBSameAs(uniform) );
+    }
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::MaxThreads", "[image][threads]")
+{
+    wxImage image("horse.png");
+    REQUIRE( image.IsOk() );
+
+    // Use an image big enough to be processed by multiple threads.
+    image.Rescale(1000, 1000);
+    image.InitAlpha();
+
+    struct Results
+    {
+        wxImage box,
+                bilinear,
+                bicubic,
+                blur,
+                rotate,
+                grey,
+                hue;
+    };
+
+    const auto process = [&image]()
+    {
+        Results r;
+        r.box = image.Scale(300, 200, wxIMAGE_QUALITY_BOX_AVERAGE);
+        r.bilinear = image.Scale(700, 900, wxIMAGE_QUALITY_BILINEAR);
+        r.bicubic = image.Scale(1200, 800, wxIMAGE_QUALITY_BICUBIC);
+        r.blur = image.Blur(5);
+        r.rotate = image.Rotate(0.5, wxPoint(100, 100));
+        r.grey = image.ConvertToGreyscale();
+        r.hue = image.Copy();
+        r.hue.RotateHue(0.25);
+        return r;
+    };
+
+    CHECK( wxImage::GetMaxThreads() == 1 );
+    const Results serial = process();
+
+    wxImage::SetMaxThreads(4);
+    const Results parallel = process();
+    wxImage::SetMaxThreads(1);
+
+    CHECK_THAT( parallel.box, RGBASameAs(serial.box) );
+    CHECK_THAT( parallel.bilinear, RGBASameAs(serial.bilinear) );
+    CHECK_THAT( parallel.bicubic, RGBASameAs(serial.bicubic) );
+    CHECK_THAT( parallel.blur, RGBASameAs(serial.blur) );
+    CHECK_THAT( parallel.rotate, RGBASameAs(serial.rotate) );
+    CHECK_THAT( parallel.grey, RGBASameAs(serial.grey) );
+    CHECK_THAT( parallel.hue, RGBASameAs(serial.hue) );
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxQuantize", "[image][quantize]")
+{
+    wxImage image("horse.png");
+    REQUIRE( image.IsOk() );
+
+    // Use an image big enough to be processed by multiple threads.
+    image.Rescale(600, 600, wxIMAGE_QUALITY_BILINEAR);
+
+    const int modes[] =
+    {
+        0,
+        wxQUANTIZE_NO_DITHER,
+        wxQUANTIZE_ORDERED_DITHER,
+    };
+
+    for ( int mode : modes )
+    {
+        INFO("Mode " << mode);
+
+        wxImage serial;
+        REQUIRE( wxQuantize::Quantize(image, serial, nullptr, 16, nullptr,
+                                      wxQUANTIZE_FILL_DESTINATION_IMAGE | mode) );
+        CHECK( serial.GetSize() == image.GetSize() );
+        CHECK( serial.CountColours() <= 16 );
+
+        wxImage::SetMaxThreads(4);
+        wxImage parallel;
+        wxQuantize::Quantize(image, parallel, nullptr, 16, nullptr,
+                             wxQUANTIZE_FILL_DESTINATION_IMAGE | mode);
+        wxImage::SetMaxThreads(1);
+
+        CHECK_THAT( parallel, RGBSameAs(serial) );
+    }
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImageView", "[image][view]")
+{
+    wxImage image("horse.png");
+    REQUIRE( image.IsOk() );
+
+    image.InitAlpha();
+    const int width = image.GetWidth();
+    const int height = image.GetHeight();
+    for ( int y = 0; y < height; y++ )
+    {
+        for ( int x = 0; x < width; x++ )
+            image.SetAlpha(x, y, (x + 3*y) % 256);
+    }
+
+    // Create a BGRA buffer with padding at the end of each row.
+    const int stride = 4*width + 12;
+    wxVector<unsigned char> buffer(stride*height);
+    for ( int y = 0; y < height; y++ )
+    {
+        unsigned char* p = &buffer[y*stride];
+        for ( int x = 0; x < width; x++, p += 4 )
+        {
+            p[0] = image.GetBlue(x, y);
+            p[1] = image.GetGreen(x, y);
+            p[2] = image.GetRed(x, y);
+            p[3] = image.GetAlpha(x, y);
+        }
+    }
+
+    const wxImageView view(&buffer[0], width, height,
+                           wxIMAGE_PIXEL_FORMAT_BGRA, stride);
+    REQUIRE( view.IsOk() );
+    CHECK( view.HasAlpha() );
+
+    CHECK_THAT( view.ToImage(), RGBASameAs(image) );
+
+    CHECK_THAT( view.Scale(100, 70, wxIMAGE_QUALITY_NEAREST),
+                RGBASameAs(image.Scale(100, 70, wxIMAGE_QUALITY_NEAREST)) );
+    CHECK_THAT( view.Scale(100, 70, wxIMAGE_QUALITY_BOX_AVERAGE),
+                RGBASameAs(image.Scale(100, 70, wxIMAGE_QUALITY_BOX_AVERAGE)) );
+    CHECK_THAT( view.Scale(300, 200, wxIMAGE_QUALITY_BILINEAR),
+                RGBASameAs(image.Scale(300, 200, wxIMAGE_QUALITY_BILINEAR)) );
+    CHECK_THAT( view.Scale(300, 200, wxIMAGE_QUALITY_BICUBIC),
+                RGBASameAs(image.Scale(300, 200, wxIMAGE_QUALITY_BICUBIC)) );
+    CHECK_THAT( view.Scale(50, 40),
+                RGBASameAs(image.Scale(50, 40)) );
+
+    // Shrinking by an exact integer factor averages the pixels.
+    const wxRect rectShrink(0, 0, 60, 48);
+    const wxImageView viewShrink = view.GetSubView(rectShrink);
+    const wxImage imageShrink = image.GetSubImage(rectShrink);
+    CHECK_THAT( viewShrink.Scale(30, 24, wxIMAGE_QUALITY_NEAREST),
+                RGBASameAs(imageShrink.Scale(30, 24, wxIMAGE_QUALITY_NEAREST)) );
+    CHECK_THAT( viewShrink.Scale(20, 16, wxIMAGE_QUALITY_FAST),
+                RGBASameAs(imageShrink.Scale(20, 16, wxIMAGE_QUALITY_FAST)) );
+
+    CHECK_THAT( view.Rotate90(), RGBASameAs(image.Rotate90()) );
+    CHECK_THAT( view.Rotate90(false), RGBASameAs(image.Rotate90(false)) );
+    CHECK_THAT( view.Mirror(), RGBASameAs(image.Mirror()) );
+    CHECK_THAT( view.Mirror(false), RGBASameAs(image.Mirror(false)) );
+
+    const wxRect rect(10, 20, 30, 40);
+    CHECK_THAT( view.GetSubView(rect).ToImage(),
+                RGBASameAs(image.GetSubImage(rect)) );
+
+    // Check that using a separate alpha plane works too.
+    wxImageView viewRGB(image.GetData(), width, height,
+                        wxIMAGE_PIXEL_FORMAT_RGB);
+    CHECK( !viewRGB.HasAlpha() );
+    viewRGB.SetAlpha(image.GetAlpha());
+    CHECK( viewRGB.HasAlpha() );
+    CHECK_THAT( viewRGB.Scale(300, 200, wxIMAGE_QUALITY_BILINEAR),
+                RGBASameAs(image.Scale(300, 200, wxIMAGE_QUALITY_BILINEAR)) );
+
+#if wxUSE_LIBPNG
+    wxMemoryOutputStream mos;
+    REQUIRE( view.SaveFile(mos, wxBITMAP_TYPE_PNG) );
+
+    wxMemoryInputStream mis(mos);
+    wxImage saved;
+    REQUIRE( saved.LoadFile(mis, wxBITMAP_TYPE_PNG) );
+    CHECK_THAT( saved, RGBASameAs(image) );
+#endif // wxUSE_LIBPNG
+}
+
+#if wxUSE_LIBPNG && wxUSE_LIBJPEG
+
+namespace
+{
+
+// Reassembles the image from the rows passed to it.
+class ImageRowCollector : public wxImageRowConsumer
+{
+public:
+    explicit ImageRowCollector(int stopAfter = -1,
+                               const wxSize& maxSize = wxSize(0, 0))
+        : m_stopAfter(stopAfter),
+          m_maxSize(maxSize)
+    {
+    }
+
+    wxSize GetMaxSize() const override { return m_maxSize; }
+
+    bool OnImageStart(int width, int height, bool hasAlpha) override
+    {
+        m_image.Create(width, height, false);
+        if ( hasAlpha )
+            m_image.SetAlpha();
+        return true;
+    }
+
+    bool OnImageRow(int y,
+                    const unsigned char* rgb,
+                    const unsigned char* alpha) override
+    {
+        CHECK( y == m_rows );
+
+        const int width = m_image.GetWidth();
+        memcpy(m_image.GetData() + 3*width*y, rgb, 3*width);
+        if ( alpha )
+            memcpy(m_image.GetAlpha() + width*y, alpha, width);
+
+        return ++m_rows != m_stopAfter;
+    }
+
+    const wxImage& GetImage() const { return m_image; }
+    int GetRowCount() const { return m_rows; }
+
+private:
+    const int m_stopAfter;
+    const wxSize m_maxSize;
+    int m_rows = 0;
+    wxImage m_image;
+};
+
+} // anonymous namespace
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImageHandler::LoadRows", "[image][rows]")
+{
+    const struct
+    {
+        const char* file;
+        wxBitmapType type;
+    } testFiles[] =
+    {
+        { "horse.png",           wxBITMAP_TYPE_PNG  },
+        { "image/toucan.png",    wxBITMAP_TYPE_PNG  }, // interlaced
+        { "image/bitfields.bmp", wxBITMAP_TYPE_BMP  }, // not row by row
+        { "horse.jpg",           wxBITMAP_TYPE_JPEG },
+    };
+
+    for ( const auto& t : testFiles )
+    {
+        INFO("File: " << t.file);
+
+        wxImage image;
+        REQUIRE( image.LoadFile(t.file, t.type) );
+
+        wxImageHandler* const handler = wxImage::FindHandler(t.type);
+        REQUIRE( handler );
+
+        wxFileInputStream stream(t.file);
+        ImageRowCollector collector;
+        REQUIRE( handler->LoadRows(collector, stream) );
+        CHECK( collector.GetRowCount() == image.GetHeight() );
+
+        // LoadFile() doesn't create alpha channel if all pixels are opaque.
+        if ( image.HasAlpha() || !collector.GetImage().HasAlpha() )
+            CHECK_THAT( collector.GetImage(), RGBASameAs(image) );
+        else
+            CHECK_THAT( collector.GetImage(), RGBSameAs(image) );
+
+        // Check that loading can be stopped too.
+        wxFileInputStream stream2(t.file);
+        ImageRowCollector collectorStop(3);
+        CHECK( !handler->LoadRows(collectorStop, stream2) );
+        CHECK( collectorStop.GetRowCount() == 3 );
+    }
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::LoadMaxSize", "[image][jpeg]")
+{
+    // The JPEG handler reduces the 200*200 image by 4 while decoding it.
+    wxImage image;
+    image.SetOption(wxIMAGE_OPTION_MAX_WIDTH, 60);
+    REQUIRE( image.LoadFile("horse.jpg") );
+    CHECK( image.GetSize() == wxSize(50, 50) );
+    CHECK( image.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_WIDTH) == 200 );
+    CHECK( image.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_HEIGHT) == 200 );
+
+    // It can't reduce it by more than 8, so the rest is done by rescaling.
+    wxImage small;
+    small.SetOption(wxIMAGE_OPTION_MAX_HEIGHT, 20);
+    REQUIRE( small.LoadFile("horse.jpg") );
+    CHECK( small.GetSize() == wxSize(12, 12) );
+    CHECK( small.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_WIDTH) == 200 );
+
+    // Other handlers just rescale the full image.
+    wxImage png;
+    png.SetOption(wxIMAGE_OPTION_MAX_WIDTH, 60);
+    REQUIRE( png.LoadFile("horse.png") );
+    CHECK( png.GetSize() == wxSize(50, 50) );
+    CHECK( png.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_WIDTH) == 200 );
+
+    // The same reduction is done when loading the image row by row.
+    wxImageHandler* const handler = wxImage::FindHandler(wxBITMAP_TYPE_JPEG);
+    REQUIRE( handler );
+
+    wxFileInputStream stream("horse.jpg");
+    ImageRowCollector collector(-1, wxSize(60, 0));
+    REQUIRE( handler->LoadRows(collector, stream) );
+    CHECK( collector.GetRowCount() == 50 );
+    CHECK_THAT( collector.GetImage(), RGBSameAs(image) );
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImageBatchLoader", "[image][batch]")
+{
+    const wxImage jpeg("horse.jpg");
+    const wxImage png("horse.png");
+    REQUIRE( jpeg.IsOk() );
+    REQUIRE( png.IsOk() );
+
+    wxImageBatchLoader loader;
+    loader.SetMaxThreads(3);
+
+    static const int NUM_IMAGES = 20;
+    for ( int n = 0; n < NUM_IMAGES; n++ )
+    {
+        if ( n % 2 )
+            loader.Add(new wxFileInputStream("horse.png"), wxBITMAP_TYPE_PNG);
+        else
+            CHECK( loader.Add("horse.jpg") == static_cast<size_t>(n) );
+    }
+
+    REQUIRE( loader.GetCount() == NUM_IMAGES );
+    REQUIRE( loader.Load() );
+
+    for ( int n = 0; n < NUM_IMAGES; n++ )
+    {
+        INFO("Image #" << n);
+        CHECK( loader.IsLoaded(n) );
+        CHECK_THAT( loader.GetImage(n), RGBSameAs(n % 2 ? png : jpeg) );
+    }
+
+    // Check that options are used and failing to load doesn't prevent other
+    // images from being loaded.
+    loader.Clear();
+    loader.SetOption(wxIMAGE_OPTION_MAX_WIDTH, 50);
+    loader.Add("horse.jpg");
+    loader.Add("no-such-file.png");
+    loader.Add("horse.png");
+
+    CHECK( !loader.Load() );
+
+    CHECK( loader.GetImage(0).GetSize() == wxSize(50, 50) );
+    CHECK( !loader.IsLoaded(1) );
+    CHECK( !loader.GetImage(1).IsOk() );
+    CHECK( loader.GetImage(2).GetSize() == wxSize(50, 50) );
+    CHECK( loader.GetFileName(2) == "horse.png" );
+
+    // Check that loading again doesn't try to reload the image from the
+    // stream which failed to load, as it's not available any more.
+    loader.Clear();
+    static const char notAnImage[] = "this is not a PNG file";
+    loader.Add(new wxMemoryInputStream(notAnImage, sizeof(notAnImage)),
+               wxBITMAP_TYPE_PNG);
+    loader.Add("horse.png");
+
+    {
+        wxLogNull noLog;
+        CHECK( !loader.Load() );
+    }
+    CHECK( !loader.IsLoaded(0) );
+    CHECK( loader.IsLoaded(1) );
+
+    // Any attempt to load the image here would result in an error, use a
+    // single thread to ensure that it would be logged immediately.
+    loader.SetMaxThreads(1);
+    TestLog* const log = new TestLog;
+    wxLog* const logOld = wxLog::SetActiveTarget(log);
+    const bool logWasEnabled = wxLog::EnableLogging();
+
+    CHECK( !loader.Load() );
+    CHECK( log->GetLog(wxLOG_Error).empty() );
+
+    delete wxLog::SetActiveTarget(logOld);
+    wxLog::EnableLogging(logWasEnabled);
+
+    CHECK( !loader.IsLoaded(0) );
+    CHECK( !loader.GetImage(0).IsOk() );
+    CHECK( loader.IsLoaded(1) );
+}
+
+#endif // wxUSE_LIBPNG && wxUSE_LIBJPEG
+
 // This can be used to test loading an arbitrary image file by setting the
 // environment variable WX_TEST_IMAGE_PATH to point to it.
 TEST_CASE_METHOD(ImageHandlersInit, "wxImage::LoadPath", "[.]")
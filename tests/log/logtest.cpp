@@ -18,6 +18,9 @@
     #include "wx/filefn.h"
 #endif // WX_PRECOMP
 
+#include "wx/logasync.h"
+#include "wx/logbinary.h"
+#include "wx/mstream.h"
 #include "wx/scopeguard.h"
 
 #if wxUSE_LOG
@@ -33,6 +36,9 @@
 
 #include "testlog.h"
 
+#include <atomic>
+#include <vector>
+
 TEST_CASE_METHOD(LogTestCase, "wxLog::Functions", "[log]")
 {
     wxLogMessage("Message");
@@ -264,4 +270,437 @@ TEST_CASE("wxLog::WXTRACE", "[log][.]")
     wxLogTrace("logtest", "Ending test 1/4s later");
 }
 
+#if wxUSE_THREADS
+
+namespace
+{
+
+// Log target storing all the messages, it doesn't need to be thread-safe as
+// it's only used by wxLogAsync from one thread at a time.
+class AllMessagesLog : public wxLog
+{
+public:
+    AllMessagesLog() { }
+
+    const std::vector<wxString>& GetMessages() const { return m_messages; }
+
+protected:
+    virtual void DoLogRecord(wxLogLevel WXUNUSED(level),
+                             const wxString& msg,
+                             const wxLogRecordInfo& WXUNUSED(info)) override
+    {
+        m_messages.push_back(msg);
+    }
+
+private:
+    std::vector<wxString> m_messages;
+};
+
+// Log target blocking on the first message until Release() is called.
+class BlockingLog : public AllMessagesLog
+{
+public:
+    BlockingLog() : m_blocked(true) { }
+
+    bool WaitUntilBlocked() { return m_entered.WaitTimeout(10000) == wxSEMA_NO_ERROR; }
+    void Release() { m_release.Post(); }
+
+protected:
+    virtual void DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info) override
+    {
+        if ( m_blocked )
+        {
+            m_blocked = false;
+            m_entered.Post();
+            m_release.Wait();
+        }
+
+        AllMessagesLog::DoLogRecord(level, msg, info);
+    }
+
+private:
+    wxSemaphore m_entered,
+                m_release;
+    bool m_blocked;
+};
+
+class LogThread : public wxThread
+{
+public:
+    explicit LogThread(int n) : wxThread(wxTHREAD_JOINABLE), m_n(n) { }
+
+protected:
+    virtual void* Entry() override
+    {
+        for ( int i = 0; i < 100; i++ )
+            wxLogMessage("Thread %d message %d", m_n, i);
+
+        return nullptr;
+    }
+
+private:
+    const int m_n;
+};
+
+// Set the given log target as the active one during this object lifetime.
+class AsyncLogSetter
+{
+public:
+    explicit AsyncLogSetter(wxLogAsync* log)
+        : m_logOld(wxLog::SetActiveTarget(log)),
+          m_logWasEnabled(wxLog::EnableLogging())
+    {
+    }
+
+    ~AsyncLogSetter()
+    {
+        delete wxLog::SetActiveTarget(m_logOld);
+        wxLog::EnableLogging(m_logWasEnabled);
+    }
+
+private:
+    wxLog* const m_logOld;
+    const bool m_logWasEnabled;
+
+    wxDECLARE_NO_COPY_CLASS(AsyncLogSetter);
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxLogAsync::Threads", "[log][async]")
+{
+    AllMessagesLog* const target = new AllMessagesLog;
+    wxLogAsync* const log = new wxLogAsync(target, wxLOG_ASYNC_BLOCK, 16);
+    AsyncLogSetter setLog(log);
+
+    wxLogMessage("Main thread message");
+
+    LogThread* threads[4];
+    for ( int n = 0; n < 4; n++ )
+    {
+        threads[n] = new LogThread(n);
+        REQUIRE( threads[n]->Run() == wxTHREAD_NO_ERROR );
+    }
+
+    for ( LogThread* thread : threads )
+    {
+        thread->Wait();
+        delete thread;
+    }
+
+    wxLogSysError(17, "Error");
+
+    log->Flush();
+
+    CHECK( log->GetDroppedCount() == 0 );
+    CHECK( log->GetLoggedCount() == 402 );
+
+    const std::vector<wxString>& messages = target->GetMessages();
+    REQUIRE( messages.size() == 402 );
+
+    // The messages of each thread must be in order, but there is no order
+    // between the messages of different threads.
+    int next[4] = { 0 };
+    int numMain = 0;
+    for ( const wxString& msg : messages )
+    {
+        int n, i;
+        if ( wxSscanf(msg, "Thread %d message %d", &n, &i) == 2 )
+        {
+            REQUIRE( n >= 0 );
+            REQUIRE( n < 4 );
+            CHECK( i == next[n]++ );
+        }
+        else if ( msg == "Main thread message" )
+        {
+            CHECK( numMain++ == 0 );
+        }
+        else
+        {
+            // The system error message is added by wxLogAsync.
+            CHECK( msg.StartsWith("Error (error 17") );
+        }
+    }
+
+    for ( int n = 0; n < 4; n++ )
+        CHECK( next[n] == 100 );
+}
+
+TEST_CASE("wxLogAsync::Drop", "[log][async]")
+{
+    BlockingLog* const target = new BlockingLog;
+    wxLogAsync* const log = new wxLogAsync(target, wxLOG_ASYNC_DROP, 2);
+    AsyncLogSetter setLog(log);
+
+    wxLogMessage("First");
+    REQUIRE( target->WaitUntilBlocked() );
+
+    // The first message still occupies the buffer while it's being logged,
+    // so only the first of these messages fits into it.
+    for ( int i = 0; i < 10; i++ )
+        wxLogMessage("Message %d", i);
+
+    CHECK( log->GetDroppedCount() == 9 );
+
+    target->Release();
+    log->Flush();
+
+    CHECK( log->GetLoggedCount() == 2 );
+
+    const std::vector<wxString>& messages = target->GetMessages();
+    REQUIRE( messages.size() == 3 );
+    CHECK( messages[0] == "First" );
+
+    // The warning about the dropped messages may be logged before or after
+    // the message which was queued, depending on when the background thread
+    // notices it.
+    const int posMessage = messages[1] == "Message 0" ? 1 : 2;
+    CHECK( messages[posMessage] == "Message 0" );
+    CHECK( messages[3 - posMessage] == "9 log messages were dropped." );
+}
+
+TEST_CASE("wxLogAsync::ThreadExit", "[log][async]")
+{
+    SECTION("Dropped")
+    {
+        BlockingLog* const target = new BlockingLog;
+        wxLogAsync* const log = new wxLogAsync(target, wxLOG_ASYNC_DROP, 2);
+        AsyncLogSetter setLog(log);
+
+        wxLogMessage("First");
+        REQUIRE( target->WaitUntilBlocked() );
+
+        LogThread thread(0);
+        REQUIRE( thread.Run() == wxTHREAD_NO_ERROR );
+        thread.Wait();
+
+        CHECK( log->GetDroppedCount() == 98 );
+
+        target->Release();
+        log->Flush();
+
+        // The messages dropped by the thread must still be counted after its
+        // buffer is freed.
+        CHECK( log->GetDroppedCount() == 98 );
+        CHECK( log->GetLoggedCount() == 3 );
+        CHECK( target->GetMessages().size() == 4 );
+    }
+
+    SECTION("Many")
+    {
+        AllMessagesLog* const target = new AllMessagesLog;
+        wxLogAsync* const log = new wxLogAsync(target, wxLOG_ASYNC_BLOCK, 16);
+        AsyncLogSetter setLog(log);
+
+        for ( int n = 0; n < 50; n++ )
+        {
+            LogThread thread(n);
+            REQUIRE( thread.Run() == wxTHREAD_NO_ERROR );
+            thread.Wait();
+        }
+
+        log->Flush();
+
+        CHECK( log->GetDroppedCount() == 0 );
+        CHECK( log->GetLoggedCount() == 5000 );
+        CHECK( target->GetMessages().size() == 5000 );
+    }
+}
+
+namespace
+{
+
+// Thread logging messages until it is asked to stop.
+class LogUntilStoppedThread : public wxThread
+{
+public:
+    explicit LogUntilStoppedThread(const std::atomic<bool>& stop)
+        : wxThread(wxTHREAD_JOINABLE), m_stop(stop), m_count(0) { }
+
+    size_t GetCount() const { return m_count; }
+
+protected:
+    virtual void* Entry() override
+    {
+        while ( !m_stop )
+            wxLogMessage("Message %zu", m_count++);
+
+        return nullptr;
+    }
+
+private:
+    const std::atomic<bool>& m_stop;
+    size_t m_count;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxLogAsync::Replace", "[log][async]")
+{
+    wxLog* const logOld =
+        wxLog::SetActiveTarget(new wxLogAsync(new AllMessagesLog, wxLOG_ASYNC_BLOCK, 4));
+    const bool logWasEnabled = wxLog::EnableLogging();
+
+    std::atomic<bool> stop{false};
+    LogUntilStoppedThread* threads[4];
+    for ( auto& thread : threads )
+    {
+        thread = new LogUntilStoppedThread(stop);
+        REQUIRE( thread->Run() == wxTHREAD_NO_ERROR );
+    }
+
+    // The previous target must be safe to delete as soon as it's replaced,
+    // even if the other threads are logging to it right now.
+    size_t logged = 0;
+    for ( int n = 0; n < 50; n++ )
+    {
+        wxLogAsync* const logPrev = static_cast<wxLogAsync*>(
+            wxLog::SetActiveTarget(new wxLogAsync(new AllMessagesLog,
+                                                  wxLOG_ASYNC_BLOCK, 4)));
+        logPrev->Flush();
+        logged += logPrev->GetLoggedCount();
+        CHECK( logPrev->GetDroppedCount() == 0 );
+        delete logPrev;
+
+        wxMilliSleep(1);
+    }
+
+    stop = true;
+
+    size_t count = 0;
+    for ( LogUntilStoppedThread* thread : threads )
+    {
+        thread->Wait();
+        count += thread->GetCount();
+        delete thread;
+    }
+
+    wxLogAsync* const logLast =
+        static_cast<wxLogAsync*>(wxLog::SetActiveTarget(logOld));
+    logLast->Flush();
+    logged += logLast->GetLoggedCount();
+    delete logLast;
+
+    wxLog::EnableLogging(logWasEnabled);
+
+    // No messages must have been lost.
+    CHECK( logged == count );
+}
+
+#endif // wxUSE_THREADS
+
+#if wxUSE_STREAMS
+
+TEST_CASE("wxLogBinary::RoundTrip", "[log][binary]")
+{
+    // Use a small buffer to check that writing the records in several
+    // chunks works too.
+    const size_t bufferSize = GENERATE(16, 65536);
+    INFO("Buffer size: " << bufferSize);
+
+    const wxString unicodeMsg = wxString::FromUTF8("\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82");
+    const wxLongLong_t before = wxGetUTCTimeMillis().GetValue();
+
+    wxMemoryOutputStream out;
+    int line;
+    {
+        wxLogBinary log(&out, bufferSize);
+        wxLog* const logOld = wxLog::SetActiveTarget(&log);
+        const bool logWasEnabled = wxLog::EnableLogging();
+
+        line = __LINE__ + 1;
+        wxLogMessage("Hello %d", 17);
+        wxLogWarning("%s", unicodeMsg);
+        wxLogError("");
+        for ( int n = 0; n < 100; n++ )
+            wxLogMessage("Message %d", n);
+
+        wxLog::SetActiveTarget(logOld);
+        wxLog::EnableLogging(logWasEnabled);
+
+        CHECK( log.IsOk() );
+    }
+
+    const wxLongLong_t after = wxGetUTCTimeMillis().GetValue();
+
+    wxMemoryInputStream in(out);
+    wxLogBinaryReader reader(in);
+    REQUIRE( reader.IsOk() );
+    CHECK( reader.GetVersion() == wxLOG_BINARY_VERSION );
+
+    wxLogBinaryRecord record;
+    REQUIRE( reader.ReadRecord(record) );
+    CHECK( record.level == wxLOG_Message );
+    CHECK( record.msg == "Hello 17" );
+    CHECK( record.timestampMS >= before );
+    CHECK( record.timestampMS <= after );
+    CHECK( record.filename.EndsWith("logtest.cpp") );
+    CHECK( record.line == line );
+    CHECK( !record.func.empty() );
+    CHECK( record.component == "test" );
+#if wxUSE_THREADS
+    CHECK( record.threadId == static_cast<wxULongLong_t>(wxThread::GetCurrentId()) );
+#endif
+
+    REQUIRE( reader.ReadRecord(record) );
+    CHECK( record.level == wxLOG_Warning );
+    CHECK( record.msg == unicodeMsg );
+    CHECK( record.line == line + 1 );
+
+    REQUIRE( reader.ReadRecord(record) );
+    CHECK( record.level == wxLOG_Error );
+    CHECK( record.msg.empty() );
+
+    for ( int n = 0; n < 100; n++ )
+    {
+        REQUIRE( reader.ReadRecord(record) );
+        CHECK( record.msg == wxString::Format("Message %d", n) );
+        CHECK( record.component == "test" );
+    }
+
+    CHECK( !reader.ReadRecord(record) );
+    CHECK( reader.IsOk() );
+}
+
+TEST_CASE("wxLogBinary::Invalid", "[log][binary]")
+{
+    SECTION("Not a log")
+    {
+        const char data[] = "This is not a binary log";
+        wxMemoryInputStream in(data, sizeof(data));
+
+        wxLogBinaryReader reader(in);
+        CHECK( !reader.IsOk() );
+    }
+
+    SECTION("Truncated")
+    {
+        wxMemoryOutputStream out;
+        {
+            wxLogBinary log(&out);
+            wxLog* const logOld = wxLog::SetActiveTarget(&log);
+            const bool logWasEnabled = wxLog::EnableLogging();
+
+            wxLogMessage("Truncated message");
+
+            wxLog::SetActiveTarget(logOld);
+            wxLog::EnableLogging(logWasEnabled);
+        }
+
+        const wxStreamBuffer* const buf = out.GetOutputStreamBuffer();
+        wxMemoryInputStream in(buf->GetBufferStart(), buf->GetIntPosition() - 3);
+
+        wxLogBinaryReader reader(in);
+        REQUIRE( reader.IsOk() );
+
+        wxLogBinaryRecord record;
+        CHECK( !reader.ReadRecord(record) );
+        CHECK( !reader.IsOk() );
+    }
+}
+
+#endif // wxUSE_STREAMS
+
 #endif // wxUSE_LOG
@@ -1508,3 +1508,81 @@ TEST_CASE("wxMBConv::cMB2WC", "[mbconv][mb2wc]")
     CHECK( wxConvUTF7.cMB2WC(wxCharBuffer()).length() == 0 );
     CHECK( wxConvUTF7.cMB2WC("+AKM-").length() == 1 );
 }
+
+TEST_CASE("wxMBConv::UTF8ASCII", "[mbconv][utf8]")
+{
+    // Check that the conversions of strings consisting mostly of ASCII
+    // characters, which are handled in blocks, work correctly for all
+    // lengths and positions of a non-ASCII character in them.
+    for ( size_t len = 0; len < 70; len++ )
+    {
+        for ( size_t pos = 0; pos <= len; pos++ )
+        {
+            INFO("Length " << len << ", non-ASCII character at " << pos);
+
+            std::string utf8;
+            std::wstring wide;
+            for ( size_t n = 0; n < len; n++ )
+            {
+                if ( n == pos )
+                {
+                    utf8 += "\xc3\xa9";
+                    wide += L'\xe9';
+                }
+                else
+                {
+                    const char ch = static_cast<char>('0' + n % 64);
+                    utf8 += ch;
+                    wide += static_cast<wchar_t>(ch);
+                }
+            }
+
+            // Conversion to wchar_t.
+            CHECK( wxConvUTF8.ToWChar(nullptr, 0, utf8.c_str(), utf8.length())
+                    == wide.length() );
+            CHECK( wxConvUTF8.ToWChar(nullptr, 0, utf8.c_str())
+                    == wide.length() + 1 );
+
+            std::vector<wchar_t> wbuf(wide.length() + 1, L'x');
+            REQUIRE( wxConvUTF8.ToWChar(wbuf.data(), wbuf.size(),
+                                        utf8.c_str()) == wide.length() + 1 );
+            CHECK( std::wstring(wbuf.data()) == wide );
+
+            // Note that passing 0 as the buffer size means computing the
+            // length, so only test the too small buffers of positive size.
+            if ( wide.length() > 1 )
+            {
+                CHECK( wxConvUTF8.ToWChar(wbuf.data(), wide.length() - 1,
+                                          utf8.c_str(), utf8.length())
+                        == wxCONV_FAILED );
+            }
+
+            // Conversion from wchar_t.
+            CHECK( wxConvUTF8.FromWChar(nullptr, 0, wide.c_str(), wide.length())
+                    == utf8.length() );
+            CHECK( wxConvUTF8.FromWChar(nullptr, 0, wide.c_str())
+                    == utf8.length() + 1 );
+
+            std::vector<char> buf(utf8.length() + 1, 'x');
+            REQUIRE( wxConvUTF8.FromWChar(buf.data(), buf.size(),
+                                          wide.c_str()) == utf8.length() + 1 );
+            CHECK( std::string(buf.data()) == utf8 );
+
+            if ( utf8.length() > 1 )
+            {
+                CHECK( wxConvUTF8.FromWChar(buf.data(), utf8.length() - 1,
+                                            wide.c_str(), wide.length())
+                        == wxCONV_FAILED );
+            }
+
+            // Invalid UTF-8 must be detected whatever its position is.
+            if ( pos < len )
+            {
+                std::string invalid = utf8;
+                invalid[pos] = '\xff';
+                CHECK( wxConvUTF8.ToWChar(nullptr, 0, invalid.c_str(),
+                                          invalid.length()) == wxCONV_FAILED );
+            }
+        }
+    }
+}
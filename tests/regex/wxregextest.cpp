@@ -39,6 +39,7 @@ static wxString FlagStr(int flags)
             case wxRE_ICASE:    str += wxT(" | wxRE_ICASE"); break;
             case wxRE_NOSUB:    str += wxT(" | wxRE_NOSUB"); break;
             case wxRE_NEWLINE:  str += wxT(" | wxRE_NEWLINE"); break;
+            case wxRE_NOJIT:    str += wxT(" | wxRE_NOJIT"); break;
             case wxRE_NOTBOL:   str += wxT(" | wxRE_NOTBOL"); break;
             case wxRE_NOTEOL:   str += wxT(" | wxRE_NOTEOL"); break;
             default: wxFAIL; break;
@@ -134,6 +135,111 @@ TEST_CASE("wxRegEx::Match", "[regex][match]")
         "Fri Jul 13 18:37:52 CEST 2001\tFri\tJul\t13\t2001");
 }
 
+TEST_CASE("wxRegEx::MatchesLen", "[regex][match]")
+{
+    wxRegEx re("b+");
+    REQUIRE( re.IsValid() );
+
+    const wxString text("abbbc");
+
+    size_t start, len;
+    REQUIRE( re.Matches(text.wc_str(), 0, 3) );
+    REQUIRE( re.GetMatch(&start, &len) );
+    CHECK( start == 1 );
+    CHECK( len == 2 );
+
+    CHECK_FALSE( re.Matches(text.wc_str(), 0, 1) );
+}
+
+TEST_CASE("wxRegEx::MatchesUTF8", "[regex][match][unicode]")
+{
+    wxRegEx re("(\\w+)@(\\w+)");
+    REQUIRE( re.IsValid() );
+
+    // Cyrillic "AB", space, U+1F600, space and an ASCII address.
+    const char* const text = "\xd0\x90\xd0\x91 \xf0\x9f\x98\x80 user@host";
+
+    size_t start, len;
+    REQUIRE( re.MatchesUTF8(text, strlen(text)) );
+    REQUIRE( re.GetMatch(&start, &len) );
+    CHECK( start == 10 );
+    CHECK( len == 9 );
+    REQUIRE( re.GetMatch(&start, &len, 2) );
+    CHECK( start == 15 );
+    CHECK( len == 4 );
+
+    REQUIRE( re.Compile(wxString::FromUTF8("\xd0\x91+(.)")) );
+    REQUIRE( re.MatchesUTF8(text, strlen(text)) );
+    REQUIRE( re.GetMatch(&start, &len) );
+    CHECK( start == 2 );
+    CHECK( len == 3 );
+    REQUIRE( re.GetMatch(&start, &len, 1) );
+    CHECK( start == 4 );
+    CHECK( len == 1 );
+
+    // The text doesn't need to be NUL-terminated.
+    CHECK_FALSE( re.MatchesUTF8(text, 4) );
+
+    wxLogNull noLog;
+    CHECK_FALSE( re.MatchesUTF8("\xd0\x91\xff", 3) );
+}
+
+TEST_CASE("wxRegEx::NoJIT", "[regex][match]")
+{
+    CheckMatch("OoBa", "FoObAr", "oObA", wxRE_ICASE | wxRE_NOJIT);
+    CheckMatch("^[A-Z].*$", "AA\nbb\nCC", "CC", wxRE_NEWLINE | wxRE_NOJIT, wxRE_NOTBOL);
+}
+
+TEST_CASE("wxRegEx::JITStackLimit", "[regex][match]")
+{
+    // Matching this regex needs more stack space than the JIT code has by
+    // default, check that it still works.
+    wxRegEx re("^(a|b)*$");
+    REQUIRE( re.IsValid() );
+
+    CHECK( re.Matches(wxString('a', 100000)) );
+}
+
+TEST_CASE("wxRegEx::Cache", "[regex][cache]")
+{
+    // The same pattern compiled with different flags must not reuse the same
+    // compiled code.
+    wxRegEx re1("abc");
+    wxRegEx re2("abc", wxRE_ICASE);
+    REQUIRE( re1.IsValid() );
+    REQUIRE( re2.IsValid() );
+    CHECK_FALSE( re1.Matches("ABC") );
+    CHECK( re2.Matches("ABC") );
+
+    // The objects sharing the same compiled code still have their own matches.
+    wxRegEx re3("a(b+)c");
+    wxRegEx re4("a(b+)c");
+    REQUIRE( re3.Matches("abc") );
+    REQUIRE( re4.Matches("xabbbc") );
+
+    size_t start, len;
+    REQUIRE( re3.GetMatch(&start, &len, 1) );
+    CHECK( start == 1 );
+    CHECK( len == 1 );
+    REQUIRE( re4.GetMatch(&start, &len, 1) );
+    CHECK( start == 2 );
+    CHECK( len == 3 );
+
+    // The patterns removed from the cache can still be used.
+    wxRegEx::SetCacheSize(1);
+
+    wxRegEx re5("x+");
+    wxRegEx re6("y+");
+    CHECK( re5.Matches("xx") );
+    CHECK( re6.Matches("yy") );
+
+    wxRegEx::SetCacheSize(0);
+    CHECK( re5.Matches("xx") );
+    CHECK( wxRegEx("x+").Matches("xx") );
+
+    wxRegEx::SetCacheSize(64);
+}
+
 static void
 CheckReplace(const char* pattern,
              const char* original,
@@ -21,6 +21,7 @@
 
 #include "wx/datstrm.h"
 #include "wx/wfstream.h"
+#include "wx/mstream.h"
 #include "wx/math.h"
 
 #include "testfile.h"
@@ -42,30 +43,42 @@ private:
         CPPUNIT_TEST( LongLongRW );
         CPPUNIT_TEST( Int64RW );
         CPPUNIT_TEST( NaNRW );
+        CPPUNIT_TEST( ArrayRW );
         CPPUNIT_TEST( PseudoTest_UseBigEndian );
         CPPUNIT_TEST( FloatRW );
         CPPUNIT_TEST( DoubleRW );
+        CPPUNIT_TEST( ArrayRW );
         // Only test standard IEEE 754 formats if we're using IEEE extended
         // format by default, otherwise the tests above already covered them.
 #if wxUSE_APPLE_IEEE
         CPPUNIT_TEST( PseudoTest_UseIEEE754 );
         CPPUNIT_TEST( FloatRW );
         CPPUNIT_TEST( DoubleRW );
+        CPPUNIT_TEST( ArrayRW );
         // Also retest little endian version with standard formats.
         CPPUNIT_TEST( PseudoTest_UseLittleEndian );
         CPPUNIT_TEST( FloatRW );
         CPPUNIT_TEST( DoubleRW );
+        CPPUNIT_TEST( ArrayRW );
 #endif // wxUSE_APPLE_IEEE
     CPPUNIT_TEST_SUITE_END();
 
     wxFloat64 TestFloatRW(wxFloat64 fValue);
 
+    void SetupStream(wxDataStreamBase& stream) const;
+
     void FloatRW();
     void DoubleRW();
     void StringRW();
     void LongLongRW();
     void Int64RW();
     void NaNRW();
+    void ArrayRW();
+
+    template <typename T>
+    void DoArrayRW(const std::vector<T>& values,
+                   void (wxDataOutputStream::*writer)(const T*, size_t),
+                   void (wxDataInputStream::*reader)(T*, size_t));
 
     void PseudoTest_UseBigEndian() { ms_useBigEndianFormat = true; }
     void PseudoTest_UseLittleEndian() { ms_useBigEndianFormat = false; }
@@ -96,6 +109,17 @@ DataStreamTestCase::DataStreamTestCase()
 {
 }
 
+void DataStreamTestCase::SetupStream(wxDataStreamBase& stream) const
+{
+    if ( ms_useBigEndianFormat )
+        stream.BigEndianOrdered(true);
+
+#if wxUSE_APPLE_IEEE
+    if ( ms_useIEEE754 )
+        stream.UseBasicPrecisions();
+#endif // wxUSE_APPLE_IEEE
+}
+
 wxFloat64 DataStreamTestCase::TestFloatRW(wxFloat64 fValue)
 {
     TempFile f("mytext.dat");
@@ -297,4 +321,85 @@ void DataStreamTestCase::NaNRW()
     //TODO?
 }
 
+// Check that writing and reading the array at once produces the same results
+// as doing it element by element.
+template <typename T>
+void DataStreamTestCase::DoArrayRW(const std::vector<T>& values,
+                                   void (wxDataOutputStream::*writer)(const T*, size_t),
+                                   void (wxDataInputStream::*reader)(T*, size_t))
+{
+    const size_t count = values.size();
+
+    wxMemoryOutputStream bulkOut;
+    {
+        wxDataOutputStream out(bulkOut);
+        SetupStream(out);
+        (out.*writer)(&values[0], count);
+    }
+
+    wxMemoryOutputStream singleOut;
+    {
+        wxDataOutputStream out(singleOut);
+        SetupStream(out);
+        for ( size_t n = 0; n < count; n++ )
+            out << values[n];
+    }
+
+    const size_t len = static_cast<size_t>(bulkOut.GetLength());
+    CPPUNIT_ASSERT_EQUAL( bulkOut.GetLength(), singleOut.GetLength() );
+
+    std::vector<char> bulkData(len), singleData(len);
+    bulkOut.CopyTo(&bulkData[0], len);
+    singleOut.CopyTo(&singleData[0], len);
+    CPPUNIT_ASSERT( bulkData == singleData );
+
+    wxMemoryInputStream bulkIn(&bulkData[0], len);
+    wxDataInputStream in(bulkIn);
+    SetupStream(in);
+
+    std::vector<T> result(count);
+    (in.*reader)(&result[0], count);
+    CPPUNIT_ASSERT( result == values );
+    CPPUNIT_ASSERT_EQUAL( static_cast<wxFileOffset>(len), bulkIn.TellI() );
+
+    wxMemoryInputStream singleIn(&singleData[0], len);
+    wxDataInputStream in2(singleIn);
+    SetupStream(in2);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        T value;
+        in2 >> value;
+        CPPUNIT_ASSERT( value == values[n] );
+    }
+}
+
+void DataStreamTestCase::ArrayRW()
+{
+    // Use enough elements to need more than one internal chunk.
+    const size_t count = 3000;
+
+    std::vector<wxUint16> values16(count);
+    std::vector<wxUint32> values32(count);
+    std::vector<wxUint64> values64(count);
+    std::vector<wxInt64> valuesI64(count);
+    std::vector<float> valuesFloat(count);
+    std::vector<double> valuesDouble(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        values16[n] = static_cast<wxUint16>(n * 0x0101 + 1);
+        values32[n] = static_cast<wxUint32>(n * 0x01020304 + 5);
+        values64[n] = (wxUint64(n) << 40) + wxUint64(0x12345678u) * n;
+        valuesI64[n] = -static_cast<wxInt64>(values64[n]);
+        valuesFloat[n] = static_cast<float>(n) / 8 - 100;
+        valuesDouble[n] = static_cast<double>(n) * 1.0625 - 1e6;
+    }
+
+    DoArrayRW(values16, &wxDataOutputStream::Write16, &wxDataInputStream::Read16);
+    DoArrayRW(values32, &wxDataOutputStream::Write32, &wxDataInputStream::Read32);
+    DoArrayRW(values64, &wxDataOutputStream::Write64, &wxDataInputStream::Read64);
+    DoArrayRW(valuesI64, &wxDataOutputStream::Write64, &wxDataInputStream::Read64);
+    DoArrayRW(valuesFloat, &wxDataOutputStream::WriteFloat, &wxDataInputStream::ReadFloat);
+    DoArrayRW(valuesDouble, &wxDataOutputStream::WriteDouble, &wxDataInputStream::ReadDouble);
+}
+
 
@@ -20,6 +20,12 @@
 
 #include "bstream.h"
 
+#ifdef __LINUX__
+    #include <sys/stat.h>
+
+    #include <thread>
+#endif
+
 #define DATABUFFER_SIZE     1024
 
 static const wxString FILENAME_FILEINSTREAM = wxT("fileinstream.test");
@@ -144,3 +150,158 @@ wxString fileStream::GetInFileName() const
 // Register the stream sub suite, by using some stream helper macro.
 // Note: Don't forget to connect it to the base suite (See: bstream.cpp => StreamCase::suite())
 STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(fileStream)
+
+TEST_CASE("wxMappedFileInputStream", "[stream][file]")
+{
+    static const wxString FILENAME_MAPPED = wxT("mappedinstream.test");
+
+    char buf[DATABUFFER_SIZE];
+    for (size_t i = 0; i < DATABUFFER_SIZE; i++)
+        buf[i] = (i % 0xFF);
+
+    {
+        wxFileOutputStream out(FILENAME_MAPPED);
+        REQUIRE( out.IsOk() );
+        out.Write(buf, DATABUFFER_SIZE);
+    }
+
+    struct AutoRemove
+    {
+        ~AutoRemove() { wxRemoveFile(FILENAME_MAPPED); }
+    } autoRemove;
+
+    wxMappedFileInputStream in(FILENAME_MAPPED);
+    REQUIRE( in.IsOk() );
+    CHECK( in.GetLength() == DATABUFFER_SIZE );
+#ifdef __UNIX__
+    CHECK( in.IsMapped() );
+#endif
+
+    REQUIRE( in.GetData() );
+    CHECK( memcmp(in.GetData(), buf, DATABUFFER_SIZE) == 0 );
+
+    CHECK( in.Peek() == buf[0] );
+    CHECK( in.SeekI(100) == 100 );
+    CHECK( in.GetC() == buf[100] );
+    CHECK( in.TellI() == 101 );
+
+    char data[200];
+    CHECK( in.SeekI(-200, wxFromEnd) == DATABUFFER_SIZE - 200 );
+    CHECK( in.Read(data, sizeof(data)).LastRead() == sizeof(data) );
+    CHECK( memcmp(data, buf + DATABUFFER_SIZE - 200, sizeof(data)) == 0 );
+
+    CHECK( in.GetC() == wxEOF );
+    CHECK( in.Eof() );
+
+    // Another stream can read the same data independently.
+    wxMemoryInputStream view(in.GetData(), in.GetLength());
+    CHECK( view.GetC() == buf[0] );
+
+    // Empty files can be mapped too.
+    {
+        wxFileOutputStream out(FILENAME_MAPPED);
+    }
+
+    wxMappedFileInputStream empty(FILENAME_MAPPED);
+    CHECK( empty.IsOk() );
+    CHECK( empty.GetLength() == 0 );
+    CHECK( empty.GetC() == wxEOF );
+
+    // But non-existent ones can't.
+    wxLogNull noLog;
+    wxMappedFileInputStream missing(wxT("nosuchfile.test"));
+    CHECK( !missing.IsOk() );
+}
+
+#ifdef __LINUX__
+
+// Check that special files, which can't be mapped, are still read entirely.
+TEST_CASE("wxMappedFileInputStream::Special", "[stream][file][linux][special-file]")
+{
+    // This file has 0 size, but can still be read.
+    SECTION("/proc")
+    {
+        wxMappedFileInputStream in("/proc/self/status");
+        REQUIRE( in.IsOk() );
+        CHECK( !in.IsMapped() );
+
+        REQUIRE( in.GetLength() > 5 );
+        CHECK( memcmp(in.GetData(), "Name:", 5) == 0 );
+    }
+
+    // And this one can't be even seeked in, so doesn't have any length.
+    SECTION("FIFO")
+    {
+        static const char FIFO_NAME[] = "mappedinstream.fifo";
+
+        REQUIRE( mkfifo(FIFO_NAME, 0600) == 0 );
+
+        struct AutoRemove
+        {
+            ~AutoRemove() { wxRemoveFile(FIFO_NAME); }
+        } autoRemove;
+
+        // Use enough data to not fit into the initial buffer.
+        char buf[10*DATABUFFER_SIZE];
+        for (size_t i = 0; i < sizeof(buf); i++)
+            buf[i] = (i % 0xFF);
+
+        // Opening FIFO for reading blocks until it's opened for writing, so
+        // do it in another thread.
+        bool written = false;
+        std::thread writer([&buf, &written]()
+        {
+            wxFile out(FIFO_NAME, wxFile::write);
+            written = out.IsOpened() && out.Write(buf, sizeof(buf)) == sizeof(buf);
+        });
+
+        wxMappedFileInputStream in(FIFO_NAME);
+
+        writer.join();
+        CHECK( written );
+
+        REQUIRE( in.IsOk() );
+        CHECK( !in.IsMapped() );
+        REQUIRE( in.GetLength() == sizeof(buf) );
+        CHECK( memcmp(in.GetData(), buf, sizeof(buf)) == 0 );
+    }
+}
+
+#endif // __LINUX__
+
+TEST_CASE("wxFileOutputStream::WriteV", "[stream][file]")
+{
+    static const wxString FILENAME_WRITEV = wxT("writevoutstream.test");
+
+    struct AutoRemove
+    {
+        ~AutoRemove() { wxRemoveFile(FILENAME_WRITEV); }
+    } autoRemove;
+
+    // Use more chunks than can be written by a single system call.
+    char buf[DATABUFFER_SIZE];
+    for (size_t i = 0; i < DATABUFFER_SIZE; i++)
+        buf[i] = (i % 0xFF);
+
+    wxIOVec vec[DATABUFFER_SIZE / 4];
+    for (size_t i = 0; i < WXSIZEOF(vec); i++)
+    {
+        vec[i].data = buf + 4*i;
+        vec[i].size = 4;
+    }
+
+    {
+        wxFileOutputStream out(FILENAME_WRITEV);
+        REQUIRE( out.IsOk() );
+        CHECK( out.WriteV(vec, WXSIZEOF(vec)).LastWrite() == DATABUFFER_SIZE );
+        CHECK( out.IsOk() );
+        CHECK( out.TellO() == DATABUFFER_SIZE );
+    }
+
+    wxFileInputStream in(FILENAME_WRITEV);
+    REQUIRE( in.GetLength() == DATABUFFER_SIZE );
+
+    char data[DATABUFFER_SIZE];
+    CHECK( in.Read(data, sizeof(data)).LastRead() == sizeof(data) );
+    CHECK( memcmp(data, buf, sizeof(data)) == 0 );
+}
@@ -156,3 +156,102 @@ void memStream::Ctor_InFromOut()
 // Register the stream sub suite, by using some stream helper macro.
 // Note: Don't forget to connect it to the base suite (See: bstream.cpp => StreamCase::suite())
 STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(memStream)
+
+TEST_CASE("wxMemoryOutputStream::WriteV", "[stream][memory]")
+{
+    const wxIOVec vec[] =
+    {
+        { "header:", 7 },
+        { nullptr, 0 },
+        { "payload", 7 },
+    };
+
+    wxMemoryOutputStream out;
+    out.Write("<", 1);
+    CHECK( out.WriteV(vec, WXSIZEOF(vec)).LastWrite() == 14 );
+    CHECK( out.IsOk() );
+    CHECK( out.GetLength() == 15 );
+
+    char buf[15];
+    CHECK( out.CopyTo(buf, sizeof(buf)) == sizeof(buf) );
+    CHECK( memcmp(buf, "<header:payload", sizeof(buf)) == 0 );
+}
+
+TEST_CASE("wxBufferedOutputStream::WriteV", "[stream][buffer]")
+{
+    wxMemoryOutputStream mem;
+    wxBufferedOutputStream out(mem, 16);
+
+    // Data fitting into the buffer is buffered.
+    const wxIOVec small[] = { { "ab", 2 }, { "cd", 2 } };
+    CHECK( out.WriteV(small, WXSIZEOF(small)).LastWrite() == 4 );
+    CHECK( mem.GetLength() == 0 );
+
+    // Bigger data is written directly, together with the buffered data.
+    wxCharBuffer big(100);
+    memset(big.data(), 'x', big.length());
+
+    const wxIOVec large[] = { { "ef", 2 }, { big.data(), big.length() } };
+    CHECK( out.WriteV(large, WXSIZEOF(large)).LastWrite() == 102 );
+    CHECK( mem.GetLength() == 106 );
+
+    out.Write("gh", 2);
+    out.Sync();
+    REQUIRE( mem.GetLength() == 108 );
+
+    char buf[108];
+    mem.CopyTo(buf, sizeof(buf));
+    CHECK( memcmp(buf, "abcdef", 6) == 0 );
+    CHECK( memcmp(buf + 6, big.data(), big.length()) == 0 );
+    CHECK( memcmp(buf + 106, "gh", 2) == 0 );
+}
+
+TEST_CASE("wxBufferedInputStream::Adaptive", "[stream][buffer]")
+{
+    const size_t size = 1024*1024;
+    wxCharBuffer data(size);
+    for ( size_t n = 0; n < size; n++ )
+        data.data()[n] = static_cast<char>(n % 251);
+
+    wxMemoryInputStream mem(data.data(), size);
+    wxBufferedInputStream in(mem);
+    wxStreamBuffer* const buf = in.GetInputStreamBuffer();
+    const size_t initialSize = buf->GetBufferSize();
+    CHECK( buf->GetMaxBufferSize() > initialSize );
+
+    // Reading sequentially in small chunks grows the buffer, so that much
+    // fewer reads from the underlying stream are needed.
+    char chunk[100];
+    for ( size_t pos = 0; pos < size; pos += sizeof(chunk) )
+    {
+        const size_t len = wxMin(sizeof(chunk), size - pos);
+        REQUIRE( in.Read(chunk, len).LastRead() == len );
+        REQUIRE( memcmp(chunk, data.data() + pos, len) == 0 );
+    }
+
+    CHECK( buf->GetBufferSize() == buf->GetMaxBufferSize() );
+    CHECK( buf->GetSysCallCount() < size / initialSize / 4 );
+    CHECK( buf->GetBytesCopied() == size );
+    CHECK( in.TellI() == static_cast<wxFileOffset>(size) );
+
+    // Seeking back goes back to the initial size.
+    CHECK( in.SeekI(1000) == 1000 );
+    CHECK( buf->GetBufferSize() == initialSize );
+    CHECK( in.TellI() == 1000 );
+    REQUIRE( in.Read(chunk, sizeof(chunk)).LastRead() == sizeof(chunk) );
+    CHECK( memcmp(chunk, data.data() + 1000, sizeof(chunk)) == 0 );
+    CHECK( in.TellI() == 1100 );
+
+    // Big reads bypass the buffer once it is empty.
+    buf->ResetCounters();
+    const size_t bigSize = 100000;
+    wxCharBuffer big(bigSize);
+    REQUIRE( in.Read(big.data(), bigSize).LastRead() == bigSize );
+    CHECK( memcmp(big.data(), data.data() + 1100, bigSize) == 0 );
+    CHECK( buf->GetBytesCopied() < initialSize );
+    CHECK( buf->GetSysCallCount() == 1 );
+    CHECK( in.TellI() == static_cast<wxFileOffset>(1100 + bigSize) );
+
+    REQUIRE( in.Read(chunk, sizeof(chunk)).LastRead() == sizeof(chunk) );
+    CHECK( memcmp(chunk, data.data() + 1100 + bigSize, sizeof(chunk)) == 0 );
+}
@@ -24,6 +24,8 @@
 
 #include "bstream.h"
 
+#include <vector>
+
 using std::string;
 
 #define DATABUFFER_SIZE 1024
@@ -548,3 +550,109 @@ void zlibStream::genExtTestData(wxTextOutputStream &out, const char *buf, int fl
 // Note: Don't forget to connect it to the base suite (See: bstream.cpp => StreamCase::suite())
 STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(zlibStream)
 
+
+TEST_CASE("wxZlibOutputStream::Parallel", "[stream][zlib]")
+{
+    // Create some data compressible enough to use the dictionary across the
+    // block boundaries.
+    wxMemoryBuffer buf;
+    for ( int n = 0; buf.GetDataLen() < 1000000; n++ )
+    {
+        const wxCharBuffer
+            line = wxString::Format("line %d of the test data\n", n % 777).ToAscii();
+        buf.AppendData(line.data(), line.length());
+    }
+
+    const char* const data = static_cast<const char*>(buf.GetData());
+    const size_t size = buf.GetDataLen();
+
+    const int flags[] = { wxZLIB_NO_HEADER, wxZLIB_ZLIB, wxZLIB_GZIP };
+    const size_t sizes[] = { 0, 10, 70000, size };
+
+    for ( int flag : flags )
+    {
+        for ( size_t len : sizes )
+        {
+            INFO("Flags " << flag << ", size " << len);
+
+            wxMemoryOutputStream mos;
+            {
+                wxZlibOutputStream zos(mos, wxZ_BEST_SPEED, flag);
+                REQUIRE( zos.SetMaxThreads(4, 32*1024) );
+                CHECK( zos.GetMaxThreads() == 4 );
+
+                // Flushing in the middle must still produce a valid stream.
+                zos.Write(data, len / 3);
+                zos.Sync();
+                zos.Write(data + len / 3, len - len / 3);
+
+                CHECK( zos.GetLength() == static_cast<wxFileOffset>(len) );
+                CHECK( zos.Close() );
+            }
+
+            wxMemoryInputStream mis(mos);
+            wxZlibInputStream zis(mis, flag == wxZLIB_NO_HEADER ? flag
+                                                                : wxZLIB_AUTO);
+
+            wxMemoryOutputStream out;
+            zis.Read(out);
+            CHECK( zis.GetLastError() == wxSTREAM_EOF );
+
+            REQUIRE( out.GetSize() == len );
+            std::vector<char> result(len + 1);
+            out.CopyTo(result.data(), len);
+            CHECK( memcmp(result.data(), data, len) == 0 );
+        }
+    }
+}
+
+TEST_CASE("wxZlibOutputStream::ParallelSync", "[stream][zlib]")
+{
+    wxMemoryBuffer buf;
+    for ( int n = 0; buf.GetDataLen() < 300000; n++ )
+    {
+        const wxCharBuffer
+            line = wxString::Format("line %d of the test data\n", n % 777).ToAscii();
+        buf.AppendData(line.data(), line.length());
+    }
+
+    const char* const data = static_cast<const char*>(buf.GetData());
+    const size_t size = buf.GetDataLen();
+
+    // Fill exactly one batch of blocks before calling Sync(), so that there
+    // is nothing left to compress when it's called.
+    static const size_t blockSize = 32*1024;
+    const size_t syncPos = 4*blockSize;
+
+    wxMemoryOutputStream mos;
+    wxFileOffset syncOffset;
+    {
+        wxZlibOutputStream zos(mos, wxZ_BEST_SPEED, wxZLIB_NO_HEADER);
+        REQUIRE( zos.SetMaxThreads(4, blockSize) );
+
+        zos.Write(data, syncPos);
+        zos.Sync();
+        syncOffset = mos.GetLength();
+
+        zos.Write(data + syncPos, size - syncPos);
+        CHECK( zos.Close() );
+    }
+
+    // The data after the flush point must be decodable on its own.
+    std::vector<char> compressed(mos.GetSize());
+    mos.CopyTo(compressed.data(), compressed.size());
+
+    wxMemoryInputStream mis(compressed.data() + syncOffset,
+                            compressed.size() - syncOffset);
+    wxZlibInputStream zis(mis, wxZLIB_NO_HEADER);
+
+    wxMemoryOutputStream out;
+    zis.Read(out);
+    CHECK( zis.GetLastError() == wxSTREAM_EOF );
+
+    const size_t len = size - syncPos;
+    REQUIRE( out.GetSize() == len );
+    std::vector<char> result(len);
+    out.CopyTo(result.data(), len);
+    CHECK( memcmp(result.data(), data + syncPos, len) == 0 );
+}
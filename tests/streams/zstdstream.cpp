@@ -0,0 +1,280 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/streams/zstdstream.cpp
+// Purpose:     Unit tests for Zstandard stream classes
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testprec.h"
+
+
+#if wxUSE_LIBZSTD && wxUSE_STREAMS
+
+#include "wx/mstream.h"
+#include "wx/zstdstream.h"
+
+#include "bstream.h"
+
+#include <memory>
+#include <string>
+
+class ZstdStream : public BaseStreamTestCase<wxZstdInputStream, wxZstdOutputStream>
+{
+public:
+    ZstdStream();
+
+    CPPUNIT_TEST_SUITE(zstdStream);
+        // Base class stream tests.
+        CPPUNIT_TEST(Input_GetSizeFail);
+        CPPUNIT_TEST(Input_GetC);
+        CPPUNIT_TEST(Input_Read);
+        CPPUNIT_TEST(Input_Eof);
+        CPPUNIT_TEST(Input_LastRead);
+        CPPUNIT_TEST(Input_CanRead);
+        CPPUNIT_TEST(Input_SeekIFail);
+        CPPUNIT_TEST(Input_TellI);
+        CPPUNIT_TEST(Input_Peek);
+        CPPUNIT_TEST(Input_Ungetch);
+
+        CPPUNIT_TEST(Output_PutC);
+        CPPUNIT_TEST(Output_Write);
+        CPPUNIT_TEST(Output_LastWrite);
+        CPPUNIT_TEST(Output_SeekOFail);
+        CPPUNIT_TEST(Output_TellO);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+    wxZstdInputStream *DoCreateInStream() override;
+    wxZstdOutputStream *DoCreateOutStream() override;
+
+private:
+    wxDECLARE_NO_COPY_CLASS(ZstdStream);
+};
+
+STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(ZstdStream)
+
+ZstdStream::ZstdStream()
+{
+    // Disable TellI() and TellO() tests in the base class which don't work
+    // with the compressed streams.
+    m_bSimpleTellITest =
+    m_bSimpleTellOTest = true;
+}
+
+wxZstdInputStream *ZstdStream::DoCreateInStream()
+{
+    // Compress some data.
+    const char data[] = "This is just some test data for Zstandard streams unit test";
+    const size_t len = sizeof(data);
+
+    wxMemoryOutputStream outmem;
+    wxZstdOutputStream outz(outmem);
+    outz.Write(data, len);
+    REQUIRE( outz.LastWrite() == len );
+    REQUIRE( outz.Close() );
+
+    wxMemoryInputStream* const inmem = new wxMemoryInputStream(outmem);
+    REQUIRE( inmem->IsOk() );
+
+    // Give ownership of the memory input stream to the Zstandard stream.
+    return new wxZstdInputStream(inmem);
+}
+
+wxZstdOutputStream *ZstdStream::DoCreateOutStream()
+{
+    return new wxZstdOutputStream(new wxMemoryOutputStream());
+}
+
+TEST_CASE("wxZstdInputStream::TrailingData", "[stream][zstd]")
+{
+    // Use enough data to need several blocks.
+    wxCharBuffer data(300000);
+    for ( size_t n = 0; n < data.length(); n++ )
+        data.data()[n] = static_cast<char>((n * n) % 251);
+
+    wxMemoryOutputStream outmem;
+    {
+        wxZstdOutputStream outz(outmem, 3);
+        outz.Write(data.data(), data.length());
+        REQUIRE( outz.LastWrite() == data.length() );
+        REQUIRE( outz.Close() );
+    }
+
+    const char trailer[] = "trailer";
+    outmem.Write(trailer, sizeof(trailer));
+
+    wxMemoryInputStream inmem(outmem);
+    wxZstdInputStream inz(inmem, wxZSTD_SINGLE_FRAME);
+
+    wxCharBuffer result(data.length());
+    inz.Read(result.data(), result.length());
+    REQUIRE( inz.LastRead() == data.length() );
+    CHECK( memcmp(result.data(), data.data(), data.length()) == 0 );
+
+    // The frame is over, so the decompressing stream must be at EOF...
+    CHECK( inz.GetC() == wxEOF );
+    CHECK( inz.Eof() );
+
+    // ... but the data after it must still be available in the parent stream.
+    char buf[sizeof(trailer)];
+    inmem.Read(buf, sizeof(buf));
+    REQUIRE( inmem.LastRead() == sizeof(trailer) );
+    CHECK( memcmp(buf, trailer, sizeof(trailer)) == 0 );
+}
+
+namespace
+{
+
+// Append a Zstandard frame with the given contents to the stream.
+void WriteFrame(wxOutputStream& out, const char* data)
+{
+    wxZstdOutputStream outz(out);
+    outz.Write(data, strlen(data));
+    REQUIRE( outz.LastWrite() == strlen(data) );
+    REQUIRE( outz.Close() );
+}
+
+// Read everything from the stream, which must end with EOF.
+std::string ReadAll(wxInputStream& in)
+{
+    std::string result;
+
+    char buf[16];
+    while ( in.Read(buf, sizeof(buf)).LastRead() )
+        result.append(buf, in.LastRead());
+
+    CHECK( in.GetLastError() == wxSTREAM_EOF );
+
+    return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxZstdInputStream::Concatenated", "[stream][zstd]")
+{
+    wxMemoryOutputStream outmem;
+    WriteFrame(outmem, "first frame, ");
+    WriteFrame(outmem, "second frame");
+
+    SECTION("All frames")
+    {
+        wxMemoryInputStream inmem(outmem);
+        wxZstdInputStream inz(inmem);
+
+        CHECK( ReadAll(inz) == "first frame, second frame" );
+    }
+
+    SECTION("Single frame")
+    {
+        wxMemoryInputStream inmem(outmem);
+        wxZstdInputStream inz(inmem, wxZSTD_SINGLE_FRAME);
+
+        CHECK( ReadAll(inz) == "first frame, " );
+
+        // The second frame can still be read using another stream.
+        wxZstdInputStream inz2(inmem);
+        CHECK( ReadAll(inz2) == "second frame" );
+    }
+}
+
+TEST_CASE("wxZstdInputStream::Skippable", "[stream][zstd]")
+{
+    // Skippable frame with the magic number 0x184D2A50 and 4 bytes of data,
+    // as written by pzstd at the beginning of its output.
+    const unsigned char skippable[] =
+    {
+        0x50, 0x2a, 0x4d, 0x18,
+        0x04, 0x00, 0x00, 0x00,
+        0xde, 0xad, 0xbe, 0xef
+    };
+
+    wxMemoryOutputStream outmem;
+    outmem.Write(skippable, sizeof(skippable));
+    WriteFrame(outmem, "data after skippable frame");
+
+    wxMemoryInputStream inmem(outmem);
+    wxZstdInputStream inz(inmem);
+
+    CHECK( ReadAll(inz) == "data after skippable frame" );
+}
+
+TEST_CASE("wxZstdInputStream::Truncated", "[stream][zstd]")
+{
+    // Use incompressible data big enough to need several blocks, so that the
+    // first ones can be decompressed even when the last one is truncated.
+    wxCharBuffer data(300000);
+    unsigned n = 1;
+    for ( size_t i = 0; i < data.length(); i++ )
+    {
+        n = n * 1103515245 + 12345;
+        data.data()[i] = static_cast<char>(n >> 16);
+    }
+
+    wxMemoryOutputStream outmem;
+    {
+        wxZstdOutputStream outz(outmem);
+        outz.Write(data.data(), data.length());
+        REQUIRE( outz.Close() );
+    }
+
+    // Drop the checksum and the last bytes of the frame.
+    const size_t lenTruncated = outmem.GetLength() - 10;
+    wxCharBuffer compressed(lenTruncated);
+    outmem.CopyTo(compressed.data(), lenTruncated);
+
+    wxMemoryInputStream inmem(compressed.data(), lenTruncated);
+    wxZstdInputStream inz(inmem);
+
+    wxLogNull noLog;
+
+    // The data decompressed before the error must still be returned.
+    wxCharBuffer result(data.length());
+    inz.Read(result.data(), result.length());
+    CHECK( inz.GetLastError() == wxSTREAM_READ_ERROR );
+    CHECK( inz.LastRead() > 0 );
+    CHECK( inz.LastRead() < data.length() );
+    CHECK( memcmp(result.data(), data.data(), inz.LastRead()) == 0 );
+}
+
+TEST_CASE("wxZstdInputStream::Corrupted", "[stream][zstd]")
+{
+    const char data[] = "This is not Zstandard data at all";
+    wxMemoryInputStream inmem(data, sizeof(data));
+    wxZstdInputStream inz(inmem);
+
+    wxLogNull noLog;
+
+    char buf[64];
+    inz.Read(buf, sizeof(buf));
+    CHECK( inz.LastRead() == 0 );
+    CHECK( inz.GetLastError() == wxSTREAM_READ_ERROR );
+}
+
+TEST_CASE("wxZstdClassFactory", "[stream][zstd]")
+{
+    const wxFilterClassFactory* const
+        factory = wxFilterClassFactory::Find(".zst", wxSTREAM_FILEEXT);
+    REQUIRE( factory );
+
+    CHECK( wxFilterClassFactory::Find("application/zstd", wxSTREAM_MIMETYPE)
+            == factory );
+    CHECK( factory->PopExtension("assets.tar.zst") == "assets.tar" );
+
+    wxMemoryOutputStream outmem;
+    {
+        std::unique_ptr<wxFilterOutputStream> out(factory->NewStream(outmem));
+        out->Write("zstd", 4);
+        REQUIRE( out->Close() );
+    }
+
+    wxMemoryInputStream inmem(outmem);
+    std::unique_ptr<wxFilterInputStream> in(factory->NewStream(inmem));
+
+    char buf[4];
+    in->Read(buf, sizeof(buf));
+    REQUIRE( in->LastRead() == 4 );
+    CHECK( memcmp(buf, "zstd", 4) == 0 );
+}
+
+#endif // wxUSE_LIBZSTD && wxUSE_STREAMS
@@ -0,0 +1,160 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/strings/atomstr.cpp
+// Purpose:     wxAtomString unit test
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+
+#include "wx/atomstr.h"
+
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif
+
+#include <unordered_map>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// tests implementation
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxAtomString::Basic", "[atomstr]")
+{
+    const wxAtomString empty;
+    CHECK( empty.IsEmpty() );
+    CHECK( empty.GetString().empty() );
+    CHECK( empty == wxAtomString("") );
+    CHECK( empty == wxAtomString(wxString()) );
+
+    const wxAtomString a("atomstr test label");
+    const wxAtomString b(wxString("atomstr test ") + "label");
+    const wxAtomString c(L"atomstr test other label");
+
+    CHECK( !a.IsEmpty() );
+    CHECK( a == b );
+    CHECK( a != c );
+    CHECK( a != empty );
+    CHECK( a.GetHash() == b.GetHash() );
+
+    // The same string is shared by all atoms with the same contents.
+    CHECK( &a.GetString() == &b.GetString() );
+
+    CHECK( a == "atomstr test label" );
+    CHECK( L"atomstr test label" == a );
+    CHECK( a == wxString("atomstr test label") );
+    CHECK( c != "atomstr test label" );
+
+    const wxString& s = a;
+    CHECK( s == "atomstr test label" );
+
+    wxAtomString copy = c;
+    CHECK( copy == c );
+    copy = a;
+    CHECK( copy == a );
+}
+
+TEST_CASE("wxAtomString::Unicode", "[atomstr]")
+{
+    const wxString str = wxString::FromUTF8("\xd0\xb0\xd1\x82\xd0\xbe\xd0\xbc");
+
+    const wxAtomString a(str);
+    CHECK( a.GetString() == str );
+    CHECK( a == wxAtomString(wxString::FromUTF8("\xd0\xb0\xd1\x82\xd0\xbe\xd0\xbc")) );
+    CHECK( a != wxAtomString(str + "s") );
+}
+
+TEST_CASE("wxAtomString::Hash", "[atomstr]")
+{
+    std::unordered_map<wxAtomString, int> map;
+    map[wxAtomString("atomstr hash one")] = 1;
+    map[wxAtomString("atomstr hash two")] = 2;
+    map[wxAtomString("atomstr hash one")] = 3;
+
+    CHECK( map.size() == 2 );
+    CHECK( map[wxAtomString("atomstr hash one")] == 3 );
+    CHECK( map[wxAtomString("atomstr hash two")] == 2 );
+}
+
+TEST_CASE("wxAtomString::Stats", "[atomstr]")
+{
+    const wxAtomStringStats before = wxAtomString::GetStats();
+
+    const wxString str = wxString::Format("atomstr stats %p", &before);
+    const wxAtomString a(str);
+
+    const wxAtomStringStats after = wxAtomString::GetStats();
+    CHECK( after.count == before.count + 1 );
+    CHECK( after.length == before.length + str.length() );
+    CHECK( after.memory > before.memory );
+    CHECK( after.lookups == before.lookups + 1 );
+    CHECK( after.hits == before.hits );
+
+    const wxAtomString b(str);
+
+    const wxAtomStringStats again = wxAtomString::GetStats();
+    CHECK( again.count == after.count );
+    CHECK( again.length == after.length );
+    CHECK( again.memory == after.memory );
+    CHECK( again.lookups == after.lookups + 1 );
+    CHECK( again.hits == after.hits + 1 );
+
+    // Empty atoms don't use the table at all.
+    const wxAtomString empty("");
+    CHECK( wxAtomString::GetStats().lookups == again.lookups );
+}
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+class AtomThread : public wxThread
+{
+public:
+    AtomThread() : wxThread(wxTHREAD_JOINABLE) { }
+
+    const std::vector<wxAtomString>& GetAtoms() const { return m_atoms; }
+
+protected:
+    virtual void* Entry() override
+    {
+        for ( int n = 0; n < 1000; n++ )
+            m_atoms.push_back(wxAtomString(wxString::Format("atomstr mt %d", n)));
+
+        return nullptr;
+    }
+
+private:
+    std::vector<wxAtomString> m_atoms;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxAtomString::Threads", "[atomstr]")
+{
+    AtomThread threads[4];
+    for ( auto& thread : threads )
+        REQUIRE( thread.Run() == wxTHREAD_NO_ERROR );
+
+    for ( auto& thread : threads )
+        thread.Wait();
+
+    // All threads must have got the same atoms for the same strings.
+    for ( size_t n = 0; n < 1000; n++ )
+    {
+        const wxAtomString& atom = threads[0].GetAtoms()[n];
+        CHECK( atom == wxString::Format("atomstr mt %d", static_cast<int>(n)) );
+
+        for ( const auto& thread : threads )
+            CHECK( thread.GetAtoms()[n] == atom );
+    }
+}
+
+#endif // wxUSE_THREADS
@@ -0,0 +1,176 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        logdecode.cpp
+// Purpose:     Converts binary logs written by wxLogBinary to text
+// Created:     2026-10-16
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+// For compilers that support precompilation, includes "wx/wx.h".
+#include "wx/wxprec.h"
+
+
+// for all others, include the necessary headers
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+    #include "wx/log.h"
+    #include "wx/wxcrtvararg.h"
+#endif
+
+#include "wx/cmdline.h"
+#include "wx/datetime.h"
+#include "wx/logbinary.h"
+#include "wx/stream.h"
+#include "wx/wfstream.h"
+
+class LogDecodeApp : public wxAppConsole
+{
+public:
+    // don't use builtin cmd line parsing:
+    virtual bool OnInit() override { return true; }
+    virtual int OnRun() override;
+
+private:
+    bool DecodeFile(const wxString& filename);
+    void OutputRecord(const wxLogBinaryRecord& record);
+
+    static wxString GetLevelName(wxLogLevel level);
+
+    bool m_verbose = false;
+    bool m_utc = false;
+};
+
+wxIMPLEMENT_APP_CONSOLE(LogDecodeApp);
+
+int LogDecodeApp::OnRun()
+{
+    wxGCC_WARNING_SUPPRESS(missing-field-initializers)
+
+    static const wxCmdLineEntryDesc cmdLineDesc[] =
+    {
+        { wxCMD_LINE_SWITCH, "h", "help",  "show help message", wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+        { wxCMD_LINE_SWITCH, "v", "verbose", "output thread, component and location of each message" },
+        { wxCMD_LINE_SWITCH, "u", "utc", "output time stamps in UTC instead of local time" },
+        { wxCMD_LINE_PARAM,  nullptr, nullptr, "input file(s)",
+              wxCMD_LINE_VAL_STRING,
+              wxCMD_LINE_PARAM_MULTIPLE | wxCMD_LINE_OPTION_MANDATORY },
+
+        wxCMD_LINE_DESC_END
+    };
+
+    wxGCC_WARNING_RESTORE(missing-field-initializers)
+
+    wxCmdLineParser parser(cmdLineDesc, argc, argv);
+
+    switch ( parser.Parse() )
+    {
+        case -1:
+            return 0;
+
+        case 0:
+            {
+                m_verbose = parser.Found("v");
+                m_utc = parser.Found("u");
+
+                int retCode = 0;
+                for ( size_t n = 0; n < parser.GetParamCount(); n++ )
+                {
+                    if ( !DecodeFile(parser.GetParam(n)) )
+                        retCode = 2;
+                }
+
+                return retCode;
+            }
+    }
+
+    return 1;
+}
+
+bool LogDecodeApp::DecodeFile(const wxString& filename)
+{
+    wxFileInputStream fileStream(filename);
+    if ( !fileStream.IsOk() )
+        return false;
+
+    wxBufferedInputStream stream(fileStream);
+
+    wxLogBinaryReader reader(stream);
+    if ( !reader.IsOk() )
+    {
+        wxLogError("File \"%s\" is not a binary log.", filename);
+        return false;
+    }
+
+    wxLogBinaryRecord record;
+    while ( reader.ReadRecord(record) )
+        OutputRecord(record);
+
+    if ( !reader.IsOk() )
+    {
+        wxLogError("File \"%s\" is truncated or corrupted.", filename);
+        return false;
+    }
+
+    return true;
+}
+
+void LogDecodeApp::OutputRecord(const wxLogBinaryRecord& record)
+{
+    const wxDateTime dt(wxLongLong(record.timestampMS));
+    wxString line = dt.Format("%Y-%m-%d %H:%M:%S.%l",
+                              m_utc ? wxDateTime::UTC : wxDateTime::Local);
+
+    if ( m_verbose )
+        line += wxString::Format(" [%" wxLongLongFmtSpec "x]", record.threadId);
+
+    line << ' ' << GetLevelName(record.level) << ": " << record.msg;
+
+    if ( m_verbose )
+    {
+        if ( !record.component.empty() )
+            line << " [" << record.component << ']';
+
+        if ( !record.filename.empty() )
+        {
+            line << " (" << record.filename << ':' << record.line;
+            if ( !record.func.empty() )
+                line << " in " << record.func;
+            line << ')';
+        }
+    }
+
+    wxPrintf("%s\n", line);
+}
+
+/* static */
+wxString LogDecodeApp::GetLevelName(wxLogLevel level)
+{
+    switch ( level )
+    {
+        case wxLOG_FatalError:
+            return "Fatal error";
+
+        case wxLOG_Error:
+            return "Error";
+
+        case wxLOG_Warning:
+            return "Warning";
+
+        case wxLOG_Message:
+            return "Message";
+
+        case wxLOG_Status:
+            return "Status";
+
+        case wxLOG_Info:
+            return "Info";
+
+        case wxLOG_Debug:
+            return "Debug";
+
+        case wxLOG_Trace:
+            return "Trace";
+    }
+
+    return wxString::Format("Level %lu", level);
+}